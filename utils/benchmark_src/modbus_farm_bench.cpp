@@ -0,0 +1,1303 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 OpenPLC Project
+// This file is part of the OpenPLC Software Stack.
+//
+// OpenPLC is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenPLC is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with OpenPLC.  If not, see <http://www.gnu.org/licenses/>.
+//------
+//
+// Modbus master scalability benchmark for the OpenPLC runtime. It simulates a
+// farm of Modbus slaves, Modbus/TCP slaves on local ports and Modbus RTU
+// slaves on pseudo-terminals, with configurable response latency, jitter,
+// exception rate, lost replies and disconnects. It writes the mbconfig.cfg
+// that makes the runtime poll all of them, (optionally) starts the runtime
+// and measures:
+//
+//  - the refresh rate of every slave, counted on the slave side as the
+//    input register reads it answered per second;
+//  - the age of the data in the runtime: every input register of a slave
+//    holds the time (in ms) at which the slave answered, and a probe reads
+//    them back from the Modbus server of the runtime (%IW100 onward), so the
+//    difference to the current time is how old the value is;
+//  - the CPU time the runtime used during the measurement.
+//
+// Everything runs on one machine: all the slaves are served by one thread
+// with epoll, so the farm itself stays cheap next to the runtime.
+//-----------------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <cerrno>
+#include <cstdint>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <time.h>
+#include <poll.h>
+#include <termios.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+using namespace std;
+
+#define INTERACTIVE_PORT    43628
+#define IO_TIMEOUT_MS       2000
+#define MAX_MB_IO           400     // points per area the runtime's master supports
+#define RTU_FRAME_GAP_MS    50      // a partial RTU frame older than this is dropped
+#define MAX_PDU_SIZE        253
+
+/// How one simulated slave answers
+struct SlaveProfile
+{
+    int latency_ms;
+    int jitter_ms;          // extra latency, uniform in [0, jitter_ms]
+    double error_rate;      // requests answered with a slave device failure exception
+    double drop_rate;       // requests left unanswered
+    double disconnect_rate; // requests that start an outage
+    int outage_ms;          // how long the slave stays unreachable after a disconnect
+};
+
+/// Benchmark configuration
+struct FarmConfig
+{
+    string host;
+    int tcp_slaves;
+    int rtu_slaves;
+    int rtu_per_bus;
+    int base_port;
+    int discrete_inputs;    // per slave
+    int coils;
+    int input_registers;
+    int holding_registers;
+    int polling_ms;
+    int timeout_ms;
+    int slow_slaves;        // the first n slaves use slow_latency_ms
+    int slow_latency_ms;
+    SlaveProfile profile;
+    int probe_port;
+    int probe_ms;
+    int warmup_s;
+    int duration_s;
+};
+
+/// One simulated slave and what it saw during the measurement
+struct Slave
+{
+    int index;
+    bool rtu;
+    int port;               // Modbus/TCP
+    int bus;                // Modbus RTU
+    int unit_id;
+    bool slow;
+    SlaveProfile profile;
+    int listen_fd;
+    unsigned long long down_until_ns;
+    vector<uint16_t> holding;
+    vector<unsigned char> coils;
+
+    unsigned long long requests;
+    unsigned long long refreshes; // input register reads answered
+    unsigned long long errors;
+    unsigned long long drops;
+    unsigned long long disconnects;
+    unsigned long long writes;
+};
+
+/// A pseudo-terminal shared by the RTU slaves with consecutive unit ids
+struct RtuBus
+{
+    int master_fd;
+    int slave_fd;           // kept open so the pty survives reconnects of the runtime
+    string path;
+    vector<int> slaves;     // slave index by unit id - 1
+    vector<unsigned char> input;
+    unsigned long long last_byte_ns;
+};
+
+/// A Modbus/TCP connection accepted by a slave
+struct Connection
+{
+    int fd;
+    int slave;
+    unsigned int generation;
+    vector<unsigned char> input;
+};
+
+/// A reply waiting for the simulated latency to pass
+struct PendingReply
+{
+    unsigned long long due_ns;
+    bool rtu;
+    int target;             // connection or bus index
+    unsigned int generation;
+    vector<unsigned char> data;
+
+    bool operator>(const PendingReply& other) const { return due_ns > other.due_ns; }
+};
+
+enum
+{
+    EVENT_LISTEN,
+    EVENT_CONNECTION,
+    EVENT_BUS
+};
+
+static vector<Slave> slaves;
+static vector<RtuBus> buses;
+static vector<Connection> connections;
+static priority_queue<PendingReply, vector<PendingReply>, greater<PendingReply> > pending;
+static mutex farm_lock;     // protects the slave counters, taken by the event loop per event
+static atomic<bool> farm_running(true);
+static int epoll_fd = -1;
+
+static inline unsigned long long nowNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/// Pseudo-random generator of the event loop
+static unsigned long long random_state = 0x5DEECE66DULL;
+
+static double nextUniform()
+{
+    random_state = random_state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (double)(random_state >> 11) / (double)(1ULL << 53);
+}
+
+//-----------------------------------------------------------------------------
+// Socket helpers
+//-----------------------------------------------------------------------------
+
+int connectTo(const string& host, int port)
+{
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1 ||
+        connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+        close(fd);
+        return -1;
+    }
+
+    int flag = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+    return fd;
+}
+
+bool sendAll(int fd, const unsigned char *data, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t n = send(fd, data, size, MSG_NOSIGNAL);
+        if (n <= 0)
+        {
+            if (n < 0 && errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        size -= n;
+    }
+    return true;
+}
+
+/// Reads exactly size bytes. Fails if the peer is silent for IO_TIMEOUT_MS
+bool recvAll(int fd, unsigned char *data, size_t size)
+{
+    while (size > 0)
+    {
+        struct pollfd pfd = {fd, POLLIN, 0};
+        if (poll(&pfd, 1, IO_TIMEOUT_MS) <= 0) return false;
+
+        ssize_t n = recv(fd, data, size, 0);
+        if (n <= 0)
+        {
+            if (n < 0 && errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        size -= n;
+    }
+    return true;
+}
+
+static void setNonBlocking(int fd)
+{
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+static void watch(int fd, int type, int index)
+{
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.u64 = ((uint64_t)type << 32) | (uint32_t)index;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event);
+}
+
+//-----------------------------------------------------------------------------
+// Interactive server
+//-----------------------------------------------------------------------------
+
+/// Sends a command to the interactive server and returns its reply
+bool interactiveCommand(const string& host, const string& command, string& reply)
+{
+    int fd = connectTo(host, INTERACTIVE_PORT);
+    if (fd < 0) return false;
+
+    string line = command + "\n";
+    bool ok = sendAll(fd, (const unsigned char *)line.c_str(), line.size());
+
+    reply.clear();
+    int timeout = IO_TIMEOUT_MS;
+    while (ok)
+    {
+        struct pollfd pfd = {fd, POLLIN, 0};
+        if (poll(&pfd, 1, timeout) <= 0) break;
+
+        char buffer[4096];
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) break;
+        reply.append(buffer, n);
+        timeout = 100; // the reply is written at once, just drain what is left
+    }
+
+    close(fd);
+    return ok && !reply.empty();
+}
+
+/// Polls the interactive server until the runtime accepts connections
+bool waitForRuntime(const string& host, int timeout_s)
+{
+    unsigned long long deadline = nowNs() + (unsigned long long)timeout_s * 1000000000ULL;
+    while (nowNs() < deadline)
+    {
+        int fd = connectTo(host, INTERACTIVE_PORT);
+        if (fd >= 0)
+        {
+            close(fd);
+            return true;
+        }
+        usleep(200000);
+    }
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+// Modbus slave
+//-----------------------------------------------------------------------------
+
+static uint16_t modbusCrc(const unsigned char *data, int size)
+{
+    uint16_t crc = 0xFFFF;
+    for (int i = 0; i < size; i++)
+    {
+        crc ^= data[i];
+        for (int j = 0; j < 8; j++)
+            crc = (crc & 1) ? (crc >> 1) ^ 0xA001 : crc >> 1;
+    }
+    return crc;
+}
+
+/// Answers a request PDU (function code and data) the way a slave with the
+/// configured areas would. Input registers hold the time of the answer in ms,
+/// discrete inputs toggle every second
+void answerRequest(Slave& slave, const FarmConfig& config, const unsigned char *pdu, int size, vector<unsigned char>& reply)
+{
+    unsigned char function = pdu[0];
+    reply.clear();
+    reply.push_back(function);
+
+    int address = (size >= 5) ? (pdu[1] << 8) | pdu[2] : 0;
+    int count = (size >= 5) ? (pdu[3] << 8) | pdu[4] : 0;
+    int exception = 0;
+
+    if (size < 5)
+    {
+        exception = 3;
+    }
+    else if (function == 0x01 || function == 0x02)
+    {
+        int limit = (function == 0x01) ? config.coils : config.discrete_inputs;
+        if (count < 1 || count > 2000 || address + count > limit)
+        {
+            exception = 2;
+        }
+        else
+        {
+            unsigned long long second = nowNs() / 1000000000ULL;
+            reply.push_back((count + 7) / 8);
+            for (int i = 0; i < count; i += 8)
+            {
+                unsigned char bits = 0;
+                for (int b = 0; b < 8 && i + b < count; b++)
+                {
+                    bool value = (function == 0x01) ? slave.coils[address + i + b] : ((second + address + i + b) & 1);
+                    if (value) bits |= (1 << b);
+                }
+                reply.push_back(bits);
+            }
+        }
+    }
+    else if (function == 0x03 || function == 0x04)
+    {
+        int limit = (function == 0x03) ? config.holding_registers : config.input_registers;
+        if (count < 1 || count > 125 || address + count > limit)
+        {
+            exception = 2;
+        }
+        else
+        {
+            uint16_t stamp = (uint16_t)(nowNs() / 1000000ULL);
+            reply.push_back(count * 2);
+            for (int i = 0; i < count; i++)
+            {
+                uint16_t value = (function == 0x03) ? slave.holding[address + i] : stamp;
+                reply.push_back(value >> 8);
+                reply.push_back(value & 0xFF);
+            }
+        }
+    }
+    else if (function == 0x05 || function == 0x06)
+    {
+        if (function == 0x05 && address < config.coils) slave.coils[address] = (pdu[3] == 0xFF);
+        else if (function == 0x06 && address < config.holding_registers) slave.holding[address] = count;
+        else exception = 2;
+        if (!exception)
+        {
+            reply.insert(reply.end(), pdu + 1, pdu + 5);
+            slave.writes++;
+        }
+    }
+    else if (function == 0x0F || function == 0x10)
+    {
+        int limit = (function == 0x0F) ? config.coils : config.holding_registers;
+        int bytes = (size >= 6) ? pdu[5] : 0;
+        if (count < 1 || address + count > limit || size < 6 + bytes)
+        {
+            exception = 2;
+        }
+        else
+        {
+            for (int i = 0; i < count; i++)
+            {
+                if (function == 0x0F) slave.coils[address + i] = (pdu[6 + i / 8] >> (i % 8)) & 1;
+                else if (7 + i * 2 < size) slave.holding[address + i] = (pdu[6 + i * 2] << 8) | pdu[7 + i * 2];
+            }
+            reply.insert(reply.end(), pdu + 1, pdu + 5);
+            slave.writes++;
+        }
+    }
+    else
+    {
+        exception = 1;
+    }
+
+    if (exception)
+    {
+        reply.clear();
+        reply.push_back(function | 0x80);
+        reply.push_back(exception);
+    }
+}
+
+/// Decides what happens to a request: answered (returns true and the delay),
+/// answered with an exception, dropped or cut off by an outage
+bool injectFaults(Slave& slave, unsigned long long now, vector<unsigned char>& reply, unsigned long long& delay_ns, bool& disconnect)
+{
+    const SlaveProfile& profile = slave.profile;
+    disconnect = false;
+
+    if (nextUniform() < profile.disconnect_rate)
+    {
+        slave.disconnects++;
+        slave.down_until_ns = now + (unsigned long long)profile.outage_ms * 1000000ULL;
+        disconnect = true;
+        return false;
+    }
+    if (nextUniform() < profile.drop_rate)
+    {
+        slave.drops++;
+        return false;
+    }
+    if (nextUniform() < profile.error_rate)
+    {
+        unsigned char function = reply.empty() ? 0 : reply[0];
+        reply.clear();
+        reply.push_back(function | 0x80);
+        reply.push_back(0x04); // slave device failure
+        slave.errors++;
+    }
+
+    delay_ns = (unsigned long long)profile.latency_ms * 1000000ULL;
+    if (profile.jitter_ms > 0) delay_ns += (unsigned long long)(nextUniform() * profile.jitter_ms * 1000000.0);
+    return true;
+}
+
+static void closeConnection(int index)
+{
+    Connection& connection = connections[index];
+    if (connection.fd < 0) return;
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, connection.fd, NULL);
+    close(connection.fd);
+    connection.fd = -1;
+    connection.generation++;
+    connection.input.clear();
+}
+
+/// Accepts a client on the port of a slave. While the slave is in an outage
+/// the connection is closed right away
+static void acceptClient(int slave_index)
+{
+    int fd = accept(slaves[slave_index].listen_fd, NULL, NULL);
+    if (fd < 0) return;
+    if (nowNs() < slaves[slave_index].down_until_ns)
+    {
+        close(fd);
+        return;
+    }
+
+    int flag = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+    setNonBlocking(fd);
+
+    size_t index = 0;
+    while (index < connections.size() && connections[index].fd >= 0) index++;
+    if (index == connections.size())
+    {
+        Connection connection;
+        connection.fd = -1;
+        connection.generation = 0;
+        connections.push_back(connection);
+    }
+    connections[index].fd = fd;
+    connections[index].slave = slave_index;
+    connections[index].input.clear();
+    watch(fd, EVENT_CONNECTION, index);
+}
+
+/// Reads from a Modbus/TCP connection and schedules the replies of the
+/// complete requests received
+static void serveConnection(int index, const FarmConfig& config)
+{
+    Connection& connection = connections[index];
+    unsigned char buffer[4096];
+    ssize_t n = recv(connection.fd, buffer, sizeof(buffer), 0);
+    if (n <= 0)
+    {
+        if (n < 0 && (errno == EAGAIN || errno == EINTR)) return;
+        closeConnection(index);
+        return;
+    }
+    connection.input.insert(connection.input.end(), buffer, buffer + n);
+
+    while (connection.input.size() >= 8)
+    {
+        int length = (connection.input[4] << 8) | connection.input[5];
+        if (length < 2 || length > MAX_PDU_SIZE + 1)
+        {
+            closeConnection(index);
+            return;
+        }
+        if ((int)connection.input.size() < 6 + length) break;
+
+        Slave& slave = slaves[connection.slave];
+        unsigned long long now = nowNs();
+        vector<unsigned char> pdu_reply;
+        unsigned long long delay_ns = 0;
+        bool disconnect;
+
+        lock_guard<mutex> guard(farm_lock);
+        slave.requests++;
+        answerRequest(slave, config, &connection.input[7], length - 1, pdu_reply);
+        if (injectFaults(slave, now, pdu_reply, delay_ns, disconnect))
+        {
+            if (pdu_reply[0] == 0x04) slave.refreshes++;
+            PendingReply reply;
+            reply.due_ns = now + delay_ns;
+            reply.rtu = false;
+            reply.target = index;
+            reply.generation = connection.generation;
+            reply.data.assign(connection.input.begin(), connection.input.begin() + 7);
+            reply.data[4] = (pdu_reply.size() + 1) >> 8;
+            reply.data[5] = (pdu_reply.size() + 1) & 0xFF;
+            reply.data.insert(reply.data.end(), pdu_reply.begin(), pdu_reply.end());
+            pending.push(reply);
+        }
+        else if (disconnect)
+        {
+            closeConnection(index);
+            return;
+        }
+        connection.input.erase(connection.input.begin(), connection.input.begin() + 6 + length);
+    }
+}
+
+/// Size of the RTU request starting at frame[0], or 0 if it is not known yet
+static int rtuRequestSize(const vector<unsigned char>& frame)
+{
+    if (frame.size() < 2) return 0;
+    unsigned char function = frame[1];
+    if (function >= 0x01 && function <= 0x06) return 8;
+    if (function == 0x0F || function == 0x10) return (frame.size() < 7) ? 0 : 9 + frame[6];
+    return -1;
+}
+
+/// Reads from a pseudo-terminal and schedules the replies of the slaves on
+/// that bus. Frames for unit ids that are not on the bus are ignored, as a
+/// real RTU line would
+static void serveBus(int index, const FarmConfig& config)
+{
+    RtuBus& bus = buses[index];
+    unsigned char buffer[4096];
+    ssize_t n = read(bus.master_fd, buffer, sizeof(buffer));
+    if (n <= 0) return;
+
+    unsigned long long now = nowNs();
+    if (!bus.input.empty() && now - bus.last_byte_ns > RTU_FRAME_GAP_MS * 1000000ULL) bus.input.clear();
+    bus.last_byte_ns = now;
+    bus.input.insert(bus.input.end(), buffer, buffer + n);
+
+    while (true)
+    {
+        int size = rtuRequestSize(bus.input);
+        if (size < 0 || size > MAX_PDU_SIZE + 3)
+        {
+            bus.input.clear();
+            return;
+        }
+        if (size == 0 || (int)bus.input.size() < size) return;
+
+        uint16_t crc = modbusCrc(&bus.input[0], size - 2);
+        bool valid = (bus.input[size - 2] == (crc & 0xFF) && bus.input[size - 1] == (crc >> 8));
+        int unit = bus.input[0];
+        if (valid && unit >= 1 && unit <= (int)bus.slaves.size())
+        {
+            Slave& slave = slaves[bus.slaves[unit - 1]];
+            vector<unsigned char> pdu_reply;
+            unsigned long long delay_ns = 0;
+            bool disconnect;
+
+            lock_guard<mutex> guard(farm_lock);
+            if (now >= slave.down_until_ns)
+            {
+                slave.requests++;
+                answerRequest(slave, config, &bus.input[1], size - 3, pdu_reply);
+                if (injectFaults(slave, now, pdu_reply, delay_ns, disconnect))
+                {
+                    if (pdu_reply[0] == 0x04) slave.refreshes++;
+                    PendingReply reply;
+                    reply.due_ns = now + delay_ns;
+                    reply.rtu = true;
+                    reply.target = index;
+                    reply.generation = 0;
+                    reply.data.push_back(unit);
+                    reply.data.insert(reply.data.end(), pdu_reply.begin(), pdu_reply.end());
+                    crc = modbusCrc(&reply.data[0], reply.data.size());
+                    reply.data.push_back(crc & 0xFF);
+                    reply.data.push_back(crc >> 8);
+                    pending.push(reply);
+                }
+            }
+        }
+        bus.input.erase(bus.input.begin(), bus.input.begin() + size);
+    }
+}
+
+/// Sends the replies whose latency has passed. Returns the time until the
+/// next one is due, in ms, for epoll_wait
+static int sendDueReplies()
+{
+    unsigned long long now = nowNs();
+    while (!pending.empty() && pending.top().due_ns <= now)
+    {
+        const PendingReply& reply = pending.top();
+        if (reply.rtu)
+        {
+            if (write(buses[reply.target].master_fd, &reply.data[0], reply.data.size()) < 0) {}
+        }
+        else if (connections[reply.target].fd >= 0 && connections[reply.target].generation == reply.generation)
+        {
+            if (!sendAll(connections[reply.target].fd, &reply.data[0], reply.data.size())) closeConnection(reply.target);
+        }
+        pending.pop();
+    }
+
+    if (pending.empty()) return 100;
+    return (int)((pending.top().due_ns - now + 999999ULL) / 1000000ULL);
+}
+
+/// Event loop of the farm. Serves all the slaves until farm_running is
+/// cleared
+void farmThread(const FarmConfig *config)
+{
+    struct epoll_event events[64];
+    while (farm_running)
+    {
+        int timeout = sendDueReplies();
+        int n = epoll_wait(epoll_fd, events, 64, timeout);
+        for (int i = 0; i < n; i++)
+        {
+            int type = events[i].data.u64 >> 32;
+            int index = events[i].data.u64 & 0xFFFFFFFF;
+            if (type == EVENT_LISTEN) acceptClient(index);
+            else if (type == EVENT_CONNECTION) serveConnection(index, *config);
+            else serveBus(index, *config);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Farm setup
+//-----------------------------------------------------------------------------
+
+/// Opens a pseudo-terminal for an RTU bus. The slave side is put in raw mode
+/// and kept open
+bool openBus(RtuBus& bus)
+{
+    bus.master_fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (bus.master_fd < 0 || grantpt(bus.master_fd) < 0 || unlockpt(bus.master_fd) < 0) return false;
+    bus.path = ptsname(bus.master_fd);
+
+    bus.slave_fd = open(bus.path.c_str(), O_RDWR | O_NOCTTY);
+    if (bus.slave_fd < 0) return false;
+    struct termios tio;
+    tcgetattr(bus.slave_fd, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(bus.slave_fd, TCSANOW, &tio);
+
+    setNonBlocking(bus.master_fd);
+    bus.last_byte_ns = 0;
+    return true;
+}
+
+/// Creates the slaves: listening sockets for the TCP ones, buses for the RTU
+/// ones. The first slow_slaves get the slow latency
+bool createFarm(const FarmConfig& config)
+{
+    epoll_fd = epoll_create1(0);
+    if (epoll_fd < 0) return false;
+
+    int total = config.tcp_slaves + config.rtu_slaves;
+    slaves.resize(total);
+    for (int i = 0; i < total; i++)
+    {
+        Slave& slave = slaves[i];
+        slave.index = i;
+        slave.rtu = (i >= config.tcp_slaves);
+        slave.slow = (i < config.slow_slaves);
+        slave.profile = config.profile;
+        if (slave.slow) slave.profile.latency_ms = config.slow_latency_ms;
+        slave.listen_fd = -1;
+        slave.port = 0;
+        slave.bus = -1;
+        slave.unit_id = 1;
+        slave.down_until_ns = 0;
+        slave.holding.assign(config.holding_registers, 0);
+        slave.coils.assign(config.coils, 0);
+        slave.requests = slave.refreshes = slave.errors = slave.drops = slave.disconnects = slave.writes = 0;
+
+        if (!slave.rtu)
+        {
+            slave.port = config.base_port + i;
+            slave.listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+            int enable = 1;
+            setsockopt(slave.listen_fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+            struct sockaddr_in addr;
+            memset(&addr, 0, sizeof(addr));
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(slave.port);
+            inet_pton(AF_INET, config.host.c_str(), &addr.sin_addr);
+            if (bind(slave.listen_fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(slave.listen_fd, 16) < 0)
+            {
+                cout << "Error listening on port " << slave.port << ": " << strerror(errno) << endl;
+                return false;
+            }
+            setNonBlocking(slave.listen_fd);
+            watch(slave.listen_fd, EVENT_LISTEN, i);
+        }
+        else
+        {
+            int rtu_index = i - config.tcp_slaves;
+            if (rtu_index % config.rtu_per_bus == 0)
+            {
+                RtuBus bus;
+                if (!openBus(bus))
+                {
+                    cout << "Error creating a pseudo-terminal: " << strerror(errno) << endl;
+                    return false;
+                }
+                buses.push_back(bus);
+                watch(buses.back().master_fd, EVENT_BUS, buses.size() - 1);
+            }
+            slave.bus = buses.size() - 1;
+            buses.back().slaves.push_back(i);
+            slave.unit_id = buses.back().slaves.size();
+        }
+    }
+    return true;
+}
+
+/// Writes the mbconfig.cfg that makes the runtime poll every slave of the farm
+void emitMbconfig(ostream& cfg, const FarmConfig& config)
+{
+    cfg << "Num_Devices = \"" << slaves.size() << "\"\n";
+    cfg << "Polling_Period = \"" << config.polling_ms << "\"\n";
+    cfg << "Timeout = \"" << config.timeout_ms << "\"\n";
+
+    for (size_t i = 0; i < slaves.size(); i++)
+    {
+        const Slave& slave = slaves[i];
+        string device = "device" + to_string(i);
+        cfg << "\n# ------------\n#   DEVICE " << i << "\n# ------------\n";
+        cfg << device << ".name = \"" << (slave.rtu ? "rtu" : "tcp") << i << (slave.slow ? "_slow" : "") << "\"\n";
+        cfg << device << ".slave_id = \"" << slave.unit_id << "\"\n";
+        cfg << device << ".protocol = \"" << (slave.rtu ? "RTU" : "TCP") << "\"\n";
+        cfg << device << ".address = \"" << (slave.rtu ? buses[slave.bus].path : config.host) << "\"\n";
+        cfg << device << ".IP_Port = \"" << slave.port << "\"\n";
+        cfg << device << ".RTU_Baud_Rate = \"115200\"\n";
+        cfg << device << ".RTU_Parity = \"None\"\n";
+        cfg << device << ".RTU_Data_Bits = \"8\"\n";
+        cfg << device << ".RTU_Stop_Bits = \"1\"\n";
+        cfg << device << ".RTU_TX_Pause = \"0\"\n\n";
+        cfg << device << ".Discrete_Inputs_Start = \"0\"\n";
+        cfg << device << ".Discrete_Inputs_Size = \"" << config.discrete_inputs << "\"\n";
+        cfg << device << ".Coils_Start = \"0\"\n";
+        cfg << device << ".Coils_Size = \"" << config.coils << "\"\n";
+        cfg << device << ".Input_Registers_Start = \"0\"\n";
+        cfg << device << ".Input_Registers_Size = \"" << config.input_registers << "\"\n";
+        cfg << device << ".Holding_Registers_Read_Start = \"0\"\n";
+        cfg << device << ".Holding_Registers_Read_Size = \"0\"\n";
+        cfg << device << ".Holding_Registers_Start = \"0\"\n";
+        cfg << device << ".Holding_Registers_Size = \"" << config.holding_registers << "\"\n";
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Data age probe
+//-----------------------------------------------------------------------------
+
+/// Age samples (in ms) of every input register, in the order the master
+/// packs them: all the registers of device 0, then device 1 and so on
+static vector<vector<unsigned int> > point_ages;
+static mutex probe_lock;
+static atomic<bool> probe_running(true);
+static atomic<bool> probe_recording(false);
+static unsigned long long probe_errors = 0;
+
+/// Reads input registers from the Modbus server of the runtime
+bool readInputRegisters(int fd, uint16_t tid, int address, int count, vector<uint16_t>& values)
+{
+    unsigned char request[12] = {(unsigned char)(tid >> 8), (unsigned char)(tid & 0xFF), 0, 0, 0, 6, 1, 0x04,
+                                 (unsigned char)(address >> 8), (unsigned char)(address & 0xFF), 0, (unsigned char)count};
+    if (!sendAll(fd, request, sizeof(request))) return false;
+
+    unsigned char response[260];
+    if (!recvAll(fd, response, 7)) return false;
+    int length = (response[4] << 8) | response[5];
+    if (length < 2 || length > 254) return false;
+    if (!recvAll(fd, response + 7, length - 1)) return false;
+    if (response[7] != 0x04 || response[8] != count * 2) return false;
+
+    for (int i = 0; i < count; i++) values.push_back((response[9 + i * 2] << 8) | response[10 + i * 2]);
+    return true;
+}
+
+/// Samples the input registers the master copied into the runtime (%IW100
+/// onward) every probe_ms and records how old each value is. A register
+/// still at 0 has never been refreshed and is not counted. The stamps are
+/// 16 bit, so ages wrap after 65 s
+void probeThread(const FarmConfig *config)
+{
+    int points = (int)slaves.size() * config->input_registers;
+    int fd = -1;
+    uint16_t tid = 0;
+
+    while (probe_running)
+    {
+        if (fd < 0) fd = connectTo(config->host, config->probe_port);
+        if (fd < 0)
+        {
+            usleep(200000);
+            continue;
+        }
+
+        vector<uint16_t> values;
+        bool ok = true;
+        for (int address = 0; address < points && ok; address += 125)
+            ok = readInputRegisters(fd, ++tid, 100 + address, min(125, points - address), values);
+        uint16_t now_ms = (uint16_t)(nowNs() / 1000000ULL);
+
+        if (!ok)
+        {
+            close(fd);
+            fd = -1;
+            lock_guard<mutex> guard(probe_lock);
+            if (probe_recording) probe_errors++;
+            continue;
+        }
+
+        if (probe_recording)
+        {
+            lock_guard<mutex> guard(probe_lock);
+            for (int i = 0; i < points; i++)
+                if (values[i] != 0) point_ages[i].push_back((uint16_t)(now_ms - values[i]));
+        }
+        usleep(config->probe_ms * 1000);
+    }
+    if (fd >= 0) close(fd);
+}
+
+//-----------------------------------------------------------------------------
+// Reporting
+//-----------------------------------------------------------------------------
+
+/// CPU time (user + system) used by a process so far, in seconds
+static double processCpuSeconds(pid_t pid)
+{
+    string path = "/proc/" + to_string(pid) + "/stat";
+    ifstream stat(path.c_str());
+    string content;
+    if (!getline(stat, content)) return -1;
+
+    // the command name can hold spaces, the fields start after its ')'
+    size_t end = content.rfind(')');
+    if (end == string::npos) return -1;
+    stringstream fields(content.substr(end + 2));
+    string field;
+    unsigned long long utime = 0, stime = 0;
+    for (int i = 3; fields >> field; i++)
+    {
+        if (i == 14) utime = strtoull(field.c_str(), NULL, 10);
+        if (i == 15)
+        {
+            stime = strtoull(field.c_str(), NULL, 10);
+            break;
+        }
+    }
+    return (double)(utime + stime) / sysconf(_SC_CLK_TCK);
+}
+
+static double percentile(const vector<unsigned int>& sorted, double pct)
+{
+    if (sorted.empty()) return 0;
+    size_t index = (size_t)(pct / 100.0 * (sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+/// Refresh rate and data age of a group of slaves
+struct GroupSummary
+{
+    int slaves;
+    int stale;              // slaves never refreshed during the measurement
+    double min_hz, max_hz, total_hz;
+    vector<unsigned int> ages;
+};
+
+void printReport(const FarmConfig& config, double elapsed_s, double runtime_cpu_s, double farm_cpu_s, const string& csv_file)
+{
+    ofstream csv;
+    if (!csv_file.empty())
+    {
+        csv.open(csv_file.c_str(), ios::trunc);
+        csv << "device,protocol,latency_ms,requests,refreshes,errors,drops,disconnects,writes,refresh_hz,age_p50_ms,age_p99_ms,age_max_ms\n";
+    }
+
+    GroupSummary groups[2];
+    for (int g = 0; g < 2; g++)
+    {
+        groups[g].slaves = groups[g].stale = 0;
+        groups[g].min_hz = 1e30;
+        groups[g].max_hz = groups[g].total_hz = 0;
+    }
+
+    char line[256];
+    for (size_t i = 0; i < slaves.size(); i++)
+    {
+        const Slave& slave = slaves[i];
+        vector<unsigned int> ages;
+        for (int p = 0; p < config.input_registers; p++)
+        {
+            const vector<unsigned int>& samples = point_ages[i * config.input_registers + p];
+            ages.insert(ages.end(), samples.begin(), samples.end());
+        }
+        sort(ages.begin(), ages.end());
+        double hz = slave.refreshes / elapsed_s;
+
+        GroupSummary& group = groups[slave.slow ? 1 : 0];
+        group.slaves++;
+        if (slave.refreshes == 0) group.stale++;
+        group.min_hz = min(group.min_hz, hz);
+        group.max_hz = max(group.max_hz, hz);
+        group.total_hz += hz;
+        group.ages.insert(group.ages.end(), ages.begin(), ages.end());
+
+        if (csv.is_open())
+            csv << (slave.rtu ? "rtu" : "tcp") << i << "," << (slave.rtu ? "RTU" : "TCP") << "," << slave.profile.latency_ms << ","
+                << slave.requests << "," << slave.refreshes << "," << slave.errors << "," << slave.drops << "," << slave.disconnects << ","
+                << slave.writes << "," << hz << "," << percentile(ages, 50) << "," << percentile(ages, 99) << ","
+                << (ages.empty() ? 0 : ages.back()) << "\n";
+    }
+
+    cout << endl;
+    snprintf(line, sizeof(line), "%-8s %7s %7s %10s %10s %10s %11s %11s %11s", "slaves", "count", "stale", "min Hz", "avg Hz", "max Hz",
+             "age p50 ms", "age p99 ms", "age max ms");
+    cout << line << endl;
+    if (csv.is_open()) csv << "\nslaves,count,stale,min_hz,avg_hz,max_hz,age_p50_ms,age_p99_ms,age_max_ms\n";
+
+    const char *names[2] = {"normal", "slow"};
+    for (int g = 0; g < 2; g++)
+    {
+        GroupSummary& group = groups[g];
+        if (group.slaves == 0) continue;
+        sort(group.ages.begin(), group.ages.end());
+        double avg = group.total_hz / group.slaves;
+        double worst = group.ages.empty() ? 0 : group.ages.back();
+        snprintf(line, sizeof(line), "%-8s %7d %7d %10.2f %10.2f %10.2f %11.0f %11.0f %11.0f", names[g], group.slaves, group.stale,
+                 group.min_hz, avg, group.max_hz, percentile(group.ages, 50), percentile(group.ages, 99), worst);
+        cout << line << endl;
+        if (csv.is_open())
+            csv << names[g] << "," << group.slaves << "," << group.stale << "," << group.min_hz << "," << avg << "," << group.max_hz << ","
+                << percentile(group.ages, 50) << "," << percentile(group.ages, 99) << "," << worst << "\n";
+    }
+
+    unsigned long long requests = 0, errors = 0, drops = 0, disconnects = 0;
+    for (size_t i = 0; i < slaves.size(); i++)
+    {
+        requests += slaves[i].requests;
+        errors += slaves[i].errors;
+        drops += slaves[i].drops;
+        disconnects += slaves[i].disconnects;
+    }
+
+    cout << endl;
+    cout << "Requests served:     " << requests << " (" << requests / elapsed_s << "/s), " << errors << " exceptions, " << drops
+         << " dropped, " << disconnects << " disconnects" << endl;
+    cout << "Probe read errors:   " << probe_errors << endl;
+    if (runtime_cpu_s >= 0)
+    {
+        snprintf(line, sizeof(line), "Runtime CPU:         %.2f s (%.1f%% of one core)", runtime_cpu_s, runtime_cpu_s * 100.0 / elapsed_s);
+        cout << line << endl;
+    }
+    snprintf(line, sizeof(line), "Farm CPU:            %.2f s (%.1f%% of one core)", farm_cpu_s, farm_cpu_s * 100.0 / elapsed_s);
+    cout << line << endl;
+
+    if (csv.is_open())
+    {
+        csv << "\nrequests,exceptions,dropped,disconnects,probe_errors,runtime_cpu_s,farm_cpu_s,elapsed_s\n";
+        csv << requests << "," << errors << "," << drops << "," << disconnects << "," << probe_errors << "," << runtime_cpu_s << ","
+            << farm_cpu_s << "," << elapsed_s << "\n";
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Command line handling
+//-----------------------------------------------------------------------------
+
+static double farmCpuSeconds()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+}
+
+void printUsage()
+{
+    cout << "Usage " << endl << endl;
+    cout << "  modbus_farm_bench [options]" << endl << endl;
+    cout << "Simulates a farm of Modbus/TCP and Modbus RTU slaves, makes the OpenPLC runtime poll all of" << endl;
+    cout << "them as slave devices and reports the refresh rate of every slave, the age of the data in" << endl;
+    cout << "the runtime and the CPU time the runtime used." << endl << endl;
+    cout << "Options" << endl;
+    cout << "  --launch <dir>          = Write <dir>/mbconfig.cfg, start the runtime from this webserver folder" << endl;
+    cout << "                            and stop it at the end. The original mbconfig.cfg is restored" << endl;
+    cout << "  --mbconfig <file>       = Without --launch: write the slave devices here and keep the farm" << endl;
+    cout << "                            running while the runtime is (re)started by hand" << endl;
+    cout << "  --pid <pid>             = Runtime process to measure the CPU time of, without --launch" << endl;
+    cout << "  --host <ip>             = Address of the runtime and of the farm (default 127.0.0.1)" << endl;
+    cout << "  --tcp <n>               = Modbus/TCP slaves (default 50)" << endl;
+    cout << "  --rtu <n>               = Modbus RTU slaves on pseudo-terminals (default 0)" << endl;
+    cout << "  --rtu-per-bus <n>       = RTU slaves sharing one pseudo-terminal (default 1)" << endl;
+    cout << "  --base-port <port>      = Port of the first TCP slave, the others follow (default 15020)" << endl;
+    cout << "  --inputs <n>            = Discrete inputs per slave (default 8)" << endl;
+    cout << "  --coils <n>             = Coils per slave (default 0)" << endl;
+    cout << "  --registers <n>         = Input registers per slave, at least 1 (default 2)" << endl;
+    cout << "  --holding <n>           = Holding registers written by the master per slave (default 0)" << endl;
+    cout << "  --polling <ms>          = Polling_Period of the master (default 100)" << endl;
+    cout << "  --timeout <ms>          = Timeout of the master (default 1000)" << endl;
+    cout << "  --latency <ms>          = Response latency of the slaves (default 2)" << endl;
+    cout << "  --jitter <ms>           = Extra random latency, up to this much (default 1)" << endl;
+    cout << "  --slow <n>              = The first n slaves answer with --slow-latency (default 0)" << endl;
+    cout << "  --slow-latency <ms>     = (default 200)" << endl;
+    cout << "  --error-rate <p>        = Fraction of requests answered with an exception (default 0)" << endl;
+    cout << "  --drop-rate <p>         = Fraction of requests left unanswered (default 0)" << endl;
+    cout << "  --disconnect-rate <p>   = Fraction of requests that start an outage of the slave (default 0)" << endl;
+    cout << "  --outage <ms>           = Length of an outage (default 2000)" << endl;
+    cout << "  --probe-port <port>     = Modbus server of the runtime used to read the data back (default 502)" << endl;
+    cout << "  --probe <ms>            = Data age sampling period (default 100)" << endl;
+    cout << "  --warmup <s>            = Time for the master to connect before measuring (default 5)" << endl;
+    cout << "  --duration <s>          = Length of the measurement (default 30)" << endl;
+    cout << "  --csv <file>            = Also store the per slave results as csv" << endl;
+    cout << "  --help,-h               = Print usage information and exit." << endl;
+}
+
+static void handleStop(int)
+{
+    farm_running = false;
+}
+
+int main(int argc, char *argv[])
+{
+    FarmConfig config;
+    config.host = "127.0.0.1";
+    config.tcp_slaves = 50;
+    config.rtu_slaves = 0;
+    config.rtu_per_bus = 1;
+    config.base_port = 15020;
+    config.discrete_inputs = 8;
+    config.coils = 0;
+    config.input_registers = 2;
+    config.holding_registers = 0;
+    config.polling_ms = 100;
+    config.timeout_ms = 1000;
+    config.slow_slaves = 0;
+    config.slow_latency_ms = 200;
+    config.profile.latency_ms = 2;
+    config.profile.jitter_ms = 1;
+    config.profile.error_rate = 0;
+    config.profile.drop_rate = 0;
+    config.profile.disconnect_rate = 0;
+    config.profile.outage_ms = 2000;
+    config.probe_port = 502;
+    config.probe_ms = 100;
+    config.warmup_s = 5;
+    config.duration_s = 30;
+
+    string launch_dir, mbconfig_file, csv_file;
+    pid_t runtime_pid = -1;
+
+    for (int i = 1; i < argc; i++)
+    {
+        string arg(argv[i]);
+        bool has_value = (i + 1 < argc);
+
+        if (arg == "-h" || arg == "--help")
+        {
+            printUsage();
+            return 0;
+        }
+        else if (arg == "--launch" && has_value) launch_dir = argv[++i];
+        else if (arg == "--mbconfig" && has_value) mbconfig_file = argv[++i];
+        else if (arg == "--pid" && has_value) runtime_pid = atoi(argv[++i]);
+        else if (arg == "--host" && has_value) config.host = argv[++i];
+        else if (arg == "--tcp" && has_value) config.tcp_slaves = atoi(argv[++i]);
+        else if (arg == "--rtu" && has_value) config.rtu_slaves = atoi(argv[++i]);
+        else if (arg == "--rtu-per-bus" && has_value) config.rtu_per_bus = atoi(argv[++i]);
+        else if (arg == "--base-port" && has_value) config.base_port = atoi(argv[++i]);
+        else if (arg == "--inputs" && has_value) config.discrete_inputs = atoi(argv[++i]);
+        else if (arg == "--coils" && has_value) config.coils = atoi(argv[++i]);
+        else if (arg == "--registers" && has_value) config.input_registers = atoi(argv[++i]);
+        else if (arg == "--holding" && has_value) config.holding_registers = atoi(argv[++i]);
+        else if (arg == "--polling" && has_value) config.polling_ms = atoi(argv[++i]);
+        else if (arg == "--timeout" && has_value) config.timeout_ms = atoi(argv[++i]);
+        else if (arg == "--latency" && has_value) config.profile.latency_ms = atoi(argv[++i]);
+        else if (arg == "--jitter" && has_value) config.profile.jitter_ms = atoi(argv[++i]);
+        else if (arg == "--slow" && has_value) config.slow_slaves = atoi(argv[++i]);
+        else if (arg == "--slow-latency" && has_value) config.slow_latency_ms = atoi(argv[++i]);
+        else if (arg == "--error-rate" && has_value) config.profile.error_rate = atof(argv[++i]);
+        else if (arg == "--drop-rate" && has_value) config.profile.drop_rate = atof(argv[++i]);
+        else if (arg == "--disconnect-rate" && has_value) config.profile.disconnect_rate = atof(argv[++i]);
+        else if (arg == "--outage" && has_value) config.profile.outage_ms = atoi(argv[++i]);
+        else if (arg == "--probe-port" && has_value) config.probe_port = atoi(argv[++i]);
+        else if (arg == "--probe" && has_value) config.probe_ms = atoi(argv[++i]);
+        else if (arg == "--warmup" && has_value) config.warmup_s = atoi(argv[++i]);
+        else if (arg == "--duration" && has_value) config.duration_s = atoi(argv[++i]);
+        else if (arg == "--csv" && has_value) csv_file = argv[++i];
+        else
+        {
+            cout << "Unrecognized option: " << arg << endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (config.duration_s < 1) config.duration_s = 1;
+    if (config.probe_ms < 1) config.probe_ms = 1;
+    if (config.rtu_per_bus < 1) config.rtu_per_bus = 1;
+    if (config.rtu_per_bus > 247) config.rtu_per_bus = 247;
+    if (config.input_registers < 1) config.input_registers = 1;
+
+    // the master packs the data of all the slaves in buffers of MAX_MB_IO points
+    int total = config.tcp_slaves + config.rtu_slaves;
+    if (total < 1 || total > 255)
+    {
+        cout << "The farm needs between 1 and 255 slaves (the runtime supports up to 255 slave devices)" << endl;
+        return 1;
+    }
+    if (total * config.input_registers > MAX_MB_IO || total * config.discrete_inputs > MAX_MB_IO ||
+        total * config.coils > MAX_MB_IO || total * config.holding_registers > MAX_MB_IO)
+    {
+        cout << "The runtime supports up to " << MAX_MB_IO << " points of each kind over all slave devices. Lower --registers," << endl;
+        cout << "--inputs, --coils or --holding, or the number of slaves" << endl;
+        return 1;
+    }
+    if (launch_dir.empty() && mbconfig_file.empty())
+    {
+        cout << "Use --launch to start the runtime, or --mbconfig to write the slave devices for a runtime started by hand" << endl;
+        return 1;
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+    signal(SIGINT, handleStop);
+    signal(SIGTERM, handleStop);
+
+    if (!createFarm(config)) return 2;
+    cout << "Farm: " << config.tcp_slaves << " Modbus/TCP slaves from port " << config.base_port << ", " << config.rtu_slaves
+         << " Modbus RTU slaves on " << buses.size() << " pseudo-terminal(s)" << endl;
+
+    // the devices, with the pseudo-terminal names of this run
+    string backup_file;
+    if (!launch_dir.empty())
+    {
+        mbconfig_file = launch_dir + "/mbconfig.cfg";
+        backup_file = mbconfig_file + ".farm_backup";
+        if (rename(mbconfig_file.c_str(), backup_file.c_str()) != 0) backup_file.clear();
+    }
+    {
+        ofstream cfg(mbconfig_file.c_str(), ios::trunc);
+        if (!cfg.is_open())
+        {
+            cout << "Error creating " << mbconfig_file << endl;
+            return 1;
+        }
+        emitMbconfig(cfg, config);
+    }
+
+    thread farm(farmThread, &config);
+    point_ages.resize(total * config.input_registers);
+
+    if (!launch_dir.empty())
+    {
+        runtime_pid = fork();
+        if (runtime_pid == 0)
+        {
+            if (chdir(launch_dir.c_str()) != 0) _exit(127);
+            int log_fd = open("modbus_farm_bench_runtime.log", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (log_fd >= 0)
+            {
+                dup2(log_fd, STDOUT_FILENO);
+                dup2(log_fd, STDERR_FILENO);
+                close(log_fd);
+            }
+            execl("./core/openplc", "openplc", (char *)NULL);
+            _exit(127);
+        }
+        else if (runtime_pid < 0)
+        {
+            cout << "Error starting the runtime: " << strerror(errno) << endl;
+        }
+    }
+    else
+    {
+        cout << "Slave devices written to " << mbconfig_file << ". Restart the runtime with it now" << endl;
+    }
+
+    int status = 0;
+    string reply;
+    if (!waitForRuntime(config.host, launch_dir.empty() ? 60 : 10))
+    {
+        cout << "The runtime is not answering on port " << INTERACTIVE_PORT << endl;
+        status = 2;
+    }
+    else
+    {
+        interactiveCommand(config.host, "start_modbus(" + to_string(config.probe_port) + ")", reply);
+        thread probe(probeThread, &config);
+
+        cout << "Warming up for " << config.warmup_s << " s" << endl;
+        sleep(config.warmup_s);
+
+        {
+            lock_guard<mutex> guard(farm_lock);
+            for (size_t i = 0; i < slaves.size(); i++)
+                slaves[i].requests = slaves[i].refreshes = slaves[i].errors = slaves[i].drops = slaves[i].disconnects = slaves[i].writes = 0;
+        }
+        double runtime_cpu_start = (runtime_pid > 0) ? processCpuSeconds(runtime_pid) : -1;
+        double farm_cpu_start = farmCpuSeconds();
+        unsigned long long start = nowNs();
+        probe_recording = true;
+
+        cout << "Measuring for " << config.duration_s << " s" << endl;
+        for (int s = 0; s < config.duration_s && farm_running; s++) sleep(1);
+
+        probe_recording = false;
+        double elapsed_s = (nowNs() - start) / 1e9;
+        double runtime_cpu_s = (runtime_cpu_start >= 0) ? processCpuSeconds(runtime_pid) - runtime_cpu_start : -1;
+        double farm_cpu_s = farmCpuSeconds() - farm_cpu_start;
+
+        probe_running = false;
+        probe.join();
+
+        lock_guard<mutex> guard(farm_lock);
+        printReport(config, elapsed_s, runtime_cpu_s, farm_cpu_s, csv_file);
+
+        bool refreshed = false;
+        for (size_t i = 0; i < slaves.size(); i++)
+            if (slaves[i].refreshes > 0) refreshed = true;
+        if (!refreshed) status = 1;
+    }
+
+    if (!launch_dir.empty() && runtime_pid > 0)
+    {
+        interactiveCommand(config.host, "quit()", reply);
+        sleep(1);
+        if (waitpid(runtime_pid, NULL, WNOHANG) == 0)
+        {
+            kill(runtime_pid, SIGTERM);
+            waitpid(runtime_pid, NULL, 0);
+        }
+    }
+    if (!launch_dir.empty())
+    {
+        if (!backup_file.empty()) rename(backup_file.c_str(), mbconfig_file.c_str());
+        else remove(mbconfig_file.c_str());
+    }
+
+    farm_running = false;
+    farm.join();
+    return status;
+}
@@ -0,0 +1,1116 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 OpenPLC Project
+// This file is part of the OpenPLC Software Stack.
+//
+// OpenPLC is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenPLC is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with OpenPLC.  If not, see <http://www.gnu.org/licenses/>.
+//------
+//
+// Protocol load benchmark for the OpenPLC runtime. It (optionally) starts the
+// runtime, enables the Modbus/TCP, EtherNet/IP (PCCC) and DNP3 servers through
+// the interactive server and drives them with N concurrent clients per
+// protocol, each one issuing requests from a configurable mix. Every request
+// is timed individually and the report shows latency percentiles and
+// throughput per operation. The scan statistics of the runtime are sampled
+// once with the servers idle and once under load, so the effect of protocol
+// traffic on scan jitter (lock waits, late wake-ups, overruns) is visible
+// next to the request latencies.
+//
+// The clients are implemented here on plain sockets, so the benchmark has no
+// dependency on libmodbus or opendnp3.
+//-----------------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <cerrno>
+#include <cstdint>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <time.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+using namespace std;
+
+#define INTERACTIVE_PORT    43628
+#define IO_TIMEOUT_MS       2000
+
+/// One operation of a request mix and its relative weight
+struct MixEntry
+{
+    int op;
+    int weight;
+};
+
+/// Latency samples (in ns) and error count of one protocol operation
+struct OpResult
+{
+    vector<unsigned long long> latency_ns;
+    unsigned long long errors;
+};
+
+/// Benchmark configuration
+struct BenchConfig
+{
+    string host;
+    int duration_s;
+    int idle_s;
+    int rate;           // requests per second per client, 0 = as fast as possible
+    int modbus_clients;
+    int enip_clients;
+    int dnp3_clients;
+    int modbus_port;
+    int enip_port;
+    int dnp3_port;
+    int registers;      // registers/coils touched by each request
+    vector<MixEntry> modbus_mix;
+    vector<MixEntry> enip_mix;
+    vector<MixEntry> dnp3_mix;
+};
+
+static inline unsigned long long nowNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/// Per thread pseudo-random generator used to pick operations from the mix
+static int nextRandom(unsigned long long& state, int limit)
+{
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (int)((state >> 33) % (unsigned long long)limit);
+}
+
+static int pickOperation(const vector<MixEntry>& mix, unsigned long long& state)
+{
+    int total = 0;
+    for (size_t i = 0; i < mix.size(); i++) total += mix[i].weight;
+    int r = nextRandom(state, total);
+    for (size_t i = 0; i < mix.size(); i++)
+    {
+        if (r < mix[i].weight) return mix[i].op;
+        r -= mix[i].weight;
+    }
+    return mix.back().op;
+}
+
+//-----------------------------------------------------------------------------
+// Socket helpers
+//-----------------------------------------------------------------------------
+
+int connectTo(const string& host, int port)
+{
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1 ||
+        connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+        close(fd);
+        return -1;
+    }
+
+    int flag = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+    return fd;
+}
+
+bool sendAll(int fd, const unsigned char *data, size_t size)
+{
+    while (size > 0)
+    {
+        ssize_t n = send(fd, data, size, MSG_NOSIGNAL);
+        if (n <= 0)
+        {
+            if (n < 0 && errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        size -= n;
+    }
+    return true;
+}
+
+/// Reads exactly size bytes. Fails if the peer is silent for IO_TIMEOUT_MS
+bool recvAll(int fd, unsigned char *data, size_t size)
+{
+    while (size > 0)
+    {
+        struct pollfd pfd = {fd, POLLIN, 0};
+        if (poll(&pfd, 1, IO_TIMEOUT_MS) <= 0) return false;
+
+        ssize_t n = recv(fd, data, size, 0);
+        if (n <= 0)
+        {
+            if (n < 0 && errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        size -= n;
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Interactive server
+//-----------------------------------------------------------------------------
+
+/// Sends a command to the interactive server and returns its reply
+bool interactiveCommand(const string& host, const string& command, string& reply)
+{
+    int fd = connectTo(host, INTERACTIVE_PORT);
+    if (fd < 0) return false;
+
+    string line = command + "\n";
+    bool ok = sendAll(fd, (const unsigned char *)line.c_str(), line.size());
+
+    reply.clear();
+    int timeout = IO_TIMEOUT_MS;
+    while (ok)
+    {
+        struct pollfd pfd = {fd, POLLIN, 0};
+        if (poll(&pfd, 1, timeout) <= 0) break;
+
+        char buffer[4096];
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) break;
+        reply.append(buffer, n);
+        timeout = 100; // the reply is written at once, just drain what is left
+    }
+
+    close(fd);
+    return ok && !reply.empty();
+}
+
+/// Polls the interactive server until the runtime accepts connections
+bool waitForRuntime(const string& host, int timeout_s)
+{
+    unsigned long long deadline = nowNs() + (unsigned long long)timeout_s * 1000000000ULL;
+    while (nowNs() < deadline)
+    {
+        int fd = connectTo(host, INTERACTIVE_PORT);
+        if (fd >= 0)
+        {
+            close(fd);
+            return true;
+        }
+        usleep(200000);
+    }
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+// Modbus/TCP client
+//-----------------------------------------------------------------------------
+
+enum
+{
+    MB_READ_COILS,
+    MB_READ_DISCRETE,
+    MB_READ_HOLDING,
+    MB_READ_INPUT,
+    MB_WRITE_COIL,
+    MB_WRITE_REGISTER,
+    MB_WRITE_REGISTERS,
+    MB_NUM_OPS
+};
+
+const char *modbus_op_names[MB_NUM_OPS] = {"read_coils", "read_discrete", "read_holding", "read_input",
+                                           "write_coil", "write_register", "write_registers"};
+
+/// Builds and sends one request, then waits for the complete response.
+/// Returns false on transport errors and Modbus exceptions
+bool modbusTransaction(int fd, int op, uint16_t tid, int registers, uint16_t value)
+{
+    unsigned char request[260];
+    static const unsigned char function_codes[MB_NUM_OPS] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x10};
+    int size = 12;
+
+    request[0] = tid >> 8;
+    request[1] = tid & 0xFF;
+    request[2] = 0;
+    request[3] = 0;
+    request[6] = 1; // unit id
+    request[7] = function_codes[op];
+    request[8] = 0; // start address
+    request[9] = 0;
+
+    if (op == MB_WRITE_COIL)
+    {
+        request[10] = (value & 1) ? 0xFF : 0x00;
+        request[11] = 0x00;
+    }
+    else if (op == MB_WRITE_REGISTER)
+    {
+        request[10] = value >> 8;
+        request[11] = value & 0xFF;
+    }
+    else
+    {
+        request[10] = registers >> 8;
+        request[11] = registers & 0xFF;
+        if (op == MB_WRITE_REGISTERS)
+        {
+            request[12] = registers * 2;
+            for (int i = 0; i < registers; i++)
+            {
+                request[13 + i * 2] = value >> 8;
+                request[14 + i * 2] = value & 0xFF;
+            }
+            size = 13 + registers * 2;
+        }
+    }
+    request[4] = (size - 6) >> 8;
+    request[5] = (size - 6) & 0xFF;
+
+    if (!sendAll(fd, request, size)) return false;
+
+    unsigned char response[260];
+    if (!recvAll(fd, response, 7)) return false;
+    int length = (response[4] << 8) | response[5];
+    if (length < 2 || length > 254) return false;
+    if (!recvAll(fd, response + 7, length - 1)) return false;
+
+    uint16_t response_tid = (response[0] << 8) | response[1];
+    return (response_tid == tid && response[7] == function_codes[op]);
+}
+
+//-----------------------------------------------------------------------------
+// EtherNet/IP client (PCCC encapsulated in unconnected SendRRData requests)
+//-----------------------------------------------------------------------------
+
+enum
+{
+    ENIP_READ_INT,
+    ENIP_READ_COILS,
+    ENIP_NUM_OPS
+};
+
+const char *enip_op_names[ENIP_NUM_OPS] = {"read_int", "read_coils"};
+
+/// Opens an EtherNet/IP session. Returns false if the server did not answer
+bool enipRegisterSession(int fd, unsigned char session[4])
+{
+    unsigned char request[28];
+    memset(request, 0, sizeof(request));
+    request[0] = 0x65; // Register Session
+    request[2] = 4;    // length
+    request[24] = 1;   // protocol version
+
+    unsigned char response[28];
+    if (!sendAll(fd, request, sizeof(request)) || !recvAll(fd, response, sizeof(response)))
+        return false;
+
+    memcpy(session, &response[4], 4);
+    return (response[0] == 0x65);
+}
+
+/// Sends a PCCC Protected Logical Read and waits for the reply
+bool enipTransaction(int fd, int op, const unsigned char session[4], uint16_t tns, int registers)
+{
+    unsigned char request[80];
+    memset(request, 0, sizeof(request));
+
+    // PCCC command
+    unsigned char *pccc = &request[53];
+    int pccc_size = 10;
+    pccc[0] = 0x0f; // protected typed logical read
+    pccc[2] = tns & 0xFF;
+    pccc[3] = tns >> 8;
+    pccc[4] = 0xa2;
+    if (op == ENIP_READ_INT)
+    {
+        pccc[5] = registers * 2;
+        pccc[6] = 0x07; // N7
+        pccc[7] = 0x89; // integer file
+    }
+    else
+    {
+        pccc[5] = (registers + 7) / 8;
+        pccc[6] = 0x00; // O0
+        pccc[7] = 0x8b; // output file
+        pccc[10] = 0x01; // bit mask
+        pccc_size = 12;
+    }
+
+    // Encapsulation header
+    int length = 29 + pccc_size;
+    request[0] = 0x6f; // SendRRData
+    request[2] = length & 0xFF;
+    request[3] = length >> 8;
+    memcpy(&request[4], session, 4);
+
+    // Common packet format: null address item + unconnected data item
+    request[28] = 10;   // timeout
+    request[30] = 2;    // item count
+    request[36] = 0xb2;
+    request[38] = (13 + pccc_size) & 0xFF;
+    request[40] = 0x4b; // Execute PCCC
+    request[41] = 2;    // path size in words
+    request[42] = 0x20;
+    request[43] = 0x67; // PCCC object
+    request[44] = 0x24;
+    request[45] = 0x01;
+    request[46] = 7;    // requestor id length
+
+    if (!sendAll(fd, request, 24 + length)) return false;
+
+    unsigned char response[600];
+    if (!recvAll(fd, response, 24)) return false;
+    int response_length = response[2] | (response[3] << 8);
+    if (response_length > (int)sizeof(response) - 24) return false;
+    if (!recvAll(fd, response + 24, response_length)) return false;
+
+    return (response[0] == 0x6f && response_length > 0);
+}
+
+//-----------------------------------------------------------------------------
+// DNP3 client (master at address 1 polling the outstation at address 10)
+//-----------------------------------------------------------------------------
+
+enum
+{
+    DNP3_INTEGRITY_POLL,
+    DNP3_EVENT_POLL,
+    DNP3_NUM_OPS
+};
+
+const char *dnp3_op_names[DNP3_NUM_OPS] = {"integrity_poll", "event_poll"};
+
+#define DNP3_MASTER_ADDRESS     1
+#define DNP3_OUTSTATION_ADDRESS 10
+
+static uint16_t dnp3Crc(const unsigned char *data, int size)
+{
+    uint16_t crc = 0;
+    for (int i = 0; i < size; i++)
+    {
+        crc ^= data[i];
+        for (int j = 0; j < 8; j++)
+            crc = (crc & 1) ? (crc >> 1) ^ 0xA6BC : crc >> 1;
+    }
+    return ~crc;
+}
+
+/// Wraps user data into a link layer frame (header and 16 byte blocks, each
+/// followed by its CRC) and sends it
+bool dnp3SendFrame(int fd, unsigned char control, const unsigned char *user_data, int size)
+{
+    unsigned char frame[292];
+    frame[0] = 0x05;
+    frame[1] = 0x64;
+    frame[2] = size + 5;
+    frame[3] = control;
+    frame[4] = DNP3_OUTSTATION_ADDRESS & 0xFF;
+    frame[5] = DNP3_OUTSTATION_ADDRESS >> 8;
+    frame[6] = DNP3_MASTER_ADDRESS & 0xFF;
+    frame[7] = DNP3_MASTER_ADDRESS >> 8;
+    uint16_t crc = dnp3Crc(frame, 8);
+    frame[8] = crc & 0xFF;
+    frame[9] = crc >> 8;
+
+    int pos = 10;
+    for (int i = 0; i < size; i += 16)
+    {
+        int block = (size - i < 16) ? size - i : 16;
+        memcpy(&frame[pos], &user_data[i], block);
+        crc = dnp3Crc(&frame[pos], block);
+        pos += block;
+        frame[pos++] = crc & 0xFF;
+        frame[pos++] = crc >> 8;
+    }
+
+    return sendAll(fd, frame, pos);
+}
+
+/// Receives one link layer frame. Returns the frame control byte, or -1 on
+/// errors, and stores the user data without the block CRCs
+int dnp3ReceiveFrame(int fd, unsigned char *user_data, int& size)
+{
+    unsigned char header[10];
+    if (!recvAll(fd, header, 10)) return -1;
+    if (header[0] != 0x05 || header[1] != 0x64 || header[2] < 5) return -1;
+
+    size = header[2] - 5;
+    int blocks = (size + 15) / 16;
+    unsigned char body[292];
+    if (!recvAll(fd, body, size + blocks * 2)) return -1;
+
+    for (int i = 0, pos = 0; i < size; i += 16)
+    {
+        int block = (size - i < 16) ? size - i : 16;
+        memcpy(&user_data[i], &body[pos], block);
+        pos += block + 2;
+    }
+    return header[3];
+}
+
+/// Sends an application layer fragment as a single transport segment
+bool dnp3SendFragment(int fd, unsigned char& transport_seq, const unsigned char *apdu, int size)
+{
+    unsigned char user_data[250];
+    user_data[0] = 0xC0 | (transport_seq & 0x3F); // FIR + FIN
+    transport_seq++;
+    memcpy(&user_data[1], apdu, size);
+    return dnp3SendFrame(fd, 0xC4, user_data, size + 1); // DIR + PRM, unconfirmed user data
+}
+
+/// Sends a READ request and collects the complete (possibly multi-fragment)
+/// response. Unsolicited responses and link status requests from the
+/// outstation are answered and do not count towards the transaction
+bool dnp3Transaction(int fd, int op, unsigned char& app_seq, unsigned char& transport_seq)
+{
+    unsigned char request[16];
+    int size = 2;
+    request[0] = 0xC0 | (app_seq & 0x0F);
+    request[1] = 0x01; // READ
+    if (op == DNP3_INTEGRITY_POLL)
+    {
+        unsigned char objects[] = {60, 2, 0x06, 60, 3, 0x06, 60, 4, 0x06, 60, 1, 0x06};
+        memcpy(&request[2], objects, sizeof(objects));
+        size += sizeof(objects);
+    }
+    else
+    {
+        unsigned char objects[] = {60, 2, 0x06, 60, 3, 0x06, 60, 4, 0x06};
+        memcpy(&request[2], objects, sizeof(objects));
+        size += sizeof(objects);
+    }
+
+    unsigned char seq = app_seq & 0x0F;
+    app_seq++;
+    if (!dnp3SendFragment(fd, transport_seq, request, size)) return false;
+
+    vector<unsigned char> apdu;
+    while (true)
+    {
+        unsigned char user_data[256];
+        int user_size = 0;
+        int control = dnp3ReceiveFrame(fd, user_data, user_size);
+        if (control < 0) return false;
+
+        if ((control & 0x0F) == 0x09)
+        {
+            // Request link status (keep alive)
+            unsigned char empty;
+            if (!dnp3SendFrame(fd, 0x8B, &empty, 0)) return false;
+            continue;
+        }
+        if ((control & 0x0F) != 0x04 && (control & 0x0F) != 0x03) continue;
+        if (user_size < 1) continue;
+
+        unsigned char transport = user_data[0];
+        if (transport & 0x40) apdu.clear();
+        apdu.insert(apdu.end(), user_data + 1, user_data + user_size);
+        if (!(transport & 0x80)) continue;
+
+        if (apdu.size() < 2) return false;
+        unsigned char app_control = apdu[0];
+        unsigned char function = apdu[1];
+        bool confirm = (app_control & 0x20);
+
+        if (app_control & 0x10)
+        {
+            // Unsolicited response
+            if (confirm)
+            {
+                unsigned char ack[2] = {(unsigned char)(0xD0 | (app_control & 0x0F)), 0x00};
+                if (!dnp3SendFragment(fd, transport_seq, ack, 2)) return false;
+            }
+            apdu.clear();
+            continue;
+        }
+
+        if (function != 0x81 || (app_control & 0x0F) != seq) return false;
+        if (confirm)
+        {
+            unsigned char ack[2] = {(unsigned char)(0xC0 | seq), 0x00};
+            if (!dnp3SendFragment(fd, transport_seq, ack, 2)) return false;
+        }
+        if (app_control & 0x40) return true; // final fragment
+        apdu.clear();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Load generation
+//-----------------------------------------------------------------------------
+
+/// Results of all operations indexed by "protocol/operation"
+map<string, OpResult> results;
+mutex results_lock;
+
+void mergeResults(const string& protocol, const char **op_names, vector<OpResult>& local)
+{
+    lock_guard<mutex> guard(results_lock);
+    for (size_t i = 0; i < local.size(); i++)
+    {
+        if (local[i].latency_ns.empty() && local[i].errors == 0) continue;
+        OpResult& r = results[protocol + "/" + op_names[i]];
+        r.latency_ns.insert(r.latency_ns.end(), local[i].latency_ns.begin(), local[i].latency_ns.end());
+        r.errors += local[i].errors;
+    }
+}
+
+/// Sleeps until the next request slot when the request rate is limited
+static void pace(unsigned long long& next_request, int rate)
+{
+    if (rate <= 0) return;
+    next_request += 1000000000ULL / rate;
+    unsigned long long now = nowNs();
+    if (next_request > now)
+    {
+        struct timespec ts;
+        ts.tv_sec = (next_request - now) / 1000000000ULL;
+        ts.tv_nsec = (next_request - now) % 1000000000ULL;
+        nanosleep(&ts, NULL);
+    }
+    else
+    {
+        next_request = now;
+    }
+}
+
+/// Runs one client until the deadline. A failed request closes the
+/// connection and the client reconnects, so the error is counted once
+void clientThread(const BenchConfig *config, string protocol, int id, unsigned long long deadline)
+{
+    const vector<MixEntry> *mix;
+    const char **op_names;
+    int port, num_ops;
+
+    if (protocol == "modbus")
+    {
+        mix = &config->modbus_mix; op_names = modbus_op_names; port = config->modbus_port; num_ops = MB_NUM_OPS;
+    }
+    else if (protocol == "enip")
+    {
+        mix = &config->enip_mix; op_names = enip_op_names; port = config->enip_port; num_ops = ENIP_NUM_OPS;
+    }
+    else
+    {
+        mix = &config->dnp3_mix; op_names = dnp3_op_names; port = config->dnp3_port; num_ops = DNP3_NUM_OPS;
+    }
+
+    vector<OpResult> local(num_ops);
+    for (int i = 0; i < num_ops; i++)
+    {
+        local[i].errors = 0;
+        local[i].latency_ns.reserve(1024);
+    }
+
+    unsigned long long random_state = 0x5DEECE66DULL + id * 7919;
+    unsigned long long next_request = nowNs();
+    uint16_t transaction = 0;
+    unsigned char session[4];
+    unsigned char app_seq = 0, transport_seq = 0;
+    int fd = -1;
+
+    while (nowNs() < deadline)
+    {
+        if (fd < 0)
+        {
+            fd = connectTo(config->host, port);
+            if (fd >= 0 && protocol == "enip" && !enipRegisterSession(fd, session))
+            {
+                close(fd);
+                fd = -1;
+            }
+            if (fd < 0)
+            {
+                usleep(100000);
+                continue;
+            }
+        }
+
+        int op = pickOperation(*mix, random_state);
+        transaction++;
+
+        unsigned long long start = nowNs();
+        bool ok;
+        if (protocol == "modbus")
+            ok = modbusTransaction(fd, op, transaction, config->registers, transaction);
+        else if (protocol == "enip")
+            ok = enipTransaction(fd, op, session, transaction, config->registers);
+        else
+            ok = dnp3Transaction(fd, op, app_seq, transport_seq);
+        unsigned long long end = nowNs();
+
+        if (ok)
+        {
+            local[op].latency_ns.push_back(end - start);
+        }
+        else
+        {
+            local[op].errors++;
+            close(fd);
+            fd = -1;
+        }
+
+        pace(next_request, config->rate);
+    }
+
+    if (fd >= 0) close(fd);
+    mergeResults(protocol, op_names, local);
+}
+
+//-----------------------------------------------------------------------------
+// Scan statistics
+//-----------------------------------------------------------------------------
+
+/// Extracts the scan jitter figures from the scan_stats() reply: the
+/// key=value pairs of the summary lines plus the max_ns of every stage
+map<string, string> parseScanStats(const string& reply)
+{
+    map<string, string> values;
+    stringstream ss(reply);
+    string line;
+
+    while (getline(ss, line))
+    {
+        if (line.find('=') != string::npos)
+        {
+            stringstream fields(line);
+            string field;
+            while (getline(fields, field, ','))
+            {
+                size_t eq = field.find('=');
+                if (eq != string::npos) values[field.substr(0, eq)] = field.substr(eq + 1);
+            }
+        }
+        else if (line.compare(0, 6, "stage,") != 0)
+        {
+            // stage,runs,skips,last_ns,avg_ns,max_ns
+            vector<string> columns;
+            stringstream fields(line);
+            string field;
+            while (getline(fields, field, ',')) columns.push_back(field);
+            if (columns.size() == 6)
+            {
+                values[columns[0] + ".avg_ns"] = columns[4];
+                values[columns[0] + ".max_ns"] = columns[5];
+            }
+        }
+    }
+    return values;
+}
+
+/// Clears the scan statistics, waits and samples them again
+bool sampleScanStats(const string& host, int seconds, map<string, string>& stats)
+{
+    string reply;
+    if (!interactiveCommand(host, "reset_scan_stats()", reply)) return false;
+    sleep(seconds);
+    if (!interactiveCommand(host, "scan_stats()", reply)) return false;
+    stats = parseScanStats(reply);
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Reporting
+//-----------------------------------------------------------------------------
+
+static double percentileUs(const vector<unsigned long long>& sorted, double pct)
+{
+    if (sorted.empty()) return 0;
+    size_t index = (size_t)(pct / 100.0 * (sorted.size() - 1) + 0.5);
+    return sorted[index] / 1000.0;
+}
+
+void printReport(const BenchConfig& config, const map<string, string>& idle, const map<string, string>& load,
+                 const string& csv_file)
+{
+    ofstream csv;
+    if (!csv_file.empty())
+    {
+        csv.open(csv_file.c_str(), ios::trunc);
+        csv << "operation,requests,errors,req_per_s,p50_us,p90_us,p99_us,p999_us,max_us\n";
+    }
+
+    char line[256];
+    cout << endl;
+    snprintf(line, sizeof(line), "%-28s %9s %7s %10s %9s %9s %9s %9s %9s", "operation", "requests", "errors",
+             "req/s", "p50 us", "p90 us", "p99 us", "p99.9 us", "max us");
+    cout << line << endl;
+
+    for (map<string, OpResult>::iterator it = results.begin(); it != results.end(); ++it)
+    {
+        vector<unsigned long long>& samples = it->second.latency_ns;
+        sort(samples.begin(), samples.end());
+        double rate = (double)samples.size() / config.duration_s;
+        double p50 = percentileUs(samples, 50), p90 = percentileUs(samples, 90);
+        double p99 = percentileUs(samples, 99), p999 = percentileUs(samples, 99.9);
+        double worst = samples.empty() ? 0 : samples.back() / 1000.0;
+
+        snprintf(line, sizeof(line), "%-28s %9zu %7llu %10.1f %9.1f %9.1f %9.1f %9.1f %9.1f", it->first.c_str(),
+                 samples.size(), it->second.errors, rate, p50, p90, p99, p999, worst);
+        cout << line << endl;
+        if (csv.is_open())
+            csv << it->first << "," << samples.size() << "," << it->second.errors << "," << rate << "," << p50 << ","
+                << p90 << "," << p99 << "," << p999 << "," << worst << "\n";
+    }
+
+    if (idle.empty() && load.empty()) return;
+
+    const char *keys[] = {"wakeup_avg_ns", "wakeup_max_ns", "lock_wait_avg_ns", "lock_wait_max_ns",
+                          "plc_logic.avg_ns", "plc_logic.max_ns", "overruns", "max_overrun_ns"};
+    cout << endl;
+    snprintf(line, sizeof(line), "%-28s %14s %14s", "scan", "idle", "load");
+    cout << line << endl;
+    if (csv.is_open()) csv << "\nscan,idle,load\n";
+    for (size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); i++)
+    {
+        map<string, string>::const_iterator a = idle.find(keys[i]);
+        map<string, string>::const_iterator b = load.find(keys[i]);
+        snprintf(line, sizeof(line), "%-28s %14s %14s", keys[i], a == idle.end() ? "-" : a->second.c_str(),
+                 b == load.end() ? "-" : b->second.c_str());
+        cout << line << endl;
+        if (csv.is_open())
+            csv << keys[i] << "," << (a == idle.end() ? "" : a->second) << "," << (b == load.end() ? "" : b->second) << "\n";
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Command line handling
+//-----------------------------------------------------------------------------
+
+/// Parses a mix such as "read_holding=60,write_register=40"
+bool parseMix(const string& text, const char **op_names, int num_ops, vector<MixEntry>& mix)
+{
+    mix.clear();
+    stringstream ss(text);
+    string item;
+    while (getline(ss, item, ','))
+    {
+        size_t eq = item.find('=');
+        string name = item.substr(0, eq);
+        int weight = (eq == string::npos) ? 1 : atoi(item.substr(eq + 1).c_str());
+
+        int op = -1;
+        for (int i = 0; i < num_ops; i++)
+            if (name == op_names[i]) op = i;
+        if (op < 0 || weight < 0)
+        {
+            cout << "Unknown operation in request mix: " << item << endl;
+            return false;
+        }
+        if (weight > 0)
+        {
+            MixEntry entry = {op, weight};
+            mix.push_back(entry);
+        }
+    }
+    return !mix.empty();
+}
+
+/// Writes the ST program the runtime should run during the benchmark. It
+/// maps the coils and registers touched by the clients to located variables
+/// and keeps some logic running so the scan has a realistic cost
+void emitProgram(ostream& st, int registers)
+{
+    st << "PROGRAM BENCH_IO\n";
+    st << "  VAR\n";
+    for (int i = 0; i < registers; i++)
+    {
+        st << "    DO" << i << " AT %QX" << i / 8 << "." << i % 8 << " : BOOL;\n";
+        st << "    AI" << i << " AT %IW" << i << " : INT;\n";
+        st << "    HR" << i << " AT %QW" << i << " : INT;\n";
+        st << "    MW" << i << " AT %MW" << i << " : INT;\n";
+    }
+    st << "    CNT : CTU;\n";
+    st << "    T0 : TON;\n";
+    st << "  END_VAR\n\n";
+    st << "  T0(IN := NOT T0.Q, PT := T#100ms);\n";
+    st << "  CNT(CU := T0.Q, R := CNT.Q, PV := 1000);\n";
+    for (int i = 0; i < registers; i++)
+    {
+        st << "  MW" << i << " := MW" << i << " + AI" << i << ";\n";
+        st << "  DO" << i << " := CNT.CV MOD " << (i + 2) << " = 0;\n";
+    }
+    st << "END_PROGRAM\n\n";
+    st << "CONFIGURATION Config0\n\n";
+    st << "  RESOURCE Res0 ON PLC\n";
+    st << "    TASK Main(INTERVAL := T#10ms,PRIORITY := 0);\n";
+    st << "    PROGRAM Inst0 WITH Main : BENCH_IO;\n";
+    st << "  END_RESOURCE\n";
+    st << "END_CONFIGURATION\n";
+}
+
+/// Appends settings to the runtime.cfg of the launched runtime. The last
+/// value of a setting wins, so they override the ones already in the file.
+/// The original contents are kept in original to put them back afterwards
+bool overrideRuntimeConfig(const string& launch_dir, const vector<string>& settings, string& original)
+{
+    string path = launch_dir + "/runtime.cfg";
+    ifstream in(path.c_str());
+    stringstream contents;
+    if (in.is_open()) contents << in.rdbuf();
+    original = contents.str();
+    in.close();
+
+    ofstream out(path.c_str(), ios::trunc);
+    if (!out.is_open()) return false;
+    out << original << "\n# added by protocol_bench\n";
+    for (size_t i = 0; i < settings.size(); i++)
+    {
+        string setting = settings[i];
+        size_t equal = setting.find('=');
+        if (equal != string::npos) setting.replace(equal, 1, " = ");
+        out << setting << "\n";
+    }
+    return true;
+}
+
+void restoreRuntimeConfig(const string& launch_dir, const string& original)
+{
+    string path = launch_dir + "/runtime.cfg";
+    ofstream out(path.c_str(), ios::trunc);
+    out << original;
+}
+
+void printUsage()
+{
+    cout << "Usage " << endl << endl;
+    cout << "  protocol_bench [options]" << endl << endl;
+    cout << "Drives the Modbus/TCP, EtherNet/IP and DNP3 servers of a running OpenPLC runtime with" << endl;
+    cout << "concurrent clients and reports request latency percentiles, throughput and the scan" << endl;
+    cout << "jitter measured by the runtime with the servers idle and under load." << endl << endl;
+    cout << "Options" << endl;
+    cout << "  --launch <dir>        = Start the runtime from this webserver folder (core/openplc) and stop it" << endl;
+    cout << "                          at the end. Without it, the runtime must already be running" << endl;
+    cout << "  --set <key=value>     = With --launch, override a runtime.cfg setting for this run, e.g." << endl;
+    cout << "                          net_backend=io_uring. Can be repeated" << endl;
+    cout << "  --host <ip>           = Runtime address (default 127.0.0.1)" << endl;
+    cout << "  --duration <s>        = Length of the load phase (default 10)" << endl;
+    cout << "  --idle <s>            = Length of the idle sample taken before the load (default 3, 0 = skip)" << endl;
+    cout << "  --modbus <n>          = Number of Modbus/TCP clients (default 4)" << endl;
+    cout << "  --enip <n>            = Number of EtherNet/IP clients (default 0)" << endl;
+    cout << "  --dnp3 <n>            = Number of DNP3 masters (default 0)" << endl;
+    cout << "  --modbus-port <port>  = (default 502)" << endl;
+    cout << "  --enip-port <port>    = (default 44818)" << endl;
+    cout << "  --dnp3-port <port>    = (default 20000)" << endl;
+    cout << "  --modbus-mix <mix>    = Weighted request mix, e.g. read_holding=60,write_register=40. Operations:" << endl;
+    cout << "                          read_coils read_discrete read_holding read_input write_coil" << endl;
+    cout << "                          write_register write_registers (default read_holding=70,read_coils=20,write_register=10)" << endl;
+    cout << "  --enip-mix <mix>      = Operations: read_int read_coils (default read_int=80,read_coils=20)" << endl;
+    cout << "  --dnp3-mix <mix>      = Operations: integrity_poll event_poll (default integrity_poll=20,event_poll=80)" << endl;
+    cout << "  --registers <n>       = Registers/coils per request (default 16)" << endl;
+    cout << "  --rate <n>            = Requests per second per client, 0 = closed loop (default 0)" << endl;
+    cout << "  --csv <file>          = Also store the results as csv" << endl;
+    cout << "  --emit-program <file> = Write an ST program that maps the registers used by the benchmark" << endl;
+    cout << "                          and exit. Compile it into the runtime with the blank hardware layer" << endl;
+    cout << "  --help,-h             = Print usage information and exit." << endl;
+}
+
+int main(int argc, char *argv[])
+{
+    BenchConfig config;
+    config.host = "127.0.0.1";
+    config.duration_s = 10;
+    config.idle_s = 3;
+    config.rate = 0;
+    config.modbus_clients = 4;
+    config.enip_clients = 0;
+    config.dnp3_clients = 0;
+    config.modbus_port = 502;
+    config.enip_port = 44818;
+    config.dnp3_port = 20000;
+    config.registers = 16;
+
+    string launch_dir, csv_file, program_file, original_config;
+    vector<string> settings;
+    string modbus_mix("read_holding=70,read_coils=20,write_register=10");
+    string enip_mix("read_int=80,read_coils=20");
+    string dnp3_mix("integrity_poll=20,event_poll=80");
+
+    for (int i = 1; i < argc; i++)
+    {
+        string arg(argv[i]);
+        bool has_value = (i + 1 < argc);
+
+        if (arg == "-h" || arg == "--help")
+        {
+            printUsage();
+            return 0;
+        }
+        else if (arg == "--launch" && has_value) launch_dir = argv[++i];
+        else if (arg == "--set" && has_value) settings.push_back(argv[++i]);
+        else if (arg == "--host" && has_value) config.host = argv[++i];
+        else if (arg == "--duration" && has_value) config.duration_s = atoi(argv[++i]);
+        else if (arg == "--idle" && has_value) config.idle_s = atoi(argv[++i]);
+        else if (arg == "--modbus" && has_value) config.modbus_clients = atoi(argv[++i]);
+        else if (arg == "--enip" && has_value) config.enip_clients = atoi(argv[++i]);
+        else if (arg == "--dnp3" && has_value) config.dnp3_clients = atoi(argv[++i]);
+        else if (arg == "--modbus-port" && has_value) config.modbus_port = atoi(argv[++i]);
+        else if (arg == "--enip-port" && has_value) config.enip_port = atoi(argv[++i]);
+        else if (arg == "--dnp3-port" && has_value) config.dnp3_port = atoi(argv[++i]);
+        else if (arg == "--modbus-mix" && has_value) modbus_mix = argv[++i];
+        else if (arg == "--enip-mix" && has_value) enip_mix = argv[++i];
+        else if (arg == "--dnp3-mix" && has_value) dnp3_mix = argv[++i];
+        else if (arg == "--registers" && has_value) config.registers = atoi(argv[++i]);
+        else if (arg == "--rate" && has_value) config.rate = atoi(argv[++i]);
+        else if (arg == "--csv" && has_value) csv_file = argv[++i];
+        else if (arg == "--emit-program" && has_value) program_file = argv[++i];
+        else
+        {
+            cout << "Unrecognized option: " << arg << endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (config.duration_s < 1) config.duration_s = 1;
+    if (config.registers < 1) config.registers = 1;
+    if (config.registers > 100) config.registers = 100;
+
+    if (!program_file.empty())
+    {
+        ofstream st(program_file.c_str(), ios::trunc);
+        if (!st.is_open())
+        {
+            cout << "Error creating " << program_file << endl;
+            return 1;
+        }
+        emitProgram(st, config.registers);
+        return 0;
+    }
+
+    if (!parseMix(modbus_mix, modbus_op_names, MB_NUM_OPS, config.modbus_mix) ||
+        !parseMix(enip_mix, enip_op_names, ENIP_NUM_OPS, config.enip_mix) ||
+        !parseMix(dnp3_mix, dnp3_op_names, DNP3_NUM_OPS, config.dnp3_mix))
+        return 1;
+
+    signal(SIGPIPE, SIG_IGN);
+
+    if (!settings.empty() && launch_dir.empty())
+    {
+        cout << "--set needs --launch" << endl;
+        return 1;
+    }
+
+    pid_t runtime_pid = -1;
+    if (!launch_dir.empty())
+    {
+        if (!settings.empty() && !overrideRuntimeConfig(launch_dir, settings, original_config))
+        {
+            cout << "Error writing " << launch_dir << "/runtime.cfg" << endl;
+            return 2;
+        }
+
+        runtime_pid = fork();
+        if (runtime_pid == 0)
+        {
+            if (chdir(launch_dir.c_str()) != 0) _exit(127);
+            int log_fd = open("protocol_bench_runtime.log", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (log_fd >= 0)
+            {
+                dup2(log_fd, STDOUT_FILENO);
+                dup2(log_fd, STDERR_FILENO);
+                close(log_fd);
+            }
+            execl("./core/openplc", "openplc", (char *)NULL);
+            _exit(127);
+        }
+        else if (runtime_pid < 0)
+        {
+            cout << "Error starting the runtime: " << strerror(errno) << endl;
+            if (!settings.empty()) restoreRuntimeConfig(launch_dir, original_config);
+            return 2;
+        }
+    }
+
+    if (!waitForRuntime(config.host, 10))
+    {
+        cout << "The runtime is not answering on port " << INTERACTIVE_PORT << endl;
+        if (runtime_pid > 0) kill(runtime_pid, SIGTERM);
+        if (!settings.empty()) restoreRuntimeConfig(launch_dir, original_config);
+        return 2;
+    }
+
+    string reply;
+    if (config.modbus_clients > 0)
+        interactiveCommand(config.host, "start_modbus(" + to_string(config.modbus_port) + ")", reply);
+    if (config.enip_clients > 0)
+        interactiveCommand(config.host, "start_enip(" + to_string(config.enip_port) + ")", reply);
+    if (config.dnp3_clients > 0)
+        interactiveCommand(config.host, "start_dnp3(" + to_string(config.dnp3_port) + ")", reply);
+    sleep(1); // servers are started on their own threads
+
+    map<string, string> idle_stats, load_stats;
+    if (config.idle_s > 0)
+    {
+        cout << "Sampling scan statistics with the servers idle (" << config.idle_s << " s)" << endl;
+        if (!sampleScanStats(config.host, config.idle_s, idle_stats))
+            cout << "Scan statistics are not available on this runtime" << endl;
+    }
+
+    cout << "Load: " << config.modbus_clients << " Modbus, " << config.enip_clients << " EtherNet/IP, "
+         << config.dnp3_clients << " DNP3 clients for " << config.duration_s << " s" << endl;
+
+    interactiveCommand(config.host, "reset_scan_stats()", reply);
+    unsigned long long deadline = nowNs() + (unsigned long long)config.duration_s * 1000000000ULL;
+    vector<thread> clients;
+    for (int i = 0; i < config.modbus_clients; i++)
+        clients.push_back(thread(clientThread, &config, string("modbus"), i, deadline));
+    for (int i = 0; i < config.enip_clients; i++)
+        clients.push_back(thread(clientThread, &config, string("enip"), i, deadline));
+    for (int i = 0; i < config.dnp3_clients; i++)
+        clients.push_back(thread(clientThread, &config, string("dnp3"), i, deadline));
+    for (size_t i = 0; i < clients.size(); i++)
+        clients[i].join();
+
+    if (interactiveCommand(config.host, "scan_stats()", reply))
+        load_stats = parseScanStats(reply);
+
+    printReport(config, idle_stats, load_stats, csv_file);
+
+    int status = 0;
+    for (map<string, OpResult>::iterator it = results.begin(); it != results.end(); ++it)
+        if (it->second.latency_ns.empty()) status = 1;
+    if (results.empty()) status = 1;
+
+    if (runtime_pid > 0)
+    {
+        interactiveCommand(config.host, "quit()", reply);
+        sleep(1);
+        if (waitpid(runtime_pid, NULL, WNOHANG) == 0)
+        {
+            kill(runtime_pid, SIGTERM);
+            waitpid(runtime_pid, NULL, 0);
+        }
+    }
+    if (!settings.empty()) restoreRuntimeConfig(launch_dir, original_config);
+
+    return status;
+}
@@ -0,0 +1,524 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 OpenPLC Project
+// This file is part of the OpenPLC Software Stack.
+//
+// OpenPLC is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenPLC is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with OpenPLC.  If not, see <http://www.gnu.org/licenses/>.
+//------
+//
+// Compile-time benchmark for the OpenPLC toolchain. It generates a corpus of
+// synthetic ST projects (programs, function blocks, SFC chains and LD-style
+// boolean rungs), runs every stage that compile_program.sh runs on them and
+// records the wall time and peak memory of each stage. Results can be saved
+// as a baseline and later runs compared against it to catch regressions.
+//-----------------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+
+using namespace std;
+
+/// Size parameters of one synthetic project
+struct ProjectSpec
+{
+    string name;
+    int pous;           // number of programs (each one has its own FB type)
+    int vars;           // variables declared on each POU
+    int fb_instances;   // FB instances declared on each program
+    int sfc_depth;      // steps on the SFC chain of each program (0 = no SFC)
+    int rungs;          // LD-style boolean rungs on each program
+};
+
+/// Measurement of a single toolchain stage
+struct StageResult
+{
+    string project;
+    string stage;
+    double wall_ms;
+    long peak_rss_kb;
+    int exit_code;
+};
+
+/// Deterministic pseudo-random generator so that every run produces the
+/// exact same corpus
+static unsigned long long lcg_state = 0x5DEECE66DULL;
+static int nextRandom(int limit)
+{
+    lcg_state = lcg_state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (int)((lcg_state >> 33) % (unsigned long long)limit);
+}
+
+//-----------------------------------------------------------------------------
+// Synthetic project generation
+//-----------------------------------------------------------------------------
+
+/// Writes one function block type. Each FB has a timer, a counter and a
+/// handful of arithmetic and boolean statements over its own variables.
+void generateFunctionBlock(ostream& st, const ProjectSpec& spec, int index)
+{
+    int vars = spec.vars < 4 ? 4 : spec.vars;
+
+    st << "FUNCTION_BLOCK BENCH_FB" << index << "\n";
+    st << "  VAR_INPUT\n    IN : BOOL;\n    X : INT;\n  END_VAR\n";
+    st << "  VAR_OUTPUT\n    Q : BOOL;\n    Y : INT;\n  END_VAR\n";
+    st << "  VAR\n    T0 : TON;\n    C0 : CTU;\n";
+    for (int i = 0; i < vars; i++)
+        st << "    B" << i << " : BOOL;\n    W" << i << " : INT;\n";
+    st << "  END_VAR\n\n";
+
+    st << "  T0(IN := IN, PT := T#" << (100 + index) << "ms);\n";
+    st << "  C0(CU := T0.Q, R := NOT IN, PV := " << (10 + index) << ");\n";
+    for (int i = 1; i < vars; i++)
+    {
+        st << "  B" << i << " := (B" << nextRandom(vars) << " AND IN) OR NOT B" << nextRandom(vars) << ";\n";
+        st << "  W" << i << " := W" << (i - 1) << " + X * " << (1 + nextRandom(7)) << ";\n";
+    }
+    st << "  Q := C0.Q OR B" << (vars - 1) << ";\n";
+    st << "  Y := W" << (vars - 1) << ";\n";
+    st << "END_FUNCTION_BLOCK\n\n";
+}
+
+/// Writes one program. Programs hold the located variables, the FB instances,
+/// the boolean rungs that the PLCopen Editor produces when converting LD to ST
+/// and, optionally, a linear SFC chain.
+void generateProgram(ostream& st, const ProjectSpec& spec, int index)
+{
+    int vars = spec.vars < 4 ? 4 : spec.vars;
+
+    st << "PROGRAM BENCH_PRG" << index << "\n";
+    st << "  VAR\n";
+    // Located variables use a different byte/word for every program so the
+    // glue generator sees a realistic address space
+    st << "    DI AT %IX" << index << ".0 : BOOL;\n";
+    st << "    DO AT %QX" << index << ".0 : BOOL;\n";
+    st << "    AI AT %IW" << index << " : INT;\n";
+    st << "    AO AT %QW" << index << " : INT;\n";
+    for (int i = 0; i < vars; i++)
+        st << "    B" << i << " : BOOL;\n    W" << i << " : INT;\n";
+    for (int i = 0; i < spec.fb_instances; i++)
+        st << "    FB" << i << " : BENCH_FB" << index << ";\n";
+    st << "  END_VAR\n\n";
+
+    // LD networks converted to ST: one coil per rung, contacts in series and
+    // parallel branches
+    for (int i = 0; i < spec.rungs; i++)
+    {
+        st << "  B" << nextRandom(vars) << " := ((B" << nextRandom(vars) << " AND NOT B" << nextRandom(vars)
+           << ") OR B" << nextRandom(vars) << ") AND (DI OR B" << nextRandom(vars) << ");\n";
+    }
+
+    for (int i = 0; i < spec.fb_instances; i++)
+    {
+        st << "  FB" << i << "(IN := B" << nextRandom(vars) << ", X := AI);\n";
+        st << "  W" << nextRandom(vars) << " := FB" << i << ".Y;\n";
+    }
+    st << "  DO := B0;\n";
+    st << "  AO := W0;\n\n";
+
+    // Linear SFC chain that loops back to the initial step
+    if (spec.sfc_depth > 0)
+    {
+        st << "  INITIAL_STEP S0:\n  END_STEP\n\n";
+        for (int i = 1; i <= spec.sfc_depth; i++)
+        {
+            st << "  STEP S" << i << ":\n    A" << i << "(N);\n  END_STEP\n\n";
+            st << "  ACTION A" << i << ":\n    W" << (i % vars) << " := W" << (i % vars) << " + 1;\n  END_ACTION\n\n";
+        }
+        for (int i = 0; i <= spec.sfc_depth; i++)
+        {
+            int next = (i == spec.sfc_depth) ? 0 : i + 1;
+            st << "  TRANSITION FROM S" << i << " TO S" << next << "\n    := B" << (i % vars) << ";\n  END_TRANSITION\n\n";
+        }
+    }
+
+    st << "END_PROGRAM\n\n";
+}
+
+/// Writes the complete project (all POUs plus the configuration) to the
+/// provided stream
+void generateProject(ostream& st, const ProjectSpec& spec)
+{
+    lcg_state = 0x5DEECE66DULL;
+
+    for (int i = 0; i < spec.pous; i++)
+        generateFunctionBlock(st, spec, i);
+
+    for (int i = 0; i < spec.pous; i++)
+        generateProgram(st, spec, i);
+
+    st << "CONFIGURATION Config0\n\n";
+    st << "  RESOURCE Res0 ON PLC\n";
+    st << "    TASK Main(INTERVAL := T#20ms,PRIORITY := 0);\n";
+    for (int i = 0; i < spec.pous; i++)
+        st << "    PROGRAM Inst" << i << " WITH Main : BENCH_PRG" << i << ";\n";
+    st << "  END_RESOURCE\n";
+    st << "END_CONFIGURATION\n";
+}
+
+//-----------------------------------------------------------------------------
+// Stage execution
+//-----------------------------------------------------------------------------
+
+/// Runs a command inside the working directory and records its wall time and
+/// peak resident set size. The command output goes to a log file so that it
+/// does not disturb the report.
+StageResult runStage(const string& project, const string& stage, const string& workdir,
+                     const vector<string>& command)
+{
+    StageResult result;
+    result.project = project;
+    result.stage = stage;
+    result.wall_ms = 0;
+    result.peak_rss_kb = 0;
+    result.exit_code = -1;
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        if (chdir(workdir.c_str()) != 0) _exit(127);
+        string log_name = stage + ".log";
+        int log_fd = open(log_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (log_fd >= 0)
+        {
+            dup2(log_fd, STDOUT_FILENO);
+            dup2(log_fd, STDERR_FILENO);
+            close(log_fd);
+        }
+
+        vector<char *> args;
+        for (size_t i = 0; i < command.size(); i++)
+            args.push_back(const_cast<char *>(command[i].c_str()));
+        args.push_back(NULL);
+
+        execvp(args[0], &args[0]);
+        _exit(127);
+    }
+    else if (pid < 0)
+    {
+        cout << "Error forking " << stage << ": " << strerror(errno) << endl;
+        return result;
+    }
+
+    int status = 0;
+    struct rusage usage;
+    memset(&usage, 0, sizeof(usage));
+    wait4(pid, &status, 0, &usage);
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    result.wall_ms = (end.tv_sec - start.tv_sec) * 1000.0 + (end.tv_nsec - start.tv_nsec) / 1000000.0;
+    result.peak_rss_kb = usage.ru_maxrss;
+    result.exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+
+    return result;
+}
+
+/// Generates the project and runs the toolchain on it, stage by stage, the
+/// same way compile_program.sh does. Stops at the first failing stage.
+bool benchmarkProject(const ProjectSpec& spec, const string& toolchain, const string& work_root,
+                      vector<StageResult>& results)
+{
+    string workdir = work_root + "/" + spec.name;
+    mkdir(work_root.c_str(), 0755);
+    mkdir(workdir.c_str(), 0755);
+
+    string st_file = workdir + "/" + spec.name + ".st";
+    ofstream st(st_file.c_str(), ios::trunc);
+    if (!st.is_open())
+    {
+        cout << "Error creating " << st_file << endl;
+        return false;
+    }
+    generateProject(st, spec);
+    st.close();
+
+    string st_name = spec.name + ".st";
+    string core_lib = toolchain + "/core/lib";
+
+    vector<pair<string, vector<string> > > stages;
+    {
+        vector<string> cmd;
+        cmd.push_back(toolchain + "/st_optimizer");
+        cmd.push_back(st_name);
+        cmd.push_back(st_name);
+        stages.push_back(make_pair(string("st_optimizer"), cmd));
+    }
+    {
+        vector<string> cmd;
+        cmd.push_back(toolchain + "/iec2c");
+        cmd.push_back("-f"); cmd.push_back("-l"); cmd.push_back("-p");
+        cmd.push_back("-r"); cmd.push_back("-R"); cmd.push_back("-a");
+        cmd.push_back("-I"); cmd.push_back(toolchain + "/lib");
+        cmd.push_back(st_name);
+        stages.push_back(make_pair(string("iec2c"), cmd));
+    }
+    {
+        vector<string> cmd;
+        cmd.push_back(toolchain + "/core/glue_generator");
+        cmd.push_back("LOCATED_VARIABLES.h");
+        cmd.push_back("glueVars.cpp");
+        stages.push_back(make_pair(string("glue_generator"), cmd));
+    }
+    const char *objects[] = {"Config0.c", "Res0.c", "glueVars.cpp"};
+    const char *object_stages[] = {"gxx_config", "gxx_resource", "gxx_gluevars"};
+    for (int i = 0; i < 3; i++)
+    {
+        vector<string> cmd;
+        cmd.push_back("g++");
+        cmd.push_back("-std=gnu++11");
+        cmd.push_back("-I"); cmd.push_back(core_lib);
+        cmd.push_back("-I"); cmd.push_back(".");
+        cmd.push_back("-c"); cmd.push_back(objects[i]);
+        cmd.push_back("-w");
+        stages.push_back(make_pair(string(object_stages[i]), cmd));
+    }
+
+    for (size_t i = 0; i < stages.size(); i++)
+    {
+        StageResult r = runStage(spec.name, stages[i].first, workdir, stages[i].second);
+        results.push_back(r);
+        cout << "  " << spec.name << "\t" << r.stage << "\t" << r.wall_ms << " ms\t" << r.peak_rss_kb << " kB" << endl;
+        if (r.exit_code != 0)
+        {
+            cout << "  Stage " << r.stage << " failed with code " << r.exit_code
+                 << " (see " << workdir << "/" << r.stage << ".log)" << endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Baseline handling
+//-----------------------------------------------------------------------------
+
+void saveResults(const string& file_name, const vector<StageResult>& results)
+{
+    ofstream out(file_name.c_str(), ios::trunc);
+    out << "project,stage,wall_ms,peak_rss_kb\n";
+    for (size_t i = 0; i < results.size(); i++)
+        out << results[i].project << "," << results[i].stage << "," << results[i].wall_ms << "," << results[i].peak_rss_kb << "\n";
+}
+
+/// Loads a baseline csv into a map indexed by "project/stage"
+bool loadBaseline(const string& file_name, map<string, StageResult>& baseline)
+{
+    ifstream in(file_name.c_str());
+    if (!in.is_open()) return false;
+
+    string line;
+    getline(in, line); // header
+    while (getline(in, line))
+    {
+        if (line.empty() || line[0] == '#') continue;
+        stringstream ss(line);
+        StageResult r;
+        string wall, rss;
+        getline(ss, r.project, ',');
+        getline(ss, r.stage, ',');
+        getline(ss, wall, ',');
+        getline(ss, rss, ',');
+        r.wall_ms = atof(wall.c_str());
+        r.peak_rss_kb = atol(rss.c_str());
+        r.exit_code = 0;
+        baseline[r.project + "/" + r.stage] = r;
+    }
+    return true;
+}
+
+/// Compares the current results against the baseline. Returns the number of
+/// regressions found (time or memory above the tolerance).
+int compareBaseline(const vector<StageResult>& results, const map<string, StageResult>& baseline, double tolerance)
+{
+    int regressions = 0;
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        map<string, StageResult>::const_iterator it = baseline.find(results[i].project + "/" + results[i].stage);
+        if (it == baseline.end()) continue;
+
+        const StageResult& base = it->second;
+        double time_limit = base.wall_ms * (1.0 + tolerance / 100.0);
+        double rss_limit = base.peak_rss_kb * (1.0 + tolerance / 100.0);
+
+        if (results[i].wall_ms > time_limit)
+        {
+            cout << "REGRESSION " << results[i].project << "/" << results[i].stage << ": time "
+                 << results[i].wall_ms << " ms (baseline " << base.wall_ms << " ms)" << endl;
+            regressions++;
+        }
+        if (results[i].peak_rss_kb > rss_limit)
+        {
+            cout << "REGRESSION " << results[i].project << "/" << results[i].stage << ": peak memory "
+                 << results[i].peak_rss_kb << " kB (baseline " << base.peak_rss_kb << " kB)" << endl;
+            regressions++;
+        }
+    }
+    return regressions;
+}
+
+//-----------------------------------------------------------------------------
+// Corpus definition
+//-----------------------------------------------------------------------------
+
+/// Default corpus. Sizes grow roughly by an order of magnitude so the scaling
+/// of each stage is visible. The scale factor multiplies every count.
+vector<ProjectSpec> defaultCorpus(int scale)
+{
+    vector<ProjectSpec> corpus;
+    ProjectSpec small = {"small", 2, 10, 4, 0, 20};
+    ProjectSpec medium = {"medium", 10, 50, 20, 10, 200};
+    ProjectSpec large = {"large", 40, 100, 50, 40, 1000};
+    ProjectSpec deep_sfc = {"deep_sfc", 4, 20, 4, 400, 10};
+    ProjectSpec big_ld = {"big_ld", 4, 200, 4, 0, 10000};
+
+    corpus.push_back(small);
+    corpus.push_back(medium);
+    corpus.push_back(large);
+    corpus.push_back(deep_sfc);
+    corpus.push_back(big_ld);
+
+    for (size_t i = 0; i < corpus.size(); i++)
+    {
+        corpus[i].pous *= scale;
+        corpus[i].fb_instances *= scale;
+        corpus[i].sfc_depth *= scale;
+        corpus[i].rungs *= scale;
+    }
+    return corpus;
+}
+
+void printUsage()
+{
+    cout << "Usage " << endl << endl;
+    cout << "  toolchain_bench [options]" << endl << endl;
+    cout << "Generates a corpus of synthetic ST projects, runs st_optimizer, iec2c, glue_generator" << endl;
+    cout << "and g++ on each of them and reports wall time and peak memory per stage." << endl << endl;
+    cout << "Options" << endl;
+    cout << "  --toolchain <dir>  = OpenPLC webserver folder holding st_optimizer, iec2c, lib/ and core/ (default ../../webserver)" << endl;
+    cout << "  --work <dir>       = Scratch folder for the generated projects (default ./toolchain_work)" << endl;
+    cout << "  --scale <n>        = Multiply every size of the default corpus by n (default 1)" << endl;
+    cout << "  --project <spec>   = Benchmark a single project instead of the corpus. <spec> is" << endl;
+    cout << "                       pous,vars,fb_instances,sfc_depth,rungs" << endl;
+    cout << "  --generate-only    = Only write the ST files, do not run the toolchain" << endl;
+    cout << "  --save <file>      = Store the results as csv (can be used later as baseline)" << endl;
+    cout << "  --baseline <file>  = Compare the results against a baseline csv" << endl;
+    cout << "  --tolerance <pct>  = Allowed growth over the baseline before reporting a regression (default 20)" << endl;
+    cout << "  --help,-h          = Print usage information and exit." << endl;
+}
+
+int main(int argc, char *argv[])
+{
+    string toolchain("../../webserver");
+    string work_root("./toolchain_work");
+    string save_file, baseline_file;
+    double tolerance = 20.0;
+    int scale = 1;
+    bool generate_only = false;
+    vector<ProjectSpec> corpus;
+
+    for (int i = 1; i < argc; i++)
+    {
+        string arg(argv[i]);
+        bool has_value = (i + 1 < argc);
+
+        if (arg == "-h" || arg == "--help")
+        {
+            printUsage();
+            return 0;
+        }
+        else if (arg == "--generate-only") generate_only = true;
+        else if (arg == "--toolchain" && has_value) toolchain = argv[++i];
+        else if (arg == "--work" && has_value) work_root = argv[++i];
+        else if (arg == "--save" && has_value) save_file = argv[++i];
+        else if (arg == "--baseline" && has_value) baseline_file = argv[++i];
+        else if (arg == "--tolerance" && has_value) tolerance = atof(argv[++i]);
+        else if (arg == "--scale" && has_value) scale = atoi(argv[++i]);
+        else if (arg == "--project" && has_value)
+        {
+            ProjectSpec spec;
+            spec.name = "custom";
+            if (sscanf(argv[++i], "%d,%d,%d,%d,%d", &spec.pous, &spec.vars, &spec.fb_instances,
+                       &spec.sfc_depth, &spec.rungs) != 5)
+            {
+                cout << "Invalid project specification: " << argv[i] << endl;
+                return 1;
+            }
+            corpus.push_back(spec);
+        }
+        else
+        {
+            cout << "Unrecognized option: " << arg << endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (scale < 1) scale = 1;
+    if (corpus.empty()) corpus = defaultCorpus(scale);
+
+    vector<StageResult> results;
+    bool all_ok = true;
+    for (size_t i = 0; i < corpus.size(); i++)
+    {
+        cout << "Project " << corpus[i].name << ": " << corpus[i].pous << " POUs, " << corpus[i].vars << " vars, "
+             << corpus[i].fb_instances << " FB instances, " << corpus[i].sfc_depth << " SFC steps, "
+             << corpus[i].rungs << " rungs" << endl;
+
+        if (generate_only)
+        {
+            mkdir(work_root.c_str(), 0755);
+            string st_file = work_root + "/" + corpus[i].name + ".st";
+            ofstream st(st_file.c_str(), ios::trunc);
+            generateProject(st, corpus[i]);
+            continue;
+        }
+
+        if (!benchmarkProject(corpus[i], toolchain, work_root, results))
+            all_ok = false;
+    }
+
+    if (generate_only) return 0;
+
+    if (!save_file.empty())
+        saveResults(save_file, results);
+
+    int regressions = 0;
+    if (!baseline_file.empty())
+    {
+        map<string, StageResult> baseline;
+        if (loadBaseline(baseline_file, baseline))
+            regressions = compareBaseline(results, baseline, tolerance);
+        else
+            cout << "Baseline " << baseline_file << " not found. Run with --save to create one." << endl;
+    }
+
+    if (!all_ok) return 2;
+    return regressions > 0 ? 1 : 0;
+}
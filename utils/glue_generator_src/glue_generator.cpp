@@ -1,11 +1,12 @@
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <string>
 #include <cstring>
 #include <cstdlib>
+#include <vector>
 
-#define MAX_LINE_INPUT 1024
-#define MAX_LOCAL_BUFFER 100
+#define BUFFER_SIZE 1024
 
 using namespace std;
 
@@ -39,6 +40,7 @@ void generateHeader(ostream& glueVars)
 //-----------------------------------------------------------------------------\r\n\
 \r\n\
 #include \"iec_std_lib.h\"\r\n\
+#include \"located_address.h\"\r\n\
 \r\n\
 TIME __CURRENT_TIME;\r\n\
 extern unsigned long long common_ticktime__;\r\n\
@@ -47,26 +49,15 @@ extern unsigned long long common_ticktime__;\r\n\
 //auto-generated glueVars.cpp file\r\n\
 #define BUFFER_SIZE		1024\r\n\
 \r\n\
-//Booleans\r\n\
-IEC_BOOL *bool_input[BUFFER_SIZE][8];\r\n\
-IEC_BOOL *bool_output[BUFFER_SIZE][8];\r\n\
-\r\n\
-//Bytes\r\n\
-IEC_BYTE *byte_input[BUFFER_SIZE];\r\n\
-IEC_BYTE *byte_output[BUFFER_SIZE];\r\n\
-\r\n\
-//Analog I/O\r\n\
-IEC_UINT *int_input[BUFFER_SIZE];\r\n\
-IEC_UINT *int_output[BUFFER_SIZE];\r\n\
-\r\n\
-//Memory\r\n\
-IEC_UINT *int_memory[BUFFER_SIZE];\r\n\
-IEC_DINT *dint_memory[BUFFER_SIZE];\r\n\
-IEC_LINT *lint_memory[BUFFER_SIZE];\r\n\
-\r\n\
-//Special Functions\r\n\
-IEC_LINT *special_functions[BUFFER_SIZE];\r\n\
+//Modbus buffers, defined in modbus.cpp\r\n\
+extern IEC_BOOL mb_discrete_input[];\r\n\
+extern IEC_BOOL mb_coils[];\r\n\
+extern IEC_UINT mb_input_regs[];\r\n\
+extern IEC_UINT mb_holding_regs[];\r\n\
 \r\n\
+//Eight consecutive slots of a Modbus buffer, for the table slots that are not\r\n\
+//used by the program\r\n\
+#define __MB_SLOTS(buffer, first) &buffer[first], &buffer[first+1], &buffer[first+2], &buffer[first+3], &buffer[first+4], &buffer[first+5], &buffer[first+6], &buffer[first+7]\r\n\
 \r\n\
 #define __LOCATED_VAR(type, name, ...) type __##name;\r\n\
 #include \"LOCATED_VARIABLES.h\"\r\n\
@@ -74,172 +65,437 @@ IEC_LINT *special_functions[BUFFER_SIZE];\r\n\
 #define __LOCATED_VAR(type, name, ...) type* name = &__##name;\r\n\
 #include \"LOCATED_VARIABLES.h\"\r\n\
 #undef __LOCATED_VAR\r\n\
-\r\n\
-void glueVars()\r\n\
-{\r\n";
+\r\n";
 }
 
-int parseIecVars(istream& locatedVars, char *varName, char *varType)
+/// A located variable as declared in LOCATED_VARIABLES.h, for example
+/// __LOCATED_VAR(BOOL,__IX0_1,I,X,0,1)
+struct LocatedVar
 {
-	string line;
-	char buffer[MAX_LINE_INPUT];
+	string type;
+	string name;
+	char area;		// I, Q or M
+	char size;		// X, B, W, D or L
+	int pos1;
+	int pos2;
+};
+
+/// The runtime buffer (table) a located variable is bound to
+enum GlueTable
+{
+	BOOL_INPUT = 0,
+	BOOL_OUTPUT,
+	BYTE_INPUT,
+	BYTE_OUTPUT,
+	INT_INPUT,
+	INT_OUTPUT,
+	INT_MEMORY,
+	DINT_MEMORY,
+	LINT_MEMORY,
+	SPECIAL_FUNCTIONS,
+	NUM_TABLES
+};
+
+static const char *table_names[NUM_TABLES] = {"bool_input", "bool_output", "byte_input", "byte_output", "int_input",
+                                              "int_output", "int_memory", "dint_memory", "lint_memory", "special_functions"};
+static const char *table_types[NUM_TABLES] = {"IEC_BOOL", "IEC_BOOL", "IEC_BYTE", "IEC_BYTE", "IEC_UINT",
+                                              "IEC_UINT", "IEC_UINT", "IEC_DINT", "IEC_LINT", "IEC_LINT"};
+
+/// The Modbus buffer the unused slots of a table point to, and the Modbus
+/// address of the first slot. The tables are constant, so the runtime cannot
+/// bind these slots itself.
+static const char *table_fallbacks[NUM_TABLES] = {"mb_discrete_input", "mb_coils", NULL, NULL, "mb_input_regs",
+                                                  "mb_holding_regs", "mb_holding_regs", NULL, NULL, NULL};
+static const int table_fallback_offsets[NUM_TABLES] = {0, 0, 0, 0, 0, 0, BUFFER_SIZE, 0, 0, 0};
+
+/// Parses a single line of LOCATED_VARIABLES.h. Returns false if the line is
+/// not a __LOCATED_VAR declaration. The positions are read from the macro
+/// arguments, so names are never decoded.
+bool parseLocatedVar(const string& line, LocatedVar& var, string& error)
+{
+	size_t open = line.find("__LOCATED_VAR(");
+	if (open == string::npos) return false;
+	open += strlen("__LOCATED_VAR(");
+
+	size_t close = line.find(')', open);
+	if (close == string::npos)
+	{
+		error = "missing closing parenthesis";
+		return true;
+	}
+
+	// Split the arguments on the commas. There are no nested parenthesis or
+	// quotes in the arguments generated by MATIEC.
+	string fields[8];
+	int num_fields = 0;
+	size_t start = open;
+	while (num_fields < 8)
+	{
+		size_t comma = line.find(',', start);
+		if (comma == string::npos || comma > close) comma = close;
+		fields[num_fields++] = line.substr(start, comma - start);
+		if (comma == close) break;
+		start = comma + 1;
+	}
+
+	if (num_fields < 5)
+	{
+		error = "expected at least 5 arguments";
+		return true;
+	}
+	if (num_fields > 6)
+	{
+		error = "nested addresses are not supported by the OpenPLC runtime";
+		return true;
+	}
+
+	var.type = fields[0];
+	var.name = fields[1];
+	var.area = fields[2].size() == 1 ? fields[2][0] : '?';
+	var.size = fields[3].size() == 1 ? fields[3][0] : '?';
 
-	if (getline(locatedVars, line))
+	char *end;
+	var.pos1 = (int)strtol(fields[4].c_str(), &end, 10);
+	if (fields[4].empty() || *end != '\0')
 	{
-		int i = 0, j = 0;
-		strncpy(buffer, line.c_str(), MAX_LINE_INPUT);
-		for (i = 0; i < MAX_LINE_INPUT && buffer[i] != '('; i++);
-		i++;
+		error = "invalid address '" + fields[4] + "'";
+		return true;
+	}
 
-		while (i < MAX_LINE_INPUT && buffer[i] != ',')
+	var.pos2 = 0;
+	if (num_fields == 6)
+	{
+		var.pos2 = (int)strtol(fields[5].c_str(), &end, 10);
+		if (fields[5].empty() || *end != '\0')
 		{
-			if(j < MAX_LOCAL_BUFFER)
-			{
-				varType[j] = buffer[i];
-				i++; j++;
-				varType[j] = '\0';
-			}
+			error = "invalid address '" + fields[5] + "'";
+			return true;
 		}
-		i++; j=0;
+	}
+
+	return true;
+}
+
+/// Returns true if the IEC type can be stored on a location of this size
+bool typeMatchesSize(const string& type, char size)
+{
+	switch (size)
+	{
+		case 'X': return type == "BOOL";
+		case 'B': return type == "BYTE" || type == "SINT" || type == "USINT";
+		case 'W': return type == "WORD" || type == "INT" || type == "UINT";
+		case 'D': return type == "DWORD" || type == "DINT" || type == "UDINT" || type == "REAL";
+		case 'L': return type == "LWORD" || type == "LINT" || type == "ULINT" || type == "LREAL";
+	}
+	return false;
+}
+
+/// Finds the runtime table and index a located variable is bound to. Returns
+/// an empty string on success or a description of the addressing error.
+string bindLocatedVar(const LocatedVar& var, int *table, int *index1, int *index2)
+{
+	if (!typeMatchesSize(var.type, var.size))
+		return "type " + var.type + " does not fit the location size";
+
+	if (var.pos1 < 0 || var.pos2 < 0)
+		return "negative addresses are not allowed";
+
+	*index1 = var.pos1;
+	*index2 = 0;
 
-		while (i < MAX_LINE_INPUT && buffer[i] != ',')
+	if (var.size == 'X')
+	{
+		if (var.pos2 >= 8)
+			return "bit index must be between 0 and 7";
+		*index2 = var.pos2;
+	}
+	else if (var.pos2 != 0)
+	{
+		return "only boolean locations can have a bit index";
+	}
+
+	*table = -1;
+	if (var.area == 'I' || var.area == 'Q')
+	{
+		bool input = (var.area == 'I');
+		switch (var.size)
 		{
-			if(j < MAX_LOCAL_BUFFER)
-			{
-				varName[j] = buffer[i];
-				i++; j++;
-				varName[j] = '\0';
-			}
+			case 'X': *table = input ? BOOL_INPUT : BOOL_OUTPUT; break;
+			case 'B': *table = input ? BYTE_INPUT : BYTE_OUTPUT; break;
+			case 'W': *table = input ? INT_INPUT : INT_OUTPUT; break;
+		}
+	}
+	else if (var.area == 'M')
+	{
+		switch (var.size)
+		{
+			case 'W': *table = INT_MEMORY; break;
+			case 'D': *table = DINT_MEMORY; break;
+			case 'L':
+				if (var.pos1 >= BUFFER_SIZE)
+				{
+					*table = SPECIAL_FUNCTIONS;
+					*index1 = var.pos1 - BUFFER_SIZE;
+				}
+				else
+				{
+					*table = LINT_MEMORY;
+				}
+				break;
 		}
-
-		return 1;
 	}
 	else
 	{
-		return 0;
+		return string("unknown location area '") + var.area + "'";
 	}
+
+	if (*table < 0)
+		return string("location %") + var.area + var.size + " is not supported by the OpenPLC runtime";
+
+	if (*index1 >= BUFFER_SIZE)
+		return "address is out of range";
+
+	return "";
 }
 
-void findPositions(char *varName, int *pos1, int *pos2)
+/// The parsed and validated content of LOCATED_VARIABLES.h. Each table slot
+/// holds the index of the variable bound to it, or -1.
+struct GlueTables
+{
+	vector<LocatedVar> vars;
+	vector<int> slots[NUM_TABLES];
+	int used_rows[NUM_TABLES];
+
+	GlueTables()
+	{
+		for (int i = 0; i < NUM_TABLES; i++)
+		{
+			int width = (i == BOOL_INPUT || i == BOOL_OUTPUT) ? 8 : 1;
+			slots[i].assign(BUFFER_SIZE * width, -1);
+			used_rows[i] = 0;
+		}
+	}
+};
+
+/// Reads LOCATED_VARIABLES.h in a single pass, binding every variable to its
+/// table slot. Addressing errors are reported on the errors stream. Returns
+/// the number of errors found.
+int parseLocatedVars(istream& locatedVars, GlueTables& tables, ostream& errors)
 {
-	int i=4, j=0;
-	char tempBuffer[100];
+	string line;
+	int line_number = 0;
+	int num_errors = 0;
 
-	while (varName[i] != '_' && varName[i] != '\0')
+	while (getline(locatedVars, line))
 	{
-		tempBuffer[j] = varName[i];
-		i++; j++;
-		tempBuffer[j] = '\0';
+		line_number++;
+
+		LocatedVar var;
+		string error;
+		if (!parseLocatedVar(line, var, error)) continue;
+
+		int table = 0, index1 = 0, index2 = 0;
+		if (error.empty())
+			error = bindLocatedVar(var, &table, &index1, &index2);
+
+		if (error.empty())
+		{
+			int width = (table == BOOL_INPUT || table == BOOL_OUTPUT) ? 8 : 1;
+			int slot = index1 * width + index2;
+			if (tables.slots[table][slot] >= 0)
+			{
+				error = "address already used by " + tables.vars[tables.slots[table][slot]].name;
+			}
+			else
+			{
+				tables.slots[table][slot] = (int)tables.vars.size();
+				tables.vars.push_back(var);
+				if (index1 + 1 > tables.used_rows[table]) tables.used_rows[table] = index1 + 1;
+			}
+		}
+
+		if (!error.empty())
+		{
+			errors << "LOCATED_VARIABLES.h:" << line_number << ": error: invalid located variable "
+			       << (var.name.empty() ? line : var.name) << ": " << error << endl;
+			num_errors++;
+		}
 	}
-	*pos1 = atoi(tempBuffer);
 
-	if (varName[i] == '\0')
+	return num_errors;
+}
+
+/// Writes the address of a located variable, casted to the table type when
+/// the IEC type differs from it (e.g. REAL on a %MD location). Unused slots
+/// point to the Modbus buffer of the table, if it has one.
+void printSlot(ostream& glueVars, const GlueTables& tables, int table, int slot)
+{
+	int var = tables.slots[table][slot];
+	if (var < 0)
 	{
-		*pos2 = 0;
+		if (table_fallbacks[table] == NULL)
+			glueVars << "NULL";
+		else
+			glueVars << "&" << table_fallbacks[table] << "[" << table_fallback_offsets[table] + slot << "]";
 		return;
 	}
 
-	j = 0; i++;
+	bool needs_cast = (table == DINT_MEMORY || table == LINT_MEMORY || table == SPECIAL_FUNCTIONS);
+	if (needs_cast) glueVars << "(" << table_types[table] << " *)";
+	glueVars << "&__" << tables.vars[var].name;
+}
 
-	while (varName[i] != '\0')
+/// Returns true if none of the slots from first to first + 7 is used
+bool slotsUnused(const GlueTables& tables, int table, int first)
+{
+	for (int slot = first; slot < first + 8; slot++)
 	{
-		tempBuffer[j] = varName[i];
-		i++; j++;
-		tempBuffer[j] = '\0';
+		if (tables.slots[table][slot] >= 0) return false;
 	}
-	*pos2 = atoi(tempBuffer);
+	return true;
 }
 
-void glueVar(ostream& glueVars, char *varName, char *varType)
+/// Writes a statically initialised constant table. Tables backed by a Modbus
+/// buffer are written in full, with runs of eight unused slots written with
+/// the __MB_SLOTS macro. The other tables are written up to the last row in
+/// use; the remaining rows are zero (NULL) initialised.
+void generateTable(ostream& glueVars, const GlueTables& tables, int table)
 {
-	cout << "varName: " << varName << "\tvarType: " << varType << endl;
-	int pos1, pos2;
+	bool is_bool = (table == BOOL_INPUT || table == BOOL_OUTPUT);
+	bool has_fallback = (table_fallbacks[table] != NULL);
 
-	findPositions(varName, &pos1, &pos2);
+	glueVars << "extern " << table_types[table] << " *const " << table_names[table] << "[BUFFER_SIZE]";
+	if (is_bool) glueVars << "[8]";
 
-	if (pos2 >= 8)
+	if (!has_fallback && tables.used_rows[table] == 0)
 	{
-		cout << "***Invalid addressing on located variable" << varName << "***" << endl;
+		glueVars << " = {};\r\n";
+		return;
 	}
 
-	if (varName[2] == 'I')
+	glueVars << " = {\r\n";
+	int rows = has_fallback ? BUFFER_SIZE : tables.used_rows[table];
+	for (int row = 0; row < rows; row++)
 	{
-		//INPUT
-		switch (varName[3])
+		if (is_bool)
 		{
-			case 'X':
-				glueVars << "\tbool_input[" << pos1 << "][" << pos2 << "] = " << varName << ";\r\n";
-				break;
-			case 'B':
-				glueVars << "\tbyte_input[" << pos1 << "] = " << varName << ";\r\n";
-				break;
-			case 'W':
-				glueVars << "\tint_input[" << pos1 << "] = " << varName << ";\r\n";
-				break;
+			glueVars << "\t{";
+			if (slotsUnused(tables, table, row * 8))
+			{
+				glueVars << "__MB_SLOTS(" << table_fallbacks[table] << ", " << row * 8 << ")";
+			}
+			else
+			{
+				for (int bit = 0; bit < 8; bit++)
+				{
+					if (bit) glueVars << ", ";
+					printSlot(glueVars, tables, table, row * 8 + bit);
+				}
+			}
+			glueVars << "},\r\n";
 		}
-	}
-	else if (varName[2] == 'Q')
-	{
-		//OUTPUT
-		switch (varName[3])
+		else if (has_fallback && row % 8 == 0 && slotsUnused(tables, table, row))
 		{
-			case 'X':
-				glueVars << "\tbool_output[" << pos1 << "][" << pos2 << "] = " << varName << ";\r\n";
-				break;
-           	case 'B':
-				glueVars << "\tbyte_output[" << pos1 << "] = " << varName << ";\r\n";
-				break;
-			case 'W':
-				glueVars << "\tint_output[" << pos1 << "] = " << varName << ";\r\n";
-				break;
+			glueVars << "\t__MB_SLOTS(" << table_fallbacks[table] << ", " << table_fallback_offsets[table] + row << "),\r\n";
+			row += 7;
+		}
+		else
+		{
+			glueVars << "\t";
+			printSlot(glueVars, tables, table, row);
+			glueVars << ",\r\n";
 		}
 	}
-	else if (varName[2] == 'M')
+	glueVars << "};\r\n";
+}
+
+/// Writes the address to type map. Entries are sorted by area, size and
+/// address so the protocol servers can search it.
+void generateAddressMap(ostream& glueVars, const GlueTables& tables)
+{
+	static const char areas[] = {'I', 'Q', 'M'};
+	static const char sizes[] = {'X', 'B', 'W', 'D', 'L'};
+
+	glueVars << "//Located variables map. Describes the IEC type of every located address\r\n";
+	glueVars << "extern const struct located_address located_address_map[] = {\r\n";
+
+	vector<const LocatedVar *> sorted;
+	for (int a = 0; a < 3; a++)
 	{
-		//MEMORY
-		switch (varName[3])
+		for (int s = 0; s < 5; s++)
 		{
-			case 'W':
-				glueVars << "\tint_memory[" << pos1 << "] = " << varName << ";\r\n";
-				break;
-			case 'D':
-				glueVars << "\tdint_memory[" << pos1 << "] = (IEC_DINT *)" << varName << ";\r\n";
-				break;
-			case 'L':
-				if (pos1 > 1023)
-					glueVars << "\tspecial_functions[" << (pos1-1024) << "] = (IEC_LINT *)" << varName << ";\r\n";
-				else
-					glueVars << "\tlint_memory[" << pos1 << "] = (IEC_LINT *)" << varName << ";\r\n";
-				break;
+			size_t first = sorted.size();
+			for (size_t i = 0; i < tables.vars.size(); i++)
+			{
+				if (tables.vars[i].area == areas[a] && tables.vars[i].size == sizes[s])
+					sorted.push_back(&tables.vars[i]);
+			}
+			// Insertion sort on the address. Each group is usually small and
+			// mostly sorted already, as MATIEC lists variables in address order.
+			for (size_t i = first + 1; i < sorted.size(); i++)
+			{
+				const LocatedVar *key = sorted[i];
+				size_t j = i;
+				while (j > first && (sorted[j-1]->pos1 > key->pos1 ||
+				       (sorted[j-1]->pos1 == key->pos1 && sorted[j-1]->pos2 > key->pos2)))
+				{
+					sorted[j] = sorted[j-1];
+					j--;
+				}
+				sorted[j] = key;
+			}
 		}
 	}
+
+	for (size_t i = 0; i < sorted.size(); i++)
+	{
+		glueVars << "\t{'" << sorted[i]->area << "', '" << sorted[i]->size << "', " << sorted[i]->pos1
+		         << ", " << sorted[i]->pos2 << ", \"" << sorted[i]->type << "\"},\r\n";
+	}
+	if (sorted.empty())
+		glueVars << "\t{0, 0, 0, 0, NULL},\r\n";
+
+	glueVars << "};\r\n";
+	glueVars << "extern const int located_address_count = " << sorted.size() << ";\r\n\r\n";
 }
 
 void generateBottom(ostream& glueVars)
 {
-	glueVars << "}\r\n\
-\r\n\
-void updateTime()\r\n\
+	glueVars << "void glueVars()\r\n\
 {\r\n\
-	__CURRENT_TIME.tv_nsec += common_ticktime__;\r\n\
-\r\n\
-	if (__CURRENT_TIME.tv_nsec >= 1000000000)\r\n\
-	{\r\n\
-		__CURRENT_TIME.tv_nsec -= 1000000000;\r\n\
-		__CURRENT_TIME.tv_sec += 1;\r\n\
-	}\r\n\
+	//The buffers are statically initialised above. Nothing to do at runtime\r\n\
 }";
 }
 
-void generateBody(istream& locatedVars, ostream& glueVars) {
-    // Start the generation process.
-    char iecVar_name[100];
-    char iecVar_type[100];
+/// Parses the located variables and writes the statically initialised tables
+/// and the address map. Returns the number of addressing errors found; the
+/// output must not be used if it is not zero.
+int generateBody(istream& locatedVars, ostream& glueVars, ostream& errors = cout)
+{
+	GlueTables tables;
+	int num_errors = parseLocatedVars(locatedVars, tables, errors);
+	if (num_errors > 0) return num_errors;
+
+	glueVars << "//Booleans\r\n";
+	generateTable(glueVars, tables, BOOL_INPUT);
+	generateTable(glueVars, tables, BOOL_OUTPUT);
+	glueVars << "\r\n//Bytes\r\n";
+	generateTable(glueVars, tables, BYTE_INPUT);
+	generateTable(glueVars, tables, BYTE_OUTPUT);
+	glueVars << "\r\n//Analog I/O\r\n";
+	generateTable(glueVars, tables, INT_INPUT);
+	generateTable(glueVars, tables, INT_OUTPUT);
+	glueVars << "\r\n//Memory\r\n";
+	generateTable(glueVars, tables, INT_MEMORY);
+	generateTable(glueVars, tables, DINT_MEMORY);
+	generateTable(glueVars, tables, LINT_MEMORY);
+	glueVars << "\r\n//Special Functions\r\n";
+	generateTable(glueVars, tables, SPECIAL_FUNCTIONS);
+	glueVars << "\r\n";
+
+	generateAddressMap(glueVars, tables);
 
-    while (parseIecVars(locatedVars, iecVar_name, iecVar_type))
-    {
-        glueVar(glueVars, iecVar_name, iecVar_type);
-    }
+	return 0;
 }
 
 /// This is our main function. We define it with a different name and then
@@ -269,12 +525,21 @@ int mainImpl(int argc, char *argv[])
 		output_file_name = argv[2];
 	}
 
-	// Try to open the files for reading and writing.
+	// Parse and validate the located variables before touching the output, so
+	// that a previous glueVars.cpp is never replaced by a broken one.
 	ifstream locatedVars(input_file_name, ios::in);
 	if (!locatedVars.is_open()) {
         cout << "Error opening located variables file at " << input_file_name << endl;
 		return 1;
 	}
+
+	stringstream body;
+	int num_errors = generateBody(locatedVars, body);
+	if (num_errors > 0) {
+		cout << num_errors << " addressing error(s) found on located variables. " << output_file_name << " was not generated" << endl;
+		return 3;
+	}
+
 	ofstream glueVars(output_file_name, ios::trunc);
 	if (!glueVars.is_open()) {
 		cout << "Error opening glue variables file at " << output_file_name << endl;
@@ -282,7 +547,7 @@ int mainImpl(int argc, char *argv[])
 	}
 
     generateHeader(glueVars);
-    generateBody(locatedVars, glueVars);
+    glueVars << body.str();
 	generateBottom(glueVars);
 
 	return 0;
@@ -28,88 +28,171 @@ SCENARIO("Commmand line", "[main]") {
 SCENARIO("", "") {
     GIVEN("IO as streams") {
         std::stringstream output_stream;
+        std::stringstream error_stream;
         WHEN("Contains single BOOL at %IX0") {
             std::stringstream input_stream("__LOCATED_VAR(BOOL,__IX0,I,X,0)");
-            generateBody(input_stream, output_stream);
-            REQUIRE(output_stream.str() == "\tbool_input[0][0] = __IX0;\r\n");
+            REQUIRE(generateBody(input_stream, output_stream, error_stream) == 0);
+            REQUIRE(output_stream.str().find("extern IEC_BOOL *const bool_input[BUFFER_SIZE][8] = {\r\n\t{&____IX0, &mb_discrete_input[1], &mb_discrete_input[2], &mb_discrete_input[3], &mb_discrete_input[4], &mb_discrete_input[5], &mb_discrete_input[6], &mb_discrete_input[7]},\r\n\t{__MB_SLOTS(mb_discrete_input, 8)},\r\n") != string::npos);
         }
 
         WHEN("Contains single BOOL at %QX0") {
             std::stringstream input_stream("__LOCATED_VAR(BOOL,__QX0,Q,X,0)");
-            generateBody(input_stream, output_stream);
-            REQUIRE(output_stream.str() == "\tbool_output[0][0] = __QX0;\r\n");
+            REQUIRE(generateBody(input_stream, output_stream, error_stream) == 0);
+            REQUIRE(output_stream.str().find("extern IEC_BOOL *const bool_output[BUFFER_SIZE][8] = {\r\n\t{&____QX0, &mb_coils[1], &mb_coils[2], &mb_coils[3], &mb_coils[4], &mb_coils[5], &mb_coils[6], &mb_coils[7]},\r\n") != string::npos);
+        }
+
+        WHEN("Contains single BOOL at %QX0.2") {
+            std::stringstream input_stream("__LOCATED_VAR(BOOL,__QX0_2,Q,X,0,2)");
+            REQUIRE(generateBody(input_stream, output_stream, error_stream) == 0);
+            REQUIRE(output_stream.str().find("extern IEC_BOOL *const bool_output[BUFFER_SIZE][8] = {\r\n\t{&mb_coils[0], &mb_coils[1], &____QX0_2, &mb_coils[3], &mb_coils[4], &mb_coils[5], &mb_coils[6], &mb_coils[7]},\r\n") != string::npos);
         }
 
         WHEN("Contains single BYTE at %IB0") {
             std::stringstream input_stream("__LOCATED_VAR(BYTE,__IB0,I,B,0)");
-            generateBody(input_stream, output_stream);
-            REQUIRE(output_stream.str() == "\tbyte_input[0] = __IB0;\r\n");
+            REQUIRE(generateBody(input_stream, output_stream, error_stream) == 0);
+            REQUIRE(output_stream.str().find("extern IEC_BYTE *const byte_input[BUFFER_SIZE] = {\r\n\t&____IB0,\r\n};") != string::npos);
         }
 
         WHEN("Contains single SINT at %IB1") {
             std::stringstream input_stream("__LOCATED_VAR(SINT,__IB1,I,B,1)");
-            generateBody(input_stream, output_stream);
-            REQUIRE(output_stream.str() == "\tbyte_input[1] = __IB1;\r\n");
+            REQUIRE(generateBody(input_stream, output_stream, error_stream) == 0);
+            REQUIRE(output_stream.str().find("extern IEC_BYTE *const byte_input[BUFFER_SIZE] = {\r\n\tNULL,\r\n\t&____IB1,\r\n};") != string::npos);
         }
 
         WHEN("Contains single SINT at %QB1") {
             std::stringstream input_stream("__LOCATED_VAR(SINT,__QB1,Q,B,1)");
-            generateBody(input_stream, output_stream);
-            REQUIRE(output_stream.str() == "\tbyte_output[1] = __QB1;\r\n");
+            REQUIRE(generateBody(input_stream, output_stream, error_stream) == 0);
+            REQUIRE(output_stream.str().find("extern IEC_BYTE *const byte_output[BUFFER_SIZE] = {\r\n\tNULL,\r\n\t&____QB1,\r\n};") != string::npos);
         }
 
         WHEN("Contains single USINT at %IB2") {
             std::stringstream input_stream("__LOCATED_VAR(USINT,__IB2,I,B,2)");
-            generateBody(input_stream, output_stream);
-            REQUIRE(output_stream.str() == "\tbyte_input[2] = __IB2;\r\n");
+            REQUIRE(generateBody(input_stream, output_stream, error_stream) == 0);
+            REQUIRE(output_stream.str().find("extern IEC_BYTE *const byte_input[BUFFER_SIZE] = {\r\n\tNULL,\r\n\tNULL,\r\n\t&____IB2,\r\n};") != string::npos);
         }
 
         WHEN("Contains single WORD at %IW0") {
             std::stringstream input_stream("__LOCATED_VAR(WORD,__IW0,I,W,0)");
-            generateBody(input_stream, output_stream);
-            REQUIRE(output_stream.str() == "\tint_input[0] = __IW0;\r\n");
+            REQUIRE(generateBody(input_stream, output_stream, error_stream) == 0);
+            REQUIRE(output_stream.str().find("extern IEC_UINT *const int_input[BUFFER_SIZE] = {\r\n\t&____IW0,\r\n\t&mb_input_regs[1],\r\n") != string::npos);
+            REQUIRE(output_stream.str().find("\t&mb_input_regs[7],\r\n\t__MB_SLOTS(mb_input_regs, 8),\r\n") != string::npos);
         }
 
         WHEN("Contains single WORD at %QW0") {
             std::stringstream input_stream("__LOCATED_VAR(WORD,__QW0,Q,W,0)");
-            generateBody(input_stream, output_stream);
-            REQUIRE(output_stream.str() == "\tint_output[0] = __QW0;\r\n");
+            REQUIRE(generateBody(input_stream, output_stream, error_stream) == 0);
+            REQUIRE(output_stream.str().find("extern IEC_UINT *const int_output[BUFFER_SIZE] = {\r\n\t&____QW0,\r\n\t&mb_holding_regs[1],\r\n") != string::npos);
         }
 
         WHEN("Contains single INT at %IW1") {
             std::stringstream input_stream("__LOCATED_VAR(INT,__IW1,I,W,1)");
-            generateBody(input_stream, output_stream);
-            REQUIRE(output_stream.str() == "\tint_input[1] = __IW1;\r\n");
+            REQUIRE(generateBody(input_stream, output_stream, error_stream) == 0);
+            REQUIRE(output_stream.str().find("extern IEC_UINT *const int_input[BUFFER_SIZE] = {\r\n\t&mb_input_regs[0],\r\n\t&____IW1,\r\n\t&mb_input_regs[2],\r\n") != string::npos);
         }
 
         WHEN("Contains single UINT at %IW2") {
             std::stringstream input_stream("__LOCATED_VAR(UINT,__IW2,I,W,2)");
-            generateBody(input_stream, output_stream);
-            REQUIRE(output_stream.str() == "\tint_input[2] = __IW2;\r\n");
+            REQUIRE(generateBody(input_stream, output_stream, error_stream) == 0);
+            REQUIRE(output_stream.str().find("extern IEC_UINT *const int_input[BUFFER_SIZE] = {\r\n\t&mb_input_regs[0],\r\n\t&mb_input_regs[1],\r\n\t&____IW2,\r\n\t&mb_input_regs[3],\r\n") != string::npos);
+        }
+
+        WHEN("Contains single INT at %QW0") {
+            std::stringstream input_stream("__LOCATED_VAR(INT,__QW0,Q,W,0)");
+            REQUIRE(generateBody(input_stream, output_stream, error_stream) == 0);
+            REQUIRE(output_stream.str().find("extern IEC_UINT *const int_output[BUFFER_SIZE] = {\r\n\t&____QW0,\r\n") != string::npos);
         }
 
         WHEN("Contains single INT at %MW2") {
             std::stringstream input_stream("__LOCATED_VAR(INT,__MW2,M,W,2)");
-            generateBody(input_stream, output_stream);
-            REQUIRE(output_stream.str() == "\tint_memory[2] = __MW2;\r\n");
+            REQUIRE(generateBody(input_stream, output_stream, error_stream) == 0);
+            REQUIRE(output_stream.str().find("extern IEC_UINT *const int_memory[BUFFER_SIZE] = {\r\n\t&mb_holding_regs[1024],\r\n\t&mb_holding_regs[1025],\r\n\t&____MW2,\r\n\t&mb_holding_regs[1027],\r\n") != string::npos);
+            REQUIRE(output_stream.str().find("\t__MB_SLOTS(mb_holding_regs, 1032),\r\n") != string::npos);
         }
 
         WHEN("Contains single DWORD at %MD0") {
-            std::stringstream input_stream("__LOCATED_VAR(DWORD,__MD2,M,D,2)");
-            generateBody(input_stream, output_stream);
-            REQUIRE(output_stream.str() == "\tdint_memory[2] = (IEC_DINT *)__MD2;\r\n");
+            std::stringstream input_stream("__LOCATED_VAR(DWORD,__MD0,M,D,0)");
+            REQUIRE(generateBody(input_stream, output_stream, error_stream) == 0);
+            REQUIRE(output_stream.str().find("extern IEC_DINT *const dint_memory[BUFFER_SIZE] = {\r\n\t(IEC_DINT *)&____MD0,\r\n};") != string::npos);
+        }
+
+        WHEN("Contains single LINT at %ML0") {
+            std::stringstream input_stream("__LOCATED_VAR(LINT,__ML0,M,L,0)");
+            REQUIRE(generateBody(input_stream, output_stream, error_stream) == 0);
+            REQUIRE(output_stream.str().find("extern IEC_LINT *const lint_memory[BUFFER_SIZE] = {\r\n\t(IEC_LINT *)&____ML0,\r\n};") != string::npos);
         }
 
         WHEN("Contains single LINT at %ML1") {
-             std::stringstream input_stream("__LOCATED_VAR(LINT,__ML1,M,L,1)");
-             generateBody(input_stream, output_stream);
-            REQUIRE(output_stream.str() == "\tlint_memory[1] = (IEC_LINT *)__ML1;\r\n");
+            std::stringstream input_stream("__LOCATED_VAR(LINT,__ML1,M,L,1)");
+            REQUIRE(generateBody(input_stream, output_stream, error_stream) == 0);
+            REQUIRE(output_stream.str().find("extern IEC_LINT *const lint_memory[BUFFER_SIZE] = {\r\n\tNULL,\r\n\t(IEC_LINT *)&____ML1,\r\n};") != string::npos);
         }
 
         WHEN("Contains single LINT at %ML1024") {
             std::stringstream input_stream("__LOCATED_VAR(LINT,__ML1024,M,L,1024)");
-            generateBody(input_stream, output_stream);
-            REQUIRE(output_stream.str() == "\tspecial_functions[0] = (IEC_LINT *)__ML1024;\r\n");
+            REQUIRE(generateBody(input_stream, output_stream, error_stream) == 0);
+            REQUIRE(output_stream.str().find("extern IEC_LINT *const special_functions[BUFFER_SIZE] = {\r\n\t(IEC_LINT *)&____ML1024,\r\n};") != string::npos);
+        }
+
+        WHEN("Unused tables are empty or point to the Modbus buffers") {
+            std::stringstream input_stream("__LOCATED_VAR(BOOL,__IX0,I,X,0)");
+            REQUIRE(generateBody(input_stream, output_stream, error_stream) == 0);
+            REQUIRE(output_stream.str().find("extern IEC_DINT *const dint_memory[BUFFER_SIZE] = {};\r\n") != string::npos);
+            REQUIRE(output_stream.str().find("extern IEC_UINT *const int_input[BUFFER_SIZE] = {\r\n\t__MB_SLOTS(mb_input_regs, 0),\r\n") != string::npos);
+            REQUIRE(output_stream.str().find("\t__MB_SLOTS(mb_input_regs, 1016),\r\n};") != string::npos);
+            REQUIRE(output_stream.str().find("\t{__MB_SLOTS(mb_coils, 8184)},\r\n};") != string::npos);
+        }
+
+        WHEN("Uses the shared located_address definition") {
+            std::stringstream input_stream("__LOCATED_VAR(BOOL,__IX0,I,X,0)");
+            REQUIRE(generateBody(input_stream, output_stream, error_stream) == 0);
+            generateHeader(output_stream);
+            REQUIRE(output_stream.str().find("#include \"located_address.h\"\r\n") != string::npos);
+            REQUIRE(output_stream.str().find("struct located_address\r\n{") == string::npos);
+        }
+
+        WHEN("Contains variables out of address order") {
+            std::stringstream input_stream("__LOCATED_VAR(INT,__IW3,I,W,3)\n__LOCATED_VAR(BOOL,__IX1_1,I,X,1,1)\n__LOCATED_VAR(INT,__IW1,I,W,1)");
+            REQUIRE(generateBody(input_stream, output_stream, error_stream) == 0);
+            REQUIRE(output_stream.str().find("\t{'I', 'X', 1, 1, \"BOOL\"},\r\n\t{'I', 'W', 1, 0, \"INT\"},\r\n\t{'I', 'W', 3, 0, \"INT\"},\r\n};") != string::npos);
+            REQUIRE(output_stream.str().find("extern const int located_address_count = 3;") != string::npos);
+        }
+    }
+}
+
+SCENARIO("Addressing errors", "[validation]") {
+    GIVEN("IO as streams") {
+        std::stringstream output_stream;
+        std::stringstream error_stream;
+        WHEN("Bit index is above 7") {
+            std::stringstream input_stream("__LOCATED_VAR(BOOL,__IX0_8,I,X,0,8)");
+            REQUIRE(generateBody(input_stream, output_stream, error_stream) == 1);
+            REQUIRE(output_stream.str().empty());
+        }
+
+        WHEN("Address is out of the buffer range") {
+            std::stringstream input_stream("__LOCATED_VAR(INT,__QW1024,Q,W,1024)");
+            REQUIRE(generateBody(input_stream, output_stream, error_stream) == 1);
+        }
+
+        WHEN("Address is used twice") {
+            std::stringstream input_stream("__LOCATED_VAR(INT,__MW5,M,W,5)\n__LOCATED_VAR(UINT,__MW5,M,W,5)");
+            REQUIRE(generateBody(input_stream, output_stream, error_stream) == 1);
+            REQUIRE(error_stream.str().find("LOCATED_VARIABLES.h:2:") != string::npos);
+        }
+
+        WHEN("Type does not fit the location size") {
+            std::stringstream input_stream("__LOCATED_VAR(REAL,__IW0,I,W,0)");
+            REQUIRE(generateBody(input_stream, output_stream, error_stream) == 1);
+        }
+
+        WHEN("Location is not supported by the runtime") {
+            std::stringstream input_stream("__LOCATED_VAR(DINT,__ID0,I,D,0)");
+            REQUIRE(generateBody(input_stream, output_stream, error_stream) == 1);
+        }
+
+        WHEN("Every invalid line is reported") {
+            std::stringstream input_stream("__LOCATED_VAR(BOOL,__IX0_9,I,X,0,9)\n__LOCATED_VAR(INT,__IW0,I,W,0)\n__LOCATED_VAR(LINT,__ML2048,M,L,2048)");
+            REQUIRE(generateBody(input_stream, output_stream, error_stream) == 2);
         }
     }
 }
@@ -15,6 +15,9 @@
 	IEC_BYTE __IS_GLOBAL_##name##_FORCED(void) {\
 		return (*GLOBAL__##name).flags & __IEC_FORCE_FLAG;\
 	}\
+	IEC_BYTE* __GET_GLOBAL_##name##_FLAGS(void) {\
+		return &((*GLOBAL__##name).flags);\
+	}\
 	type* __GET_GLOBAL_##name(void) {\
 		return &((*GLOBAL__##name).value);\
 	}
@@ -36,13 +39,21 @@
 	IEC_BYTE __IS_GLOBAL_##name##_FORCED(void) {\
 		return (*GLOBAL__##name).flags & __IEC_FORCE_FLAG;\
 	}\
+	IEC_BYTE* __GET_GLOBAL_##name##_FLAGS(void) {\
+		return &((*GLOBAL__##name).flags);\
+	}\
 	type* __GET_GLOBAL_##name(void) {\
 		return (*GLOBAL__##name).value;\
 	}
 #define __DECLARE_GLOBAL_PROTOTYPE(type, name)\
-    extern type* __GET_GLOBAL_##name(void);
+    extern type* __GET_GLOBAL_##name(void);\
+    extern IEC_BYTE* __GET_GLOBAL_##name##_FLAGS(void);
+// An external also keeps a pointer to the flags of its global, so that a
+// write can see whether the global is forced without calling into the
+// configuration
 #define __DECLARE_EXTERNAL(type, name)\
-	__IEC_##type##_p name;
+	__IEC_##type##_p name;\
+	IEC_BYTE *name##__GLOBAL_FLAGS;
 #define __DECLARE_EXTERNAL_FB(type, name)\
 	type* name;
 #define __DECLARE_LOCATED(type, name)\
@@ -69,6 +80,7 @@
 #define __INIT_EXTERNAL(type, global, name, retained)\
     {\
 		name.value = __GET_GLOBAL_##global();\
+		name##__GLOBAL_FLAGS = __GET_GLOBAL_##global##_FLAGS();\
 		__INIT_RETAIN(name, retained)\
     }
 #define __INIT_EXTERNAL_FB(type, global, name, retained)\
@@ -125,12 +137,44 @@
 #define __SET_VAR(prefix, name, suffix, new_value)\
 	if (!(prefix name.flags & __IEC_FORCE_FLAG)) prefix name.value suffix = new_value
 #define __SET_EXTERNAL(prefix, name, suffix, new_value)\
-	{extern IEC_BYTE __IS_GLOBAL_##name##_FORCED();\
-    if (!(prefix name.flags & __IEC_FORCE_FLAG || __IS_GLOBAL_##name##_FORCED()))\
+	{if (!(prefix name.flags & __IEC_FORCE_FLAG || *(prefix name##__GLOBAL_FLAGS) & __IEC_FORCE_FLAG))\
 		(*(prefix name.value)) suffix = new_value;}
 #define __SET_EXTERNAL_FB(prefix, name, suffix, new_value)\
 	__SET_VAR((*(prefix name)), suffix, new_value)
 #define __SET_LOCATED(prefix, name, suffix, new_value)\
 	if (!(prefix name.flags & __IEC_FORCE_FLAG)) *(prefix name.value) suffix = new_value
 
+// Packed BOOL variables (iec2c option 'c'). The BOOLs of the VAR and VAR_TEMP
+// sections of a program or FB are stored one bit each, and iec2c refers to
+// them by their bit index. They have no flags of their own: the retain flag
+// is the same for the whole instance, and the forced ones are marked in a
+// bitmap that stays NULL until something forces one of them.
+#define __DECLARE_PACKED_BOOL(count)\
+	IEC_UDINT __packed_bool[((count) + 31) / 32];\
+	IEC_BYTE __packed_bool_flags;\
+	IEC_UDINT *__packed_bool_forced;
+#define __PACKED_BOOL_WORD(prefix, index)\
+	prefix __packed_bool[(index) >> 5]
+#define __PACKED_BOOL_MASK(index)\
+	((IEC_UDINT)1 << ((index) & 31))
+#define __INIT_PACKED_BOOLS(prefix, retained)\
+	{\
+		unsigned int __i;\
+		for (__i = 0; __i < sizeof(prefix __packed_bool) / sizeof(IEC_UDINT); __i++)\
+			prefix __packed_bool[__i] = 0;\
+		prefix __packed_bool_flags = retained?__IEC_RETAIN_FLAG:0;\
+		prefix __packed_bool_forced = NULL;\
+	}
+#define __INIT_PACKED_BOOL(prefix, index, initial)\
+	__PACKED_BOOL_WORD(prefix, index) = (initial) ?\
+		(__PACKED_BOOL_WORD(prefix, index) | __PACKED_BOOL_MASK(index)) :\
+		(__PACKED_BOOL_WORD(prefix, index) & ~__PACKED_BOOL_MASK(index));
+#define __GET_PACKED_BOOL(prefix, index)\
+	((BOOL)((__PACKED_BOOL_WORD(prefix, index) & __PACKED_BOOL_MASK(index)) != 0))
+#define __SET_PACKED_BOOL(prefix, index, new_value)\
+	if (!(prefix __packed_bool_forced && (prefix __packed_bool_forced[(index) >> 5] & __PACKED_BOOL_MASK(index))))\
+		__PACKED_BOOL_WORD(prefix, index) = (new_value) ?\
+			(__PACKED_BOOL_WORD(prefix, index) | __PACKED_BOOL_MASK(index)) :\
+			(__PACKED_BOOL_WORD(prefix, index) & ~__PACKED_BOOL_MASK(index))
+
 #endif //__ACCESSOR_H
@@ -0,0 +1,441 @@
+/*
+ * Copyright 2026 OpenPLC Project
+ *
+ * This file is part of the OpenPLC Software Stack.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/****
+ * Native implementation of the control function blocks declared in
+ * control_st.txt (PID_CTRL, LEAD_LAG and LPF).
+ *
+ * Unlike iec_std_FB.h this file is written by hand. The data part of each
+ * block follows the layout iec2c generates for the ST declaration, so the
+ * generated programs can instantiate and call the blocks as usual.
+ *
+ * PID_CTRL loops called with BATCH := TRUE are registered in a struct of
+ * arrays engine. Each call hands the new inputs to the engine and returns
+ * the output computed from the inputs of the previous call. The first call
+ * that finds its own slot still pending runs one pass over every pending
+ * loop, so all batched loops of a task are computed together in a single
+ * loop that the compiler can vectorise. The pass also computes the pending
+ * loops of slower tasks, from the inputs and CYCLE stored by their last
+ * call, so every loop is still computed exactly once per call, with the
+ * result it would have had at its next call.
+ ****/
+
+#ifndef _IEC_CONTROL_FB_H
+#define _IEC_CONTROL_FB_H
+
+#include <float.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifndef PID_BATCH_MAX_LOOPS
+#define PID_BATCH_MAX_LOOPS 1024
+#endif
+
+#if defined(__GNUC__) && !defined(__clang__)
+#define __CONTROL_VECTORISE __attribute__((optimize("O3")))
+#else
+#define __CONTROL_VECTORISE
+#endif
+
+// FUNCTION_BLOCK PID_CTRL
+// Data part
+typedef struct {
+  // FB Interface - IN, OUT, IN_OUT variables
+  __DECLARE_VAR(BOOL,EN)
+  __DECLARE_VAR(BOOL,ENO)
+  __DECLARE_VAR(BOOL,AUTO)
+  __DECLARE_VAR(REAL,PV)
+  __DECLARE_VAR(REAL,SP)
+  __DECLARE_VAR(REAL,X0)
+  __DECLARE_VAR(REAL,FF)
+  __DECLARE_VAR(REAL,KP)
+  __DECLARE_VAR(REAL,TR)
+  __DECLARE_VAR(REAL,TD)
+  __DECLARE_VAR(REAL,TF)
+  __DECLARE_VAR(REAL,YMIN)
+  __DECLARE_VAR(REAL,YMAX)
+  __DECLARE_VAR(TIME,CYCLE)
+  __DECLARE_VAR(BOOL,BATCH)
+  __DECLARE_VAR(REAL,XOUT)
+  __DECLARE_VAR(BOOL,SAT)
+
+  // FB private variables - TEMP, private and located variables
+  __DECLARE_VAR(REAL,ITERM)
+  __DECLARE_VAR(REAL,DTERM)
+  __DECLARE_VAR(REAL,PREV_PV)
+  __DECLARE_VAR(BOOL,FIRST)
+  __DECLARE_VAR(DINT,SLOT)
+  __DECLARE_VAR(REAL,TS)
+  __DECLARE_VAR(REAL,E)
+  __DECLARE_VAR(REAL,P)
+  __DECLARE_VAR(REAL,U)
+
+} PID_CTRL;
+
+// FUNCTION_BLOCK LEAD_LAG
+// Data part
+typedef struct {
+  // FB Interface - IN, OUT, IN_OUT variables
+  __DECLARE_VAR(BOOL,EN)
+  __DECLARE_VAR(BOOL,ENO)
+  __DECLARE_VAR(BOOL,RUN)
+  __DECLARE_VAR(REAL,XIN)
+  __DECLARE_VAR(REAL,GAIN)
+  __DECLARE_VAR(REAL,LEAD)
+  __DECLARE_VAR(REAL,LAG)
+  __DECLARE_VAR(TIME,CYCLE)
+  __DECLARE_VAR(REAL,XOUT)
+
+  // FB private variables - TEMP, private and located variables
+  __DECLARE_VAR(REAL,PREV_XIN)
+  __DECLARE_VAR(REAL,TS)
+
+} LEAD_LAG;
+
+// FUNCTION_BLOCK LPF
+// Data part
+typedef struct {
+  // FB Interface - IN, OUT, IN_OUT variables
+  __DECLARE_VAR(BOOL,EN)
+  __DECLARE_VAR(BOOL,ENO)
+  __DECLARE_VAR(BOOL,RUN)
+  __DECLARE_VAR(REAL,XIN)
+  __DECLARE_VAR(REAL,TF)
+  __DECLARE_VAR(TIME,CYCLE)
+  __DECLARE_VAR(REAL,XOUT)
+
+  // FB private variables - TEMP, private and located variables
+  __DECLARE_VAR(REAL,TS)
+
+} LPF;
+
+
+/* Struct of arrays holding every batched PID_CTRL loop. The coefficients
+ * that depend on CYCLE are computed when the inputs are handed over, so the
+ * pass itself is straight line code over the arrays.
+ */
+typedef struct {
+  int count;
+  REAL sp[PID_BATCH_MAX_LOOPS];
+  REAL pv[PID_BATCH_MAX_LOOPS];
+  REAL x0[PID_BATCH_MAX_LOOPS];
+  REAL ff[PID_BATCH_MAX_LOOPS];
+  REAL kp[PID_BATCH_MAX_LOOPS];
+  REAL ki_dt[PID_BATCH_MAX_LOOPS];  /* KP * TS / TR, 0 without integral term */
+  REAL kd_dt[PID_BATCH_MAX_LOOPS];  /* KP * TD / (TF + TS), 0 without derivative term */
+  REAL alpha[PID_BATCH_MAX_LOOPS];  /* TF / (TF + TS) */
+  REAL ymin[PID_BATCH_MAX_LOOPS];
+  REAL ymax[PID_BATCH_MAX_LOOPS];
+  REAL automode[PID_BATCH_MAX_LOOPS];
+  REAL pending[PID_BATCH_MAX_LOOPS];
+  REAL iterm[PID_BATCH_MAX_LOOPS];
+  REAL dterm[PID_BATCH_MAX_LOOPS];
+  REAL prev_pv[PID_BATCH_MAX_LOOPS];
+  REAL xout[PID_BATCH_MAX_LOOPS];
+  REAL sat[PID_BATCH_MAX_LOOPS];
+} PID_BATCH_ENGINE;
+
+static PID_BATCH_ENGINE __pid_batch;
+
+
+static inline REAL __control_cycle_seconds(TIME cycle) {
+  return (REAL)cycle.tv_sec + (REAL)cycle.tv_nsec / 1.0e9f;
+}
+
+/* Branch free select: returns a where mask is all ones and b where it is
+ * zero. Plain ?: selects keep the batch pass from being vectorised.
+ */
+static inline __CONTROL_VECTORISE REAL __control_select(uint32_t mask, REAL a, REAL b) {
+  uint32_t bits_a, bits_b;
+  memcpy(&bits_a, &a, sizeof(bits_a));
+  memcpy(&bits_b, &b, sizeof(bits_b));
+  bits_a = (bits_a & mask) | (bits_b & ~mask);
+  memcpy(&a, &bits_a, sizeof(a));
+  return a;
+}
+
+static inline __CONTROL_VECTORISE REAL __control_limit(REAL mn, REAL in, REAL mx) {
+  in = __control_select(-(uint32_t)(in > mx), mx, in);
+  return __control_select(-(uint32_t)(in < mn), mn, in);
+}
+
+/* Runs every pending loop of the batch engine. Loops that are not pending
+ * keep their state untouched.
+ */
+static __CONTROL_VECTORISE void __pid_batch_pass(PID_BATCH_ENGINE *engine) {
+  int count = engine->count;
+  int i;
+
+  for (i = 0; i < count; i++) {
+    uint32_t automode = -(uint32_t)(engine->automode[i] > 0.0f);
+    uint32_t run = -(uint32_t)(engine->pending[i] > 0.0f);
+    REAL e = engine->sp[i] - engine->pv[i];
+    REAL p = engine->kp[i] * e;
+    REAL d = engine->alpha[i] * engine->dterm[i] - engine->kd_dt[i] * (engine->pv[i] - engine->prev_pv[i]);
+    REAL bias = p + d + engine->ff[i];
+    REAL integral = __control_select(automode, engine->iterm[i] + engine->ki_dt[i] * e, engine->x0[i] - bias);
+    REAL high = engine->ymax[i] - bias;
+    REAL low = engine->ymin[i] - bias;
+    REAL u;
+    REAL saturated;
+
+    integral = __control_limit(low, integral, high);
+    u = bias + integral;
+    saturated = (REAL)((u >= engine->ymax[i]) | (u <= engine->ymin[i]));
+    u = __control_limit(engine->ymin[i], u, engine->ymax[i]);
+
+    engine->iterm[i] = __control_select(run, integral, engine->iterm[i]);
+    engine->dterm[i] = __control_select(run, d, engine->dterm[i]);
+    engine->prev_pv[i] = __control_select(run, engine->pv[i], engine->prev_pv[i]);
+    engine->xout[i] = __control_select(run, u, engine->xout[i]);
+    engine->sat[i] = __control_select(run, saturated, engine->sat[i]);
+    engine->pending[i] = 0.0f;
+  }
+}
+
+
+
+
+static void PID_CTRL_init__(PID_CTRL *data__, BOOL retain) {
+  __INIT_VAR(data__->EN,__BOOL_LITERAL(TRUE),retain)
+  __INIT_VAR(data__->ENO,__BOOL_LITERAL(TRUE),retain)
+  __INIT_VAR(data__->AUTO,__BOOL_LITERAL(FALSE),retain)
+  __INIT_VAR(data__->PV,0,retain)
+  __INIT_VAR(data__->SP,0,retain)
+  __INIT_VAR(data__->X0,0,retain)
+  __INIT_VAR(data__->FF,0,retain)
+  __INIT_VAR(data__->KP,0,retain)
+  __INIT_VAR(data__->TR,0,retain)
+  __INIT_VAR(data__->TD,0,retain)
+  __INIT_VAR(data__->TF,0,retain)
+  __INIT_VAR(data__->YMIN,0,retain)
+  __INIT_VAR(data__->YMAX,0,retain)
+  __INIT_VAR(data__->CYCLE,__time_to_timespec(1, 0, 0, 0, 0, 0),retain)
+  __INIT_VAR(data__->BATCH,__BOOL_LITERAL(FALSE),retain)
+  __INIT_VAR(data__->XOUT,0,retain)
+  __INIT_VAR(data__->SAT,__BOOL_LITERAL(FALSE),retain)
+  __INIT_VAR(data__->ITERM,0,retain)
+  __INIT_VAR(data__->DTERM,0,retain)
+  __INIT_VAR(data__->PREV_PV,0,retain)
+  __INIT_VAR(data__->FIRST,__BOOL_LITERAL(TRUE),retain)
+  __INIT_VAR(data__->SLOT,-1,retain)
+  __INIT_VAR(data__->TS,0,retain)
+  __INIT_VAR(data__->E,0,retain)
+  __INIT_VAR(data__->P,0,retain)
+  __INIT_VAR(data__->U,0,retain)
+}
+
+// Hands the inputs of a loop over to the batch engine and returns the
+// output of the previous pass
+static void PID_CTRL_batch__(PID_CTRL *data__) {
+  PID_BATCH_ENGINE *engine = &__pid_batch;
+  DINT slot = __GET_VAR(data__->SLOT,);
+
+  if (slot < 0) {
+    slot = engine->count++;
+    __SET_VAR(data__->,SLOT,,slot);
+    engine->iterm[slot] = __GET_VAR(data__->ITERM,);
+    engine->dterm[slot] = __GET_VAR(data__->DTERM,);
+    engine->prev_pv[slot] = __GET_VAR(data__->PV,);
+    engine->xout[slot] = __GET_VAR(data__->XOUT,);
+    engine->sat[slot] = 0.0f;
+    engine->pending[slot] = 0.0f;
+  }
+  else if (engine->pending[slot] > 0.0f) {
+    __pid_batch_pass(engine);
+  }
+
+  __SET_VAR(data__->,XOUT,,engine->xout[slot]);
+  __SET_VAR(data__->,SAT,,engine->sat[slot] > 0.0f);
+  __SET_VAR(data__->,ITERM,,engine->iterm[slot]);
+  __SET_VAR(data__->,DTERM,,engine->dterm[slot]);
+
+  REAL dt = __control_cycle_seconds(__GET_VAR(data__->CYCLE,));
+  REAL kp = __GET_VAR(data__->KP,);
+  REAL tr = __GET_VAR(data__->TR,);
+  REAL td = __GET_VAR(data__->TD,);
+  REAL tf = __GET_VAR(data__->TF,);
+  REAL ymin = __GET_VAR(data__->YMIN,);
+  REAL ymax = __GET_VAR(data__->YMAX,);
+  int derivative = (td > 0.0f && dt > 0.0f);
+
+  engine->sp[slot] = __GET_VAR(data__->SP,);
+  engine->pv[slot] = __GET_VAR(data__->PV,);
+  engine->x0[slot] = __GET_VAR(data__->X0,);
+  engine->ff[slot] = __GET_VAR(data__->FF,);
+  engine->kp[slot] = kp;
+  engine->ki_dt[slot] = (tr > 0.0f) ? kp * dt / tr : 0.0f;
+  engine->kd_dt[slot] = derivative ? kp * td / (tf + dt) : 0.0f;
+  engine->alpha[slot] = derivative ? tf / (tf + dt) : 0.0f;
+  engine->ymin[slot] = (ymax > ymin) ? ymin : -FLT_MAX;
+  engine->ymax[slot] = (ymax > ymin) ? ymax : FLT_MAX;
+  engine->automode[slot] = __GET_VAR(data__->AUTO,) ? 1.0f : 0.0f;
+  engine->pending[slot] = 1.0f;
+}
+
+// Code part
+static void PID_CTRL_body__(PID_CTRL *data__) {
+  // Control execution
+  if (!__GET_VAR(data__->EN)) {
+    __SET_VAR(data__->,ENO,,__BOOL_LITERAL(FALSE));
+    return;
+  }
+  else {
+    __SET_VAR(data__->,ENO,,__BOOL_LITERAL(TRUE));
+  }
+
+  if (__GET_VAR(data__->BATCH,) && (__GET_VAR(data__->SLOT,) >= 0 || __pid_batch.count < PID_BATCH_MAX_LOOPS)) {
+    PID_CTRL_batch__(data__);
+    return;
+  }
+
+  __SET_VAR(data__->,TS,,__control_cycle_seconds(__GET_VAR(data__->CYCLE,)));
+  if (__GET_VAR(data__->FIRST,)) {
+    __SET_VAR(data__->,PREV_PV,,__GET_VAR(data__->PV,));
+    __SET_VAR(data__->,FIRST,,__BOOL_LITERAL(FALSE));
+  }
+  __SET_VAR(data__->,E,,(__GET_VAR(data__->SP,) - __GET_VAR(data__->PV,)));
+  __SET_VAR(data__->,P,,(__GET_VAR(data__->KP,) * __GET_VAR(data__->E,)));
+  if (__GET_VAR(data__->TD,) > 0.0 && __GET_VAR(data__->TS,) > 0.0) {
+    __SET_VAR(data__->,DTERM,,((__GET_VAR(data__->TF,) * __GET_VAR(data__->DTERM,)) - (__GET_VAR(data__->KP,) * __GET_VAR(data__->TD,) * (__GET_VAR(data__->PV,) - __GET_VAR(data__->PREV_PV,)))) / (__GET_VAR(data__->TF,) + __GET_VAR(data__->TS,)));
+  } else {
+    __SET_VAR(data__->,DTERM,,0.0);
+  }
+
+  REAL bias = __GET_VAR(data__->P,) + __GET_VAR(data__->DTERM,) + __GET_VAR(data__->FF,);
+  if (!__GET_VAR(data__->AUTO,)) {
+    __SET_VAR(data__->,ITERM,,(__GET_VAR(data__->X0,) - bias));
+  } else if (__GET_VAR(data__->TR,) > 0.0) {
+    __SET_VAR(data__->,ITERM,,(__GET_VAR(data__->ITERM,) + (__GET_VAR(data__->KP,) * __GET_VAR(data__->TS,) / __GET_VAR(data__->TR,) * __GET_VAR(data__->E,))));
+  }
+
+  __SET_VAR(data__->,SAT,,__BOOL_LITERAL(FALSE));
+  if (__GET_VAR(data__->YMAX,) > __GET_VAR(data__->YMIN,)) {
+    __SET_VAR(data__->,ITERM,,__control_limit(__GET_VAR(data__->YMIN,) - bias, __GET_VAR(data__->ITERM,), __GET_VAR(data__->YMAX,) - bias));
+    __SET_VAR(data__->,U,,(bias + __GET_VAR(data__->ITERM,)));
+    __SET_VAR(data__->,SAT,,(__GET_VAR(data__->U,) >= __GET_VAR(data__->YMAX,) || __GET_VAR(data__->U,) <= __GET_VAR(data__->YMIN,)));
+    __SET_VAR(data__->,U,,__control_limit(__GET_VAR(data__->YMIN,), __GET_VAR(data__->U,), __GET_VAR(data__->YMAX,)));
+  } else {
+    __SET_VAR(data__->,U,,(bias + __GET_VAR(data__->ITERM,)));
+  }
+  __SET_VAR(data__->,XOUT,,__GET_VAR(data__->U,));
+  __SET_VAR(data__->,PREV_PV,,__GET_VAR(data__->PV,));
+
+  // A loop that left the batch engine keeps its slot up to date, so it can
+  // rejoin without a bump
+  if (__GET_VAR(data__->SLOT,) >= 0) {
+    DINT slot = __GET_VAR(data__->SLOT,);
+    __pid_batch.iterm[slot] = __GET_VAR(data__->ITERM,);
+    __pid_batch.dterm[slot] = __GET_VAR(data__->DTERM,);
+    __pid_batch.prev_pv[slot] = __GET_VAR(data__->PV,);
+    __pid_batch.xout[slot] = __GET_VAR(data__->XOUT,);
+    __pid_batch.sat[slot] = __GET_VAR(data__->SAT,) ? 1.0f : 0.0f;
+    __pid_batch.pending[slot] = 0.0f;
+  }
+
+  goto __end;
+
+__end:
+  return;
+} // PID_CTRL_body__()
+
+
+
+
+
+static void LEAD_LAG_init__(LEAD_LAG *data__, BOOL retain) {
+  __INIT_VAR(data__->EN,__BOOL_LITERAL(TRUE),retain)
+  __INIT_VAR(data__->ENO,__BOOL_LITERAL(TRUE),retain)
+  __INIT_VAR(data__->RUN,__BOOL_LITERAL(FALSE),retain)
+  __INIT_VAR(data__->XIN,0,retain)
+  __INIT_VAR(data__->GAIN,0,retain)
+  __INIT_VAR(data__->LEAD,0,retain)
+  __INIT_VAR(data__->LAG,0,retain)
+  __INIT_VAR(data__->CYCLE,__time_to_timespec(1, 0, 0, 0, 0, 0),retain)
+  __INIT_VAR(data__->XOUT,0,retain)
+  __INIT_VAR(data__->PREV_XIN,0,retain)
+  __INIT_VAR(data__->TS,0,retain)
+}
+
+// Code part
+static void LEAD_LAG_body__(LEAD_LAG *data__) {
+  // Control execution
+  if (!__GET_VAR(data__->EN)) {
+    __SET_VAR(data__->,ENO,,__BOOL_LITERAL(FALSE));
+    return;
+  }
+  else {
+    __SET_VAR(data__->,ENO,,__BOOL_LITERAL(TRUE));
+  }
+
+  __SET_VAR(data__->,TS,,__control_cycle_seconds(__GET_VAR(data__->CYCLE,)));
+  if (__GET_VAR(data__->RUN,) && (__GET_VAR(data__->LAG,) + __GET_VAR(data__->TS,)) > 0.0) {
+    __SET_VAR(data__->,XOUT,,(((__GET_VAR(data__->LAG,) * __GET_VAR(data__->XOUT,)) + (__GET_VAR(data__->GAIN,) * (((__GET_VAR(data__->LEAD,) + __GET_VAR(data__->TS,)) * __GET_VAR(data__->XIN,)) - (__GET_VAR(data__->LEAD,) * __GET_VAR(data__->PREV_XIN,))))) / (__GET_VAR(data__->LAG,) + __GET_VAR(data__->TS,))));
+  } else {
+    __SET_VAR(data__->,XOUT,,(__GET_VAR(data__->GAIN,) * __GET_VAR(data__->XIN,)));
+  }
+  __SET_VAR(data__->,PREV_XIN,,__GET_VAR(data__->XIN,));
+
+  goto __end;
+
+__end:
+  return;
+} // LEAD_LAG_body__()
+
+
+
+
+
+static void LPF_init__(LPF *data__, BOOL retain) {
+  __INIT_VAR(data__->EN,__BOOL_LITERAL(TRUE),retain)
+  __INIT_VAR(data__->ENO,__BOOL_LITERAL(TRUE),retain)
+  __INIT_VAR(data__->RUN,__BOOL_LITERAL(FALSE),retain)
+  __INIT_VAR(data__->XIN,0,retain)
+  __INIT_VAR(data__->TF,0,retain)
+  __INIT_VAR(data__->CYCLE,__time_to_timespec(1, 0, 0, 0, 0, 0),retain)
+  __INIT_VAR(data__->XOUT,0,retain)
+  __INIT_VAR(data__->TS,0,retain)
+}
+
+// Code part
+static void LPF_body__(LPF *data__) {
+  // Control execution
+  if (!__GET_VAR(data__->EN)) {
+    __SET_VAR(data__->,ENO,,__BOOL_LITERAL(FALSE));
+    return;
+  }
+  else {
+    __SET_VAR(data__->,ENO,,__BOOL_LITERAL(TRUE));
+  }
+
+  __SET_VAR(data__->,TS,,__control_cycle_seconds(__GET_VAR(data__->CYCLE,)));
+  if (__GET_VAR(data__->RUN,) && (__GET_VAR(data__->TF,) + __GET_VAR(data__->TS,)) > 0.0) {
+    __SET_VAR(data__->,XOUT,,(__GET_VAR(data__->XOUT,) + ((__GET_VAR(data__->XIN,) - __GET_VAR(data__->XOUT,)) * __GET_VAR(data__->TS,) / (__GET_VAR(data__->TF,) + __GET_VAR(data__->TS,)))));
+  } else {
+    __SET_VAR(data__->,XOUT,,__GET_VAR(data__->XIN,));
+  }
+
+  goto __end;
+
+__end:
+  return;
+} // LPF_body__()
+
+
+#endif //_IEC_CONTROL_FB_H
@@ -12,6 +12,7 @@
  *          - to change the function prototypes to become 'static'.
  *             e.g.:   static void R_TRIG_init__(...)
  *                     ^^^^^^
+ *          - to add the __TIMER_WHEEL sections of TP, TON and TOF (see timer_wheel.h)
  * 
  * NOTE: If the structure of the C code generated by iec2c (matiec) should change, then this C 'library'
  *       file will need to be recompiled. 
@@ -384,6 +385,10 @@ typedef struct {
   __DECLARE_VAR(TIME,CURRENT_TIME)
   __DECLARE_VAR(TIME,START_TIME)
 
+#ifdef __TIMER_WHEEL
+  __timer_wheel_entry_t WHEEL;
+#endif
+
 } TP;
 
 // FUNCTION_BLOCK TON
@@ -403,6 +408,10 @@ typedef struct {
   __DECLARE_VAR(TIME,CURRENT_TIME)
   __DECLARE_VAR(TIME,START_TIME)
 
+#ifdef __TIMER_WHEEL
+  __timer_wheel_entry_t WHEEL;
+#endif
+
 } TON;
 
 // FUNCTION_BLOCK TOF
@@ -422,6 +431,10 @@ typedef struct {
   __DECLARE_VAR(TIME,CURRENT_TIME)
   __DECLARE_VAR(TIME,START_TIME)
 
+#ifdef __TIMER_WHEEL
+  __timer_wheel_entry_t WHEEL;
+#endif
+
 } TOF;
 
 // FUNCTION_BLOCK DERIVATIVE
@@ -1406,6 +1419,9 @@ static void TP_init__(TP *data__, BOOL retain) {
   __INIT_VAR(data__->PREV_IN,__BOOL_LITERAL(FALSE),retain)
   __INIT_VAR(data__->CURRENT_TIME,__time_to_timespec(1, 0, 0, 0, 0, 0),retain)
   __INIT_VAR(data__->START_TIME,__time_to_timespec(1, 0, 0, 0, 0, 0),retain)
+#ifdef __TIMER_WHEEL
+  __timer_wheel_init(&data__->WHEEL);
+#endif
 }
 
 // Code part
@@ -1419,6 +1435,31 @@ static void TP_body__(TP *data__) {
     __SET_VAR(data__->,ENO,,__BOOL_LITERAL(TRUE));
   }
   // Initialise TEMP variables
+#ifdef __TIMER_WHEEL
+  // runtime backed timer (timer_wheel.h): the runtime sets the expiry
+  if ((((__GET_VAR(data__->STATE,) == 0) && !(__GET_VAR(data__->PREV_IN,))) && __GET_VAR(data__->IN,))) {
+    __SET_VAR(data__->,STATE,,1);
+    __SET_VAR(data__->,Q,,__BOOL_LITERAL(TRUE));
+    __SET_VAR(data__->,START_TIME,,__CURRENT_TIME);
+    __timer_wheel_arm(&data__->WHEEL, __CURRENT_TIME, __GET_VAR(data__->PT,));
+  } else if ((__GET_VAR(data__->STATE,) == 1)) {
+    if (__timer_wheel_expired(&data__->WHEEL, __GET_VAR(data__->PT,))) {
+      __SET_VAR(data__->,STATE,,2);
+      __SET_VAR(data__->,Q,,__BOOL_LITERAL(FALSE));
+      __SET_VAR(data__->,ET,,__GET_VAR(data__->PT,));
+    } else {
+      __SET_VAR(data__->,ET,,__time_sub(__CURRENT_TIME, __GET_VAR(data__->START_TIME,)));
+    };
+  };
+  if (((__GET_VAR(data__->STATE,) == 2) && !(__GET_VAR(data__->IN,)))) {
+    __SET_VAR(data__->,ET,,__time_to_timespec(1, 0, 0, 0, 0, 0));
+    __SET_VAR(data__->,STATE,,0);
+  };
+  __SET_VAR(data__->,PREV_IN,,__GET_VAR(data__->IN,));
+
+  goto __end;
+#endif
+
 
   #define GetFbVar(var,...) __GET_VAR(data__->var,__VA_ARGS__)
   #define SetFbVar(var,val,...) __SET_VAR(data__->,var,__VA_ARGS__,val)
@@ -1445,6 +1486,10 @@ __SET_VAR(data__->,CURRENT_TIME,,__CURRENT_TIME)
   };
   __SET_VAR(data__->,PREV_IN,,__GET_VAR(data__->IN,));
 
+  if ((__GET_VAR(data__->STATE,) == 1)) {
+    __timer_deadline_hint(__time_add(__GET_VAR(data__->START_TIME,), __GET_VAR(data__->PT,)));
+  };
+
   goto __end;
 
 __end:
@@ -1466,6 +1511,9 @@ static void TON_init__(TON *data__, BOOL retain) {
   __INIT_VAR(data__->PREV_IN,__BOOL_LITERAL(FALSE),retain)
   __INIT_VAR(data__->CURRENT_TIME,__time_to_timespec(1, 0, 0, 0, 0, 0),retain)
   __INIT_VAR(data__->START_TIME,__time_to_timespec(1, 0, 0, 0, 0, 0),retain)
+#ifdef __TIMER_WHEEL
+  __timer_wheel_init(&data__->WHEEL);
+#endif
 }
 
 // Code part
@@ -1479,6 +1527,32 @@ static void TON_body__(TON *data__) {
     __SET_VAR(data__->,ENO,,__BOOL_LITERAL(TRUE));
   }
   // Initialise TEMP variables
+#ifdef __TIMER_WHEEL
+  // runtime backed timer (timer_wheel.h): the runtime sets the expiry
+  if ((((__GET_VAR(data__->STATE,) == 0) && !(__GET_VAR(data__->PREV_IN,))) && __GET_VAR(data__->IN,))) {
+    __SET_VAR(data__->,STATE,,1);
+    __SET_VAR(data__->,Q,,__BOOL_LITERAL(FALSE));
+    __SET_VAR(data__->,START_TIME,,__CURRENT_TIME);
+    __timer_wheel_arm(&data__->WHEEL, __CURRENT_TIME, __GET_VAR(data__->PT,));
+  } else if (!(__GET_VAR(data__->IN,))) {
+    __SET_VAR(data__->,ET,,__time_to_timespec(1, 0, 0, 0, 0, 0));
+    __SET_VAR(data__->,Q,,__BOOL_LITERAL(FALSE));
+    __SET_VAR(data__->,STATE,,0);
+    __timer_wheel_cancel(&data__->WHEEL);
+  } else if ((__GET_VAR(data__->STATE,) == 1)) {
+    if (__timer_wheel_expired(&data__->WHEEL, __GET_VAR(data__->PT,))) {
+      __SET_VAR(data__->,STATE,,2);
+      __SET_VAR(data__->,Q,,__BOOL_LITERAL(TRUE));
+      __SET_VAR(data__->,ET,,__GET_VAR(data__->PT,));
+    } else {
+      __SET_VAR(data__->,ET,,__time_sub(__CURRENT_TIME, __GET_VAR(data__->START_TIME,)));
+    };
+  };
+  __SET_VAR(data__->,PREV_IN,,__GET_VAR(data__->IN,));
+
+  goto __end;
+#endif
+
 
   #define GetFbVar(var,...) __GET_VAR(data__->var,__VA_ARGS__)
   #define SetFbVar(var,val,...) __SET_VAR(data__->,var,__VA_ARGS__,val)
@@ -1507,6 +1581,10 @@ __SET_VAR(data__->,CURRENT_TIME,,__CURRENT_TIME)
   };
   __SET_VAR(data__->,PREV_IN,,__GET_VAR(data__->IN,));
 
+  if ((__GET_VAR(data__->STATE,) == 1)) {
+    __timer_deadline_hint(__time_add(__GET_VAR(data__->START_TIME,), __GET_VAR(data__->PT,)));
+  };
+
   goto __end;
 
 __end:
@@ -1528,6 +1606,9 @@ static void TOF_init__(TOF *data__, BOOL retain) {
   __INIT_VAR(data__->PREV_IN,__BOOL_LITERAL(FALSE),retain)
   __INIT_VAR(data__->CURRENT_TIME,__time_to_timespec(1, 0, 0, 0, 0, 0),retain)
   __INIT_VAR(data__->START_TIME,__time_to_timespec(1, 0, 0, 0, 0, 0),retain)
+#ifdef __TIMER_WHEEL
+  __timer_wheel_init(&data__->WHEEL);
+#endif
 }
 
 // Code part
@@ -1541,6 +1622,30 @@ static void TOF_body__(TOF *data__) {
     __SET_VAR(data__->,ENO,,__BOOL_LITERAL(TRUE));
   }
   // Initialise TEMP variables
+#ifdef __TIMER_WHEEL
+  // runtime backed timer (timer_wheel.h): the runtime sets the expiry
+  if ((((__GET_VAR(data__->STATE,) == 0) && __GET_VAR(data__->PREV_IN,)) && !(__GET_VAR(data__->IN,)))) {
+    __SET_VAR(data__->,STATE,,1);
+    __SET_VAR(data__->,START_TIME,,__CURRENT_TIME);
+    __timer_wheel_arm(&data__->WHEEL, __CURRENT_TIME, __GET_VAR(data__->PT,));
+  } else if (__GET_VAR(data__->IN,)) {
+    __SET_VAR(data__->,ET,,__time_to_timespec(1, 0, 0, 0, 0, 0));
+    __SET_VAR(data__->,STATE,,0);
+    __timer_wheel_cancel(&data__->WHEEL);
+  } else if ((__GET_VAR(data__->STATE,) == 1)) {
+    if (__timer_wheel_expired(&data__->WHEEL, __GET_VAR(data__->PT,))) {
+      __SET_VAR(data__->,STATE,,2);
+      __SET_VAR(data__->,ET,,__GET_VAR(data__->PT,));
+    } else {
+      __SET_VAR(data__->,ET,,__time_sub(__CURRENT_TIME, __GET_VAR(data__->START_TIME,)));
+    };
+  };
+  __SET_VAR(data__->,Q,,(__GET_VAR(data__->IN,) || (__GET_VAR(data__->STATE,) == 1)));
+  __SET_VAR(data__->,PREV_IN,,__GET_VAR(data__->IN,));
+
+  goto __end;
+#endif
+
 
   #define GetFbVar(var,...) __GET_VAR(data__->var,__VA_ARGS__)
   #define SetFbVar(var,val,...) __SET_VAR(data__->,var,__VA_ARGS__,val)
@@ -1567,6 +1672,10 @@ __SET_VAR(data__->,CURRENT_TIME,,__CURRENT_TIME)
   __SET_VAR(data__->,Q,,(__GET_VAR(data__->IN,) || (__GET_VAR(data__->STATE,) == 1)));
   __SET_VAR(data__->,PREV_IN,,__GET_VAR(data__->IN,));
 
+  if ((__GET_VAR(data__->STATE,) == 1)) {
+    __timer_deadline_hint(__time_add(__GET_VAR(data__->START_TIME,), __GET_VAR(data__->PT,)));
+  };
+
   goto __end;
 
 __end:
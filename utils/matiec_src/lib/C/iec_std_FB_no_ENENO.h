@@ -12,6 +12,7 @@
  *          - to change the function prototypes to become 'static'.
  *             e.g.:   static void R_TRIG_init__(...)
  *                     ^^^^^^
+ *          - to add the __TIMER_WHEEL sections of TP, TON and TOF (see timer_wheel.h)
  * 
  * NOTE: If the structure of the C code generated by iec2c (matiec) should change, then this C 'library'
  *       file will need to be recompiled. 
@@ -343,6 +344,10 @@ typedef struct {
   __DECLARE_VAR(TIME,CURRENT_TIME)
   __DECLARE_VAR(TIME,START_TIME)
 
+#ifdef __TIMER_WHEEL
+  __timer_wheel_entry_t WHEEL;
+#endif
+
 } TP;
 
 // FUNCTION_BLOCK TON
@@ -360,6 +365,10 @@ typedef struct {
   __DECLARE_VAR(TIME,CURRENT_TIME)
   __DECLARE_VAR(TIME,START_TIME)
 
+#ifdef __TIMER_WHEEL
+  __timer_wheel_entry_t WHEEL;
+#endif
+
 } TON;
 
 // FUNCTION_BLOCK TOF
@@ -377,6 +386,10 @@ typedef struct {
   __DECLARE_VAR(TIME,CURRENT_TIME)
   __DECLARE_VAR(TIME,START_TIME)
 
+#ifdef __TIMER_WHEEL
+  __timer_wheel_entry_t WHEEL;
+#endif
+
 } TOF;
 
 // FUNCTION_BLOCK DERIVATIVE
@@ -1149,11 +1162,39 @@ static void TP_init__(TP *data__, BOOL retain) {
   __INIT_VAR(data__->PREV_IN,__BOOL_LITERAL(FALSE),retain)
   __INIT_VAR(data__->CURRENT_TIME,__time_to_timespec(1, 0, 0, 0, 0, 0),retain)
   __INIT_VAR(data__->START_TIME,__time_to_timespec(1, 0, 0, 0, 0, 0),retain)
+#ifdef __TIMER_WHEEL
+  __timer_wheel_init(&data__->WHEEL);
+#endif
 }
 
 // Code part
 static void TP_body__(TP *data__) {
 // Initialise TEMP variables
+#ifdef __TIMER_WHEEL
+// runtime backed timer (timer_wheel.h): the runtime sets the expiry
+if ((((__GET_VAR(data__->STATE,) == 0) && !(__GET_VAR(data__->PREV_IN,))) && __GET_VAR(data__->IN,))) {
+  __SET_VAR(data__->,STATE,,1);
+  __SET_VAR(data__->,Q,,__BOOL_LITERAL(TRUE));
+  __SET_VAR(data__->,START_TIME,,__CURRENT_TIME);
+  __timer_wheel_arm(&data__->WHEEL, __CURRENT_TIME, __GET_VAR(data__->PT,));
+} else if ((__GET_VAR(data__->STATE,) == 1)) {
+  if (__timer_wheel_expired(&data__->WHEEL, __GET_VAR(data__->PT,))) {
+    __SET_VAR(data__->,STATE,,2);
+    __SET_VAR(data__->,Q,,__BOOL_LITERAL(FALSE));
+    __SET_VAR(data__->,ET,,__GET_VAR(data__->PT,));
+  } else {
+    __SET_VAR(data__->,ET,,__time_sub(__CURRENT_TIME, __GET_VAR(data__->START_TIME,)));
+  };
+};
+if (((__GET_VAR(data__->STATE,) == 2) && !(__GET_VAR(data__->IN,)))) {
+  __SET_VAR(data__->,ET,,__time_to_timespec(1, 0, 0, 0, 0, 0));
+  __SET_VAR(data__->,STATE,,0);
+};
+__SET_VAR(data__->,PREV_IN,,__GET_VAR(data__->IN,));
+
+goto __end;
+#endif
+
 
 #define GetFbVar(var,...) __GET_VAR(data__->var,__VA_ARGS__)
 #define SetFbVar(var,val,...) __SET_VAR(data__->,var,__VA_ARGS__,val)
@@ -1180,6 +1221,10 @@ if (((__GET_VAR(data__->STATE,) == 2) && !(__GET_VAR(data__->IN,)))) {
 };
 __SET_VAR(data__->,PREV_IN,,__GET_VAR(data__->IN,));
 
+if ((__GET_VAR(data__->STATE,) == 1)) {
+  __timer_deadline_hint(__time_add(__GET_VAR(data__->START_TIME,), __GET_VAR(data__->PT,)));
+};
+
 goto __end;
 
 __end:
@@ -1199,11 +1244,40 @@ static void TON_init__(TON *data__, BOOL retain) {
   __INIT_VAR(data__->PREV_IN,__BOOL_LITERAL(FALSE),retain)
   __INIT_VAR(data__->CURRENT_TIME,__time_to_timespec(1, 0, 0, 0, 0, 0),retain)
   __INIT_VAR(data__->START_TIME,__time_to_timespec(1, 0, 0, 0, 0, 0),retain)
+#ifdef __TIMER_WHEEL
+  __timer_wheel_init(&data__->WHEEL);
+#endif
 }
 
 // Code part
 static void TON_body__(TON *data__) {
 // Initialise TEMP variables
+#ifdef __TIMER_WHEEL
+// runtime backed timer (timer_wheel.h): the runtime sets the expiry
+if ((((__GET_VAR(data__->STATE,) == 0) && !(__GET_VAR(data__->PREV_IN,))) && __GET_VAR(data__->IN,))) {
+  __SET_VAR(data__->,STATE,,1);
+  __SET_VAR(data__->,Q,,__BOOL_LITERAL(FALSE));
+  __SET_VAR(data__->,START_TIME,,__CURRENT_TIME);
+  __timer_wheel_arm(&data__->WHEEL, __CURRENT_TIME, __GET_VAR(data__->PT,));
+} else if (!(__GET_VAR(data__->IN,))) {
+  __SET_VAR(data__->,ET,,__time_to_timespec(1, 0, 0, 0, 0, 0));
+  __SET_VAR(data__->,Q,,__BOOL_LITERAL(FALSE));
+  __SET_VAR(data__->,STATE,,0);
+  __timer_wheel_cancel(&data__->WHEEL);
+} else if ((__GET_VAR(data__->STATE,) == 1)) {
+  if (__timer_wheel_expired(&data__->WHEEL, __GET_VAR(data__->PT,))) {
+    __SET_VAR(data__->,STATE,,2);
+    __SET_VAR(data__->,Q,,__BOOL_LITERAL(TRUE));
+    __SET_VAR(data__->,ET,,__GET_VAR(data__->PT,));
+  } else {
+    __SET_VAR(data__->,ET,,__time_sub(__CURRENT_TIME, __GET_VAR(data__->START_TIME,)));
+  };
+};
+__SET_VAR(data__->,PREV_IN,,__GET_VAR(data__->IN,));
+
+goto __end;
+#endif
+
 
 #define GetFbVar(var,...) __GET_VAR(data__->var,__VA_ARGS__)
 #define SetFbVar(var,val,...) __SET_VAR(data__->,var,__VA_ARGS__,val)
@@ -1232,6 +1306,10 @@ if ((((__GET_VAR(data__->STATE,) == 0) && !(__GET_VAR(data__->PREV_IN,))) && __G
 };
 __SET_VAR(data__->,PREV_IN,,__GET_VAR(data__->IN,));
 
+if ((__GET_VAR(data__->STATE,) == 1)) {
+  __timer_deadline_hint(__time_add(__GET_VAR(data__->START_TIME,), __GET_VAR(data__->PT,)));
+};
+
 goto __end;
 
 __end:
@@ -1251,11 +1329,38 @@ static void TOF_init__(TOF *data__, BOOL retain) {
   __INIT_VAR(data__->PREV_IN,__BOOL_LITERAL(FALSE),retain)
   __INIT_VAR(data__->CURRENT_TIME,__time_to_timespec(1, 0, 0, 0, 0, 0),retain)
   __INIT_VAR(data__->START_TIME,__time_to_timespec(1, 0, 0, 0, 0, 0),retain)
+#ifdef __TIMER_WHEEL
+  __timer_wheel_init(&data__->WHEEL);
+#endif
 }
 
 // Code part
 static void TOF_body__(TOF *data__) {
 // Initialise TEMP variables
+#ifdef __TIMER_WHEEL
+// runtime backed timer (timer_wheel.h): the runtime sets the expiry
+if ((((__GET_VAR(data__->STATE,) == 0) && __GET_VAR(data__->PREV_IN,)) && !(__GET_VAR(data__->IN,)))) {
+  __SET_VAR(data__->,STATE,,1);
+  __SET_VAR(data__->,START_TIME,,__CURRENT_TIME);
+  __timer_wheel_arm(&data__->WHEEL, __CURRENT_TIME, __GET_VAR(data__->PT,));
+} else if (__GET_VAR(data__->IN,)) {
+  __SET_VAR(data__->,ET,,__time_to_timespec(1, 0, 0, 0, 0, 0));
+  __SET_VAR(data__->,STATE,,0);
+  __timer_wheel_cancel(&data__->WHEEL);
+} else if ((__GET_VAR(data__->STATE,) == 1)) {
+  if (__timer_wheel_expired(&data__->WHEEL, __GET_VAR(data__->PT,))) {
+    __SET_VAR(data__->,STATE,,2);
+    __SET_VAR(data__->,ET,,__GET_VAR(data__->PT,));
+  } else {
+    __SET_VAR(data__->,ET,,__time_sub(__CURRENT_TIME, __GET_VAR(data__->START_TIME,)));
+  };
+};
+__SET_VAR(data__->,Q,,(__GET_VAR(data__->IN,) || (__GET_VAR(data__->STATE,) == 1)));
+__SET_VAR(data__->,PREV_IN,,__GET_VAR(data__->IN,));
+
+goto __end;
+#endif
+
 
 #define GetFbVar(var,...) __GET_VAR(data__->var,__VA_ARGS__)
 #define SetFbVar(var,val,...) __SET_VAR(data__->,var,__VA_ARGS__,val)
@@ -1282,6 +1387,10 @@ if ((((__GET_VAR(data__->STATE,) == 0) && __GET_VAR(data__->PREV_IN,)) && !(__GE
 __SET_VAR(data__->,Q,,(__GET_VAR(data__->IN,) || (__GET_VAR(data__->STATE,) == 1)));
 __SET_VAR(data__->,PREV_IN,,__GET_VAR(data__->IN,));
 
+if ((__GET_VAR(data__->STATE,) == 1)) {
+  __timer_deadline_hint(__time_add(__GET_VAR(data__->START_TIME,), __GET_VAR(data__->PT,)));
+};
+
 goto __end;
 
 __end:
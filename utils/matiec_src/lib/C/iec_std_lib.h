@@ -55,6 +55,7 @@
 #include "iec_types_all.h"
 
 extern TIME __CURRENT_TIME;
+extern unsigned long long __next_timer_deadline;
 extern BOOL __DEBUG;
 
 /* TODO
@@ -381,6 +382,21 @@ static inline TIME __time_sub(TIME IN1, TIME IN2){
   __normalize_timespec(&res);
   return res;
 }
+/* Records the expiry of a running timer (in ns of __CURRENT_TIME) when it is
+ * earlier than the ones already recorded, so an event driven scan knows when
+ * the program has to run again. Programs of a resource may run in parallel */
+static inline void __timer_deadline_hint(TIME deadline){
+  unsigned long long ns, old;
+  if (deadline.tv_sec < 0) return;
+  ns = (unsigned long long)deadline.tv_sec * 1000000000ULL + deadline.tv_nsec;
+#ifdef __GNUC__
+  old = __atomic_load_n(&__next_timer_deadline, __ATOMIC_RELAXED);
+  while (ns < old && !__atomic_compare_exchange_n(&__next_timer_deadline, &old, ns, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+#else
+  old = __next_timer_deadline;
+  if (ns < old) __next_timer_deadline = ns;
+#endif
+}
 static inline TIME __time_mul(TIME IN1, LREAL IN2){
   LREAL s_f = IN1.tv_sec * IN2;
   time_t s = (time_t)s_f;
@@ -747,10 +763,15 @@ __ANY(__move_)
 
 #include "iec_std_functions.h"
 
+#ifdef  __TIMER_WHEEL
+  #include "timer_wheel.h"
+#endif
+
 #ifdef  DISABLE_EN_ENO_PARAMETERS
   #include "iec_std_FB_no_ENENO.h"
 #else
   #include "iec_std_FB.h"
 #endif
+#include "iec_control_FB.h"
 
 #endif /* _IEC_STD_LIB_H */
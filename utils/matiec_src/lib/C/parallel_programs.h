@@ -0,0 +1,42 @@
+/*
+ * Copyright 2026 OpenPLC Project
+ *
+ * This file is part of the OpenPLC Software Stack.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/****
+ * Concurrent execution of the programs of a resource.
+ *
+ * With the 'j' stage 4 option ('-O j') iec2c splits the programs of each
+ * resource in waves of programs that share no variables, and places the code
+ * running each program in a job function. The resource run function runs
+ * the waves in order, handing the jobs of each wave with more than one
+ * program to __run_program_jobs().
+ *
+ * The runtime linked with the generated code provides __run_program_jobs().
+ * It may run the jobs in any order and on any thread, but must only return
+ * once all of them are done, and everything they wrote must be visible to
+ * the calling thread by then.
+ ****/
+
+#ifndef _PARALLEL_PROGRAMS_H
+#define _PARALLEL_PROGRAMS_H
+
+typedef void (*__program_job_t)(void);
+
+void __run_program_jobs(const __program_job_t *jobs, int count);
+
+#endif /* _PARALLEL_PROGRAMS_H */
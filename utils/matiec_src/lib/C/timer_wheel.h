@@ -0,0 +1,73 @@
+/*
+ * Copyright 2026 OpenPLC Project
+ *
+ * This file is part of the OpenPLC Software Stack.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/****
+ * Runtime backed TP, TON and TOF.
+ *
+ * With the 'w' stage 4 option ('-O w') iec2c defines __TIMER_WHEEL in the
+ * generated files, and the timer blocks of iec_std_FB.h no longer compare
+ * START_TIME + PT with the current time on every call. A timer that starts
+ * registers its deadline with the runtime, which keeps the running timers in
+ * a timer wheel and marks them expired as time goes by. The block body only
+ * checks that flag.
+ *
+ * The runtime linked with the generated code provides __timer_wheel_arm()
+ * and __timer_wheel_disarm(), and must mark the expired timers before each
+ * run of the programs, with the same time base as __CURRENT_TIME: a timer
+ * expires once START_TIME + PT <= __CURRENT_TIME, as with the plain blocks.
+ * Arming and disarming may happen on several threads at once when the
+ * programs run in parallel (-O j).
+ ****/
+
+#ifndef _TIMER_WHEEL_H
+#define _TIMER_WHEEL_H
+
+typedef struct __timer_wheel_entry_t {
+  struct __timer_wheel_entry_t *next;
+  struct __timer_wheel_entry_t *prev;
+  unsigned long long deadline; /* ns of __CURRENT_TIME */
+  TIME start;
+  TIME pt;
+  BOOL armed;
+  BOOL expired;
+} __timer_wheel_entry_t;
+
+void __timer_wheel_arm(__timer_wheel_entry_t *entry, TIME start, TIME pt);
+void __timer_wheel_disarm(__timer_wheel_entry_t *entry);
+
+static inline void __timer_wheel_init(__timer_wheel_entry_t *entry) {
+  entry->next = entry->prev = NULL;
+  entry->deadline = 0;
+  entry->armed = entry->expired = 0;
+}
+
+static inline void __timer_wheel_cancel(__timer_wheel_entry_t *entry) {
+  if (entry->armed) __timer_wheel_disarm(entry);
+  entry->expired = 0;
+}
+
+/* A change of PT while the timer runs moves its deadline, like it does with
+ * the plain blocks */
+static inline BOOL __timer_wheel_expired(__timer_wheel_entry_t *entry, TIME pt) {
+  if (entry->pt.tv_sec != pt.tv_sec || entry->pt.tv_nsec != pt.tv_nsec)
+    __timer_wheel_arm(entry, entry->start, pt);
+  return entry->expired;
+}
+
+#endif /* _TIMER_WHEEL_H */
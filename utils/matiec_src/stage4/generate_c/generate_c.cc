@@ -28,8 +28,14 @@
 #include <typeinfo>
 #include <list>
 #include <map>
+#include <set>
+#include <vector>
 #include <sstream>
 #include <strings.h>
+#include <algorithm>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h> // for realpath()
 
 
 #include "../../util/symtable.hh"
@@ -116,6 +122,7 @@
 #define DECLARE_EXTERNAL_FB "__DECLARE_EXTERNAL_FB"
 #define DECLARE_LOCATED "__DECLARE_LOCATED"
 #define DECLARE_GLOBAL_PROTOTYPE "__DECLARE_GLOBAL_PROTOTYPE"
+#define DECLARE_PACKED_BOOL "__DECLARE_PACKED_BOOL"
 
 /* Variable declaration symbol for accessor macros */
 #define INIT_VAR "__INIT_VAR"
@@ -126,12 +133,15 @@
 #define INIT_EXTERNAL_FB "__INIT_EXTERNAL_FB"
 #define INIT_LOCATED "__INIT_LOCATED"
 #define INIT_LOCATED_VALUE "__INIT_LOCATED_VALUE"
+#define INIT_PACKED_BOOLS "__INIT_PACKED_BOOLS"
+#define INIT_PACKED_BOOL "__INIT_PACKED_BOOL"
 
 /* Variable getter symbol for accessor macros */
 #define GET_VAR "__GET_VAR"
 #define GET_EXTERNAL "__GET_EXTERNAL"
 #define GET_EXTERNAL_FB "__GET_EXTERNAL_FB"
 #define GET_LOCATED "__GET_LOCATED"
+#define GET_PACKED_BOOL "__GET_PACKED_BOOL"
 
 #define GET_VAR_REF "__GET_VAR_REF"
 #define GET_EXTERNAL_REF "__GET_EXTERNAL_REF"
@@ -153,6 +163,7 @@
 #define SET_EXTERNAL "__SET_EXTERNAL"
 #define SET_EXTERNAL_FB "__SET_EXTERNAL_FB"
 #define SET_LOCATED "__SET_LOCATED"
+#define SET_PACKED_BOOL "__SET_PACKED_BOOL"
 
 /* Variable initial value symbol for accessor macros */
 #define INITIAL_VALUE "__INITIAL_VALUE"
@@ -178,13 +189,29 @@
 
 static int generate_line_directives__ = 0;
 static int generate_pou_filepairs__   = 0;
+static int generate_pou_profile__     = 0;
+static int generate_parallel_programs__ = 0;
+static int generate_timer_wheel__     = 0;
+static int generate_bitwise_bool__    = 0;
+static int generate_packed_bool__     = 0;
+static int generate_scan_estimate__   = 0;
+static const char *scan_estimate_profile__ = NULL;
+
+/* Side map of the '#line' directives (LINE_MAP.csv), written when option 'l' is set.
+ * One row per statement: the POU, the number of the statement inside the POU
+ * (the rung, for ST generated from LD/FBD), the source position and the
+ * position of the statement in the generated C file.
+ */
+static stage4out_c *line_map_s4o__       = NULL;
+static const char  *line_map_pou__       = "";
+static int          line_map_statement__ = 0;
 
 #ifdef __unix__
 /* Parse command line options passed from main.c !! */
 #include <stdlib.h> // for getsybopt()
 int  stage4_parse_options(char *options) {
-  enum {                    LINE_OPT = 0            ,  SEPTFILE_OPT              /*, SOME_OTHER_OPT, YET_ANOTHER_OPT */};
-  char *const token[] = { /*[LINE_OPT]=*/(char *)"l",/*SEPTFILE_OPT*/(char *)"p" /*, SOME_OTHER_OPT, ...             */, NULL };
+  enum {                    LINE_OPT = 0            ,  SEPTFILE_OPT              ,  PROFILE_OPT              ,  PARALLEL_OPT              ,  TIMER_WHEEL_OPT              ,  BITWISE_BOOL_OPT              ,  SCAN_ESTIMATE_OPT              ,  PACKED_BOOL_OPT              /*, SOME_OTHER_OPT, YET_ANOTHER_OPT */};
+  char *const token[] = { /*[LINE_OPT]=*/(char *)"l",/*SEPTFILE_OPT*/(char *)"p",/*PROFILE_OPT*/(char *)"t",/*PARALLEL_OPT*/(char *)"j",/*TIMER_WHEEL_OPT*/(char *)"w",/*BITWISE_BOOL_OPT*/(char *)"b",/*SCAN_ESTIMATE_OPT*/(char *)"e",/*PACKED_BOOL_OPT*/(char *)"c" /*, SOME_OTHER_OPT, ...             */, NULL };
   /* unfortunately, the above commented out syntax for array initialization is valid in C, but not in C++ */
   
   char *subopts = options;
@@ -195,6 +222,12 @@ int  stage4_parse_options(char *options) {
     switch (getsubopt(&subopts, token, &value)) {
       case     LINE_OPT: generate_line_directives__  = 1; break;
       case SEPTFILE_OPT: generate_pou_filepairs__    = 1; break;
+      case  PROFILE_OPT: generate_pou_profile__      = 1; break;
+      case PARALLEL_OPT: generate_parallel_programs__ = 1; break;
+      case TIMER_WHEEL_OPT: generate_timer_wheel__   = 1; break;
+      case BITWISE_BOOL_OPT: generate_bitwise_bool__ = 1; break;
+      case SCAN_ESTIMATE_OPT: generate_scan_estimate__ = 1; scan_estimate_profile__ = value; break;
+      case PACKED_BOOL_OPT: generate_packed_bool__   = 1; break;
       default          : fprintf(stderr, "Unrecognized option: -O %s\n", value); return -1; break;
      }
   }     
@@ -206,12 +239,20 @@ void stage4_print_options(void) {
   printf("          (options must be separated by commas. Example: 'l,w,x')\n"); 
   printf("      l : insert '#line' directives in generated C code.\n"); 
   printf("      p : place each POU in a separate pair of files (<pou_name>.c, <pou_name>.h).\n"); 
+  printf("      t : instrument program and FB bodies and FB calls for the POU profiler (pou_profile.h).\n"); 
+  printf("      j : run the programs of a resource that share no variables concurrently (parallel_programs.h).\n"); 
+  printf("      w : let the runtime expire the TP, TON and TOF timers from a timer wheel (timer_wheel.h).\n"); 
+  printf("      b : evaluate BOOL expressions without side effects (ladder rungs) with bitwise operators.\n"); 
+  printf("      e[=profile] : estimate the worst case execution time of each POU and task for a target profile\n"); 
+  printf("                    (linux, win or rpi), write it to SCAN_ESTIMATE.csv and warn about tasks that\n"); 
+  printf("                    do not fit their INTERVAL and about loops with no bound.\n");
+  printf("      c : store the BOOLs of the VAR and VAR_TEMP sections of programs and FBs one bit each.\n");
 }
 #else /* not __unix__ */
 /* getsubopt isn't supported with mingw, 
  *  then stage4 options aren't available on windows*/
 void stage4_print_options(void) {}
-int  stage4_parse_options(char *options) {}
+int  stage4_parse_options(char *options) {return 0;}
 #endif 
 
 /***********************************************************************/
@@ -222,10 +263,12 @@ int  stage4_parse_options(char *options) {}
 #include "generate_c_base.cc"
 #include "generate_c_typedecl.cc"
 #include "generate_c_sfcdecl.cc"
+#include "generate_packed_bool.cc"
 #include "generate_c_vardecl.cc"
 #include "generate_c_configbody.cc"
 #include "generate_location_list.cc"
 #include "generate_var_list.cc"
+#include "generate_program_schedule.cc"
 
 /***********************************************************************/
 /***********************************************************************/
@@ -520,6 +563,29 @@ analyse_variable_c *analyse_variable_c::singleton_ = NULL;
 /***********************************************************************/
 /***********************************************************************/
 
+/* Name of a function block call site for the POU profiler: "<POU>.<instance>".
+ * Instances that are not referenced by a plain identifier (e.g. array elements)
+ * are reported under the name of the array.
+ */
+static std::string pou_profile_site_name(symbol_c *pou_name, symbol_c *fb_name) {
+  std::string site;
+  identifier_c *pou_id = dynamic_cast<identifier_c *>(pou_name);
+  site = (pou_id != NULL)? pou_id->value : "?";
+  site += ".";
+
+  while (fb_name != NULL) {
+    identifier_c *id = dynamic_cast<identifier_c *>(fb_name);
+    if (id != NULL) {site += id->value; break;}
+    symbolic_variable_c *var = dynamic_cast<symbolic_variable_c *>(fb_name);
+    if (var != NULL) {fb_name = var->var_name; continue;}
+    array_variable_c *array = dynamic_cast<array_variable_c *>(fb_name);
+    if (array != NULL) {fb_name = array->subscripted_variable; continue;}
+    site += "?";
+    break;
+  }
+  return site;
+}
+
 
 #include "generate_c_st.cc"
 #include "generate_c_il.cc"
@@ -665,6 +731,8 @@ class calculate_common_ticktime_c: public iterator_visitor_c {
     }
 };    
 
+#include "generate_scan_estimate.cc"
+
 /***********************************************************************/
 /***********************************************************************/
 /***********************************************************************/
@@ -990,6 +1058,7 @@ class generate_c_pous_c {
                                            generate_c_vardecl_c::external_vt);
         vardecl->print(symbol->var_declarations);
         delete vardecl;
+        print_packed_bool_declaration(s4o, symbol);
         
         /* (A.4) Generate private internal variables for SFC */
         sfcdecl = new generate_c_sfcdecl_c(&s4o, symbol);
@@ -1031,6 +1100,8 @@ class generate_c_pous_c {
         s4o.indent_right();
       
         /* (B.2) Member initializations... */
+        if (packed_bool_count(symbol) > 0)
+          s4o.print(s4o.indent_spaces + INIT_PACKED_BOOLS "(" FB_FUNCTION_PARAM "->,retain)\n");
         s4o.print(s4o.indent_spaces);
         vardecl = new generate_c_vardecl_c(&s4o,
                                            generate_c_vardecl_c::constructorinit_vf,
@@ -1063,6 +1134,11 @@ class generate_c_pous_c {
       }
       
       /* (C.3) Function declaration */
+      if (generate_pou_profile__ && !print_declaration) {
+        s4o.print("__POU_PROFILE_DEFINE(");
+        symbol->fblock_name->accept(print_base);
+        s4o.print(")\n");
+      }
       s4o.print("// Code part\n");
       /* function interface */
       s4o.print("void ");
@@ -1117,6 +1193,11 @@ class generate_c_pous_c {
       
         /* (C.4) Initialize TEMP variables */
         /* function body */
+        if (generate_pou_profile__) {
+          s4o.print(s4o.indent_spaces + "__POU_PROFILE_ENTER(");
+          symbol->fblock_name->accept(print_base);
+          s4o.print(")\n");
+        }
         s4o.print(s4o.indent_spaces + "// Initialise TEMP variables\n");
         vardecl = new generate_c_vardecl_c(&s4o,
                                            generate_c_vardecl_c::init_vf,
@@ -1129,6 +1210,11 @@ class generate_c_pous_c {
         generate_c_SFC_IL_ST_c generate_c_code(&s4o, symbol->fblock_name, symbol, FB_FUNCTION_PARAM"->");
         symbol->fblock_body->accept(generate_c_code);
         print_end_of_block_label(s4o);
+        if (generate_pou_profile__) {
+          s4o.print(s4o.indent_spaces + "__POU_PROFILE_EXIT(");
+          symbol->fblock_name->accept(print_base);
+          s4o.print(")\n");
+        }
         s4o.print(s4o.indent_spaces + "return;\n");
         s4o.indent_left();
         s4o.print(s4o.indent_spaces + "} // ");
@@ -1199,6 +1285,7 @@ class generate_c_pous_c {
                       generate_c_vardecl_c::external_vt);
         vardecl->print(symbol->var_declarations);
         delete vardecl;
+        print_packed_bool_declaration(s4o, symbol);
       
         /* (A.4) Generate private internal variables for SFC */
         sfcdecl = new generate_c_sfcdecl_c(&s4o, symbol);
@@ -1240,6 +1327,8 @@ class generate_c_pous_c {
         s4o.indent_right();
       
         /* (B.2) Member initializations... */
+        if (packed_bool_count(symbol) > 0)
+          s4o.print(s4o.indent_spaces + INIT_PACKED_BOOLS "(" FB_FUNCTION_PARAM "->,retain)\n");
         s4o.print(s4o.indent_spaces);
         vardecl = new generate_c_vardecl_c(&s4o,
                                            generate_c_vardecl_c::constructorinit_vf,
@@ -1274,6 +1363,11 @@ class generate_c_pous_c {
       }
       
       /* (C.3) Function declaration */
+      if (generate_pou_profile__ && !print_declaration) {
+        s4o.print("__POU_PROFILE_DEFINE(");
+        symbol->program_type_name->accept(print_base);
+        s4o.print(")\n");
+      }
       s4o.print("// Code part\n");
       /* function interface */
       s4o.print("void ");
@@ -1294,6 +1388,11 @@ class generate_c_pous_c {
           
         /* (C.4) Initialize TEMP variables */
         /* function body */
+        if (generate_pou_profile__) {
+          s4o.print(s4o.indent_spaces + "__POU_PROFILE_ENTER(");
+          symbol->program_type_name->accept(print_base);
+          s4o.print(")\n");
+        }
         s4o.print(s4o.indent_spaces + "// Initialise TEMP variables\n");
         vardecl = new generate_c_vardecl_c(&s4o,
                                            generate_c_vardecl_c::init_vf,
@@ -1306,6 +1405,11 @@ class generate_c_pous_c {
         generate_c_SFC_IL_ST_c generate_c_code(&s4o, symbol->program_type_name, symbol, FB_FUNCTION_PARAM"->");
         symbol->function_block_body->accept(generate_c_code);
         print_end_of_block_label(s4o);
+        if (generate_pou_profile__) {
+          s4o.print(s4o.indent_spaces + "__POU_PROFILE_EXIT(");
+          symbol->program_type_name->accept(print_base);
+          s4o.print(")\n");
+        }
         s4o.print(s4o.indent_spaces + "return;\n");
         s4o.indent_left();
         s4o.print(s4o.indent_spaces + "} // ");
@@ -1407,6 +1511,13 @@ void *visit(configuration_declaration_c *symbol) {
     s4o.print("#endif\n");
   }
   
+  if (generate_timer_wheel__) {
+    // The timer blocks have a different layout with the timer wheel. Every file must agree on it!
+    s4o.print("#ifndef __TIMER_WHEEL\n");
+    s4o.print("#define __TIMER_WHEEL\n");
+    s4o.print("#endif\n");
+  }
+  
   s4o.print("#include \"iec_std_lib.h\"\n\n");
   s4o.print("#include \"accessor.h\"\n\n"); 
   s4o.print("#include \"POUS.h\"\n\n");
@@ -1721,6 +1832,13 @@ END_RESOURCE
         s4o.print("#endif\n");
       }
       
+      if (generate_timer_wheel__) {
+        // The timer blocks have a different layout with the timer wheel. Every file must agree on it!
+        s4o.print("#ifndef __TIMER_WHEEL\n");
+        s4o.print("#define __TIMER_WHEEL\n");
+        s4o.print("#endif\n");
+      }
+      
       s4o.print("#include \"iec_std_lib.h\"\n\n");
       
       /* (A) resource declaration... */
@@ -1732,6 +1850,8 @@ END_RESOURCE
       s4o.print("extern unsigned long long common_ticktime__;\n\n");
 
       s4o.print("#include \"accessor.h\"\n");
+      if (generate_parallel_programs__)
+        s4o.print("#include \"parallel_programs.h\"\n");
       s4o.print("#include \"POUS.h\"\n\n");
       s4o.print("#include \"");
       configuration_name = true;
@@ -1799,6 +1919,21 @@ END_RESOURCE
       s4o.print("}\n\n");
       
       /* (C) Resource run function... */
+      /* (C.0) Programs that may run concurrently... */
+      generate_program_schedule_c *schedule = NULL;
+      if (generate_parallel_programs__) {
+        configuration_declaration_c *config = dynamic_cast<configuration_declaration_c *>(current_configuration);
+        schedule = new generate_program_schedule_c();
+        schedule->generate((config != NULL)? config->global_var_declarations : NULL, current_global_vars, symbol->program_configuration_list);
+        if (schedule->waves.size() < (unsigned int)((list_c *)symbol->program_configuration_list)->n) {
+          print_program_jobs(schedule);
+        } else {
+          /* every program depends on the previous one, nothing to run concurrently */
+          delete schedule;
+          schedule = NULL;
+        }
+      }
+
       /* (C.1) Run function name... */
       s4o.print("void ");
       current_resource_name->accept(*this);
@@ -1812,7 +1947,12 @@ END_RESOURCE
       symbol->task_configuration_list->accept(*this);
       
       /* (C.3) Program run declaration... */
-      symbol->program_configuration_list->accept(*this);
+      if (schedule == NULL) {
+        symbol->program_configuration_list->accept(*this);
+      } else {
+        print_program_waves(schedule);
+        delete schedule;
+      }
       
       s4o.indent_left();
       s4o.print("}\n\n");
@@ -1824,6 +1964,76 @@ END_RESOURCE
       return NULL;
     }
     
+    /* One job per program: the code that runs the program in the resource run function, in a function of its own */
+    void print_program_job_name(program_configuration_c *program) {
+      current_resource_name->accept(*this);
+      s4o.print("__");
+      program->program_name->accept(*this);
+      s4o.print("__job");
+    }
+
+    void print_program_jobs(generate_program_schedule_c *schedule) {
+      s4o.print("// Program schedule. The programs of each wave share no variables and may run\n");
+      s4o.print("// concurrently. The waves run one after the other\n");
+      for (unsigned int w = 0; w < schedule->waves.size(); w++) {
+        for (unsigned int i = 0; i < schedule->waves[w].size(); i++) {
+          program_configuration_c *program = schedule->waves[w][i];
+          s4o.print("//   wave ");
+          s4o.print(w);
+          s4o.print(": ");
+          program->program_name->accept(*this);
+          if (schedule->reasons.count(program)) {
+            s4o.print(" after ");
+            s4o.print(schedule->reasons[program]);
+          }
+          s4o.print("\n");
+        }
+      }
+      s4o.print("\n");
+
+      wanted_declaretype = run_dt;
+      for (unsigned int w = 0; w < schedule->waves.size(); w++) {
+        for (unsigned int i = 0; i < schedule->waves[w].size(); i++) {
+          s4o.print("static void ");
+          print_program_job_name(schedule->waves[w][i]);
+          s4o.print("(void) {\n");
+          s4o.indent_right();
+          schedule->waves[w][i]->accept(*this);
+          s4o.indent_left();
+          s4o.print("}\n\n");
+        }
+        if (schedule->waves[w].size() < 2) continue;
+        s4o.print("static const __program_job_t ");
+        current_resource_name->accept(*this);
+        s4o.print("__wave");
+        s4o.print(w);
+        s4o.print("[] = {");
+        for (unsigned int i = 0; i < schedule->waves[w].size(); i++) {
+          if (i > 0) s4o.print(", ");
+          print_program_job_name(schedule->waves[w][i]);
+        }
+        s4o.print("};\n\n");
+      }
+    }
+
+    void print_program_waves(generate_program_schedule_c *schedule) {
+      for (unsigned int w = 0; w < schedule->waves.size(); w++) {
+        s4o.print(s4o.indent_spaces);
+        if (schedule->waves[w].size() < 2) {
+          print_program_job_name(schedule->waves[w][0]);
+          s4o.print("();\n");
+          continue;
+        }
+        s4o.print("__run_program_jobs(");
+        current_resource_name->accept(*this);
+        s4o.print("__wave");
+        s4o.print(w);
+        s4o.print(", ");
+        s4o.print((unsigned int)schedule->waves[w].size());
+        s4o.print(");\n");
+      }
+    }
+
 /*  PROGRAM [RETAIN | NON_RETAIN] program_name [WITH task_name] ':' program_type_name ['(' prog_conf_elements ')'] */
 //SYM_REF6(program_configuration_c, retain_option, program_name, task_name, program_type_name, prog_conf_elements, unused)
     void *visit(program_configuration_c *symbol) {
@@ -2093,6 +2303,7 @@ class generate_c_c: public iterator_visitor_c {
     stage4out_c             pous_incl_s4o;
     stage4out_c     located_variables_s4o;
     stage4out_c             variables_s4o;
+    stage4out_c             *line_map_s4o;
     
     generate_c_typedecl_c          generate_c_typedecl;
     generate_c_implicit_typedecl_c generate_c_implicit_typedecl;
@@ -2120,9 +2331,18 @@ class generate_c_c: public iterator_visitor_c {
       current_builddir = builddir;
       current_configuration = NULL;
       allow_output = true;
+      line_map_s4o = NULL;
+      if (generate_line_directives__) {
+        line_map_s4o = new stage4out_c(builddir, "LINE_MAP", "csv");
+        line_map_s4o->print("pou,statement,source_file,source_line,c_file,c_line\n");
+        line_map_s4o__ = line_map_s4o;
+      }
     }
             
-    ~generate_c_c(void) {}
+    ~generate_c_c(void) {
+      line_map_s4o__ = NULL;
+      delete line_map_s4o;
+    }
 
 
 
@@ -2135,6 +2355,7 @@ class generate_c_c: public iterator_visitor_c {
       pous_incl_s4o        .enable_output();  
       located_variables_s4o.enable_output();  
       variables_s4o        .enable_output();  
+      if (line_map_s4o != NULL) line_map_s4o->enable_output();
       allow_output = true;      
       return NULL;
     }
@@ -2145,6 +2366,7 @@ class generate_c_c: public iterator_visitor_c {
       pous_incl_s4o        .disable_output();  
       located_variables_s4o.disable_output();  
       variables_s4o        .disable_output();  
+      if (line_map_s4o != NULL) line_map_s4o->disable_output();
       allow_output = false;      
       return NULL;
     } 
@@ -2164,7 +2386,19 @@ class generate_c_c: public iterator_visitor_c {
         pous_incl_s4o.print("#endif\n");
       }
       
+      if (generate_timer_wheel__) {
+        // The timer blocks have a different layout with the timer wheel. Every file must agree on it!
+        pous_incl_s4o.print("#ifndef __TIMER_WHEEL\n");
+        pous_incl_s4o.print("#define __TIMER_WHEEL\n");
+        pous_incl_s4o.print("#endif\n");
+      }
+      
       pous_incl_s4o.print("#include \"accessor.h\"\n#include \"iec_std_lib.h\"\n\n");
+      if (generate_pou_profile__)
+        pous_incl_s4o.print("#include \"pou_profile.h\"\n\n");
+
+      if (generate_packed_bool__)
+        packed_bool_analyse(symbol);
 
       for(int i = 0; i < symbol->n; i++) {
         symbol->elements[i]->accept(*this);
@@ -2181,6 +2415,11 @@ class generate_c_c: public iterator_visitor_c {
 
       generate_location_list_c generate_location_list(&located_variables_s4o);
       symbol->accept(generate_location_list);
+
+      if (generate_scan_estimate__) {
+        generate_scan_estimate_c generate_scan_estimate(current_builddir, scan_estimate_profile__, common_ticktime);
+        symbol->accept(generate_scan_estimate);
+      }
       return NULL;
     }
 
@@ -2219,6 +2458,8 @@ class generate_c_c: public iterator_visitor_c {
  */
 #define handle_pou(fname,pname) \
       if (!allow_output) return NULL;\
+      line_map_pou__ = get_datatype_info_c::get_id_str(pname);\
+      line_map_statement__ = 0;\
       if (generate_pou_filepairs__) {\
         const char *pou_name = get_datatype_info_c::get_id_str(pname);\
         stage4out_c s4o_c(current_builddir, pou_name, "c");\
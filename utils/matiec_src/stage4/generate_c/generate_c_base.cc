@@ -120,12 +120,58 @@ class generate_c_base_c: public iterator_visitor_c {
         s4o.print(variable_prefix_);
     }
 
+    /* The generated files are compiled from another directory than the one iec2c was called from,
+     * so the source file is referenced by its absolute path whenever it can be resolved.
+     */
+    static const char *line_directive_file(const char *file) {
+      static std::string last_file, last_path;
+      if (file == NULL) return "";
+      if (last_file != file) {
+        last_file = file;
+        last_path = file;
+#ifdef __unix__
+        char *path = realpath(file, NULL);
+        if (path != NULL) last_path = path;
+        free(path);
+#endif
+      }
+      return last_path.c_str();
+    }
+
     void print_line_directive(symbol_c *symbol) {
       if (!generate_line_directives__) return; /* global variable generate_line_directives__ is defined in generate_c.cc */
+      const char *source_file = line_directive_file(symbol->first_file);
+      if (line_map_s4o__ != NULL) { /* also defined in generate_c.cc */
+        line_map_s4o__->print(line_map_pou__);
+        line_map_s4o__->print(",");
+        line_map_s4o__->print(++line_map_statement__);
+        line_map_s4o__->print(",");
+        line_map_s4o__->print(source_file);
+        line_map_s4o__->print(",");
+        line_map_s4o__->print(symbol->first_line);
+        line_map_s4o__->print(",");
+        line_map_s4o__->print(s4o.get_filename());
+        line_map_s4o__->print(",");
+        line_map_s4o__->print(s4o.get_line() + 1);
+        line_map_s4o__->print("\n");
+      }
       s4o.print("#line ");
       s4o.print(symbol->first_line);
       s4o.print(" \"");
-      s4o.print(symbol->first_file);
+      s4o.print(source_file);
+      s4o.print("\"\n");    
+    }
+
+    /* Point the compiler back at the generated file once the code of the statements is over, so
+     * the code that follows is not attributed to the last statement.
+     */
+    void print_line_directive_reset(void) {
+      if (!generate_line_directives__) return;
+      if (*s4o.get_filename() == '\0') return; /* printing to stdout */
+      s4o.print("#line ");
+      s4o.print(s4o.get_line() + 1);
+      s4o.print(" \"");
+      s4o.print(s4o.get_filename());
       s4o.print("\"\n");    
     }
     
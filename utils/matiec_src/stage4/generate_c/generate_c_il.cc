@@ -716,6 +716,7 @@ void *visit(instruction_list_c *symbol) {
     symbol->elements[i]->accept(*this);
     s4o.print(";\n");
   }
+  print_line_directive_reset();
   return NULL;
 }
 
@@ -1106,6 +1107,11 @@ void *visit(il_fb_call_c *symbol) {
   } /* for(...) */
 
   /* now call the function... */
+  if (generate_pou_profile__) {
+    s4o.print("__POU_PROFILE_CALL(\"");
+    s4o.print(pou_profile_site_name(fbname, symbol->fb_name));
+    s4o.print("\", ");
+  }
   function_block_type_name->accept(*this);
   s4o.print(FB_FUNCTION_SUFFIX);
   s4o.print("(");
@@ -1114,6 +1120,8 @@ void *visit(il_fb_call_c *symbol) {
   print_variable_prefix();
   symbol->fb_name->accept(*this);
   s4o.print(")");
+  if (generate_pou_profile__)
+    s4o.print(")");
 
   /* loop through each function parameter, find the variable to which
    * we should atribute the value of all output or inoutput parameters.
@@ -239,6 +239,7 @@ class generate_c_sfc_elements_c: public generate_c_base_and_typeid_c {
           }
           break;
         case transitiontest_sg:
+          print_line_directive(symbol);
           s4o.print(s4o.indent_spaces + "if (");
           symbol->from_steps->accept(*this);
           s4o.print(") {\n");
@@ -283,6 +284,7 @@ class generate_c_sfc_elements_c: public generate_c_base_and_typeid_c {
           s4o.print("],,0);\n");
           s4o.indent_left();
           s4o.print(s4o.indent_spaces + "}\n");
+          print_line_directive_reset();
           break;
         case stepset_sg:
           s4o.print(s4o.indent_spaces + "if (");
@@ -84,6 +84,9 @@ class generate_c_st_c: public generate_c_base_and_typeid_c {
 
     variablegeneration_t wanted_variablegeneration;
 
+    /* Set while printing a BOOL expression with the bitwise operators (option 'b') */
+    bool printing_bitwise_bool;
+
   public:
     generate_c_st_c(stage4out_c *s4o_ptr, symbol_c *name, symbol_c *scope, const char *variable_prefix = NULL)
     : generate_c_base_and_typeid_c(s4o_ptr) {
@@ -98,6 +101,7 @@ class generate_c_st_c: public generate_c_base_and_typeid_c {
       fcall_number = 0;
       fbname = name;
       wanted_variablegeneration = expression_vg;
+      printing_bitwise_bool = false;
     }
 
     virtual ~generate_c_st_c(void) {
@@ -119,7 +123,84 @@ class generate_c_st_c: public generate_c_base_and_typeid_c {
 
 
 
+/* Option 'b': a BOOL expression built only from variables, BOOL literals,
+ * AND, OR, XOR and NOT has no side effects, so nothing is lost by always
+ * evaluating both sides of each operator. Such expressions (the contacts of a
+ * ladder rung, once converted to ST) are printed with the bitwise operators
+ * instead of '&&' and '||', which lets the C compiler evaluate the whole rung
+ * as straight line code instead of with a branch per contact. Variables are
+ * compared with 0 first, so a BOOL holding some other non zero value still
+ * counts as TRUE.
+ */
+static bool is_bitwise_bool_leaf(symbol_c *symbol) {
+  if (NULL != dynamic_cast<boolean_literal_c *>(symbol)) return true;
+  if (!get_datatype_info_c::is_BOOL_compatible(symbol->datatype)) return false;
+  if (NULL != dynamic_cast<symbolic_variable_c *>(symbol)) return true;
+  if (NULL != dynamic_cast<direct_variable_c *>(symbol)) return true;
+  /* a.b.c: only when every part is a plain variable or field */
+  structured_variable_c *field = dynamic_cast<structured_variable_c *>(symbol);
+  while (NULL != field) {
+    if (NULL != dynamic_cast<symbolic_variable_c *>(field->record_variable)) return true;
+    field = dynamic_cast<structured_variable_c *>(field->record_variable);
+  }
+  return false;
+}
+
+static bool is_bitwise_bool_expression(symbol_c *symbol) {
+  if (!get_datatype_info_c::is_BOOL_compatible(symbol->datatype)) return false;
+  if (and_expression_c *exp = dynamic_cast<and_expression_c *>(symbol))
+    return is_bitwise_bool_expression(exp->l_exp) && is_bitwise_bool_expression(exp->r_exp);
+  if (or_expression_c  *exp = dynamic_cast< or_expression_c *>(symbol))
+    return is_bitwise_bool_expression(exp->l_exp) && is_bitwise_bool_expression(exp->r_exp);
+  if (xor_expression_c *exp = dynamic_cast<xor_expression_c *>(symbol))
+    return is_bitwise_bool_expression(exp->l_exp) && is_bitwise_bool_expression(exp->r_exp);
+  if (not_expression_c *exp = dynamic_cast<not_expression_c *>(symbol))
+    return is_bitwise_bool_expression(exp->exp);
+  return is_bitwise_bool_leaf(symbol);
+}
+
+void *print_bitwise_bool_operand(symbol_c *exp) {
+  if ((NULL == dynamic_cast<boolean_literal_c *>(exp)) && is_bitwise_bool_leaf(exp)) {
+    s4o.print("(");
+    exp->accept(*this);
+    s4o.print(" != 0)");
+  } else
+    exp->accept(*this);
+  return NULL;
+}
+
+/* Returns true if the expression was printed with the bitwise operator */
+bool print_bitwise_bool_expression(symbol_c *symbol, symbol_c *l_exp, symbol_c *r_exp, const char *operation) {
+  if (!generate_bitwise_bool__) return false;
+  if (!printing_bitwise_bool && !is_bitwise_bool_expression(symbol)) return false;
+
+  /* the operands are known to qualify too, no need to check them again */
+  bool old_printing_bitwise_bool = printing_bitwise_bool;
+  printing_bitwise_bool = true;
+  s4o.print("(");
+  print_bitwise_bool_operand(l_exp);
+  s4o.print(operation);
+  print_bitwise_bool_operand(r_exp);
+  s4o.print(")");
+  printing_bitwise_bool = old_printing_bitwise_bool;
+  return true;
+}
+
+
 void *print_getter(symbol_c *symbol) {
+  int packed_index = packed_bool_index(scope_, symbol);
+  if (packed_index >= 0) {
+    /* generate_packed_bool.cc does not pack the BOOLs passed by reference */
+    if (wanted_variablegeneration == fparam_output_vg) ERROR;
+    s4o.print(GET_PACKED_BOOL);
+    s4o.print("(");
+    print_variable_prefix();
+    s4o.print(",");
+    s4o.print(packed_index);
+    s4o.print(")");
+    return NULL;
+  }
+
   unsigned int vartype = analyse_variable_c::first_nonfb_vardecltype(symbol, scope_);
   if (wanted_variablegeneration == fparam_output_vg) {
     if (vartype == search_var_instance_decl_c::external_vt) {
@@ -169,6 +250,20 @@ void *print_setter(symbol_c* symbol,
         symbol_c* fb_symbol = NULL,
         symbol_c* fb_value = NULL) {
  
+  int packed_index = (fb_symbol == NULL) ? packed_bool_index(scope_, symbol) : -1;
+  if (packed_index >= 0) {
+    s4o.print(SET_PACKED_BOOL);
+    s4o.print("(");
+    print_variable_prefix();
+    s4o.print(",");
+    s4o.print(packed_index);
+    s4o.print(",");
+    wanted_variablegeneration = expression_vg;
+    print_check_function(type, value, fb_value);
+    s4o.print(")");
+    return NULL;
+  }
+
   if (fb_symbol == NULL) {
     unsigned int vartype = analyse_variable_c::first_nonfb_vardecltype(symbol, scope_);
     symbol_c *first_nonfb = analyse_variable_c::find_first_nonfb(symbol);
@@ -583,8 +678,10 @@ void *visit(ref_expression_c *symbol) {
 
 
 void *visit(or_expression_c *symbol) {
-  if (get_datatype_info_c::is_BOOL_compatible(symbol->datatype))
+  if (get_datatype_info_c::is_BOOL_compatible(symbol->datatype)) {
+    if (print_bitwise_bool_expression(symbol, symbol->l_exp, symbol->r_exp, " | ")) return NULL;
     return print_binary_expression(symbol->l_exp, symbol->r_exp, " || ");
+  }
   if (get_datatype_info_c::is_ANY_nBIT_compatible(symbol->datatype))
     return print_binary_expression(symbol->l_exp, symbol->r_exp, " | ");
   ERROR;
@@ -593,7 +690,9 @@ void *visit(or_expression_c *symbol) {
 
 void *visit(xor_expression_c *symbol) {
   if (get_datatype_info_c::is_BOOL_compatible(symbol->datatype)) {
-    s4o.print("(");
+    if (print_bitwise_bool_expression(symbol, symbol->l_exp, symbol->r_exp, " ^ ")) return NULL;
+    /* the outer parentheses keep '||' from binding to an enclosing '&&' */
+    s4o.print("((");
     symbol->l_exp->accept(*this);
     s4o.print(" && !");
     symbol->r_exp->accept(*this);
@@ -601,7 +700,7 @@ void *visit(xor_expression_c *symbol) {
     symbol->l_exp->accept(*this);
     s4o.print(" && ");
     symbol->r_exp->accept(*this);
-    s4o.print(")");
+    s4o.print("))");
     return NULL;
   }
   if (get_datatype_info_c::is_ANY_nBIT_compatible(symbol->datatype))
@@ -611,8 +710,10 @@ void *visit(xor_expression_c *symbol) {
 }
 
 void *visit(and_expression_c *symbol) {
-  if (get_datatype_info_c::is_BOOL_compatible(symbol->datatype))
+  if (get_datatype_info_c::is_BOOL_compatible(symbol->datatype)) {
+    if (print_bitwise_bool_expression(symbol, symbol->l_exp, symbol->r_exp, " & ")) return NULL;
     return print_binary_expression(symbol->l_exp, symbol->r_exp, " && ");
+  }
   if (get_datatype_info_c::is_ANY_nBIT_compatible(symbol->datatype))
     return print_binary_expression(symbol->l_exp, symbol->r_exp, " & ");
   ERROR;
@@ -930,6 +1031,7 @@ void *visit(statement_list_c *symbol) {
     symbol->elements[i]->accept(*this);
     s4o.print(";\n");
   }
+  print_line_directive_reset();
   return NULL;
 }
 
@@ -1018,6 +1120,11 @@ void *visit(fb_invocation_c *symbol) {
   } /* for(...) */
 
   /* now call the function... */
+  if (generate_pou_profile__) {
+    s4o.print("__POU_PROFILE_CALL(\"");
+    s4o.print(pou_profile_site_name(fbname, symbol->fb_name));
+    s4o.print("\", ");
+  }
   function_block_type_name->accept(*this);
   s4o.print(FB_FUNCTION_SUFFIX);
   s4o.print("(");
@@ -1026,6 +1133,8 @@ void *visit(fb_invocation_c *symbol) {
   print_variable_prefix();
   symbol->fb_name->accept(*this);
   s4o.print(")");
+  if (generate_pou_profile__)
+    s4o.print(")");
 
   /* loop through each function parameter, find the variable to which
    * we should atribute the value of all output or inoutput parameters.
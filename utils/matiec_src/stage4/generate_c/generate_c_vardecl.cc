@@ -957,6 +957,12 @@ class generate_c_vardecl_c: protected generate_c_base_and_typeid_c {
       return NULL;
     }
 
+    /* Bit index of a variable stored in the packed BOOLs of its POU, or -1 (see generate_packed_bool.cc) */
+    int packed_bool(symbol_c *variable) {
+      if ((current_vartype & (private_vt | temp_vt)) == 0) return -1;
+      return packed_bool_index(NULL, variable);
+    }
+
     /* Actually produce the output where variables are declared... */
     /* Note that located variables and EN/ENO are the exception, they
      * being declared in the located_var_decl_c,
@@ -972,6 +978,20 @@ class generate_c_vardecl_c: protected generate_c_base_and_typeid_c {
           (wanted_varformat == init_vf) ||
           (wanted_varformat == localinit_vf)) {
         for(int i = 0; i < list->n; i++) {
+          int packed_index = packed_bool(list->elements[i]);
+          if (packed_index >= 0) {
+            /* declared all together by print_packed_bool_declaration() */
+            if (wanted_varformat == init_vf) {
+              s4o.print(s4o.indent_spaces + SET_PACKED_BOOL "(");
+              print_variable_prefix();
+              s4o.print(",");
+              s4o.print(packed_index);
+              s4o.print(",");
+              this->current_var_init_symbol->accept(*this);
+              s4o.print(");\n");
+            }
+            continue;
+          }
           s4o.print(s4o.indent_spaces);
           if (wanted_varformat == local_vf) {
             if (!is_fb) {
@@ -1101,6 +1121,17 @@ class generate_c_vardecl_c: protected generate_c_base_and_typeid_c {
             print_retain();
             s4o.print(");");
           }
+          else if ((this->current_var_init_symbol != NULL) && (packed_bool(list->elements[i]) >= 0)) {
+            s4o.print(nv->get());
+            s4o.print(INIT_PACKED_BOOL);
+            s4o.print("(");
+            this->print_variable_prefix();
+            s4o.print(",");
+            s4o.print(packed_bool(list->elements[i]));
+            s4o.print(",");
+            this->current_var_init_symbol->accept(*this);
+            s4o.print(")");
+          }
           else if (this->current_var_init_symbol != NULL) {
             s4o.print(nv->get());
             s4o.print(INIT_VAR);
@@ -0,0 +1,283 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2026  OpenPLC Project
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * Packed BOOL variables, used by the 'c' stage 4 option.
+ *
+ * Every BOOL of a PROGRAM or FUNCTION_BLOCK is normally an __IEC_BOOL_t,
+ * a value byte and a flags byte. With the option, the BOOLs declared in the
+ * VAR and VAR_TEMP sections of a POU (neither located, RETAIN, NON_RETAIN
+ * nor CONSTANT) are stored one bit each in the __packed_bool words of the
+ * POU data, and the generated code reads and writes them by their bit
+ * index with the __GET_PACKED_BOOL and __SET_PACKED_BOOL macros of
+ * accessor.h. Their flags live beside the words (see __DECLARE_PACKED_BOOL).
+ *
+ * A bit has no address, so a BOOL is left unpacked when anything may need
+ * one, or when code other than the body of its own POU may reach it:
+ *   - the body of the POU is not in ST (IL and SFC use their own accessors);
+ *   - it is the operand of REF();
+ *   - it is passed to a function that has VAR_OUTPUT or VAR_IN_OUT
+ *     parameters (these are passed by reference);
+ *   - any POU of the library reaches it as a field of a function block
+ *     instance (fb.var).
+ * The bits are numbered in the order the variables are declared.
+ */
+
+
+typedef struct {
+  std::vector<std::string>   names;  /* packed BOOLs of the POU, by bit index */
+  std::map<std::string, int> index;  /* bit index of each packed BOOL, by upper case name */
+} packed_bool_pou_t;
+
+/* Packed BOOLs of each PROGRAM and FUNCTION_BLOCK declaration */
+static std::map<symbol_c *, packed_bool_pou_t> packed_bool_pous;
+/* Bit index of each packed BOOL, by the identifier in its declaration */
+static std::map<symbol_c *, int>               packed_bool_decls;
+
+
+class search_packed_bool_c: public iterator_visitor_c {
+
+  private:
+    typedef enum {
+      candidates_sm,  /* collect the BOOLs that may be packed    */
+      exclusions_sm   /* drop the ones that need to stay as they are */
+    } search_mode_t;
+
+    search_mode_t search_mode;
+    bool          in_packable_section;  /* inside VAR or VAR_TEMP, with no qualifier */
+    symbol_c     *current_pou;
+
+    /* BOOLs that may be packed, by POU, with the identifier they are declared with */
+    std::map<symbol_c *, std::vector<std::pair<std::string, symbol_c *> > > candidates;
+    /* BOOLs that must not be packed, by POU */
+    std::map<symbol_c *, std::set<std::string> > excluded;
+
+  public:
+    search_packed_bool_c(void) {
+      search_mode         = candidates_sm;
+      in_packable_section = false;
+      current_pou         = NULL;
+    }
+    virtual ~search_packed_bool_c(void) {}
+
+    static std::string upper(const char *str) {
+      std::string result(str);
+      for (std::string::size_type i = 0; i < result.size(); i++) result[i] = toupper(result[i]);
+      return result;
+    }
+
+    /* Fill in packed_bool_pous and packed_bool_decls for the whole library */
+    void analyse(symbol_c *library) {
+      search_mode = candidates_sm;
+      library->accept(*this);
+      search_mode = exclusions_sm;
+      library->accept(*this);
+
+      std::map<symbol_c *, std::vector<std::pair<std::string, symbol_c *> > >::iterator pou;
+      for (pou = candidates.begin(); pou != candidates.end(); pou++) {
+        std::set<std::string> &pou_excluded = excluded[pou->first];
+        packed_bool_pou_t     &packed       = packed_bool_pous[pou->first];
+        for (size_t i = 0; i < pou->second.size(); i++) {
+          const std::string &name = pou->second[i].first;
+          if (pou_excluded.count(name)) continue;
+          packed.index[name] = packed.names.size();
+          packed_bool_decls[pou->second[i].second] = packed.names.size();
+          packed.names.push_back(name);
+        }
+      }
+    }
+
+  private:
+    void exclude(symbol_c *pou, symbol_c *variable) {
+      symbolic_variable_c *symbolic_variable = dynamic_cast<symbolic_variable_c *>(variable);
+      if (symbolic_variable == NULL) return;
+      token_c *name = dynamic_cast<token_c *>(symbolic_variable->var_name);
+      if (name == NULL) return;
+      excluded[pou].insert(upper(name->value));
+    }
+
+    void *visit_pou(symbol_c *symbol, symbol_c *var_declarations, symbol_c *body) {
+      current_pou = symbol;
+      if (search_mode == candidates_sm) {
+        /* the packed BOOLs are only reached from ST */
+        if (dynamic_cast<statement_list_c *>(body) != NULL)
+          var_declarations->accept(*this);
+      } else {
+        var_declarations->accept(*this);
+        body->accept(*this);
+      }
+      current_pou = NULL;
+      return NULL;
+    }
+
+    void *visit_packable_section(symbol_c *option, symbol_c *var_decl_list) {
+      if (search_mode == candidates_sm) {
+        in_packable_section = (option == NULL);
+        var_decl_list->accept(*this);
+        in_packable_section = false;
+      } else
+        var_decl_list->accept(*this);
+      return NULL;
+    }
+
+  public:
+    /**************************************/
+    /* B.1.5 - Program organization units */
+    /**************************************/
+    void *visit(function_declaration_c *symbol) {
+      /* functions keep no state, but may reach the BOOLs of an FB through an instance of it */
+      if (search_mode == exclusions_sm) symbol->function_body->accept(*this);
+      return NULL;
+    }
+    void *visit(function_block_declaration_c *symbol) {return visit_pou(symbol, symbol->var_declarations, symbol->fblock_body);}
+    void *visit(program_declaration_c        *symbol) {return visit_pou(symbol, symbol->var_declarations, symbol->function_block_body);}
+
+    /*  VAR [CONSTANT] var_init_decl_list END_VAR */
+    void *visit(var_declarations_c *symbol) {return visit_packable_section(symbol->option, symbol->var_init_decl_list);}
+    /*  VAR_TEMP temp_var_decl_list END_VAR */
+    void *visit(temp_var_decls_c   *symbol) {return visit_packable_section(NULL, symbol->var_decl_list);}
+
+    /*  var1_list ':' simple_spec_init */
+    void *visit(var1_init_decl_c *symbol) {
+      if ((search_mode != candidates_sm) || !in_packable_section || (current_pou == NULL))
+        return iterator_visitor_c::visit(symbol);
+      if (dynamic_cast<bool_type_name_c *>(spec_init_sperator_c::get_spec(symbol->spec_init)) == NULL)
+        return NULL;
+      list_c *list = dynamic_cast<list_c *>(symbol->var1_list);
+      if (list == NULL) ERROR;
+      for (int i = 0; i < list->n; i++) {
+        token_c *name = dynamic_cast<token_c *>(list->elements[i]);
+        if (name == NULL) ERROR;
+        candidates[current_pou].push_back(std::make_pair(upper(name->value), list->elements[i]));
+      }
+      return NULL;
+    }
+
+    /*************************************/
+    /* B.1.4.2   Multi-element Variables */
+    /*************************************/
+    // SYM_REF2(structured_variable_c, record_variable, field_selector)
+    void *visit(structured_variable_c *symbol) {
+      if (search_mode == exclusions_sm) {
+        /* fb.var, from whichever POU: the FB body is not the only code reaching var */
+        function_block_declaration_c *fb_decl = dynamic_cast<function_block_declaration_c *>(symbol->record_variable->datatype);
+        token_c *field = dynamic_cast<token_c *>(symbol->field_selector);
+        if ((fb_decl != NULL) && (field != NULL))
+          excluded[fb_decl].insert(upper(field->value));
+      }
+      return iterator_visitor_c::visit(symbol);
+    }
+
+    /***********************/
+    /* B 3.1 - Expressions */
+    /***********************/
+    void *visit(ref_expression_c *symbol) {
+      if ((search_mode == exclusions_sm) && (current_pou != NULL))
+        exclude(current_pou, symbol->exp);
+      return iterator_visitor_c::visit(symbol);
+    }
+
+    // SYM_REF3(function_invocation_c, function_name, formal_param_list, nonformal_param_list, symbol_c *called_function_declaration; ...)
+    void *visit(function_invocation_c *symbol) {
+      if ((search_mode != exclusions_sm) || (current_pou == NULL))
+        return iterator_visitor_c::visit(symbol);
+
+      /* Output and in_out parameters are passed by reference. The implicit ENO is only
+       * passed when it is assigned, with '=>', which is caught below with the others.
+       */
+      bool by_reference = false;
+      if (symbol->called_function_declaration == NULL) ERROR;
+      function_param_iterator_c fp_iterator(symbol->called_function_declaration);
+      while (fp_iterator.next() != NULL)
+        if (((fp_iterator.param_direction() == function_param_iterator_c::direction_out) ||
+             (fp_iterator.param_direction() == function_param_iterator_c::direction_inout)) &&
+            !fp_iterator.is_en_eno_param_implicit())
+          by_reference = true;
+
+      list_c *nonformal = dynamic_cast<list_c *>(symbol->nonformal_param_list);
+      for (int i = 0; (nonformal != NULL) && (i < nonformal->n); i++)
+        if (by_reference) exclude(current_pou, nonformal->elements[i]);
+
+      list_c *formal = dynamic_cast<list_c *>(symbol->formal_param_list);
+      for (int i = 0; (formal != NULL) && (i < formal->n); i++) {
+        input_variable_param_assignment_c  *input  = dynamic_cast< input_variable_param_assignment_c *>(formal->elements[i]);
+        output_variable_param_assignment_c *output = dynamic_cast<output_variable_param_assignment_c *>(formal->elements[i]);
+        if ((input  != NULL) && by_reference) exclude(current_pou, input->expression);
+        if  (output != NULL)                  exclude(current_pou, output->variable);
+      }
+      return iterator_visitor_c::visit(symbol);
+    }
+}; /* search_packed_bool_c */
+
+
+
+/* Decide which BOOLs of the library get packed. Must run before any POU is generated. */
+static void packed_bool_analyse(symbol_c *library) {
+  packed_bool_pous.clear();
+  packed_bool_decls.clear();
+  search_packed_bool_c search_packed_bool;
+  search_packed_bool.analyse(library);
+}
+
+/* Number of packed BOOLs of a PROGRAM or FUNCTION_BLOCK declaration */
+static int packed_bool_count(symbol_c *pou) {
+  std::map<symbol_c *, packed_bool_pou_t>::iterator iter = packed_bool_pous.find(pou);
+  if (iter == packed_bool_pous.end()) return 0;
+  return iter->second.names.size();
+}
+
+/* Bit index of a variable of a POU, or -1 if it is not packed. The variable is
+ * either the identifier it is declared with, or a symbolic_variable_c in the POU body.
+ */
+static int packed_bool_index(symbol_c *pou, symbol_c *variable) {
+  std::map<symbol_c *, int>::iterator decl = packed_bool_decls.find(variable);
+  if (decl != packed_bool_decls.end()) return decl->second;
+
+  symbolic_variable_c *symbolic_variable = dynamic_cast<symbolic_variable_c *>(variable);
+  if ((symbolic_variable == NULL) || (pou == NULL)) return -1;
+  token_c *name = dynamic_cast<token_c *>(symbolic_variable->var_name);
+  if (name == NULL) return -1;
+  std::map<symbol_c *, packed_bool_pou_t>::iterator iter = packed_bool_pous.find(pou);
+  if (iter == packed_bool_pous.end()) return -1;
+  std::map<std::string, int>::iterator index = iter->second.index.find(search_packed_bool_c::upper(name->value));
+  if (index == iter->second.index.end()) return -1;
+  return index->second;
+}
+
+/* Declare the packed BOOLs in the data structure of a POU */
+static void print_packed_bool_declaration(stage4out_c &s4o, symbol_c *pou) {
+  int count = packed_bool_count(pou);
+  if (count == 0) return;
+  std::vector<std::string> &names = packed_bool_pous[pou].names;
+  s4o.print(s4o.indent_spaces + "// Packed BOOL variables, by bit index:");
+  for (int i = 0; i < count; i++) {
+    if (i % 8 == 0) s4o.print("\n" + s4o.indent_spaces + "//");
+    s4o.print(" ");
+    s4o.print(i);
+    s4o.print(" ");
+    s4o.print(names[i]);
+  }
+  s4o.print("\n" + s4o.indent_spaces + "__DECLARE_PACKED_BOOL(");
+  s4o.print(count);
+  s4o.print(")\n");
+}
@@ -0,0 +1,382 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2026  OpenPLC Project
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * Schedule of the programs of a resource, used by the 'j' stage 4 option.
+ *
+ * The only state that two program instances can share is the global
+ * variables (reached through VAR_EXTERNAL), the located variables (%I, %Q
+ * and %M) and the internal state of a few library function blocks. For
+ * every program instance we compute which of these it reads and which it
+ * writes, including the ones reached through the function blocks it
+ * instantiates and through its program configuration elements.
+ *
+ * Two program instances conflict when one of them writes something the
+ * other one reads or writes. The programs are then split in waves,
+ * keeping the order in which they are declared in the resource: a program
+ * goes to the wave after the last wave holding an earlier program it
+ * conflicts with. Programs in the same wave may run concurrently, and the
+ * waves run one after the other, so every pair of dependent programs still
+ * runs in the declaration order, as it would without the option.
+ *
+ * The analysis is conservative. Anything passed as a parameter of a
+ * function or function block call is taken as written, and so is
+ * everything on the left side of an assignment, including array
+ * subscripts.
+ */
+
+
+typedef std::set<std::string> program_access_set_t;
+
+typedef struct {
+  program_access_set_t reads;
+  program_access_set_t writes;
+} program_access_t;
+
+
+/* Function block types of the standard library that keep state shared by all their instances.
+ * Calling any of them counts as writing that state.
+ */
+static const char *shared_state_fb_types[][2] = {
+  {"PID_CTRL", "PID_CTRL batch engine"},  /* see __pid_batch in iec_control_FB.h */
+  {NULL, NULL}
+};
+
+
+class search_program_access_c: public iterator_visitor_c {
+
+  private:
+    typedef enum {
+      declarations_sm,   /* inside the variable declarations of a POU    */
+      body_sm,           /* inside the body of a POU                     */
+      connections_sm     /* inside the prog_conf_elements of a program   */
+    } search_mode_t;
+
+    search_mode_t     search_mode;
+    bool              writing;
+    program_access_t *access;
+
+    /* Variables of the POU being analysed that refer to shared state */
+    std::set<std::string>              external_variables;  /* VAR_EXTERNAL             */
+    std::map<std::string, std::string> located_variables;   /* name AT location, by name */
+
+    /* Locations of the located global variables of the configuration and the resource */
+    std::map<std::string, std::string> &global_locations;
+
+    /* Access of every function block type analysed so far */
+    static std::map<symbol_c *, program_access_t> fb_type_access;
+
+  public:
+    search_program_access_c(std::map<std::string, std::string> &global_locations_)
+      : global_locations(global_locations_) {
+      search_mode = body_sm;
+      writing     = false;
+      access      = NULL;
+    }
+    virtual ~search_program_access_c(void) {}
+
+    /* Access of a program instance: the body of its program type, plus its connections in the resource */
+    void get_access(program_configuration_c *program, program_access_t *result) {
+      program_type_symtable_t::iterator iter = program_type_symtable.find(program->program_type_name);
+      if (iter == program_type_symtable.end()) ERROR; // The program type MUST be in the symtable.
+      search_program_access_c search_pou(global_locations);
+      search_pou.access = result;
+      iter->second->accept(search_pou);
+
+      if (program->prog_conf_elements != NULL) {
+        search_mode = connections_sm;
+        writing     = true;
+        access      = result;
+        program->prog_conf_elements->accept(*this);
+      }
+    }
+
+    static std::string upper(const char *str) {
+      std::string result(str);
+      for (std::string::size_type i = 0; i < result.size(); i++) result[i] = toupper(result[i]);
+      return result;
+    }
+
+  private:
+    void record(const std::string &key) {
+      if (writing) access->writes.insert(key);
+      else         access->reads .insert(key);
+    }
+
+    void record_global(const char *name) {
+      std::string global = upper(name);
+      record("global " + global);
+      std::map<std::string, std::string>::iterator location = global_locations.find(global);
+      if (location != global_locations.end()) record(location->second);
+    }
+
+    /* Merge the access of a function block type into the access of the POU instantiating it */
+    void merge_fb_type(const char *type_name) {
+      for (int i = 0; shared_state_fb_types[i][0] != NULL; i++)
+        if (upper(type_name) == shared_state_fb_types[i][0])
+          access->writes.insert(shared_state_fb_types[i][1]);
+
+      function_block_type_symtable_t::iterator iter = function_block_type_symtable.find(type_name);
+      if (iter == function_block_type_symtable.end()) return; /* not a function block type */
+
+      function_block_declaration_c *fb_decl = iter->second;
+      if (fb_type_access.find(fb_decl) == fb_type_access.end()) {
+        program_access_t *fb_access = &fb_type_access[fb_decl];
+        search_program_access_c search_fb(global_locations);
+        search_fb.access = fb_access;
+        fb_decl->accept(search_fb);
+      }
+      program_access_t &fb_access = fb_type_access[fb_decl];
+      access->reads .insert(fb_access.reads .begin(), fb_access.reads .end());
+      access->writes.insert(fb_access.writes.begin(), fb_access.writes.end());
+    }
+
+    void *visit_pou(symbol_c *var_declarations, symbol_c *body) {
+      search_mode = declarations_sm;
+      var_declarations->accept(*this);
+      search_mode = body_sm;
+      writing = false;
+      body->accept(*this);
+      return NULL;
+    }
+
+    void *visit_written(symbol_c *symbol) {
+      if (symbol == NULL) return NULL;
+      bool prev_writing = writing;
+      writing = true;
+      symbol->accept(*this);
+      writing = prev_writing;
+      return NULL;
+    }
+
+    void *visit_identifier(token_c *symbol) {
+      switch (search_mode) {
+        case declarations_sm:
+          merge_fb_type(symbol->value);
+          break;
+        case body_sm: {
+          std::string name = upper(symbol->value);
+          std::map<std::string, std::string>::iterator location = located_variables.find(name);
+          if (external_variables.count(name)) record_global(symbol->value);
+          else if (location != located_variables.end()) record(location->second);
+          break;
+        }
+        case connections_sm:
+          record_global(symbol->value);
+          break;
+      }
+      return NULL;
+    }
+
+  public:
+    /*******************************************/
+    /* B 1.1 - Letters, digits and identifiers */
+    /*******************************************/
+    void *visit(                 identifier_c *symbol) {return visit_identifier(symbol);}
+    void *visit(derived_datatype_identifier_c *symbol) {if (search_mode == declarations_sm) merge_fb_type(symbol->value); return NULL;}
+    void *visit(         poutype_identifier_c *symbol) {if (search_mode == declarations_sm) merge_fb_type(symbol->value); return NULL;}
+
+    /********************************************/
+    /* B.1.4.1   Directly Represented Variables */
+    /********************************************/
+    void *visit(direct_variable_c *symbol) {
+      if (search_mode != declarations_sm) record(upper(symbol->value));
+      return NULL;
+    }
+
+    /*************************************/
+    /* B.1.4.2   Multi-element Variables */
+    /*************************************/
+    /* a[i] := ...  only writes a */
+    void *visit(array_variable_c *symbol) {
+      symbol->subscripted_variable->accept(*this);
+      bool prev_writing = writing;
+      writing = false;
+      symbol->subscript_list->accept(*this);
+      writing = prev_writing;
+      return NULL;
+    }
+
+    /* the field names are not variables */
+    void *visit(structured_variable_c *symbol) {
+      symbol->record_variable->accept(*this);
+      return NULL;
+    }
+
+    /******************************************/
+    /* B 1.4.3 - Declaration & Initialisation */
+    /******************************************/
+    void *visit(located_var_decl_c *symbol) {
+      if (symbol->variable_name != NULL) {
+        token_c *location = dynamic_cast<token_c *>(dynamic_cast<location_c *>(symbol->location)->direct_variable);
+        if (location == NULL) ERROR;
+        located_variables[upper(((token_c *)symbol->variable_name)->value)] = upper(location->value);
+      }
+      symbol->located_var_spec_init->accept(*this);
+      return NULL;
+    }
+
+    void *visit(external_declaration_c *symbol) {
+      external_variables.insert(upper(((token_c *)symbol->global_var_name)->value));
+      symbol->specification->accept(*this);
+      return NULL;
+    }
+
+    /**************************************/
+    /* B.1.5 - Program organization units */
+    /**************************************/
+    void *visit(function_declaration_c *symbol) {return NULL;} /* functions can not reach any shared state */
+    void *visit(function_block_declaration_c *symbol) {return visit_pou(symbol->var_declarations, symbol->fblock_body);}
+    void *visit(program_declaration_c *symbol) {return visit_pou(symbol->var_declarations, symbol->function_block_body);}
+
+    /********************************/
+    /* B 1.7 Configuration elements */
+    /********************************/
+    /* only the data source or sink is shared, the program variable is internal */
+    void *visit(prog_cnxn_assign_c *symbol) {return symbol->prog_data_source->accept(*this);}
+    void *visit(prog_cnxn_sendto_c *symbol) {return symbol->data_sink->accept(*this);}
+
+    void *visit(global_var_reference_c *symbol) {
+      record_global(((token_c *)symbol->global_var_name)->value);
+      return NULL;
+    }
+
+    /***********************************/
+    /* B 2.1 Instructions and Operands */
+    /***********************************/
+    void *visit(il_simple_operation_c *symbol) {
+      if (   (typeid(*symbol->il_simple_operator) == typeid(ST_operator_c))
+          || (typeid(*symbol->il_simple_operator) == typeid(STN_operator_c))
+          || (typeid(*symbol->il_simple_operator) == typeid(S_operator_c))
+          || (typeid(*symbol->il_simple_operator) == typeid(R_operator_c)))
+        return visit_written(symbol->il_operand);
+      if (symbol->il_operand != NULL) symbol->il_operand->accept(*this);
+      return NULL;
+    }
+
+    void *visit(il_function_call_c *symbol) {return visit_written(symbol->il_operand_list);}
+    void *visit(il_formal_funct_call_c *symbol) {return visit_written(symbol->il_param_list);}
+
+    void *visit(il_fb_call_c *symbol) {
+      visit_written(symbol->fb_name);
+      visit_written(symbol->il_operand_list);
+      visit_written(symbol->il_param_list);
+      return NULL;
+    }
+
+    /***************************************/
+    /* B.3 - Language ST (Structured Text) */
+    /***************************************/
+    void *visit(function_invocation_c *symbol) {
+      visit_written(symbol->formal_param_list);
+      visit_written(symbol->nonformal_param_list);
+      return NULL;
+    }
+
+    void *visit(assignment_statement_c *symbol) {
+      visit_written(symbol->l_exp);
+      symbol->r_exp->accept(*this);
+      return NULL;
+    }
+
+    void *visit(fb_invocation_c *symbol) {
+      visit_written(symbol->fb_name);
+      visit_written(symbol->formal_param_list);
+      visit_written(symbol->nonformal_param_list);
+      return NULL;
+    }
+};
+
+std::map<symbol_c *, program_access_t> search_program_access_c::fb_type_access;
+
+
+
+class generate_program_schedule_c: public iterator_visitor_c {
+
+  private:
+    std::map<std::string, std::string> global_locations;
+    std::vector<program_configuration_c *> programs;
+
+  public:
+    /* The programs of each wave, in declaration order */
+    std::vector<std::vector<program_configuration_c *> > waves;
+
+    /* The reason a program was not placed in an earlier wave (empty for the programs of the first wave) */
+    std::map<program_configuration_c *, std::string> reasons;
+
+    generate_program_schedule_c(void) {}
+    virtual ~generate_program_schedule_c(void) {}
+
+    /* config_global_vars and resource_global_vars may be NULL */
+    void generate(symbol_c *config_global_vars, symbol_c *resource_global_vars, symbol_c *program_configuration_list) {
+      if (config_global_vars   != NULL) config_global_vars  ->accept(*this);
+      if (resource_global_vars != NULL) resource_global_vars->accept(*this);
+      program_configuration_list->accept(*this);
+
+      std::vector<program_access_t> access(programs.size());
+      std::vector<int> wave(programs.size(), 0);
+      for (unsigned int i = 0; i < programs.size(); i++) {
+        search_program_access_c search_program_access(global_locations);
+        search_program_access.get_access(programs[i], &access[i]);
+
+        for (unsigned int j = 0; j < i; j++) {
+          std::string conflict = find_conflict(access[i], access[j]);
+          if (conflict.empty() || wave[j] + 1 <= wave[i]) continue;
+          wave[i] = wave[j] + 1;
+          reasons[programs[i]] = get_datatype_info_c::get_id_str(programs[j]->program_name) + std::string(" (") + conflict + ")";
+        }
+        if ((unsigned int)wave[i] >= waves.size()) waves.resize(wave[i] + 1);
+        waves[wave[i]].push_back(programs[i]);
+      }
+    }
+
+  private:
+    static std::string find_first(program_access_set_t &a, program_access_set_t &b) {
+      for (program_access_set_t::iterator it = a.begin(); it != a.end(); ++it)
+        if (b.count(*it)) return *it;
+      return "";
+    }
+
+    static std::string find_conflict(program_access_t &a, program_access_t &b) {
+      std::string conflict;
+      if (!(conflict = find_first(a.writes, b.writes)).empty()) return conflict;
+      if (!(conflict = find_first(a.writes, b.reads )).empty()) return conflict;
+      return find_first(a.reads, b.writes);
+    }
+
+  public:
+    /* [global_var_name] location, in the VAR_GLOBAL of the configuration and the resource */
+    void *visit(global_var_spec_c *symbol) {
+      if (symbol->global_var_name == NULL) return NULL;
+      token_c *location = dynamic_cast<token_c *>(dynamic_cast<location_c *>(symbol->location)->direct_variable);
+      if (location == NULL) ERROR;
+      global_locations[search_program_access_c::upper(((token_c *)symbol->global_var_name)->value)] =
+        search_program_access_c::upper(location->value);
+      return NULL;
+    }
+
+    void *visit(program_configuration_c *symbol) {
+      programs.push_back(symbol);
+      return NULL;
+    }
+};
@@ -0,0 +1,491 @@
+/*
+ *  matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ *  Copyright (C) 2026  OpenPLC Project
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * This code is made available on the understanding that it will not be
+ * used in safety-critical situations without a full and competent review.
+ */
+
+/*
+ * Static estimate of the worst case execution time, used by the 'e' stage 4
+ * option.
+ *
+ * Every POU body is costed with the per operation costs of a target profile,
+ * taking the most expensive branch of each IF and CASE, multiplying the body
+ * of each FOR loop by its number of iterations, and adding the estimate of
+ * every function and function block called (the whole call tree). A FOR loop
+ * whose bounds are not constant is bounded by the size of the arrays its
+ * control variable indexes, since going past them would already be a bug in
+ * the program. WHILE and REPEAT loops, FOR loops with no such bound and IL
+ * jumps back to an earlier label can not be bounded: a warning is printed and
+ * their body is counted once, so the estimate of the POU becomes a lower
+ * bound.
+ *
+ * The estimate of each task (the programs running WITH it) is compared with
+ * its INTERVAL, and the estimate of the tick on which every task is due is
+ * compared with the common ticktime. A warning is printed for every one that
+ * does not fit, and the whole report is written to SCAN_ESTIMATE.csv.
+ */
+
+
+/* Cost, in ns, of each kind of operation in the C code iec2c generates, compiled with -O2.
+ * These are conservative figures, including the accessors and the force flag checks.
+ */
+typedef struct {
+  const char *name;
+  double statement;    /* every statement               */
+  double variable;     /* reading or writing a variable */
+  double array_index;  /* indexing an array             */
+  double operation;    /* arithmetic, logic, comparison */
+  double divide;       /* division, modulo and power    */
+  double branch;       /* each condition of IF and CASE */
+  double loop;         /* each iteration of a loop      */
+  double call;         /* calling a function            */
+  double fb_call;      /* calling a function block      */
+} scan_cost_profile_t;
+
+static const scan_cost_profile_t scan_cost_profiles[] = {
+  /* name      statement variable array_index operation divide branch loop call fb_call */
+  {"linux",       1.0,     1.0,       2.0,       1.0,   10.0,   2.0,  2.0, 5.0,  10.0},  /* x86_64 PC                         */
+  {"win",         1.0,     1.0,       2.0,       1.0,   10.0,   2.0,  2.0, 5.0,  10.0},  /* same hardware as linux            */
+  {"rpi",         4.0,     4.0,       6.0,       3.0,   40.0,   6.0,  6.0, 20.0, 40.0},  /* Raspberry Pi class ARM Cortex-A   */
+  {NULL,          0.0,     0.0,       0.0,       0.0,    0.0,   0.0,  0.0, 0.0,   0.0}
+};
+
+
+#define SCAN_ESTIMATE_WARNING(symbol, ...) {                                                             \
+    fprintf(stderr, "%s:%d-%d..%d-%d: warning: ",                                                        \
+            (symbol)->first_file, (symbol)->first_line, (symbol)->first_column,                         \
+                                  (symbol)->last_line,  (symbol)->last_column);                         \
+    fprintf(stderr, __VA_ARGS__);                                                                        \
+    fprintf(stderr, "\n");                                                                               \
+}
+
+
+typedef struct {
+  double ns;
+  bool   bounded;  /* false if some loop could not be bounded, the estimate is then a lower bound */
+} scan_estimate_t;
+
+
+class estimate_pou_cost_c: public iterator_visitor_c {
+
+  private:
+    const scan_cost_profile_t *profile;
+    search_varfb_instance_type_c *search_varfb_instance_type;
+    double estimate;
+    bool   bounded;
+
+    /* Labels of the IL instructions seen so far, to find the jumps back */
+    std::set<std::string> il_labels;
+
+    /* Estimate of every POU analysed so far */
+    static std::map<symbol_c *, scan_estimate_t> pou_estimates;
+    static std::set<symbol_c *> pous_in_progress;
+
+    estimate_pou_cost_c(const scan_cost_profile_t *profile_, symbol_c *scope) {
+      profile  = profile_;
+      search_varfb_instance_type = new search_varfb_instance_type_c(scope);
+      estimate = 0;
+      bounded  = true;
+    }
+
+  public:
+    virtual ~estimate_pou_cost_c(void) {delete search_varfb_instance_type;}
+
+    /* Estimate of a function, function block or program declaration */
+    static scan_estimate_t get_estimate(symbol_c *pou, const scan_cost_profile_t *profile) {
+      scan_estimate_t result = {0, true};
+      if (pou == NULL) return result;
+      if (pou_estimates.find(pou) != pou_estimates.end()) return pou_estimates[pou];
+      if (pous_in_progress.count(pou)) return result; /* recursion is not allowed, stage 3 already complained */
+
+      symbol_c *body = NULL;
+      if      (function_declaration_c       *decl = dynamic_cast<function_declaration_c       *>(pou)) body = decl->function_body;
+      else if (function_block_declaration_c *decl = dynamic_cast<function_block_declaration_c *>(pou)) body = decl->fblock_body;
+      else if (program_declaration_c        *decl = dynamic_cast<program_declaration_c        *>(pou)) body = decl->function_block_body;
+      else ERROR;
+
+      pous_in_progress.insert(pou);
+      estimate_pou_cost_c estimate_pou_cost(profile, pou);
+      if (body != NULL) body->accept(estimate_pou_cost);
+      pous_in_progress.erase(pou);
+
+      result.ns      = estimate_pou_cost.estimate;
+      result.bounded = estimate_pou_cost.bounded;
+      pou_estimates[pou] = result;
+      return result;
+    }
+
+  private:
+    /* Estimate of a part of the body, without adding it to the estimate of the POU */
+    double measure(symbol_c *symbol) {
+      if (symbol == NULL) return 0;
+      double prev_estimate = estimate;
+      estimate = 0;
+      symbol->accept(*this);
+      double result = estimate;
+      estimate = prev_estimate;
+      return result;
+    }
+
+    void add_called_pou(symbol_c *pou) {
+      scan_estimate_t called = get_estimate(pou, profile);
+      estimate += called.ns;
+      bounded   = bounded && called.bounded;
+    }
+
+    static bool get_integer(symbol_c *symbol, long long *value) {
+      if (symbol == NULL) return false;
+      if (VALID_CVALUE( int64, symbol)) {*value = GET_CVALUE( int64, symbol); return true;}
+      if (VALID_CVALUE(uint64, symbol) && GET_CVALUE(uint64, symbol) <= INT64_MAX) {*value = GET_CVALUE(uint64, symbol); return true;}
+      return false;
+    }
+
+    /* Smallest dimension of the arrays the control variable of a FOR loop indexes directly, 0 if there is none */
+    class search_loop_array_bound_c: public iterator_visitor_c {
+      private:
+        const char *control_variable;
+        search_varfb_instance_type_c *search_varfb_instance_type;
+
+      public:
+        unsigned long long bound;
+
+        search_loop_array_bound_c(symbol_c *control_variable_, search_varfb_instance_type_c *search_varfb_instance_type_) {
+          control_variable = get_var_name_c::get_name(control_variable_)->value;
+          search_varfb_instance_type = search_varfb_instance_type_;
+          bound = 0;
+        }
+
+        void *visit(array_variable_c *symbol) {
+          list_c *subscripts = (list_c *)symbol->subscript_list;
+          symbol_c *var_decl = search_varfb_instance_type->get_basetype_decl(symbol->subscripted_variable);
+          if (var_decl != NULL) {
+            array_dimension_iterator_c array_dimension_iterator(var_decl);
+            for (int i = 0; i < subscripts->n; i++) {
+              subrange_c *dimension = array_dimension_iterator.next();
+              if (dimension == NULL) break;
+              if (NULL == dynamic_cast<symbolic_variable_c *>(subscripts->elements[i])) continue;
+              if (strcasecmp(get_var_name_c::get_name(subscripts->elements[i])->value, control_variable) != 0) continue;
+              if ((dimension->dimension > 0) && ((bound == 0) || (dimension->dimension < bound))) bound = dimension->dimension;
+            }
+          }
+          return iterator_visitor_c::visit(symbol);
+        }
+    };
+
+  public:
+    /*********************/
+    /* B 1.4 - Variables */
+    /*********************/
+    void *visit(symbolic_variable_c *symbol) {estimate += profile->variable; return NULL;}
+    void *visit(direct_variable_c   *symbol) {estimate += profile->variable; return NULL;}
+
+    /*************************************/
+    /* B.1.4.2   Multi-element Variables */
+    /*************************************/
+    void *visit(array_variable_c *symbol) {
+      estimate += profile->array_index * ((list_c *)symbol->subscript_list)->n;
+      return iterator_visitor_c::visit(symbol);
+    }
+
+    /* the field names are not variables */
+    void *visit(structured_variable_c *symbol) {return symbol->record_variable->accept(*this);}
+
+    /****************************************/
+    /* B.2 - Language IL (Instruction List) */
+    /****************************************/
+    void *visit(il_instruction_c *symbol) {
+      if (symbol->label != NULL) il_labels.insert(get_datatype_info_c::get_id_str(symbol->label));
+      return iterator_visitor_c::visit(symbol);
+    }
+
+    void *visit(il_simple_operation_c *symbol) {estimate += profile->statement + profile->operation; return iterator_visitor_c::visit(symbol);}
+    void *visit(il_expression_c       *symbol) {estimate += profile->statement + profile->operation; return iterator_visitor_c::visit(symbol);}
+
+    void *visit(il_jump_operation_c *symbol) {
+      estimate += profile->statement + profile->branch;
+      const char *label = get_datatype_info_c::get_id_str(symbol->label);
+      if (il_labels.count(label)) {
+        SCAN_ESTIMATE_WARNING(symbol, "Jump back to label %s forms a loop with no bound. The scan time estimate counts it once.", label);
+        bounded = false;
+      }
+      return NULL;
+    }
+
+    void *visit(il_function_call_c *symbol) {
+      estimate += profile->statement + profile->call;
+      add_called_pou(symbol->called_function_declaration);
+      return iterator_visitor_c::visit(symbol);
+    }
+
+    void *visit(il_formal_funct_call_c *symbol) {
+      estimate += profile->statement + profile->call;
+      add_called_pou(symbol->called_function_declaration);
+      return iterator_visitor_c::visit(symbol);
+    }
+
+    void *visit(il_fb_call_c *symbol) {
+      estimate += profile->statement + profile->fb_call;
+      add_called_pou(symbol->called_fb_declaration);
+      return iterator_visitor_c::visit(symbol);
+    }
+
+    /***************************************/
+    /* B.3 - Language ST (Structured Text) */
+    /***************************************/
+    /***********************/
+    /* B 3.1 - Expressions */
+    /***********************/
+#define __OPERATION_COST(class_name, cost) \
+    void *visit(class_name *symbol) {estimate += profile->cost; return iterator_visitor_c::visit(symbol);}
+
+    __OPERATION_COST(or_expression_c,     operation)
+    __OPERATION_COST(xor_expression_c,    operation)
+    __OPERATION_COST(and_expression_c,    operation)
+    __OPERATION_COST(equ_expression_c,    operation)
+    __OPERATION_COST(notequ_expression_c, operation)
+    __OPERATION_COST(lt_expression_c,     operation)
+    __OPERATION_COST(gt_expression_c,     operation)
+    __OPERATION_COST(le_expression_c,     operation)
+    __OPERATION_COST(ge_expression_c,     operation)
+    __OPERATION_COST(add_expression_c,    operation)
+    __OPERATION_COST(sub_expression_c,    operation)
+    __OPERATION_COST(mul_expression_c,    operation)
+    __OPERATION_COST(div_expression_c,    divide)
+    __OPERATION_COST(mod_expression_c,    divide)
+    __OPERATION_COST(power_expression_c,  divide)
+    __OPERATION_COST(neg_expression_c,    operation)
+    __OPERATION_COST(not_expression_c,    operation)
+#undef __OPERATION_COST
+
+    void *visit(function_invocation_c *symbol) {
+      estimate += profile->call;
+      add_called_pou(symbol->called_function_declaration);
+      return iterator_visitor_c::visit(symbol);
+    }
+
+    /********************/
+    /* B 3.2 Statements */
+    /********************/
+    void *visit(assignment_statement_c *symbol) {estimate += profile->statement; return iterator_visitor_c::visit(symbol);}
+    void *visit(return_statement_c     *symbol) {estimate += profile->statement; return NULL;}
+    void *visit(exit_statement_c       *symbol) {estimate += profile->statement; return NULL;}
+
+    void *visit(fb_invocation_c *symbol) {
+      estimate += profile->statement + profile->fb_call;
+      add_called_pou(symbol->called_fb_declaration);
+      return iterator_visitor_c::visit(symbol);
+    }
+
+    /* Every condition may be evaluated, but only the most expensive branch runs */
+    void *visit(if_statement_c *symbol) {
+      double worst_branch = std::max(measure(symbol->statement_list), measure(symbol->else_statement_list));
+      estimate += profile->statement + profile->branch + measure(symbol->expression);
+      list_c *elseif_list = (list_c *)symbol->elseif_statement_list;
+      for (int i = 0; (elseif_list != NULL) && (i < elseif_list->n); i++) {
+        elseif_statement_c *elseif = (elseif_statement_c *)elseif_list->elements[i];
+        estimate += profile->branch + measure(elseif->expression);
+        worst_branch = std::max(worst_branch, measure(elseif->statement_list));
+      }
+      estimate += worst_branch;
+      return NULL;
+    }
+
+    void *visit(case_statement_c *symbol) {
+      double worst_branch = measure(symbol->statement_list);
+      estimate += profile->statement + measure(symbol->expression);
+      list_c *element_list = (list_c *)symbol->case_element_list;
+      for (int i = 0; (element_list != NULL) && (i < element_list->n); i++) {
+        case_element_c *element = (case_element_c *)element_list->elements[i];
+        estimate += profile->branch * ((list_c *)element->case_list)->n;
+        worst_branch = std::max(worst_branch, measure(element->statement_list));
+      }
+      estimate += worst_branch;
+      return NULL;
+    }
+
+    void *visit(for_statement_c *symbol) {
+      long long beg, end, by = 1;
+      unsigned long long iterations = 0;
+      bool constant_bounds = get_integer(symbol->beg_expression, &beg) && get_integer(symbol->end_expression, &end) &&
+                             ((symbol->by_expression == NULL) || get_integer(symbol->by_expression, &by)) && (by != 0);
+      if (constant_bounds) {
+        if      ((by > 0) && (end >= beg)) iterations = (unsigned long long)(end - beg) / by + 1;
+        else if ((by < 0) && (beg >= end)) iterations = (unsigned long long)(beg - end) / -by + 1;
+      } else {
+        search_loop_array_bound_c search_loop_array_bound(symbol->control_variable, search_varfb_instance_type);
+        symbol->statement_list->accept(search_loop_array_bound);
+        iterations = search_loop_array_bound.bound;
+        if (iterations == 0) {
+          SCAN_ESTIMATE_WARNING(symbol, "FOR loop with no constant bounds and no array to bound it. The scan time estimate counts one iteration.");
+          bounded = false;
+          iterations = 1;
+        }
+      }
+
+      estimate += profile->statement + measure(symbol->beg_expression) + measure(symbol->end_expression) + measure(symbol->by_expression);
+      estimate += iterations * (profile->loop + measure(symbol->statement_list));
+      return NULL;
+    }
+
+    void *visit(while_statement_c *symbol) {
+      SCAN_ESTIMATE_WARNING(symbol, "WHILE loop with no bound. The scan time estimate counts one iteration.");
+      bounded = false;
+      estimate += profile->statement + profile->loop + measure(symbol->expression) + measure(symbol->statement_list);
+      return NULL;
+    }
+
+    void *visit(repeat_statement_c *symbol) {
+      SCAN_ESTIMATE_WARNING(symbol, "REPEAT loop with no bound. The scan time estimate counts one iteration.");
+      bounded = false;
+      estimate += profile->statement + profile->loop + measure(symbol->expression) + measure(symbol->statement_list);
+      return NULL;
+    }
+};
+
+std::map<symbol_c *, scan_estimate_t> estimate_pou_cost_c::pou_estimates;
+std::set<symbol_c *> estimate_pou_cost_c::pous_in_progress;
+
+
+
+class generate_scan_estimate_c: public iterator_visitor_c {
+
+  private:
+    stage4out_c csv_s4o;
+    const scan_cost_profile_t *profile;
+    unsigned long long common_ticktime;
+    bool allow_output;
+
+    /* Totals of the tasks of the resource being visited */
+    typedef struct {
+      symbol_c          *task;
+      unsigned long long interval;  /* ns, 0 for tasks with no INTERVAL */
+      scan_estimate_t    estimate;
+    } task_estimate_t;
+
+    std::vector<task_estimate_t> tasks;
+
+  public:
+    generate_scan_estimate_c(const char *builddir, const char *profile_name, unsigned long long common_ticktime_)
+      : csv_s4o(builddir, "SCAN_ESTIMATE", "csv") {
+      if ((profile_name == NULL) || (profile_name[0] == '\0')) profile_name = scan_cost_profiles[0].name;
+      profile = NULL;
+      for (int i = 0; scan_cost_profiles[i].name != NULL; i++)
+        if (strcmp(scan_cost_profiles[i].name, profile_name) == 0) profile = &scan_cost_profiles[i];
+      if (profile == NULL)
+        STAGE4_ERROR(NULL, NULL, "Unknown target profile '%s' for the scan time estimate (use linux, win or rpi).", profile_name);
+
+      common_ticktime = common_ticktime_;
+      allow_output = true;
+      csv_s4o.print("kind,name,estimate_ns,interval_ns,load_percent,bounded\n");
+    }
+    virtual ~generate_scan_estimate_c(void) {}
+
+  private:
+    void print_row(const char *kind, const char *name, scan_estimate_t estimate, unsigned long long interval) {
+      char buffer[64];
+      csv_s4o.print(kind); csv_s4o.print(",");
+      csv_s4o.print(name); csv_s4o.print(",");
+      csv_s4o.print_long_long_integer((unsigned long long)ceil(estimate.ns), false); csv_s4o.print(",");
+      if (interval > 0) {
+        csv_s4o.print_long_long_integer(interval, false);
+        snprintf(buffer, sizeof(buffer), ",%.2f", estimate.ns * 100 / interval);
+        csv_s4o.print(buffer);
+      } else
+        csv_s4o.print(",");
+      csv_s4o.print(estimate.bounded? ",yes\n" : ",no\n");
+    }
+
+    void check_interval(symbol_c *symbol, const char *what, scan_estimate_t estimate, unsigned long long interval) {
+      if ((interval == 0) || (estimate.ns <= interval)) return;
+      SCAN_ESTIMATE_WARNING(symbol, "%s has an estimated worst case execution time of %.1f us on %s, longer than its interval of %.1f us.",
+                            what, estimate.ns / 1000, profile->name, (double)interval / 1000);
+    }
+
+    void *visit_pou(const char *kind, symbol_c *name, symbol_c *pou) {
+      if (allow_output) print_row(kind, get_datatype_info_c::get_id_str(name), estimate_pou_cost_c::get_estimate(pou, profile), 0);
+      return NULL;
+    }
+
+  public:
+    /********************/
+    /* 2.1.6 - Pragmas  */
+    /********************/
+    void *visit(enable_code_generation_pragma_c  *symbol) {allow_output = true;  return NULL;}
+    void *visit(disable_code_generation_pragma_c *symbol) {allow_output = false; return NULL;}
+
+    /**************************************/
+    /* B.1.5 - Program organization units */
+    /**************************************/
+    void *visit(function_declaration_c       *symbol) {return visit_pou("function",       symbol->derived_function_name, symbol);}
+    void *visit(function_block_declaration_c *symbol) {return visit_pou("function_block", symbol->fblock_name,           symbol);}
+    void *visit(program_declaration_c        *symbol) {return visit_pou("program",        symbol->program_type_name,     symbol);}
+
+    /********************************/
+    /* B 1.7 Configuration elements */
+    /********************************/
+    void *visit(configuration_declaration_c *symbol) {return symbol->resource_declarations->accept(*this);}
+    void *visit(resource_declaration_c      *symbol) {return symbol->resource_declaration ->accept(*this);}
+
+    void *visit(single_resource_declaration_c *symbol) {
+      tasks.clear();
+      symbol->task_configuration_list->accept(*this);
+
+      /* programs with no task run on every tick */
+      task_estimate_t every_tick = {symbol, common_ticktime, {0, true}};
+      list_c *programs = (list_c *)symbol->program_configuration_list;
+      for (int i = 0; i < programs->n; i++) {
+        program_configuration_c *program = (program_configuration_c *)programs->elements[i];
+        program_type_symtable_t::iterator iter = program_type_symtable.find(program->program_type_name);
+        if (iter == program_type_symtable.end()) ERROR; // The program type MUST be in the symtable.
+        scan_estimate_t estimate = estimate_pou_cost_c::get_estimate(iter->second, profile);
+
+        task_estimate_t *task = &every_tick;
+        for (unsigned int t = 0; t < tasks.size(); t++)
+          if ((program->task_name != NULL) && (strcasecmp(get_datatype_info_c::get_id_str(program->task_name),
+                                                          get_datatype_info_c::get_id_str(tasks[t].task)) == 0))
+            task = &tasks[t];
+        task->estimate.ns     += estimate.ns;
+        task->estimate.bounded = task->estimate.bounded && estimate.bounded;
+      }
+
+      /* on the ticks where every task is due, all of them run one after the other */
+      scan_estimate_t scan = every_tick.estimate;
+      for (unsigned int t = 0; t < tasks.size(); t++) {
+        const char *task_name = get_datatype_info_c::get_id_str(tasks[t].task);
+        std::string what = std::string("Task ") + task_name;
+        print_row("task", task_name, tasks[t].estimate, tasks[t].interval);
+        check_interval(tasks[t].task, what.c_str(), tasks[t].estimate, tasks[t].interval);
+        scan.ns     += tasks[t].estimate.ns;
+        scan.bounded = scan.bounded && tasks[t].estimate.bounded;
+      }
+      print_row("scan", "common_ticktime", scan, common_ticktime);
+      check_interval(symbol, "The tick on which every task is due", scan, common_ticktime);
+      return NULL;
+    }
+
+    /*  TASK task_name task_initialization */
+    void *visit(task_configuration_c *symbol) {
+      task_initialization_c *init = (task_initialization_c *)symbol->task_initialization;
+      task_estimate_t task = {symbol->task_name, 0, {0, true}};
+      if ((init != NULL) && (init->interval_data_source != NULL)) task.interval = calculate_time(init->interval_data_source);
+      tasks.push_back(task);
+      return NULL;
+    }
+};
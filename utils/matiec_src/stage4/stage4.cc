@@ -79,6 +79,7 @@ stage4out_c::stage4out_c(std::string indent_level):
   this->indent_level = indent_level;
   this->indent_spaces = "";
   allow_output = true;
+  line = 1;
 }
 
 stage4out_c::stage4out_c(const char *dir, const char *radix, const char *extension, std::string indent_level) {	
@@ -100,9 +101,11 @@ stage4out_c::stage4out_c(const char *dir, const char *radix, const char *extensi
   }
   out = file;
   m_file = file;
+  this->filename = filename;
   this->indent_level = indent_level;
   this->indent_spaces = "";
   allow_output = true;
+  line = 1;
 }
 
 stage4out_c::~stage4out_c(void) {
@@ -136,8 +139,29 @@ void stage4out_c::indent_left(void) {
     indent_spaces.erase();
 }
 
-void *stage4out_c::print(           std::string value) {if (!allow_output) return NULL; *out << value; return NULL;}
-void *stage4out_c::print(           const char *value) {if (!allow_output) return NULL; *out << value; return NULL;}
+const char *stage4out_c::get_filename(void) {
+  return filename.c_str();
+}
+
+unsigned long stage4out_c::get_line(void) {
+  return line;
+}
+
+/* Only strings may contain new lines, so these are the only print() methods that need to count them */
+void *stage4out_c::print(           std::string value) {
+  if (!allow_output) return NULL;
+  for (std::string::size_type i = value.find('\n'); i != std::string::npos; i = value.find('\n', i + 1)) line++;
+  *out << value;
+  return NULL;
+}
+
+void *stage4out_c::print(           const char *value) {
+  if (!allow_output) return NULL;
+  for (const char *p = value; *p != '\0'; p++) if (*p == '\n') line++;
+  *out << value;
+  return NULL;
+}
+
 //void *stage4out_c::print(               int64_t value) {if (!allow_output) return NULL; *out << value; return NULL;}
 //void *stage4out_c::print(              uint64_t value) {if (!allow_output) return NULL; *out << value; return NULL;}
 void *stage4out_c::print(              real64_t value) {if (!allow_output) return NULL; *out << value; return NULL;}
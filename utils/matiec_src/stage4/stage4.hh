@@ -63,6 +63,10 @@ class stage4out_c {
     void indent_right(void);
     void indent_left(void);
 
+    /* Position in the output, used to point #line directives back at the generated file */
+    const char *get_filename(void);
+    unsigned long get_line(void);
+
     void *print(          std::string  value);
     void *print(           const char *value);
     //void *print(               int64_t value); // not required, since we have long long int, or similar
@@ -98,6 +102,12 @@ class stage4out_c {
      */
     bool allow_output;
 
+    /* Name of the output file ("" when printing to stdout), and number of
+     * the line currently being written (the first line is 1).
+     */
+    std::string filename;
+    unsigned long line;
+
 };
 
 
@@ -0,0 +1,249 @@
+/*
+ * matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ * Copyright (C) 2026  OpenPLC Project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * Tests for the control blocks of iec_control_FB.h: LPF, LEAD_LAG and
+ * PID_CTRL, both computed on each call and in the batch engine.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "iec_std_lib.h"
+
+TIME __CURRENT_TIME;
+unsigned long long __next_timer_deadline;
+
+static int failures = 0;
+
+#define CHECK_NEAR(what, value, expected) {\
+    double __value = (value), __expected = (expected);\
+    if (fabs(__value - __expected) > 1e-4) {\
+        printf("[ERROR]    %s: %f, expected %f\n", what, __value, __expected);\
+        failures++;\
+    }\
+}
+
+#define CHECK(what, condition) {\
+    if (!(condition)) {\
+        printf("[ERROR]    %s\n", what);\
+        failures++;\
+    }\
+}
+
+/* 100 ms */
+#define CYCLE_100MS __time_to_timespec(1, 100, 0, 0, 0, 0)
+
+/* The init functions only add the retain flag, like for the instances of
+ * generated programs, which live in zeroed static storage.
+ */
+#define INIT_FB(type, fb) {\
+    memset(fb, 0, sizeof(type));\
+    type##_init__(fb, 0);\
+}
+
+
+static void test_lpf(void) {
+    LPF lpf;
+    int i;
+
+    INIT_FB(LPF, &lpf);
+    lpf.CYCLE.value = CYCLE_100MS;
+    lpf.TF.value = 0.9;
+    lpf.XIN.value = 1.0;
+
+    /* not running: the output follows the input */
+    LPF_body__(&lpf);
+    CHECK_NEAR("LPF stopped", lpf.XOUT.value, 1.0);
+
+    /* a step from 0 to 1 rises by TS / (TF + TS) of the gap each call */
+    lpf.XIN.value = 0.0;
+    LPF_body__(&lpf);
+    lpf.RUN.value = TRUE;
+    lpf.XIN.value = 1.0;
+    for (i = 1; i <= 10; i++) {
+        LPF_body__(&lpf);
+        CHECK_NEAR("LPF step", lpf.XOUT.value, 1.0 - pow(0.9, i));
+    }
+
+    lpf.EN.value = FALSE;
+    lpf.XIN.value = 5.0;
+    LPF_body__(&lpf);
+    CHECK("LPF ENO when disabled", !lpf.ENO.value);
+    CHECK_NEAR("LPF holds when disabled", lpf.XOUT.value, 1.0 - pow(0.9, 10));
+}
+
+
+static void test_lead_lag(void) {
+    LEAD_LAG lead_lag;
+    int i;
+
+    INIT_FB(LEAD_LAG, &lead_lag);
+    lead_lag.CYCLE.value = CYCLE_100MS;
+    lead_lag.GAIN.value = 2.0;
+    lead_lag.LEAD.value = 1.0;
+    lead_lag.LAG.value = 0.9;
+
+    /* not running: the output is the input times the gain */
+    lead_lag.XIN.value = 0.0;
+    LEAD_LAG_body__(&lead_lag);
+    CHECK_NEAR("LEAD_LAG stopped", lead_lag.XOUT.value, 0.0);
+
+    /* the step overshoots by the lead, then settles to the gain */
+    lead_lag.RUN.value = TRUE;
+    lead_lag.XIN.value = 1.0;
+    LEAD_LAG_body__(&lead_lag);
+    CHECK_NEAR("LEAD_LAG step", lead_lag.XOUT.value, 2.0 * 1.1);
+    LEAD_LAG_body__(&lead_lag);
+    CHECK_NEAR("LEAD_LAG second call", lead_lag.XOUT.value, (0.9 * 2.2 + 2.0 * 0.1) / 1.0);
+    for (i = 0; i < 200; i++)
+        LEAD_LAG_body__(&lead_lag);
+    CHECK_NEAR("LEAD_LAG settled", lead_lag.XOUT.value, 2.0);
+}
+
+
+static void pid_setup(PID_CTRL *pid, BOOL batch) {
+    INIT_FB(PID_CTRL, pid);
+    pid->CYCLE.value = CYCLE_100MS;
+    pid->AUTO.value = TRUE;
+    pid->BATCH.value = batch;
+}
+
+
+static void test_pid(void) {
+    PID_CTRL pid;
+    int i;
+
+    /* proportional only, then limited */
+    pid_setup(&pid, FALSE);
+    pid.KP.value = 2.0;
+    pid.SP.value = 1.0;
+    PID_CTRL_body__(&pid);
+    CHECK_NEAR("PID_CTRL P", pid.XOUT.value, 2.0);
+    CHECK("PID_CTRL P not saturated", !pid.SAT.value);
+    pid.YMIN.value = 0.0;
+    pid.YMAX.value = 1.5;
+    PID_CTRL_body__(&pid);
+    CHECK_NEAR("PID_CTRL P limited", pid.XOUT.value, 1.5);
+    CHECK("PID_CTRL P saturated", pid.SAT.value);
+
+    /* integral term: grows by KP * TS / TR * E each call */
+    pid_setup(&pid, FALSE);
+    pid.KP.value = 1.0;
+    pid.TR.value = 1.0;
+    pid.SP.value = 1.0;
+    PID_CTRL_body__(&pid);
+    CHECK_NEAR("PID_CTRL PI first call", pid.XOUT.value, 1.1);
+    PID_CTRL_body__(&pid);
+    CHECK_NEAR("PID_CTRL PI second call", pid.XOUT.value, 1.2);
+
+    /* anti-windup: the integral term stops at the limit... */
+    pid.YMAX.value = 1.5;
+    pid.YMIN.value = -1.5;
+    for (i = 0; i < 100; i++)
+        PID_CTRL_body__(&pid);
+    CHECK_NEAR("PID_CTRL PI saturated", pid.XOUT.value, 1.5);
+    CHECK_NEAR("PID_CTRL integral clamped", pid.ITERM.value, 0.5);
+    /* ...so the output leaves the limit as soon as the error is gone */
+    pid.PV.value = 1.0;
+    PID_CTRL_body__(&pid);
+    CHECK_NEAR("PID_CTRL no windup", pid.XOUT.value, 0.5);
+    CHECK("PID_CTRL no windup, not saturated", !pid.SAT.value);
+
+    /* manual mode follows X0, and switching back to auto is bumpless */
+    pid.AUTO.value = FALSE;
+    pid.X0.value = 0.7;
+    PID_CTRL_body__(&pid);
+    CHECK_NEAR("PID_CTRL manual", pid.XOUT.value, 0.7);
+    pid.AUTO.value = TRUE;
+    PID_CTRL_body__(&pid);
+    CHECK_NEAR("PID_CTRL bumpless", pid.XOUT.value, 0.7);
+
+    /* derivative on the measurement, filtered by TF */
+    pid_setup(&pid, FALSE);
+    pid.KP.value = 1.0;
+    pid.TD.value = 0.5;
+    pid.TF.value = 0.1;
+    PID_CTRL_body__(&pid);
+    CHECK_NEAR("PID_CTRL D steady", pid.XOUT.value, 0.0);
+    pid.PV.value = 1.0;
+    PID_CTRL_body__(&pid);
+    /* E = -1, DTERM = -KP * TD * 1 / (TF + TS) */
+    CHECK_NEAR("PID_CTRL D step", pid.XOUT.value, -1.0 - 0.5 / 0.2);
+    PID_CTRL_body__(&pid);
+    CHECK_NEAR("PID_CTRL D decays", pid.XOUT.value, -1.0 + (0.1 * -2.5) / 0.2);
+}
+
+
+/* A batched loop returns on each call the output the same loop computed
+ * on each call had returned on the previous one.
+ */
+static void test_pid_batch(void) {
+    PID_CTRL direct[2], batched[2];
+    REAL previous[2];
+    int i, loop;
+
+    for (loop = 0; loop < 2; loop++) {
+        pid_setup(&direct[loop], FALSE);
+        pid_setup(&batched[loop], TRUE);
+    }
+
+    for (i = 0; i < 50; i++) {
+        for (loop = 0; loop < 2; loop++) {
+            PID_CTRL *pids[2] = {&direct[loop], &batched[loop]};
+            int j;
+            for (j = 0; j < 2; j++) {
+                PID_CTRL *pid = pids[j];
+                pid->KP.value = loop ? 0.5 : 2.0;
+                pid->TR.value = loop ? 0.0 : 2.0;
+                pid->TD.value = loop ? 0.2 : 0.0;
+                pid->TF.value = 0.05;
+                pid->YMIN.value = -1.0;
+                pid->YMAX.value = loop ? 10.0 : 1.0;
+                pid->SP.value = (i < 20) ? 1.0 : -0.5;
+                pid->PV.value = 0.1 * (i % 7);
+                pid->AUTO.value = (i < 30 || i > 35);
+                pid->X0.value = 0.25;
+            }
+            previous[loop] = direct[loop].XOUT.value;
+            PID_CTRL_body__(&direct[loop]);
+        }
+        for (loop = 0; loop < 2; loop++) {
+            PID_CTRL_body__(&batched[loop]);
+            CHECK_NEAR("PID_CTRL batched, one call behind", batched[loop].XOUT.value, previous[loop]);
+        }
+    }
+    CHECK("PID_CTRL batched, slots", batched[0].SLOT.value == 0 && batched[1].SLOT.value == 1);
+}
+
+
+int main(int argc, char **argv) {
+    test_lpf();
+    test_lead_lag();
+    test_pid();
+    test_pid_batch();
+
+    if (failures == 0)
+        printf("SUCCESS -> All tests passed!\n");
+    else
+        printf("FAILURE -> %d checks failed!\n", failures);
+    return failures != 0;
+}
@@ -0,0 +1,149 @@
+/*
+ * matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ * Copyright (C) 2026  OpenPLC Project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * Tests that TP, TON and TOF record the expiry of a running timer with
+ * __timer_deadline_hint(), so the event driven scan of the runtime wakes up
+ * for it. Built once with EN/ENO (iec_std_FB.h) and once without
+ * (iec_std_FB_no_ENENO.h), see the Makefile.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "iec_std_lib.h"
+
+TIME __CURRENT_TIME;
+unsigned long long __next_timer_deadline;
+
+static int failures = 0;
+
+#define NO_DEADLINE 0xFFFFFFFFFFFFFFFFULL
+
+#define CHECK(what, condition) {\
+    if (!(condition)) {\
+        printf("[ERROR]    %s\n", what);\
+        failures++;\
+    }\
+}
+
+/* The init functions only add the retain flag, like for the instances of
+ * generated programs, which live in zeroed static storage.
+ */
+#define INIT_FB(type, fb) {\
+    memset(fb, 0, sizeof(type));\
+    type##_init__(fb, 0);\
+}
+
+/* Runs the body of a timer at the given second of __CURRENT_TIME and returns
+ * the deadline it recorded, in ns, or NO_DEADLINE.
+ */
+#define RUN_AT(type, fb, seconds) (\
+    __CURRENT_TIME = __time_to_timespec(1, 0, seconds, 0, 0, 0),\
+    __next_timer_deadline = NO_DEADLINE,\
+    type##_body__(fb),\
+    __next_timer_deadline)
+
+#define SECONDS(s) ((unsigned long long)(s) * 1000000000ULL)
+
+
+static void test_tp(void) {
+    TP tp;
+
+    INIT_FB(TP, &tp);
+    tp.PT.value = __time_to_timespec(1, 0, 2, 0, 0, 0);
+
+    CHECK("TP idle records no deadline", RUN_AT(TP, &tp, 10) == NO_DEADLINE);
+    tp.IN.value = TRUE;
+    CHECK("TP pulse start records its end", RUN_AT(TP, &tp, 10) == SECONDS(12));
+    CHECK("TP running pulse records its end", RUN_AT(TP, &tp, 11) == SECONDS(12));
+    CHECK("TP ended pulse records no deadline", RUN_AT(TP, &tp, 12) == NO_DEADLINE);
+    CHECK("TP output is off after the pulse", !tp.Q.value);
+}
+
+
+static void test_ton(void) {
+    TON ton;
+
+    INIT_FB(TON, &ton);
+    ton.PT.value = __time_to_timespec(1, 0, 2, 0, 0, 0);
+
+    CHECK("TON idle records no deadline", RUN_AT(TON, &ton, 10) == NO_DEADLINE);
+    ton.IN.value = TRUE;
+    CHECK("TON start records its expiry", RUN_AT(TON, &ton, 10) == SECONDS(12));
+    CHECK("TON running records its expiry", RUN_AT(TON, &ton, 11) == SECONDS(12));
+    CHECK("TON expired records no deadline", RUN_AT(TON, &ton, 12) == NO_DEADLINE);
+    CHECK("TON output is on after it expires", ton.Q.value);
+    ton.IN.value = FALSE;
+    CHECK("TON reset records no deadline", RUN_AT(TON, &ton, 13) == NO_DEADLINE);
+}
+
+
+static void test_tof(void) {
+    TOF tof;
+
+    INIT_FB(TOF, &tof);
+    tof.PT.value = __time_to_timespec(1, 0, 2, 0, 0, 0);
+
+    tof.IN.value = TRUE;
+    CHECK("TOF input on records no deadline", RUN_AT(TOF, &tof, 10) == NO_DEADLINE);
+    tof.IN.value = FALSE;
+    CHECK("TOF start records its expiry", RUN_AT(TOF, &tof, 11) == SECONDS(13));
+    CHECK("TOF running records its expiry", RUN_AT(TOF, &tof, 12) == SECONDS(13));
+    CHECK("TOF output is on while it runs", tof.Q.value);
+    CHECK("TOF expired records no deadline", RUN_AT(TOF, &tof, 13) == NO_DEADLINE);
+    CHECK("TOF output is off after it expires", !tof.Q.value);
+}
+
+
+static void test_earliest(void) {
+    TON early, late;
+
+    /* of two running timers, the one that expires first is kept */
+    INIT_FB(TON, &early);
+    INIT_FB(TON, &late);
+    early.PT.value = __time_to_timespec(1, 0, 2, 0, 0, 0);
+    late.PT.value = __time_to_timespec(1, 0, 5, 0, 0, 0);
+    early.IN.value = TRUE;
+    late.IN.value = TRUE;
+
+    __CURRENT_TIME = __time_to_timespec(1, 0, 10, 0, 0, 0);
+    __next_timer_deadline = NO_DEADLINE;
+    TON_body__(&late);
+    TON_body__(&early);
+    CHECK("the earliest expiry is kept", __next_timer_deadline == SECONDS(12));
+    TON_body__(&late);
+    CHECK("a later expiry does not replace it", __next_timer_deadline == SECONDS(12));
+}
+
+
+int main(void) {
+    test_tp();
+    test_ton();
+    test_tof();
+    test_earliest();
+
+    if (failures != 0) {
+        printf("FAILURE -> %d test(s) failed!\n", failures);
+        return 1;
+    }
+    printf("SUCCESS -> All tests passed!\n");
+    return 0;
+}
@@ -60,6 +60,7 @@ void config_init__(void);
  **/
  
 TIME __CURRENT_TIME;
+unsigned long long __next_timer_deadline;
 
 #define __LOCATED_VAR(type, name, ...) type __##name;
 #include "LOCATED_VARIABLES.h"
@@ -0,0 +1,60 @@
+/*
+ * matiec - a compiler for the programming languages defined in IEC 61131-3
+ *
+ * Copyright (C) 2026  OpenPLC Project
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * Runs a self checking test program for a few scans.
+ *
+ * The program of the test counts its failed checks in %QW0 and sets
+ * %QX0.0 once it has run them all. Exits with 0 if it did so with no
+ * failure.
+ */
+
+#include <stdio.h>
+
+#include "iec_std_lib.h"
+
+#ifndef SCANS
+#define SCANS 5
+#endif
+
+void config_run__(unsigned long tick);
+void config_init__(void);
+
+TIME __CURRENT_TIME;
+unsigned long long __next_timer_deadline;
+
+#define __LOCATED_VAR(type, name, ...) type __##name;
+#include "LOCATED_VARIABLES.h"
+#undef __LOCATED_VAR
+#define __LOCATED_VAR(type, name, ...) type* name = &__##name;
+#include "LOCATED_VARIABLES.h"
+#undef __LOCATED_VAR
+
+int main(int argc, char **argv)
+{
+    unsigned long tick;
+
+    config_init__();
+    for (tick = 0; tick < SCANS; tick++)
+        config_run__(tick);
+
+    printf("done = %s, failures = %d\n", *__QX0_0 ? "TRUE" : "FALSE", *__QW0);
+    return (*__QX0_0 && *__QW0 == 0) ? 0 : 1;
+}
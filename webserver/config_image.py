@@ -0,0 +1,222 @@
+#Builds the binary configuration image (config.img) the runtime maps at startup
+#instead of parsing mbconfig.cfg and dnp3.cfg. The layout must match
+#core/config_image.h. The text files are validated here, so a bad setting is
+#reported when it is saved and not when the runtime trips over it.
+#
+#Can also be run by hand to convert the text files:
+#    python config_image.py [mbconfig.cfg] [dnp3.cfg] [config.img]
+import os
+import re
+import struct
+import sys
+
+IMAGE_MAGIC = b'OPLCIMG\0'
+IMAGE_VERSION = 1
+MAX_MB_IO = 400
+
+MB_TCP = 1
+MB_RTU = 2
+
+HEADER_FORMAT = '<8sIIIIqqIIIIII'
+DEVICE_FORMAT = '<100s100sBBcBHHiiiiHHHHHHHHHH'
+DNP3_FORMAT = '<I17i'
+
+DEVICE_FIELDS = ['name', 'protocol', 'slave_id', 'address', 'IP_Port', 'RTU_Baud_Rate', 'RTU_Parity', 'RTU_Data_Bits', 'RTU_Stop_Bits', 'RTU_TX_Pause',
+                 'Discrete_Inputs_Start', 'Discrete_Inputs_Size', 'Coils_Start', 'Coils_Size', 'Input_Registers_Start', 'Input_Registers_Size',
+                 'Holding_Registers_Read_Start', 'Holding_Registers_Read_Size', 'Holding_Registers_Start', 'Holding_Registers_Size']
+
+#same order as the present bits in config_image.h
+DNP3_FIELDS = ['local_address', 'remote_address', 'keep_alive_timeout', 'enable_unsolicited', 'select_timeout', 'max_controls_per_request',
+               'max_rx_frag_size', 'max_tx_frag_size', 'event_buffer_size', 'database_size', 'offset_di', 'offset_do', 'offset_ai', 'offset_ao',
+               'sol_confirm_timeout', 'unsol_confirm_timeout', 'unsol_retry_timeout']
+
+class ConfigImageError(Exception): pass
+
+def checksum(data):
+    #FNV-1a, same as imageChecksum() in core/config_image.cpp
+    value = 2166136261
+    for byte in bytearray(data):
+        value = ((value ^ byte) * 16777619) & 0xFFFFFFFF
+    return value
+
+def to_int(value, name, minimum, maximum):
+    try:
+        number = int(value)
+    except ValueError:
+        raise ConfigImageError(name + ' must be a number, not "' + str(value) + '"')
+    if (number < minimum or number > maximum):
+        raise ConfigImageError(name + ' must be between ' + str(minimum) + ' and ' + str(maximum) + ', not ' + str(number))
+    return number
+
+def parse_mbconfig(text):
+    '''
+    Parses the contents of mbconfig.cfg. Returns the polling period, the
+    timeout and the list of devices, each one a dict of its settings
+    '''
+    settings = {}
+    devices = {}
+    for line_number, line in enumerate(text.splitlines(), 1):
+        line = line.strip()
+        if (line == '' or line.startswith('#')):
+            continue
+        match = re.match(r'^([A-Za-z_]+)(\d+)?(?:\.([A-Za-z_]+))?\s*=\s*"(.*)"$', line)
+        if (match == None):
+            raise ConfigImageError('mbconfig.cfg line ' + str(line_number) + ': malformed line "' + line + '"')
+        key, device, field, value = match.groups()
+        if (key == 'device' and device != None and field != None):
+            if (field not in DEVICE_FIELDS):
+                raise ConfigImageError('mbconfig.cfg line ' + str(line_number) + ': unknown setting "' + field + '"')
+            devices.setdefault(int(device), {})[field] = value
+        elif (device == None and field == None and key in ('Num_Devices', 'Polling_Period', 'Timeout')):
+            settings[key] = value
+        else:
+            raise ConfigImageError('mbconfig.cfg line ' + str(line_number) + ': unknown setting "' + line.split('=')[0].strip() + '"')
+
+    num_devices = to_int(settings.get('Num_Devices', '0'), 'Num_Devices', 0, 255)
+    if (sorted(devices.keys()) != list(range(num_devices))):
+        raise ConfigImageError('mbconfig.cfg declares ' + str(num_devices) + ' device(s) but describes ' + str(len(devices)))
+    polling_period = to_int(settings.get('Polling_Period', '100'), 'Polling_Period', 1, 65535)
+    timeout = to_int(settings.get('Timeout', '1000'), 'Timeout', 1, 65535)
+
+    return polling_period, timeout, [devices[i] for i in range(num_devices)]
+
+def pack_device(number, device):
+    name = 'device' + str(number)
+    for field in DEVICE_FIELDS:
+        if (field not in device):
+            raise ConfigImageError(name + ' has no ' + field + ' setting')
+
+    protocol = {'TCP': MB_TCP, 'RTU': MB_RTU}.get(device['protocol'])
+    if (protocol == None):
+        raise ConfigImageError(name + '.protocol must be TCP or RTU, not "' + device['protocol'] + '"')
+    if (len(device['name']) >= 100 or len(device['address']) >= 100):
+        raise ConfigImageError(name + ' has a name or address longer than 99 characters')
+    if (device['address'] == ''):
+        raise ConfigImageError(name + ' has no address')
+
+    ranges = []
+    for area in ('Discrete_Inputs', 'Coils', 'Input_Registers', 'Holding_Registers_Read', 'Holding_Registers'):
+        start = to_int(device[area + '_Start'], name + '.' + area + '_Start', 0, 65535)
+        size = to_int(device[area + '_Size'], name + '.' + area + '_Size', 0, 65535)
+        if (start + size > 65536):
+            raise ConfigImageError(name + ' ' + area + ' go past address 65535')
+        ranges += [start, size]
+
+    #the web form leaves the settings of the other protocol empty or zero
+    def optional_int(field, minimum, maximum):
+        if (protocol == MB_TCP and field.startswith('RTU')) or (protocol == MB_RTU and field == 'IP_Port'):
+            try:
+                return int(device[field])
+            except ValueError:
+                return 0
+        return to_int(device[field], name + '.' + field, minimum, maximum)
+
+    ip_port = optional_int('IP_Port', 1, 65535)
+    baud = optional_int('RTU_Baud_Rate', 1, 4000000)
+    data_bits = optional_int('RTU_Data_Bits', 5, 8)
+    stop_bits = optional_int('RTU_Stop_Bits', 1, 2)
+    parity = (device['RTU_Parity'] + 'N')[0]
+    if (protocol == MB_RTU and parity not in 'NEO'):
+        raise ConfigImageError(name + '.RTU_Parity must be None, Even or Odd, not "' + device['RTU_Parity'] + '"')
+    tx_pause = 0 if device['RTU_TX_Pause'] in ('', 'None') else to_int(device['RTU_TX_Pause'], name + '.RTU_TX_Pause', 0, 2147483647)
+    slave_id = to_int(device['slave_id'], name + '.slave_id', 0, 255)
+
+    return ranges, struct.pack(DEVICE_FORMAT, device['name'].encode(), device['address'].encode(), protocol, slave_id, parity.encode(), 0,
+                               ip_port & 0xFFFF, 0, baud, data_bits, stop_bits, tx_pause, *ranges)
+
+def parse_dnp3_cfg(text):
+    '''
+    Parses the contents of dnp3.cfg. Returns the bitmask of the settings
+    present and the list of values in DNP3_FIELDS order
+    '''
+    present = 0
+    values = [0] * len(DNP3_FIELDS)
+    for line_number, line in enumerate(text.splitlines(), 1):
+        line = line.strip()
+        if (line == '' or line.startswith('#')):
+            continue
+        if ('=' not in line):
+            raise ConfigImageError('dnp3.cfg line ' + str(line_number) + ': malformed line "' + line + '"')
+        key, value = [part.strip() for part in line.split('=', 1)]
+        if (key not in DNP3_FIELDS):
+            raise ConfigImageError('dnp3.cfg line ' + str(line_number) + ': unknown setting "' + key + '"')
+
+        index = DNP3_FIELDS.index(key)
+        if (key == 'keep_alive_timeout' and value == 'MAX'):
+            values[index] = -1
+        elif (key == 'enable_unsolicited'):
+            if (value not in ('True', 'False')):
+                raise ConfigImageError('dnp3.cfg line ' + str(line_number) + ': enable_unsolicited must be True or False')
+            values[index] = 1 if value == 'True' else 0
+        else:
+            values[index] = to_int(value, 'dnp3.cfg line ' + str(line_number) + ': ' + key, 0, 2147483647)
+        present |= (1 << index)
+
+    return present, values
+
+def build_image(mbconfig_text, dnp3_text, mbconfig_mtime = 0, dnp3_mtime = 0):
+    '''
+    Validates the text configuration and returns the image as bytes. Raises
+    ConfigImageError on the first problem found
+    '''
+    polling_period, timeout, devices = parse_mbconfig(mbconfig_text or '')
+
+    device_records = b''
+    totals = [0, 0, 0, 0]
+    for number, device in enumerate(devices):
+        ranges, record = pack_device(number, device)
+        device_records += record
+        totals[0] += ranges[1]
+        totals[1] += ranges[3]
+        totals[2] += ranges[5] + ranges[7]
+        totals[3] += ranges[9]
+    for total, area in zip(totals, ('discrete inputs', 'coils', 'input and holding read registers', 'holding registers')):
+        if (total > MAX_MB_IO):
+            raise ConfigImageError('The slave devices use ' + str(total) + ' ' + area + ', the runtime supports up to ' + str(MAX_MB_IO))
+
+    header_size = struct.calcsize(HEADER_FORMAT)
+    body = device_records
+    dnp3_offset = 0
+    if (dnp3_text != None):
+        present, values = parse_dnp3_cfg(dnp3_text)
+        dnp3_offset = header_size + len(body)
+        body += struct.pack(DNP3_FORMAT, present, *values)
+
+    header = struct.pack(HEADER_FORMAT, IMAGE_MAGIC, IMAGE_VERSION, header_size, header_size + len(body), checksum(body),
+                         int(mbconfig_mtime), int(dnp3_mtime), len(devices), header_size, struct.calcsize(DEVICE_FORMAT),
+                         polling_period, timeout, dnp3_offset)
+    return header + body
+
+def read_text(path):
+    if (not os.path.isfile(path)):
+        return None, 0
+    with open(path, 'r') as f:
+        return f.read(), os.path.getmtime(path)
+
+def convert(mbconfig_path = './mbconfig.cfg', dnp3_path = './dnp3.cfg', image_path = './config.img'):
+    '''
+    Builds the image from the text files. On error the old image is removed,
+    so the runtime does not keep using settings that are out of date, and
+    ConfigImageError is raised
+    '''
+    mbconfig_text, mbconfig_mtime = read_text(mbconfig_path)
+    dnp3_text, dnp3_mtime = read_text(dnp3_path)
+    try:
+        image = build_image(mbconfig_text, dnp3_text, mbconfig_mtime, dnp3_mtime)
+    except ConfigImageError:
+        if (os.path.isfile(image_path)):
+            os.remove(image_path)
+        raise
+
+    #replace the image in one step, the runtime may be mapping it
+    temp_path = image_path + '.tmp'
+    with open(temp_path, 'wb') as f:
+        f.write(image)
+    os.rename(temp_path, image_path)
+
+if __name__ == '__main__':
+    try:
+        convert(*sys.argv[1:4])
+    except ConfigImageError as e:
+        print('Configuration error: ' + str(e))
+        sys.exit(1)
@@ -0,0 +1,177 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 OpenPLC Project
+// This file is part of the OpenPLC Software Stack.
+//
+// OpenPLC is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenPLC is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with OpenPLC.  If not, see <http://www.gnu.org/licenses/>.
+//------
+//
+// Loader for the binary configuration image (see config_image.h). The image
+// is mapped read only and checked once. The Modbus master and the DNP3
+// server then read their settings straight from the mapping. An image that
+// fails any check, or that is older than the text files next to it, is
+// ignored and the runtime falls back to parsing the text files.
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "ladder.h"
+#include "config_image.h"
+
+static const struct config_image_header *config_image = NULL;
+static bool config_image_loaded = false;
+static pthread_mutex_t config_image_lock = PTHREAD_MUTEX_INITIALIZER;
+
+//-----------------------------------------------------------------------------
+// Helper function - FNV-1a hash, same as checksum() in config_image.py
+//-----------------------------------------------------------------------------
+static uint32_t imageChecksum(const unsigned char *data, size_t size)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Returns true if the text file was changed after the
+// image was built from it
+//-----------------------------------------------------------------------------
+static bool newerThanImage(const char *path, int64_t image_mtime)
+{
+    struct stat file_stat;
+    if (stat(path, &file_stat) < 0) return false;
+    return (int64_t)file_stat.st_mtime > image_mtime;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Checks a range of a slave device
+//-----------------------------------------------------------------------------
+static bool validRange(const struct config_image_range *range)
+{
+    return (uint32_t)range->start + range->size <= 65536;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Checks everything the runtime relies on. Returns NULL if
+// the image is valid or the reason it is not
+//-----------------------------------------------------------------------------
+static const char *checkImage(const struct config_image_header *image, size_t size)
+{
+    if (memcmp(image->magic, CONFIG_IMAGE_MAGIC, sizeof(CONFIG_IMAGE_MAGIC)) != 0) return "bad magic";
+    if (image->version != CONFIG_IMAGE_VERSION) return "unsupported version";
+    if (image->header_size != sizeof(struct config_image_header)) return "bad header size";
+    if (image->image_size != size) return "truncated image";
+    if (image->checksum != imageChecksum((const unsigned char *)image + image->header_size, size - image->header_size)) return "bad checksum";
+    if (image->device_size != sizeof(struct config_image_device)) return "bad device record size";
+    if (image->device_count > 255) return "too many devices";
+    if (image->device_offset < image->header_size || image->device_offset % 4 != 0 ||
+        (uint64_t)image->device_offset + (uint64_t)image->device_count * image->device_size > size) return "bad device table";
+    if (image->dnp3_offset != 0 && (image->dnp3_offset < image->header_size || image->dnp3_offset % 4 != 0 ||
+        (uint64_t)image->dnp3_offset + sizeof(struct config_image_dnp3) > size)) return "bad DNP3 section";
+    if (image->device_count > 0 && (image->polling_period == 0 || image->timeout == 0)) return "bad polling period or timeout";
+
+    //the polling thread packs the data of all devices in buffers of MAX_MB_IO
+    int discrete_inputs = 0, coils = 0, input_registers = 0, holding_registers = 0;
+    const struct config_image_device *devices = configImageDevices(image);
+    for (uint32_t i = 0; i < image->device_count; i++)
+    {
+        const struct config_image_device *device = &devices[i];
+        if (memchr(device->name, '\0', sizeof(device->name)) == NULL) return "device name not terminated";
+        if (memchr(device->address, '\0', sizeof(device->address)) == NULL) return "device address not terminated";
+        if (device->protocol != MB_TCP && device->protocol != MB_RTU) return "bad device protocol";
+        if (!validRange(&device->discrete_inputs) || !validRange(&device->coils) || !validRange(&device->input_registers) ||
+            !validRange(&device->holding_read_registers) || !validRange(&device->holding_registers)) return "bad device range";
+
+        discrete_inputs += device->discrete_inputs.size;
+        coils += device->coils.size;
+        input_registers += device->input_registers.size + device->holding_read_registers.size;
+        holding_registers += device->holding_registers.size;
+    }
+    if (discrete_inputs > MAX_MB_IO || coils > MAX_MB_IO || input_registers > MAX_MB_IO || holding_registers > MAX_MB_IO)
+        return "slave devices use more I/O than available";
+
+    return NULL;
+}
+
+//-----------------------------------------------------------------------------
+// Maps and checks config.img the first time it is called. Returns the image,
+// or NULL if the text files have to be used instead
+//-----------------------------------------------------------------------------
+const struct config_image_header *loadConfigImage()
+{
+    unsigned char log_msg[1000];
+
+    pthread_mutex_lock(&config_image_lock);
+    if (config_image_loaded)
+    {
+        pthread_mutex_unlock(&config_image_lock);
+        return config_image;
+    }
+    config_image_loaded = true;
+
+    int fd = open(CONFIG_IMAGE_FILE, O_RDONLY);
+    if (fd < 0)
+    {
+        pthread_mutex_unlock(&config_image_lock);
+        return NULL;
+    }
+
+    struct stat file_stat;
+    void *mapping = MAP_FAILED;
+    if (fstat(fd, &file_stat) == 0 && file_stat.st_size >= (off_t)sizeof(struct config_image_header))
+    {
+        mapping = mmap(NULL, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+
+    if (mapping == MAP_FAILED)
+    {
+        sprintf(log_msg, "Ignoring %s: could not map the file\n", CONFIG_IMAGE_FILE);
+        log(log_msg);
+        pthread_mutex_unlock(&config_image_lock);
+        return NULL;
+    }
+
+    const struct config_image_header *image = (const struct config_image_header *)mapping;
+    const char *problem = checkImage(image, file_stat.st_size);
+    if (problem == NULL && (newerThanImage("mbconfig.cfg", image->mbconfig_mtime) || newerThanImage("dnp3.cfg", image->dnp3_mtime)))
+    {
+        problem = "the text configuration files are newer";
+    }
+
+    if (problem != NULL)
+    {
+        sprintf(log_msg, "Ignoring %s: %s\n", CONFIG_IMAGE_FILE, problem);
+        log(log_msg);
+        munmap(mapping, file_stat.st_size);
+        pthread_mutex_unlock(&config_image_lock);
+        return NULL;
+    }
+
+    sprintf(log_msg, "Loaded configuration image with %d slave device(s)%s\n", image->device_count, image->dnp3_offset ? " and DNP3 settings" : "");
+    log(log_msg);
+    config_image = image;
+    pthread_mutex_unlock(&config_image_lock);
+
+    return config_image;
+}
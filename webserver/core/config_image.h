@@ -0,0 +1,146 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 OpenPLC Project
+// This file is part of the OpenPLC Software Stack.
+//
+// OpenPLC is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenPLC is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with OpenPLC.  If not, see <http://www.gnu.org/licenses/>.
+//------
+//
+// Layout of the binary configuration image (config.img). The webserver
+// builds it from mbconfig.cfg and dnp3.cfg (see webserver/config_image.py)
+// after validating them, and the runtime maps it and reads the settings in
+// place instead of parsing the text files. Every field is little endian and
+// naturally aligned, so the structures below match the file byte for byte.
+// Any change to them must bump CONFIG_IMAGE_VERSION and be mirrored in
+// config_image.py
+//-----------------------------------------------------------------------------
+
+#ifndef CONFIG_IMAGE_H
+#define CONFIG_IMAGE_H
+
+#include <stdint.h>
+
+#define CONFIG_IMAGE_FILE       "config.img"
+#define CONFIG_IMAGE_MAGIC      "OPLCIMG"
+#define CONFIG_IMAGE_VERSION    1
+
+//size of each of the buffers the slave devices are mapped to
+#define MAX_MB_IO               400
+
+#define MB_TCP                  1
+#define MB_RTU                  2
+
+struct config_image_header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t image_size;
+    uint32_t checksum;                  //FNV-1a of everything after the header
+    int64_t mbconfig_mtime;             //modification time of the text files the
+    int64_t dnp3_mtime;                 //image was built from, 0 if missing
+    uint32_t device_count;
+    uint32_t device_offset;
+    uint32_t device_size;
+    uint32_t polling_period;
+    uint32_t timeout;
+    uint32_t dnp3_offset;               //0 if there is no DNP3 section
+};
+
+struct config_image_range
+{
+    uint16_t start;
+    uint16_t size;
+};
+
+struct config_image_device
+{
+    char name[100];
+    char address[100];
+    uint8_t protocol;
+    uint8_t slave_id;
+    char rtu_parity;
+    uint8_t reserved0;
+    uint16_t ip_port;
+    uint16_t reserved1;
+    int32_t rtu_baud;
+    int32_t rtu_data_bits;
+    int32_t rtu_stop_bits;
+    int32_t rtu_tx_pause;
+    struct config_image_range discrete_inputs;
+    struct config_image_range coils;
+    struct config_image_range input_registers;
+    struct config_image_range holding_read_registers;
+    struct config_image_range holding_registers;
+};
+
+//one bit of present per field, in order. Fields that are not present keep
+//the defaults of the DNP3 stack
+#define DNP3_IMAGE_LOCAL_ADDRESS            (1 << 0)
+#define DNP3_IMAGE_REMOTE_ADDRESS           (1 << 1)
+#define DNP3_IMAGE_KEEP_ALIVE_TIMEOUT       (1 << 2)
+#define DNP3_IMAGE_ENABLE_UNSOLICITED       (1 << 3)
+#define DNP3_IMAGE_SELECT_TIMEOUT           (1 << 4)
+#define DNP3_IMAGE_MAX_CONTROLS             (1 << 5)
+#define DNP3_IMAGE_MAX_RX_FRAG_SIZE         (1 << 6)
+#define DNP3_IMAGE_MAX_TX_FRAG_SIZE         (1 << 7)
+#define DNP3_IMAGE_EVENT_BUFFER_SIZE        (1 << 8)
+#define DNP3_IMAGE_DATABASE_SIZE            (1 << 9)
+#define DNP3_IMAGE_OFFSET_DI                (1 << 10)
+#define DNP3_IMAGE_OFFSET_DO                (1 << 11)
+#define DNP3_IMAGE_OFFSET_AI                (1 << 12)
+#define DNP3_IMAGE_OFFSET_AO                (1 << 13)
+#define DNP3_IMAGE_SOL_CONFIRM_TIMEOUT      (1 << 14)
+#define DNP3_IMAGE_UNSOL_CONFIRM_TIMEOUT    (1 << 15)
+#define DNP3_IMAGE_UNSOL_RETRY_TIMEOUT      (1 << 16)
+
+//keep_alive_timeout value for MAX
+#define DNP3_IMAGE_TIMEOUT_MAX              (-1)
+
+struct config_image_dnp3
+{
+    uint32_t present;
+    int32_t local_address;
+    int32_t remote_address;
+    int32_t keep_alive_timeout;
+    int32_t enable_unsolicited;
+    int32_t select_timeout;
+    int32_t max_controls_per_request;
+    int32_t max_rx_frag_size;
+    int32_t max_tx_frag_size;
+    int32_t event_buffer_size;
+    int32_t database_size;
+    int32_t offset_di;
+    int32_t offset_do;
+    int32_t offset_ai;
+    int32_t offset_ao;
+    int32_t sol_confirm_timeout;
+    int32_t unsol_confirm_timeout;
+    int32_t unsol_retry_timeout;
+};
+
+//config_image.cpp
+const struct config_image_header *loadConfigImage();
+
+static inline const struct config_image_device *configImageDevices(const struct config_image_header *image)
+{
+    return (const struct config_image_device *)((const char *)image + image->device_offset);
+}
+
+static inline const struct config_image_dnp3 *configImageDnp3(const struct config_image_header *image)
+{
+    if (image->dnp3_offset == 0) return NULL;
+    return (const struct config_image_dnp3 *)((const char *)image + image->dnp3_offset);
+}
+
+#endif
@@ -27,6 +27,7 @@
 #include <fstream>
 
 #include "ladder.h"
+#include "config_image.h"
 
 //some modbus defines
 #define MAX_DISCRETE_INPUT      8192
@@ -109,6 +110,7 @@ public:
                 *bool_output[index/8][index%8] = crob_val;
             }
             pthread_mutex_unlock(&bufferLock);
+            notifyScanEvent();
         }
         else {
             return_val = CommandStatus::NOT_SUPPORTED;
@@ -136,6 +138,7 @@ public:
             return CommandStatus::OUT_OF_RANGE;
         }
         pthread_mutex_unlock(&bufferLock);
+        notifyScanEvent();
         return CommandStatus::SUCCESS;
     }
 
@@ -154,6 +157,7 @@ public:
             *dint_memory[index - MIN_32B_RANGE] = ao_val;
         }
         pthread_mutex_unlock(&bufferLock);
+        notifyScanEvent();
 
         return CommandStatus::SUCCESS;
     }
@@ -174,6 +178,7 @@ public:
             *dint_memory[index - MIN_32B_RANGE] = ao_val;
         }
         pthread_mutex_unlock(&bufferLock);
+        notifyScanEvent();
 
         return CommandStatus::SUCCESS;
     }
@@ -193,6 +198,7 @@ public:
             *lint_memory[index - MIN_64B_RANGE] = ao_val;
         }
         pthread_mutex_unlock(&bufferLock);
+        notifyScanEvent();
 
         return CommandStatus::SUCCESS;
     }
@@ -282,7 +288,7 @@ OutstationStackConfig create_config() {
                     continue;
             } catch(...) {
                 cout << "Malformatted Line: " << line << endl;
-                exit(1);
+                continue;
             } 
 
         }
@@ -290,10 +296,62 @@ OutstationStackConfig create_config() {
     return OutstationStackConfig(DatabaseSizes::AllTypes(10));
 }
 
+//----------------------------------------------------------------------
+// Build the dnp3 settings from the configuration image. Settings that
+// were not in dnp3.cfg keep the opendnp3 defaults
+//----------------------------------------------------------------------
+OutstationStackConfig imageDNP3Config(const struct config_image_dnp3 *image) {
+    int database_size = (image->present & DNP3_IMAGE_DATABASE_SIZE) ? image->database_size : 10;
+    OutstationStackConfig config(DatabaseSizes::AllTypes(database_size));
+
+    if (image->present & DNP3_IMAGE_LOCAL_ADDRESS)
+        config.link.LocalAddr = image->local_address;
+    if (image->present & DNP3_IMAGE_REMOTE_ADDRESS)
+        config.link.RemoteAddr = image->remote_address;
+    if (image->present & DNP3_IMAGE_KEEP_ALIVE_TIMEOUT) {
+        if (image->keep_alive_timeout == DNP3_IMAGE_TIMEOUT_MAX)
+            config.link.KeepAliveTimeout = openpal::TimeDuration::Max();
+        else
+            config.link.KeepAliveTimeout = openpal::TimeDuration::Seconds(image->keep_alive_timeout);
+    }
+    if (image->present & DNP3_IMAGE_ENABLE_UNSOLICITED)
+        config.outstation.params.allowUnsolicited = (image->enable_unsolicited != 0);
+    if (image->present & DNP3_IMAGE_SELECT_TIMEOUT)
+        config.outstation.params.selectTimeout = openpal::TimeDuration::Seconds(image->select_timeout);
+    if (image->present & DNP3_IMAGE_MAX_CONTROLS)
+        config.outstation.params.maxControlsPerRequest = image->max_controls_per_request;
+    if (image->present & DNP3_IMAGE_MAX_RX_FRAG_SIZE)
+        config.outstation.params.maxRxFragSize = image->max_rx_frag_size;
+    if (image->present & DNP3_IMAGE_MAX_TX_FRAG_SIZE)
+        config.outstation.params.maxTxFragSize = image->max_tx_frag_size;
+    if (image->present & DNP3_IMAGE_EVENT_BUFFER_SIZE)
+        config.outstation.eventBufferConfig = EventBufferConfig::AllTypes(image->event_buffer_size);
+    if (image->present & DNP3_IMAGE_OFFSET_DI)
+        offset_di = image->offset_di;
+    if (image->present & DNP3_IMAGE_OFFSET_DO)
+        offset_do = image->offset_do;
+    if (image->present & DNP3_IMAGE_OFFSET_AI)
+        offset_ai = image->offset_ai;
+    if (image->present & DNP3_IMAGE_OFFSET_AO)
+        offset_ao = image->offset_ao;
+    if (image->present & DNP3_IMAGE_SOL_CONFIRM_TIMEOUT)
+        config.outstation.params.solConfirmTimeout = openpal::TimeDuration::Milliseconds(image->sol_confirm_timeout);
+    if (image->present & DNP3_IMAGE_UNSOL_CONFIRM_TIMEOUT)
+        config.outstation.params.unsolConfirmTimeout = openpal::TimeDuration::Milliseconds(image->unsol_confirm_timeout);
+    if (image->present & DNP3_IMAGE_UNSOL_RETRY_TIMEOUT)
+        config.outstation.params.unsolRetryTimeout = openpal::TimeDuration::Milliseconds(image->unsol_retry_timeout);
+
+    return config;
+}
+
 //----------------------------------------------------------------------
 // parse dnp3.cfg and set dnp3 settings
 //----------------------------------------------------------------------
 OutstationStackConfig parseDNP3Config() {
+    const struct config_image_header *image = loadConfigImage();
+    if (image != NULL && configImageDnp3(image) != NULL)
+        return imageDNP3Config(configImageDnp3(image));
+
     string line;
     ifstream cfgfile("dnp3.cfg");
     OutstationStackConfig config = create_config();
@@ -314,6 +372,7 @@ OutstationStackConfig parseDNP3Config() {
                     config.link.RemoteAddr = atoi(token.c_str());
                 } else if (token == "keep_alive_timeout") {
                     getline(iss, token, '=');     
+                    token = trim(token);
                     if(token == "MAX") {
                         config.link.KeepAliveTimeout = 
                             openpal::TimeDuration::Max();
@@ -324,6 +383,7 @@ OutstationStackConfig parseDNP3Config() {
                     }
                 } else if (token == "enable_unsolicited") {
                     getline(iss, token, '=');
+                    token = trim(token);
                     if(token == "True")
                         config.outstation.params.allowUnsolicited = true;
                     else
@@ -389,7 +449,6 @@ OutstationStackConfig parseDNP3Config() {
             }
             catch(...) {
                 cout << "Malformatted Line: " << line << endl;
-                exit(1);
             }
         }
     }
@@ -0,0 +1,697 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 OpenPLC Project
+// This file is part of the OpenPLC Software Stack.
+//
+// OpenPLC is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenPLC is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with OpenPLC.  If not, see <http://www.gnu.org/licenses/>.
+//------
+//
+// Flight recorder. Right before the program runs, the scan thread appends a
+// frame to an in-memory ring with the tick, the IEC time and every located
+// variable of the program that changed: the inputs (%I) that changed since
+// the previous frame, and the outputs and memory (%Q, %M) that something else
+// than the program wrote since the end of the previous scan (protocol
+// servers, Modbus master, special functions). After the program runs, a hash
+// of the %Q and %M values closes the frame. Frames are delta encoded, with a
+// full frame (keyframe) every FLIGHT_KEYFRAME_SCANS scans so a dump can start
+// at any of them.
+//
+// The scan thread is the only writer and never waits for the readers. A dump
+// copies the ring from the oldest keyframe still in it and then checks that
+// the scan did not overwrite what was copied in the meantime. The ring is
+// dumped to disk when the runtime crashes, when a scan overruns its cycle and
+// with the flight_recorder_dump() command.
+//
+// A dump is replayed by setting flight_replay in runtime.cfg: the runtime
+// then feeds the program with the recorded values, tick and time instead of
+// the live ones, and reports the scans whose outputs differ from the
+// recording. The program starts from its initial state, so state built up
+// before the first keyframe of the dump is not reproduced.
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <signal.h>
+#include <pthread.h>
+#include <semaphore.h>
+
+#include "iec_types.h"
+#include "ladder.h"
+
+#define FLIGHT_FILE_MAGIC       "OPLCFLT"
+#define FLIGHT_FILE_VERSION     1
+#define FLIGHT_KEYFRAME_SCANS   1000
+#define FLIGHT_KEYFRAMES        64
+#define FLIGHT_OVERRUN_INTERVAL 60      //seconds between two dumps on overrun
+
+//frame types. Frames closed by the fault handler have no output hash
+#define FRAME_KEY               'K'
+#define FRAME_DELTA             'D'
+#define FRAME_KEY_OPEN          'k'
+#define FRAME_DELTA_OPEN        'd'
+
+#define FLIGHT_DUMP_FAULT       0
+#define FLIGHT_DUMP_OVERRUN     1
+#define FLIGHT_DUMP_COMMAND     2
+
+static const char *dump_files[] = {"flight_fault.flt", "flight_overrun.flt", "flight_command.flt"};
+
+//size of the ring in KB (configured in runtime.cfg). 0 disables the recorder
+int flight_recorder_kb = 1024;
+//recording to replay instead of the live inputs (configured in runtime.cfg)
+char flight_replay[256] = "";
+
+struct flight_file_header
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t common_ticktime;
+    uint32_t point_count;
+    uint32_t reason;
+    uint64_t frames_size;
+    int64_t dump_time;
+};
+
+struct flight_file_point
+{
+    char area;
+    char size;
+    uint8_t pos2;
+    uint8_t reserved;
+    uint16_t pos1;
+    uint16_t reserved2;
+};
+
+struct flight_point
+{
+    char area;
+    char size;
+    void *value;
+};
+
+extern unsigned long __tick;
+extern IEC_TIME __CURRENT_TIME;
+
+//located variables of the program and their last recorded values
+static struct flight_point *points = NULL;
+static struct flight_file_point *point_table = NULL;
+static uint64_t *point_values = NULL;
+static int num_points = 0;
+
+//ring, written by the scan thread only. write_pos and keyframe_count only
+//grow, positions in the ring are taken modulo ring_size
+static unsigned char *ring = NULL;
+static uint64_t ring_size = 0;
+static uint64_t write_pos = 0;
+static uint64_t keyframes[FLIGHT_KEYFRAMES];
+static uint32_t keyframe_count = 0;
+static int scans_since_keyframe = FLIGHT_KEYFRAME_SCANS;
+static uint64_t keyframe_pos = 0;
+
+//frame being built during the current scan
+static unsigned char *frame_buffer = NULL;
+static unsigned char *frame_end = NULL;
+static bool frame_key = false;
+static volatile bool frame_pending = false;
+
+static pthread_t scan_thread;
+static sem_t dump_request;
+static time_t last_overrun_dump = 0;
+
+//replay
+static unsigned char *replay_data = NULL;
+static size_t replay_size = 0;
+static size_t replay_pos = 0;
+static bool replay_active = false;
+static bool replay_finished = false;
+static bool replay_check = false;
+static uint32_t replay_hash = 0;
+static unsigned long long replay_scans = 0;
+static unsigned long long replay_mismatches = 0;
+
+//-----------------------------------------------------------------------------
+// Helper functions - Variable length encoding of unsigned integers (7 bits
+// per byte, low bits first)
+//-----------------------------------------------------------------------------
+static inline unsigned char *putVarint(unsigned char *p, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        *p++ = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    *p++ = (unsigned char)value;
+    return p;
+}
+
+static inline const unsigned char *getVarint(const unsigned char *p, const unsigned char *end, uint64_t *value)
+{
+    *value = 0;
+    for (int shift = 0; p < end && shift < 64; shift += 7)
+    {
+        *value |= (uint64_t)(*p & 0x7F) << shift;
+        if ((*p++ & 0x80) == 0) return p;
+    }
+    return NULL;
+}
+
+//-----------------------------------------------------------------------------
+// Helper functions - Read and write a located variable as an unsigned integer
+//-----------------------------------------------------------------------------
+static inline uint64_t readPoint(struct flight_point *point)
+{
+    switch (point->size)
+    {
+        case 'X': return *(IEC_BOOL *)point->value;
+        case 'B': return *(IEC_BYTE *)point->value;
+        case 'W': return *(IEC_UINT *)point->value;
+        case 'D': return (uint32_t)*(IEC_DINT *)point->value;
+        default: return (uint64_t)*(IEC_LINT *)point->value;
+    }
+}
+
+static inline void writePoint(struct flight_point *point, uint64_t value)
+{
+    switch (point->size)
+    {
+        case 'X': *(IEC_BOOL *)point->value = (IEC_BOOL)value; break;
+        case 'B': *(IEC_BYTE *)point->value = (IEC_BYTE)value; break;
+        case 'W': *(IEC_UINT *)point->value = (IEC_UINT)value; break;
+        case 'D': *(IEC_DINT *)point->value = (IEC_DINT)(uint32_t)value; break;
+        default: *(IEC_LINT *)point->value = (IEC_LINT)value; break;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - FNV-1a of the %Q and %M values. Also stores them as the
+// values the next scan compares against
+//-----------------------------------------------------------------------------
+static uint32_t hashOutputs()
+{
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < num_points; i++)
+    {
+        if (points[i].area == 'I') continue;
+        uint64_t value = readPoint(&points[i]);
+        point_values[i] = value;
+        for (int b = 0; b < 8; b++)
+        {
+            hash ^= (unsigned char)(value >> (b * 8));
+            hash *= 16777619u;
+        }
+    }
+    return hash;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Returns the variable bound to a located address, or NULL
+// if the program does not use it
+//-----------------------------------------------------------------------------
+static void *locatedPointer(const struct located_address *address)
+{
+    if (address->size == 'X' && address->pos2 >= 8) return NULL;
+
+    if (address->area == 'I' || address->area == 'Q')
+    {
+        if (address->pos1 >= BUFFER_SIZE) return NULL;
+        bool input = (address->area == 'I');
+        if (address->size == 'X') return input ? bool_input[address->pos1][address->pos2] : bool_output[address->pos1][address->pos2];
+        if (address->size == 'B') return input ? (void *)byte_input[address->pos1] : (void *)byte_output[address->pos1];
+        if (address->size == 'W') return input ? int_input[address->pos1] : int_output[address->pos1];
+    }
+    else if (address->area == 'M')
+    {
+        if (address->size == 'W' && address->pos1 < BUFFER_SIZE) return int_memory[address->pos1];
+        if (address->size == 'D' && address->pos1 < BUFFER_SIZE) return dint_memory[address->pos1];
+        if (address->size == 'L' && address->pos1 < BUFFER_SIZE) return lint_memory[address->pos1];
+        if (address->size == 'L' && address->pos1 < 2 * BUFFER_SIZE) return special_functions[address->pos1 - BUFFER_SIZE];
+    }
+    return NULL;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Builds the list of located variables of the program
+//-----------------------------------------------------------------------------
+static bool buildPoints()
+{
+    points = (struct flight_point *)malloc(sizeof(struct flight_point) * (located_address_count + 1));
+    point_table = (struct flight_file_point *)calloc(located_address_count + 1, sizeof(struct flight_file_point));
+    point_values = (uint64_t *)calloc(located_address_count + 1, sizeof(uint64_t));
+    if (points == NULL || point_table == NULL || point_values == NULL) return false;
+
+    num_points = 0;
+    for (int i = 0; i < located_address_count; i++)
+    {
+        void *value = locatedPointer(&located_address_map[i]);
+        if (value == NULL) continue;
+
+        points[num_points].area = located_address_map[i].area;
+        points[num_points].size = located_address_map[i].size;
+        points[num_points].value = value;
+        point_table[num_points].area = located_address_map[i].area;
+        point_table[num_points].size = located_address_map[i].size;
+        point_table[num_points].pos1 = located_address_map[i].pos1;
+        point_table[num_points].pos2 = located_address_map[i].pos2;
+        num_points++;
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Copies a finished frame to the ring
+//-----------------------------------------------------------------------------
+static void commitFrame(char type)
+{
+    unsigned char header[16];
+    size_t body_size = frame_end - frame_buffer;
+    header[0] = type;
+    size_t header_size = putVarint(header + 1, body_size) - header;
+
+    uint64_t pos = write_pos;
+    if (type == FRAME_KEY || type == FRAME_KEY_OPEN)
+    {
+        __atomic_store_n(&keyframes[keyframe_count % FLIGHT_KEYFRAMES], pos, __ATOMIC_RELAXED);
+        keyframe_pos = pos;
+        scans_since_keyframe = 0;
+    }
+
+    const unsigned char *parts[2] = {header, frame_buffer};
+    size_t sizes[2] = {header_size, body_size};
+    for (int part = 0; part < 2; part++)
+    {
+        size_t offset = (pos + (part ? header_size : 0)) % ring_size;
+        size_t first = (sizes[part] < ring_size - offset) ? sizes[part] : ring_size - offset;
+        memcpy(ring + offset, parts[part], first);
+        memcpy(ring, parts[part] + first, sizes[part] - first);
+    }
+
+    __atomic_store_n(&write_pos, pos + header_size + body_size, __ATOMIC_RELEASE);
+    if (type == FRAME_KEY || type == FRAME_KEY_OPEN) __atomic_store_n(&keyframe_count, keyframe_count + 1, __ATOMIC_RELEASE);
+    scans_since_keyframe++;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Writes the ring to a dump file, starting at the oldest
+// keyframe. If the scan overwrote that keyframe while it was being copied,
+// the copy is retried from a newer one. Only uses async-signal-safe calls, so
+// the fault handler can use it. Returns the size of the file or -1
+//-----------------------------------------------------------------------------
+static long writeDump(int reason)
+{
+    int fd = open(dump_files[reason], O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return -1;
+
+    for (int attempt = 0; attempt < 3; attempt++)
+    {
+        uint64_t end = __atomic_load_n(&write_pos, __ATOMIC_ACQUIRE);
+        uint32_t count = __atomic_load_n(&keyframe_count, __ATOMIC_ACQUIRE);
+
+        //the slot of the oldest keyframe may be getting overwritten, skip it
+        uint32_t first = (count > FLIGHT_KEYFRAMES - 1) ? count - (FLIGHT_KEYFRAMES - 1) : 0;
+        uint64_t start = end;
+        bool found = false;
+        for (uint32_t i = first; i < count && !found; i++)
+        {
+            uint64_t pos = __atomic_load_n(&keyframes[i % FLIGHT_KEYFRAMES], __ATOMIC_RELAXED);
+            if (pos + ring_size >= end && pos <= end)
+            {
+                start = pos;
+                found = true;
+            }
+        }
+        if (!found) break;
+
+        struct flight_file_header header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, FLIGHT_FILE_MAGIC, sizeof(FLIGHT_FILE_MAGIC));
+        header.version = FLIGHT_FILE_VERSION;
+        header.header_size = sizeof(header);
+        header.common_ticktime = common_ticktime__;
+        header.point_count = num_points;
+        header.reason = reason;
+        header.frames_size = end - start;
+        header.dump_time = time(NULL);
+
+        size_t table_size = sizeof(struct flight_file_point) * num_points;
+        bool written = (pwrite(fd, &header, sizeof(header), 0) == (ssize_t)sizeof(header)) &&
+                       (pwrite(fd, point_table, table_size, sizeof(header)) == (ssize_t)table_size);
+
+        off_t file_pos = sizeof(header) + table_size;
+        for (uint64_t pos = start; pos < end && written; )
+        {
+            size_t offset = pos % ring_size;
+            size_t chunk = (end - pos < ring_size - offset) ? end - pos : ring_size - offset;
+            written = (pwrite(fd, ring + offset, chunk, file_pos) == (ssize_t)chunk);
+            pos += chunk;
+            file_pos += chunk;
+        }
+
+        //everything copied is still in the ring, the dump is consistent
+        if (written && __atomic_load_n(&write_pos, __ATOMIC_ACQUIRE) <= start + ring_size)
+        {
+            ftruncate(fd, file_pos);
+            close(fd);
+            return file_pos;
+        }
+    }
+
+    close(fd);
+    unlink(dump_files[reason]);
+    return -1;
+}
+
+//-----------------------------------------------------------------------------
+// Fault handler. Closes the frame of the scan that crashed, dumps the ring and
+// lets the signal take its default action
+//-----------------------------------------------------------------------------
+static void flightFaultHandler(int sig)
+{
+    if (pthread_equal(pthread_self(), scan_thread) && frame_pending)
+    {
+        frame_pending = false;
+        commitFrame(frame_key ? FRAME_KEY_OPEN : FRAME_DELTA_OPEN);
+    }
+
+    const char msg[] = "Runtime crashed, flight recorder dumped to flight_fault.flt\n";
+    if (writeDump(FLIGHT_DUMP_FAULT) > 0) write(STDOUT_FILENO, msg, sizeof(msg) - 1);
+    raise(sig);
+}
+
+//-----------------------------------------------------------------------------
+// Dump thread. Writes the dumps requested on overrun, so the scan thread
+// never waits for the disk
+//-----------------------------------------------------------------------------
+static void *flightDumpThread(void *arg)
+{
+    unsigned char log_msg[1000];
+    applyThreadProfile(THREAD_PSTORAGE);
+
+    while (true)
+    {
+        sem_wait(&dump_request);
+        long size = writeDump(FLIGHT_DUMP_OVERRUN);
+        if (size > 0) sprintf(log_msg, "Flight recorder: scan overrun, %ld bytes dumped to %s\n", size, dump_files[FLIGHT_DUMP_OVERRUN]);
+        else sprintf(log_msg, "Flight recorder: scan overrun, could not write %s\n", dump_files[FLIGHT_DUMP_OVERRUN]);
+        log(log_msg);
+    }
+    return NULL;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Loads the recording set in flight_replay. Returns false if
+// it can not be replayed with this program
+//-----------------------------------------------------------------------------
+static bool loadReplay()
+{
+    unsigned char log_msg[1000];
+    const char *problem = NULL;
+    struct flight_file_header header;
+
+    FILE *file = fopen(flight_replay, "rb");
+    if (file == NULL)
+    {
+        sprintf(log_msg, "Flight replay: could not open %s\n", flight_replay);
+        log(log_msg);
+        return false;
+    }
+
+    size_t table_size = sizeof(struct flight_file_point) * num_points;
+    if (fread(&header, sizeof(header), 1, file) != 1) problem = "truncated file";
+    else if (memcmp(header.magic, FLIGHT_FILE_MAGIC, sizeof(FLIGHT_FILE_MAGIC)) != 0) problem = "not a flight recording";
+    else if (header.version != FLIGHT_FILE_VERSION || header.header_size != sizeof(header)) problem = "unsupported version";
+    else if (header.point_count != (uint32_t)num_points) problem = "recorded with a different program";
+
+    if (problem == NULL)
+    {
+        struct flight_file_point *table = (struct flight_file_point *)malloc(table_size + 1);
+        replay_data = (unsigned char *)malloc(header.frames_size + 1);
+        if (table == NULL || replay_data == NULL) problem = "out of memory";
+        else if (fread(table, 1, table_size, file) != table_size || fread(replay_data, 1, header.frames_size, file) != header.frames_size) problem = "truncated file";
+        else if (memcmp(table, point_table, table_size) != 0) problem = "recorded with a different program";
+        free(table);
+    }
+    fclose(file);
+
+    if (problem != NULL)
+    {
+        sprintf(log_msg, "Flight replay: ignoring %s: %s\n", flight_replay, problem);
+        log(log_msg);
+        free(replay_data);
+        replay_data = NULL;
+        return false;
+    }
+
+    replay_size = header.frames_size;
+    replay_pos = 0;
+    sprintf(log_msg, "Flight replay: running the program on %s (%llu bytes of frames). Use a hardware layer that drives no real outputs\n",
+            flight_replay, (unsigned long long)replay_size);
+    log(log_msg);
+    if (header.common_ticktime != common_ticktime__)
+    {
+        sprintf(log_msg, "Flight replay: recorded with a cycle of %llu ns, the program now has %llu ns\n",
+                (unsigned long long)header.common_ticktime, common_ticktime__);
+        log(log_msg);
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Sets up the recorder, or the replay, as configured in runtime.cfg. Called
+// from the scan thread after the buffers are glued
+//-----------------------------------------------------------------------------
+void initFlightRecorder()
+{
+    unsigned char log_msg[1000];
+
+    if (flight_recorder_kb <= 0 && flight_replay[0] == '\0') return;
+    if (!buildPoints())
+    {
+        sprintf(log_msg, "Flight recorder: out of memory\n");
+        log(log_msg);
+        return;
+    }
+
+    if (flight_replay[0] != '\0')
+    {
+        replay_active = loadReplay();
+        return;
+    }
+
+    //worst case frame: header, tick, time, every point and the hash
+    size_t max_frame = 64 + (size_t)num_points * 20;
+    frame_buffer = (unsigned char *)malloc(max_frame);
+    ring_size = (uint64_t)flight_recorder_kb * 1024;
+    if (ring_size < 16 * max_frame) ring_size = 16 * max_frame;
+    ring = (unsigned char *)malloc(ring_size);
+    if (frame_buffer == NULL || ring == NULL)
+    {
+        free(frame_buffer);
+        free(ring);
+        ring = NULL;
+        frame_buffer = NULL;
+        sprintf(log_msg, "Flight recorder: could not allocate %llu KB\n", (unsigned long long)ring_size / 1024);
+        log(log_msg);
+        ring_size = 0;
+        return;
+    }
+    memset(ring, 0, ring_size); //fault the pages in before the scan starts
+
+    scan_thread = pthread_self();
+    sem_init(&dump_request, 0, 0);
+    pthread_t dump_thread;
+    createRuntimeThread(&dump_thread, flightDumpThread, NULL, THREAD_PSTORAGE);
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = flightFaultHandler;
+    action.sa_flags = SA_RESETHAND;
+    sigemptyset(&action.sa_mask);
+    int signals[] = {SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT};
+    for (unsigned int i = 0; i < sizeof(signals) / sizeof(signals[0]); i++) sigaction(signals[i], &action, NULL);
+
+    sprintf(log_msg, "Flight recorder: recording %d located variables in %llu KB\n", num_points, (unsigned long long)ring_size / 1024);
+    log(log_msg);
+}
+
+//-----------------------------------------------------------------------------
+// Returns the memory taken by the ring and the tables, for the memory report
+//-----------------------------------------------------------------------------
+unsigned long long flightRecorderMemory()
+{
+    unsigned long long size = ring_size + replay_size;
+    if (points != NULL) size += (unsigned long long)(located_address_count + 1) * (sizeof(struct flight_point) + sizeof(struct flight_file_point) + sizeof(uint64_t));
+    if (frame_buffer != NULL) size += 64 + (unsigned long long)num_points * 20;
+    return size;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Replays the next frame of the recording. Returns false
+// when there are no frames left
+//-----------------------------------------------------------------------------
+static bool replayScanStart()
+{
+    unsigned char log_msg[1000];
+    const unsigned char *p = replay_data + replay_pos;
+    const unsigned char *end = replay_data + replay_size;
+    uint64_t body_size, tick, time_ns;
+
+    if (replay_finished) return false;
+
+    char type = (p < end) ? *p++ : 0;
+    if (p < end) p = getVarint(p, end, &body_size);
+    const unsigned char *body_end = (p != NULL) ? p + body_size : NULL;
+    bool closed = (type == FRAME_KEY || type == FRAME_DELTA);
+    bool valid = (type == FRAME_KEY || type == FRAME_DELTA || type == FRAME_KEY_OPEN || type == FRAME_DELTA_OPEN) &&
+                 p != NULL && body_end <= end && body_size >= (closed ? 4 : 0);
+    const unsigned char *changes_end = closed ? body_end - 4 : body_end;
+
+    if (valid) p = getVarint(p, changes_end, &tick);
+    if (valid && p != NULL) p = getVarint(p, changes_end, &time_ns);
+    valid = valid && (p != NULL);
+
+    //changes: distance to the previous changed point, new value
+    int index = -1;
+    while (valid && p < changes_end)
+    {
+        uint64_t gap, value;
+        p = getVarint(p, changes_end, &gap);
+        if (p != NULL) p = getVarint(p, changes_end, &value);
+        if (p == NULL || index + 1 + gap >= (uint64_t)num_points)
+        {
+            valid = false;
+            break;
+        }
+        index += 1 + gap;
+        point_values[index] = value;
+    }
+
+    if (!valid)
+    {
+        replay_finished = true;
+        sprintf(log_msg, "Flight replay: finished after %llu scans, %llu of them with outputs different from the recording%s\n",
+                replay_scans, replay_mismatches, (replay_pos < replay_size) ? " (the rest of the file is damaged)" : "");
+        log(log_msg);
+        return false;
+    }
+
+    //the values not in the frame are the ones of the previous scan, which
+    //undoes any live write that came in between
+    for (int i = 0; i < num_points; i++) writePoint(&points[i], point_values[i]);
+
+    replay_check = closed;
+    if (closed) memcpy(&replay_hash, changes_end, 4);
+    replay_pos = body_end - replay_data;
+
+    __tick = tick;
+    __CURRENT_TIME.tv_sec = time_ns / 1000000000ULL;
+    __CURRENT_TIME.tv_nsec = time_ns % 1000000000ULL;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Called by the scan thread right before the program runs. Starts the frame
+// of this scan, or loads the next frame of the replay. Returns false if the
+// program must not run (the replay is over)
+//-----------------------------------------------------------------------------
+bool flightRecorderScanStart()
+{
+    if (replay_active) return replayScanStart();
+    if (ring == NULL) return true;
+
+    frame_key = (scans_since_keyframe >= FLIGHT_KEYFRAME_SCANS || write_pos - keyframe_pos >= ring_size / 4);
+
+    unsigned char *p = frame_buffer;
+    p = putVarint(p, __tick);
+    p = putVarint(p, (uint64_t)__CURRENT_TIME.tv_sec * 1000000000ULL + __CURRENT_TIME.tv_nsec);
+
+    int last = -1;
+    for (int i = 0; i < num_points; i++)
+    {
+        uint64_t value = readPoint(&points[i]);
+        if (!frame_key && value == point_values[i]) continue;
+        p = putVarint(p, i - last - 1);
+        p = putVarint(p, value);
+        point_values[i] = value;
+        last = i;
+    }
+
+    frame_end = p;
+    frame_pending = true;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Called by the scan thread right after the program runs. Closes the frame
+// with the hash of the outputs, or checks them against the recording
+//-----------------------------------------------------------------------------
+void flightRecorderScanEnd()
+{
+    unsigned char log_msg[1000];
+
+    if (replay_active)
+    {
+        if (replay_finished) return;
+        uint32_t hash = hashOutputs();
+        replay_scans++;
+        if (replay_check && hash != replay_hash && replay_mismatches++ == 0)
+        {
+            sprintf(log_msg, "Flight replay: outputs differ from the recording from scan %llu (tick %lu) on\n", replay_scans, __tick - 1);
+            log(log_msg);
+        }
+        return;
+    }
+
+    if (!frame_pending) return;
+    uint32_t hash = hashOutputs();
+    memcpy(frame_end, &hash, 4);
+    frame_end += 4;
+    frame_pending = false;
+    commitFrame(frame_key ? FRAME_KEY : FRAME_DELTA);
+}
+
+//-----------------------------------------------------------------------------
+// Called by the scan pipeline when a scan overruns its cycle. Asks the dump
+// thread for a dump, at most once every FLIGHT_OVERRUN_INTERVAL seconds
+//-----------------------------------------------------------------------------
+void flightRecorderOverrun()
+{
+    if (ring == NULL) return;
+
+    time_t now = time(NULL);
+    if (now - last_overrun_dump < FLIGHT_OVERRUN_INTERVAL) return;
+    last_overrun_dump = now;
+    sem_post(&dump_request);
+}
+
+//-----------------------------------------------------------------------------
+// Dumps the ring on request of the interactive server. Writes the name and
+// size of the file to the buffer and returns the number of characters
+// written, or -1 if there is nothing to dump
+//-----------------------------------------------------------------------------
+int flightRecorderDump(char *buffer, int buffer_size)
+{
+    unsigned char log_msg[1000];
+    if (ring == NULL) return -1;
+
+    long size = writeDump(FLIGHT_DUMP_COMMAND);
+    if (size < 0) return -1;
+
+    sprintf(log_msg, "Issued flight_recorder_dump() command. %ld bytes dumped to %s\n", size, dump_files[FLIGHT_DUMP_COMMAND]);
+    log(log_msg);
+    return snprintf(buffer, buffer_size, "%s,%ld\n", dump_files[FLIGHT_DUMP_COMMAND], size);
+}
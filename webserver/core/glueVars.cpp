@@ -23,6 +23,7 @@
 //-----------------------------------------------------------------------------
 
 #include "iec_std_lib.h"
+#include "located_address.h"
 
 TIME __CURRENT_TIME;
 extern unsigned long long common_ticktime__;
@@ -31,42 +32,2487 @@ extern unsigned long long common_ticktime__;
 //auto-generated glueVars.cpp file
 #define BUFFER_SIZE		1024
 
+//Modbus buffers, defined in modbus.cpp
+extern IEC_BOOL mb_discrete_input[];
+extern IEC_BOOL mb_coils[];
+extern IEC_UINT mb_input_regs[];
+extern IEC_UINT mb_holding_regs[];
+
+//Eight consecutive slots of a Modbus buffer, for the table slots that are not
+//used by the program
+#define __MB_SLOTS(buffer, first) &buffer[first], &buffer[first+1], &buffer[first+2], &buffer[first+3], &buffer[first+4], &buffer[first+5], &buffer[first+6], &buffer[first+7]
+
+#define __LOCATED_VAR(type, name, ...) type __##name;
+#include "LOCATED_VARIABLES.h"
+#undef __LOCATED_VAR
+#define __LOCATED_VAR(type, name, ...) type* name = &__##name;
+#include "LOCATED_VARIABLES.h"
+#undef __LOCATED_VAR
+
 //Booleans
-IEC_BOOL *bool_input[BUFFER_SIZE][8];
-IEC_BOOL *bool_output[BUFFER_SIZE][8];
+extern IEC_BOOL *const bool_input[BUFFER_SIZE][8] = {
+	{__MB_SLOTS(mb_discrete_input, 0)},
+	{__MB_SLOTS(mb_discrete_input, 8)},
+	{__MB_SLOTS(mb_discrete_input, 16)},
+	{__MB_SLOTS(mb_discrete_input, 24)},
+	{__MB_SLOTS(mb_discrete_input, 32)},
+	{__MB_SLOTS(mb_discrete_input, 40)},
+	{__MB_SLOTS(mb_discrete_input, 48)},
+	{__MB_SLOTS(mb_discrete_input, 56)},
+	{__MB_SLOTS(mb_discrete_input, 64)},
+	{__MB_SLOTS(mb_discrete_input, 72)},
+	{__MB_SLOTS(mb_discrete_input, 80)},
+	{__MB_SLOTS(mb_discrete_input, 88)},
+	{__MB_SLOTS(mb_discrete_input, 96)},
+	{__MB_SLOTS(mb_discrete_input, 104)},
+	{__MB_SLOTS(mb_discrete_input, 112)},
+	{__MB_SLOTS(mb_discrete_input, 120)},
+	{__MB_SLOTS(mb_discrete_input, 128)},
+	{__MB_SLOTS(mb_discrete_input, 136)},
+	{__MB_SLOTS(mb_discrete_input, 144)},
+	{__MB_SLOTS(mb_discrete_input, 152)},
+	{__MB_SLOTS(mb_discrete_input, 160)},
+	{__MB_SLOTS(mb_discrete_input, 168)},
+	{__MB_SLOTS(mb_discrete_input, 176)},
+	{__MB_SLOTS(mb_discrete_input, 184)},
+	{__MB_SLOTS(mb_discrete_input, 192)},
+	{__MB_SLOTS(mb_discrete_input, 200)},
+	{__MB_SLOTS(mb_discrete_input, 208)},
+	{__MB_SLOTS(mb_discrete_input, 216)},
+	{__MB_SLOTS(mb_discrete_input, 224)},
+	{__MB_SLOTS(mb_discrete_input, 232)},
+	{__MB_SLOTS(mb_discrete_input, 240)},
+	{__MB_SLOTS(mb_discrete_input, 248)},
+	{__MB_SLOTS(mb_discrete_input, 256)},
+	{__MB_SLOTS(mb_discrete_input, 264)},
+	{__MB_SLOTS(mb_discrete_input, 272)},
+	{__MB_SLOTS(mb_discrete_input, 280)},
+	{__MB_SLOTS(mb_discrete_input, 288)},
+	{__MB_SLOTS(mb_discrete_input, 296)},
+	{__MB_SLOTS(mb_discrete_input, 304)},
+	{__MB_SLOTS(mb_discrete_input, 312)},
+	{__MB_SLOTS(mb_discrete_input, 320)},
+	{__MB_SLOTS(mb_discrete_input, 328)},
+	{__MB_SLOTS(mb_discrete_input, 336)},
+	{__MB_SLOTS(mb_discrete_input, 344)},
+	{__MB_SLOTS(mb_discrete_input, 352)},
+	{__MB_SLOTS(mb_discrete_input, 360)},
+	{__MB_SLOTS(mb_discrete_input, 368)},
+	{__MB_SLOTS(mb_discrete_input, 376)},
+	{__MB_SLOTS(mb_discrete_input, 384)},
+	{__MB_SLOTS(mb_discrete_input, 392)},
+	{__MB_SLOTS(mb_discrete_input, 400)},
+	{__MB_SLOTS(mb_discrete_input, 408)},
+	{__MB_SLOTS(mb_discrete_input, 416)},
+	{__MB_SLOTS(mb_discrete_input, 424)},
+	{__MB_SLOTS(mb_discrete_input, 432)},
+	{__MB_SLOTS(mb_discrete_input, 440)},
+	{__MB_SLOTS(mb_discrete_input, 448)},
+	{__MB_SLOTS(mb_discrete_input, 456)},
+	{__MB_SLOTS(mb_discrete_input, 464)},
+	{__MB_SLOTS(mb_discrete_input, 472)},
+	{__MB_SLOTS(mb_discrete_input, 480)},
+	{__MB_SLOTS(mb_discrete_input, 488)},
+	{__MB_SLOTS(mb_discrete_input, 496)},
+	{__MB_SLOTS(mb_discrete_input, 504)},
+	{__MB_SLOTS(mb_discrete_input, 512)},
+	{__MB_SLOTS(mb_discrete_input, 520)},
+	{__MB_SLOTS(mb_discrete_input, 528)},
+	{__MB_SLOTS(mb_discrete_input, 536)},
+	{__MB_SLOTS(mb_discrete_input, 544)},
+	{__MB_SLOTS(mb_discrete_input, 552)},
+	{__MB_SLOTS(mb_discrete_input, 560)},
+	{__MB_SLOTS(mb_discrete_input, 568)},
+	{__MB_SLOTS(mb_discrete_input, 576)},
+	{__MB_SLOTS(mb_discrete_input, 584)},
+	{__MB_SLOTS(mb_discrete_input, 592)},
+	{__MB_SLOTS(mb_discrete_input, 600)},
+	{__MB_SLOTS(mb_discrete_input, 608)},
+	{__MB_SLOTS(mb_discrete_input, 616)},
+	{__MB_SLOTS(mb_discrete_input, 624)},
+	{__MB_SLOTS(mb_discrete_input, 632)},
+	{__MB_SLOTS(mb_discrete_input, 640)},
+	{__MB_SLOTS(mb_discrete_input, 648)},
+	{__MB_SLOTS(mb_discrete_input, 656)},
+	{__MB_SLOTS(mb_discrete_input, 664)},
+	{__MB_SLOTS(mb_discrete_input, 672)},
+	{__MB_SLOTS(mb_discrete_input, 680)},
+	{__MB_SLOTS(mb_discrete_input, 688)},
+	{__MB_SLOTS(mb_discrete_input, 696)},
+	{__MB_SLOTS(mb_discrete_input, 704)},
+	{__MB_SLOTS(mb_discrete_input, 712)},
+	{__MB_SLOTS(mb_discrete_input, 720)},
+	{__MB_SLOTS(mb_discrete_input, 728)},
+	{__MB_SLOTS(mb_discrete_input, 736)},
+	{__MB_SLOTS(mb_discrete_input, 744)},
+	{__MB_SLOTS(mb_discrete_input, 752)},
+	{__MB_SLOTS(mb_discrete_input, 760)},
+	{__MB_SLOTS(mb_discrete_input, 768)},
+	{__MB_SLOTS(mb_discrete_input, 776)},
+	{__MB_SLOTS(mb_discrete_input, 784)},
+	{__MB_SLOTS(mb_discrete_input, 792)},
+	{__MB_SLOTS(mb_discrete_input, 800)},
+	{__MB_SLOTS(mb_discrete_input, 808)},
+	{__MB_SLOTS(mb_discrete_input, 816)},
+	{__MB_SLOTS(mb_discrete_input, 824)},
+	{__MB_SLOTS(mb_discrete_input, 832)},
+	{__MB_SLOTS(mb_discrete_input, 840)},
+	{__MB_SLOTS(mb_discrete_input, 848)},
+	{__MB_SLOTS(mb_discrete_input, 856)},
+	{__MB_SLOTS(mb_discrete_input, 864)},
+	{__MB_SLOTS(mb_discrete_input, 872)},
+	{__MB_SLOTS(mb_discrete_input, 880)},
+	{__MB_SLOTS(mb_discrete_input, 888)},
+	{__MB_SLOTS(mb_discrete_input, 896)},
+	{__MB_SLOTS(mb_discrete_input, 904)},
+	{__MB_SLOTS(mb_discrete_input, 912)},
+	{__MB_SLOTS(mb_discrete_input, 920)},
+	{__MB_SLOTS(mb_discrete_input, 928)},
+	{__MB_SLOTS(mb_discrete_input, 936)},
+	{__MB_SLOTS(mb_discrete_input, 944)},
+	{__MB_SLOTS(mb_discrete_input, 952)},
+	{__MB_SLOTS(mb_discrete_input, 960)},
+	{__MB_SLOTS(mb_discrete_input, 968)},
+	{__MB_SLOTS(mb_discrete_input, 976)},
+	{__MB_SLOTS(mb_discrete_input, 984)},
+	{__MB_SLOTS(mb_discrete_input, 992)},
+	{__MB_SLOTS(mb_discrete_input, 1000)},
+	{__MB_SLOTS(mb_discrete_input, 1008)},
+	{__MB_SLOTS(mb_discrete_input, 1016)},
+	{__MB_SLOTS(mb_discrete_input, 1024)},
+	{__MB_SLOTS(mb_discrete_input, 1032)},
+	{__MB_SLOTS(mb_discrete_input, 1040)},
+	{__MB_SLOTS(mb_discrete_input, 1048)},
+	{__MB_SLOTS(mb_discrete_input, 1056)},
+	{__MB_SLOTS(mb_discrete_input, 1064)},
+	{__MB_SLOTS(mb_discrete_input, 1072)},
+	{__MB_SLOTS(mb_discrete_input, 1080)},
+	{__MB_SLOTS(mb_discrete_input, 1088)},
+	{__MB_SLOTS(mb_discrete_input, 1096)},
+	{__MB_SLOTS(mb_discrete_input, 1104)},
+	{__MB_SLOTS(mb_discrete_input, 1112)},
+	{__MB_SLOTS(mb_discrete_input, 1120)},
+	{__MB_SLOTS(mb_discrete_input, 1128)},
+	{__MB_SLOTS(mb_discrete_input, 1136)},
+	{__MB_SLOTS(mb_discrete_input, 1144)},
+	{__MB_SLOTS(mb_discrete_input, 1152)},
+	{__MB_SLOTS(mb_discrete_input, 1160)},
+	{__MB_SLOTS(mb_discrete_input, 1168)},
+	{__MB_SLOTS(mb_discrete_input, 1176)},
+	{__MB_SLOTS(mb_discrete_input, 1184)},
+	{__MB_SLOTS(mb_discrete_input, 1192)},
+	{__MB_SLOTS(mb_discrete_input, 1200)},
+	{__MB_SLOTS(mb_discrete_input, 1208)},
+	{__MB_SLOTS(mb_discrete_input, 1216)},
+	{__MB_SLOTS(mb_discrete_input, 1224)},
+	{__MB_SLOTS(mb_discrete_input, 1232)},
+	{__MB_SLOTS(mb_discrete_input, 1240)},
+	{__MB_SLOTS(mb_discrete_input, 1248)},
+	{__MB_SLOTS(mb_discrete_input, 1256)},
+	{__MB_SLOTS(mb_discrete_input, 1264)},
+	{__MB_SLOTS(mb_discrete_input, 1272)},
+	{__MB_SLOTS(mb_discrete_input, 1280)},
+	{__MB_SLOTS(mb_discrete_input, 1288)},
+	{__MB_SLOTS(mb_discrete_input, 1296)},
+	{__MB_SLOTS(mb_discrete_input, 1304)},
+	{__MB_SLOTS(mb_discrete_input, 1312)},
+	{__MB_SLOTS(mb_discrete_input, 1320)},
+	{__MB_SLOTS(mb_discrete_input, 1328)},
+	{__MB_SLOTS(mb_discrete_input, 1336)},
+	{__MB_SLOTS(mb_discrete_input, 1344)},
+	{__MB_SLOTS(mb_discrete_input, 1352)},
+	{__MB_SLOTS(mb_discrete_input, 1360)},
+	{__MB_SLOTS(mb_discrete_input, 1368)},
+	{__MB_SLOTS(mb_discrete_input, 1376)},
+	{__MB_SLOTS(mb_discrete_input, 1384)},
+	{__MB_SLOTS(mb_discrete_input, 1392)},
+	{__MB_SLOTS(mb_discrete_input, 1400)},
+	{__MB_SLOTS(mb_discrete_input, 1408)},
+	{__MB_SLOTS(mb_discrete_input, 1416)},
+	{__MB_SLOTS(mb_discrete_input, 1424)},
+	{__MB_SLOTS(mb_discrete_input, 1432)},
+	{__MB_SLOTS(mb_discrete_input, 1440)},
+	{__MB_SLOTS(mb_discrete_input, 1448)},
+	{__MB_SLOTS(mb_discrete_input, 1456)},
+	{__MB_SLOTS(mb_discrete_input, 1464)},
+	{__MB_SLOTS(mb_discrete_input, 1472)},
+	{__MB_SLOTS(mb_discrete_input, 1480)},
+	{__MB_SLOTS(mb_discrete_input, 1488)},
+	{__MB_SLOTS(mb_discrete_input, 1496)},
+	{__MB_SLOTS(mb_discrete_input, 1504)},
+	{__MB_SLOTS(mb_discrete_input, 1512)},
+	{__MB_SLOTS(mb_discrete_input, 1520)},
+	{__MB_SLOTS(mb_discrete_input, 1528)},
+	{__MB_SLOTS(mb_discrete_input, 1536)},
+	{__MB_SLOTS(mb_discrete_input, 1544)},
+	{__MB_SLOTS(mb_discrete_input, 1552)},
+	{__MB_SLOTS(mb_discrete_input, 1560)},
+	{__MB_SLOTS(mb_discrete_input, 1568)},
+	{__MB_SLOTS(mb_discrete_input, 1576)},
+	{__MB_SLOTS(mb_discrete_input, 1584)},
+	{__MB_SLOTS(mb_discrete_input, 1592)},
+	{__MB_SLOTS(mb_discrete_input, 1600)},
+	{__MB_SLOTS(mb_discrete_input, 1608)},
+	{__MB_SLOTS(mb_discrete_input, 1616)},
+	{__MB_SLOTS(mb_discrete_input, 1624)},
+	{__MB_SLOTS(mb_discrete_input, 1632)},
+	{__MB_SLOTS(mb_discrete_input, 1640)},
+	{__MB_SLOTS(mb_discrete_input, 1648)},
+	{__MB_SLOTS(mb_discrete_input, 1656)},
+	{__MB_SLOTS(mb_discrete_input, 1664)},
+	{__MB_SLOTS(mb_discrete_input, 1672)},
+	{__MB_SLOTS(mb_discrete_input, 1680)},
+	{__MB_SLOTS(mb_discrete_input, 1688)},
+	{__MB_SLOTS(mb_discrete_input, 1696)},
+	{__MB_SLOTS(mb_discrete_input, 1704)},
+	{__MB_SLOTS(mb_discrete_input, 1712)},
+	{__MB_SLOTS(mb_discrete_input, 1720)},
+	{__MB_SLOTS(mb_discrete_input, 1728)},
+	{__MB_SLOTS(mb_discrete_input, 1736)},
+	{__MB_SLOTS(mb_discrete_input, 1744)},
+	{__MB_SLOTS(mb_discrete_input, 1752)},
+	{__MB_SLOTS(mb_discrete_input, 1760)},
+	{__MB_SLOTS(mb_discrete_input, 1768)},
+	{__MB_SLOTS(mb_discrete_input, 1776)},
+	{__MB_SLOTS(mb_discrete_input, 1784)},
+	{__MB_SLOTS(mb_discrete_input, 1792)},
+	{__MB_SLOTS(mb_discrete_input, 1800)},
+	{__MB_SLOTS(mb_discrete_input, 1808)},
+	{__MB_SLOTS(mb_discrete_input, 1816)},
+	{__MB_SLOTS(mb_discrete_input, 1824)},
+	{__MB_SLOTS(mb_discrete_input, 1832)},
+	{__MB_SLOTS(mb_discrete_input, 1840)},
+	{__MB_SLOTS(mb_discrete_input, 1848)},
+	{__MB_SLOTS(mb_discrete_input, 1856)},
+	{__MB_SLOTS(mb_discrete_input, 1864)},
+	{__MB_SLOTS(mb_discrete_input, 1872)},
+	{__MB_SLOTS(mb_discrete_input, 1880)},
+	{__MB_SLOTS(mb_discrete_input, 1888)},
+	{__MB_SLOTS(mb_discrete_input, 1896)},
+	{__MB_SLOTS(mb_discrete_input, 1904)},
+	{__MB_SLOTS(mb_discrete_input, 1912)},
+	{__MB_SLOTS(mb_discrete_input, 1920)},
+	{__MB_SLOTS(mb_discrete_input, 1928)},
+	{__MB_SLOTS(mb_discrete_input, 1936)},
+	{__MB_SLOTS(mb_discrete_input, 1944)},
+	{__MB_SLOTS(mb_discrete_input, 1952)},
+	{__MB_SLOTS(mb_discrete_input, 1960)},
+	{__MB_SLOTS(mb_discrete_input, 1968)},
+	{__MB_SLOTS(mb_discrete_input, 1976)},
+	{__MB_SLOTS(mb_discrete_input, 1984)},
+	{__MB_SLOTS(mb_discrete_input, 1992)},
+	{__MB_SLOTS(mb_discrete_input, 2000)},
+	{__MB_SLOTS(mb_discrete_input, 2008)},
+	{__MB_SLOTS(mb_discrete_input, 2016)},
+	{__MB_SLOTS(mb_discrete_input, 2024)},
+	{__MB_SLOTS(mb_discrete_input, 2032)},
+	{__MB_SLOTS(mb_discrete_input, 2040)},
+	{__MB_SLOTS(mb_discrete_input, 2048)},
+	{__MB_SLOTS(mb_discrete_input, 2056)},
+	{__MB_SLOTS(mb_discrete_input, 2064)},
+	{__MB_SLOTS(mb_discrete_input, 2072)},
+	{__MB_SLOTS(mb_discrete_input, 2080)},
+	{__MB_SLOTS(mb_discrete_input, 2088)},
+	{__MB_SLOTS(mb_discrete_input, 2096)},
+	{__MB_SLOTS(mb_discrete_input, 2104)},
+	{__MB_SLOTS(mb_discrete_input, 2112)},
+	{__MB_SLOTS(mb_discrete_input, 2120)},
+	{__MB_SLOTS(mb_discrete_input, 2128)},
+	{__MB_SLOTS(mb_discrete_input, 2136)},
+	{__MB_SLOTS(mb_discrete_input, 2144)},
+	{__MB_SLOTS(mb_discrete_input, 2152)},
+	{__MB_SLOTS(mb_discrete_input, 2160)},
+	{__MB_SLOTS(mb_discrete_input, 2168)},
+	{__MB_SLOTS(mb_discrete_input, 2176)},
+	{__MB_SLOTS(mb_discrete_input, 2184)},
+	{__MB_SLOTS(mb_discrete_input, 2192)},
+	{__MB_SLOTS(mb_discrete_input, 2200)},
+	{__MB_SLOTS(mb_discrete_input, 2208)},
+	{__MB_SLOTS(mb_discrete_input, 2216)},
+	{__MB_SLOTS(mb_discrete_input, 2224)},
+	{__MB_SLOTS(mb_discrete_input, 2232)},
+	{__MB_SLOTS(mb_discrete_input, 2240)},
+	{__MB_SLOTS(mb_discrete_input, 2248)},
+	{__MB_SLOTS(mb_discrete_input, 2256)},
+	{__MB_SLOTS(mb_discrete_input, 2264)},
+	{__MB_SLOTS(mb_discrete_input, 2272)},
+	{__MB_SLOTS(mb_discrete_input, 2280)},
+	{__MB_SLOTS(mb_discrete_input, 2288)},
+	{__MB_SLOTS(mb_discrete_input, 2296)},
+	{__MB_SLOTS(mb_discrete_input, 2304)},
+	{__MB_SLOTS(mb_discrete_input, 2312)},
+	{__MB_SLOTS(mb_discrete_input, 2320)},
+	{__MB_SLOTS(mb_discrete_input, 2328)},
+	{__MB_SLOTS(mb_discrete_input, 2336)},
+	{__MB_SLOTS(mb_discrete_input, 2344)},
+	{__MB_SLOTS(mb_discrete_input, 2352)},
+	{__MB_SLOTS(mb_discrete_input, 2360)},
+	{__MB_SLOTS(mb_discrete_input, 2368)},
+	{__MB_SLOTS(mb_discrete_input, 2376)},
+	{__MB_SLOTS(mb_discrete_input, 2384)},
+	{__MB_SLOTS(mb_discrete_input, 2392)},
+	{__MB_SLOTS(mb_discrete_input, 2400)},
+	{__MB_SLOTS(mb_discrete_input, 2408)},
+	{__MB_SLOTS(mb_discrete_input, 2416)},
+	{__MB_SLOTS(mb_discrete_input, 2424)},
+	{__MB_SLOTS(mb_discrete_input, 2432)},
+	{__MB_SLOTS(mb_discrete_input, 2440)},
+	{__MB_SLOTS(mb_discrete_input, 2448)},
+	{__MB_SLOTS(mb_discrete_input, 2456)},
+	{__MB_SLOTS(mb_discrete_input, 2464)},
+	{__MB_SLOTS(mb_discrete_input, 2472)},
+	{__MB_SLOTS(mb_discrete_input, 2480)},
+	{__MB_SLOTS(mb_discrete_input, 2488)},
+	{__MB_SLOTS(mb_discrete_input, 2496)},
+	{__MB_SLOTS(mb_discrete_input, 2504)},
+	{__MB_SLOTS(mb_discrete_input, 2512)},
+	{__MB_SLOTS(mb_discrete_input, 2520)},
+	{__MB_SLOTS(mb_discrete_input, 2528)},
+	{__MB_SLOTS(mb_discrete_input, 2536)},
+	{__MB_SLOTS(mb_discrete_input, 2544)},
+	{__MB_SLOTS(mb_discrete_input, 2552)},
+	{__MB_SLOTS(mb_discrete_input, 2560)},
+	{__MB_SLOTS(mb_discrete_input, 2568)},
+	{__MB_SLOTS(mb_discrete_input, 2576)},
+	{__MB_SLOTS(mb_discrete_input, 2584)},
+	{__MB_SLOTS(mb_discrete_input, 2592)},
+	{__MB_SLOTS(mb_discrete_input, 2600)},
+	{__MB_SLOTS(mb_discrete_input, 2608)},
+	{__MB_SLOTS(mb_discrete_input, 2616)},
+	{__MB_SLOTS(mb_discrete_input, 2624)},
+	{__MB_SLOTS(mb_discrete_input, 2632)},
+	{__MB_SLOTS(mb_discrete_input, 2640)},
+	{__MB_SLOTS(mb_discrete_input, 2648)},
+	{__MB_SLOTS(mb_discrete_input, 2656)},
+	{__MB_SLOTS(mb_discrete_input, 2664)},
+	{__MB_SLOTS(mb_discrete_input, 2672)},
+	{__MB_SLOTS(mb_discrete_input, 2680)},
+	{__MB_SLOTS(mb_discrete_input, 2688)},
+	{__MB_SLOTS(mb_discrete_input, 2696)},
+	{__MB_SLOTS(mb_discrete_input, 2704)},
+	{__MB_SLOTS(mb_discrete_input, 2712)},
+	{__MB_SLOTS(mb_discrete_input, 2720)},
+	{__MB_SLOTS(mb_discrete_input, 2728)},
+	{__MB_SLOTS(mb_discrete_input, 2736)},
+	{__MB_SLOTS(mb_discrete_input, 2744)},
+	{__MB_SLOTS(mb_discrete_input, 2752)},
+	{__MB_SLOTS(mb_discrete_input, 2760)},
+	{__MB_SLOTS(mb_discrete_input, 2768)},
+	{__MB_SLOTS(mb_discrete_input, 2776)},
+	{__MB_SLOTS(mb_discrete_input, 2784)},
+	{__MB_SLOTS(mb_discrete_input, 2792)},
+	{__MB_SLOTS(mb_discrete_input, 2800)},
+	{__MB_SLOTS(mb_discrete_input, 2808)},
+	{__MB_SLOTS(mb_discrete_input, 2816)},
+	{__MB_SLOTS(mb_discrete_input, 2824)},
+	{__MB_SLOTS(mb_discrete_input, 2832)},
+	{__MB_SLOTS(mb_discrete_input, 2840)},
+	{__MB_SLOTS(mb_discrete_input, 2848)},
+	{__MB_SLOTS(mb_discrete_input, 2856)},
+	{__MB_SLOTS(mb_discrete_input, 2864)},
+	{__MB_SLOTS(mb_discrete_input, 2872)},
+	{__MB_SLOTS(mb_discrete_input, 2880)},
+	{__MB_SLOTS(mb_discrete_input, 2888)},
+	{__MB_SLOTS(mb_discrete_input, 2896)},
+	{__MB_SLOTS(mb_discrete_input, 2904)},
+	{__MB_SLOTS(mb_discrete_input, 2912)},
+	{__MB_SLOTS(mb_discrete_input, 2920)},
+	{__MB_SLOTS(mb_discrete_input, 2928)},
+	{__MB_SLOTS(mb_discrete_input, 2936)},
+	{__MB_SLOTS(mb_discrete_input, 2944)},
+	{__MB_SLOTS(mb_discrete_input, 2952)},
+	{__MB_SLOTS(mb_discrete_input, 2960)},
+	{__MB_SLOTS(mb_discrete_input, 2968)},
+	{__MB_SLOTS(mb_discrete_input, 2976)},
+	{__MB_SLOTS(mb_discrete_input, 2984)},
+	{__MB_SLOTS(mb_discrete_input, 2992)},
+	{__MB_SLOTS(mb_discrete_input, 3000)},
+	{__MB_SLOTS(mb_discrete_input, 3008)},
+	{__MB_SLOTS(mb_discrete_input, 3016)},
+	{__MB_SLOTS(mb_discrete_input, 3024)},
+	{__MB_SLOTS(mb_discrete_input, 3032)},
+	{__MB_SLOTS(mb_discrete_input, 3040)},
+	{__MB_SLOTS(mb_discrete_input, 3048)},
+	{__MB_SLOTS(mb_discrete_input, 3056)},
+	{__MB_SLOTS(mb_discrete_input, 3064)},
+	{__MB_SLOTS(mb_discrete_input, 3072)},
+	{__MB_SLOTS(mb_discrete_input, 3080)},
+	{__MB_SLOTS(mb_discrete_input, 3088)},
+	{__MB_SLOTS(mb_discrete_input, 3096)},
+	{__MB_SLOTS(mb_discrete_input, 3104)},
+	{__MB_SLOTS(mb_discrete_input, 3112)},
+	{__MB_SLOTS(mb_discrete_input, 3120)},
+	{__MB_SLOTS(mb_discrete_input, 3128)},
+	{__MB_SLOTS(mb_discrete_input, 3136)},
+	{__MB_SLOTS(mb_discrete_input, 3144)},
+	{__MB_SLOTS(mb_discrete_input, 3152)},
+	{__MB_SLOTS(mb_discrete_input, 3160)},
+	{__MB_SLOTS(mb_discrete_input, 3168)},
+	{__MB_SLOTS(mb_discrete_input, 3176)},
+	{__MB_SLOTS(mb_discrete_input, 3184)},
+	{__MB_SLOTS(mb_discrete_input, 3192)},
+	{__MB_SLOTS(mb_discrete_input, 3200)},
+	{__MB_SLOTS(mb_discrete_input, 3208)},
+	{__MB_SLOTS(mb_discrete_input, 3216)},
+	{__MB_SLOTS(mb_discrete_input, 3224)},
+	{__MB_SLOTS(mb_discrete_input, 3232)},
+	{__MB_SLOTS(mb_discrete_input, 3240)},
+	{__MB_SLOTS(mb_discrete_input, 3248)},
+	{__MB_SLOTS(mb_discrete_input, 3256)},
+	{__MB_SLOTS(mb_discrete_input, 3264)},
+	{__MB_SLOTS(mb_discrete_input, 3272)},
+	{__MB_SLOTS(mb_discrete_input, 3280)},
+	{__MB_SLOTS(mb_discrete_input, 3288)},
+	{__MB_SLOTS(mb_discrete_input, 3296)},
+	{__MB_SLOTS(mb_discrete_input, 3304)},
+	{__MB_SLOTS(mb_discrete_input, 3312)},
+	{__MB_SLOTS(mb_discrete_input, 3320)},
+	{__MB_SLOTS(mb_discrete_input, 3328)},
+	{__MB_SLOTS(mb_discrete_input, 3336)},
+	{__MB_SLOTS(mb_discrete_input, 3344)},
+	{__MB_SLOTS(mb_discrete_input, 3352)},
+	{__MB_SLOTS(mb_discrete_input, 3360)},
+	{__MB_SLOTS(mb_discrete_input, 3368)},
+	{__MB_SLOTS(mb_discrete_input, 3376)},
+	{__MB_SLOTS(mb_discrete_input, 3384)},
+	{__MB_SLOTS(mb_discrete_input, 3392)},
+	{__MB_SLOTS(mb_discrete_input, 3400)},
+	{__MB_SLOTS(mb_discrete_input, 3408)},
+	{__MB_SLOTS(mb_discrete_input, 3416)},
+	{__MB_SLOTS(mb_discrete_input, 3424)},
+	{__MB_SLOTS(mb_discrete_input, 3432)},
+	{__MB_SLOTS(mb_discrete_input, 3440)},
+	{__MB_SLOTS(mb_discrete_input, 3448)},
+	{__MB_SLOTS(mb_discrete_input, 3456)},
+	{__MB_SLOTS(mb_discrete_input, 3464)},
+	{__MB_SLOTS(mb_discrete_input, 3472)},
+	{__MB_SLOTS(mb_discrete_input, 3480)},
+	{__MB_SLOTS(mb_discrete_input, 3488)},
+	{__MB_SLOTS(mb_discrete_input, 3496)},
+	{__MB_SLOTS(mb_discrete_input, 3504)},
+	{__MB_SLOTS(mb_discrete_input, 3512)},
+	{__MB_SLOTS(mb_discrete_input, 3520)},
+	{__MB_SLOTS(mb_discrete_input, 3528)},
+	{__MB_SLOTS(mb_discrete_input, 3536)},
+	{__MB_SLOTS(mb_discrete_input, 3544)},
+	{__MB_SLOTS(mb_discrete_input, 3552)},
+	{__MB_SLOTS(mb_discrete_input, 3560)},
+	{__MB_SLOTS(mb_discrete_input, 3568)},
+	{__MB_SLOTS(mb_discrete_input, 3576)},
+	{__MB_SLOTS(mb_discrete_input, 3584)},
+	{__MB_SLOTS(mb_discrete_input, 3592)},
+	{__MB_SLOTS(mb_discrete_input, 3600)},
+	{__MB_SLOTS(mb_discrete_input, 3608)},
+	{__MB_SLOTS(mb_discrete_input, 3616)},
+	{__MB_SLOTS(mb_discrete_input, 3624)},
+	{__MB_SLOTS(mb_discrete_input, 3632)},
+	{__MB_SLOTS(mb_discrete_input, 3640)},
+	{__MB_SLOTS(mb_discrete_input, 3648)},
+	{__MB_SLOTS(mb_discrete_input, 3656)},
+	{__MB_SLOTS(mb_discrete_input, 3664)},
+	{__MB_SLOTS(mb_discrete_input, 3672)},
+	{__MB_SLOTS(mb_discrete_input, 3680)},
+	{__MB_SLOTS(mb_discrete_input, 3688)},
+	{__MB_SLOTS(mb_discrete_input, 3696)},
+	{__MB_SLOTS(mb_discrete_input, 3704)},
+	{__MB_SLOTS(mb_discrete_input, 3712)},
+	{__MB_SLOTS(mb_discrete_input, 3720)},
+	{__MB_SLOTS(mb_discrete_input, 3728)},
+	{__MB_SLOTS(mb_discrete_input, 3736)},
+	{__MB_SLOTS(mb_discrete_input, 3744)},
+	{__MB_SLOTS(mb_discrete_input, 3752)},
+	{__MB_SLOTS(mb_discrete_input, 3760)},
+	{__MB_SLOTS(mb_discrete_input, 3768)},
+	{__MB_SLOTS(mb_discrete_input, 3776)},
+	{__MB_SLOTS(mb_discrete_input, 3784)},
+	{__MB_SLOTS(mb_discrete_input, 3792)},
+	{__MB_SLOTS(mb_discrete_input, 3800)},
+	{__MB_SLOTS(mb_discrete_input, 3808)},
+	{__MB_SLOTS(mb_discrete_input, 3816)},
+	{__MB_SLOTS(mb_discrete_input, 3824)},
+	{__MB_SLOTS(mb_discrete_input, 3832)},
+	{__MB_SLOTS(mb_discrete_input, 3840)},
+	{__MB_SLOTS(mb_discrete_input, 3848)},
+	{__MB_SLOTS(mb_discrete_input, 3856)},
+	{__MB_SLOTS(mb_discrete_input, 3864)},
+	{__MB_SLOTS(mb_discrete_input, 3872)},
+	{__MB_SLOTS(mb_discrete_input, 3880)},
+	{__MB_SLOTS(mb_discrete_input, 3888)},
+	{__MB_SLOTS(mb_discrete_input, 3896)},
+	{__MB_SLOTS(mb_discrete_input, 3904)},
+	{__MB_SLOTS(mb_discrete_input, 3912)},
+	{__MB_SLOTS(mb_discrete_input, 3920)},
+	{__MB_SLOTS(mb_discrete_input, 3928)},
+	{__MB_SLOTS(mb_discrete_input, 3936)},
+	{__MB_SLOTS(mb_discrete_input, 3944)},
+	{__MB_SLOTS(mb_discrete_input, 3952)},
+	{__MB_SLOTS(mb_discrete_input, 3960)},
+	{__MB_SLOTS(mb_discrete_input, 3968)},
+	{__MB_SLOTS(mb_discrete_input, 3976)},
+	{__MB_SLOTS(mb_discrete_input, 3984)},
+	{__MB_SLOTS(mb_discrete_input, 3992)},
+	{__MB_SLOTS(mb_discrete_input, 4000)},
+	{__MB_SLOTS(mb_discrete_input, 4008)},
+	{__MB_SLOTS(mb_discrete_input, 4016)},
+	{__MB_SLOTS(mb_discrete_input, 4024)},
+	{__MB_SLOTS(mb_discrete_input, 4032)},
+	{__MB_SLOTS(mb_discrete_input, 4040)},
+	{__MB_SLOTS(mb_discrete_input, 4048)},
+	{__MB_SLOTS(mb_discrete_input, 4056)},
+	{__MB_SLOTS(mb_discrete_input, 4064)},
+	{__MB_SLOTS(mb_discrete_input, 4072)},
+	{__MB_SLOTS(mb_discrete_input, 4080)},
+	{__MB_SLOTS(mb_discrete_input, 4088)},
+	{__MB_SLOTS(mb_discrete_input, 4096)},
+	{__MB_SLOTS(mb_discrete_input, 4104)},
+	{__MB_SLOTS(mb_discrete_input, 4112)},
+	{__MB_SLOTS(mb_discrete_input, 4120)},
+	{__MB_SLOTS(mb_discrete_input, 4128)},
+	{__MB_SLOTS(mb_discrete_input, 4136)},
+	{__MB_SLOTS(mb_discrete_input, 4144)},
+	{__MB_SLOTS(mb_discrete_input, 4152)},
+	{__MB_SLOTS(mb_discrete_input, 4160)},
+	{__MB_SLOTS(mb_discrete_input, 4168)},
+	{__MB_SLOTS(mb_discrete_input, 4176)},
+	{__MB_SLOTS(mb_discrete_input, 4184)},
+	{__MB_SLOTS(mb_discrete_input, 4192)},
+	{__MB_SLOTS(mb_discrete_input, 4200)},
+	{__MB_SLOTS(mb_discrete_input, 4208)},
+	{__MB_SLOTS(mb_discrete_input, 4216)},
+	{__MB_SLOTS(mb_discrete_input, 4224)},
+	{__MB_SLOTS(mb_discrete_input, 4232)},
+	{__MB_SLOTS(mb_discrete_input, 4240)},
+	{__MB_SLOTS(mb_discrete_input, 4248)},
+	{__MB_SLOTS(mb_discrete_input, 4256)},
+	{__MB_SLOTS(mb_discrete_input, 4264)},
+	{__MB_SLOTS(mb_discrete_input, 4272)},
+	{__MB_SLOTS(mb_discrete_input, 4280)},
+	{__MB_SLOTS(mb_discrete_input, 4288)},
+	{__MB_SLOTS(mb_discrete_input, 4296)},
+	{__MB_SLOTS(mb_discrete_input, 4304)},
+	{__MB_SLOTS(mb_discrete_input, 4312)},
+	{__MB_SLOTS(mb_discrete_input, 4320)},
+	{__MB_SLOTS(mb_discrete_input, 4328)},
+	{__MB_SLOTS(mb_discrete_input, 4336)},
+	{__MB_SLOTS(mb_discrete_input, 4344)},
+	{__MB_SLOTS(mb_discrete_input, 4352)},
+	{__MB_SLOTS(mb_discrete_input, 4360)},
+	{__MB_SLOTS(mb_discrete_input, 4368)},
+	{__MB_SLOTS(mb_discrete_input, 4376)},
+	{__MB_SLOTS(mb_discrete_input, 4384)},
+	{__MB_SLOTS(mb_discrete_input, 4392)},
+	{__MB_SLOTS(mb_discrete_input, 4400)},
+	{__MB_SLOTS(mb_discrete_input, 4408)},
+	{__MB_SLOTS(mb_discrete_input, 4416)},
+	{__MB_SLOTS(mb_discrete_input, 4424)},
+	{__MB_SLOTS(mb_discrete_input, 4432)},
+	{__MB_SLOTS(mb_discrete_input, 4440)},
+	{__MB_SLOTS(mb_discrete_input, 4448)},
+	{__MB_SLOTS(mb_discrete_input, 4456)},
+	{__MB_SLOTS(mb_discrete_input, 4464)},
+	{__MB_SLOTS(mb_discrete_input, 4472)},
+	{__MB_SLOTS(mb_discrete_input, 4480)},
+	{__MB_SLOTS(mb_discrete_input, 4488)},
+	{__MB_SLOTS(mb_discrete_input, 4496)},
+	{__MB_SLOTS(mb_discrete_input, 4504)},
+	{__MB_SLOTS(mb_discrete_input, 4512)},
+	{__MB_SLOTS(mb_discrete_input, 4520)},
+	{__MB_SLOTS(mb_discrete_input, 4528)},
+	{__MB_SLOTS(mb_discrete_input, 4536)},
+	{__MB_SLOTS(mb_discrete_input, 4544)},
+	{__MB_SLOTS(mb_discrete_input, 4552)},
+	{__MB_SLOTS(mb_discrete_input, 4560)},
+	{__MB_SLOTS(mb_discrete_input, 4568)},
+	{__MB_SLOTS(mb_discrete_input, 4576)},
+	{__MB_SLOTS(mb_discrete_input, 4584)},
+	{__MB_SLOTS(mb_discrete_input, 4592)},
+	{__MB_SLOTS(mb_discrete_input, 4600)},
+	{__MB_SLOTS(mb_discrete_input, 4608)},
+	{__MB_SLOTS(mb_discrete_input, 4616)},
+	{__MB_SLOTS(mb_discrete_input, 4624)},
+	{__MB_SLOTS(mb_discrete_input, 4632)},
+	{__MB_SLOTS(mb_discrete_input, 4640)},
+	{__MB_SLOTS(mb_discrete_input, 4648)},
+	{__MB_SLOTS(mb_discrete_input, 4656)},
+	{__MB_SLOTS(mb_discrete_input, 4664)},
+	{__MB_SLOTS(mb_discrete_input, 4672)},
+	{__MB_SLOTS(mb_discrete_input, 4680)},
+	{__MB_SLOTS(mb_discrete_input, 4688)},
+	{__MB_SLOTS(mb_discrete_input, 4696)},
+	{__MB_SLOTS(mb_discrete_input, 4704)},
+	{__MB_SLOTS(mb_discrete_input, 4712)},
+	{__MB_SLOTS(mb_discrete_input, 4720)},
+	{__MB_SLOTS(mb_discrete_input, 4728)},
+	{__MB_SLOTS(mb_discrete_input, 4736)},
+	{__MB_SLOTS(mb_discrete_input, 4744)},
+	{__MB_SLOTS(mb_discrete_input, 4752)},
+	{__MB_SLOTS(mb_discrete_input, 4760)},
+	{__MB_SLOTS(mb_discrete_input, 4768)},
+	{__MB_SLOTS(mb_discrete_input, 4776)},
+	{__MB_SLOTS(mb_discrete_input, 4784)},
+	{__MB_SLOTS(mb_discrete_input, 4792)},
+	{__MB_SLOTS(mb_discrete_input, 4800)},
+	{__MB_SLOTS(mb_discrete_input, 4808)},
+	{__MB_SLOTS(mb_discrete_input, 4816)},
+	{__MB_SLOTS(mb_discrete_input, 4824)},
+	{__MB_SLOTS(mb_discrete_input, 4832)},
+	{__MB_SLOTS(mb_discrete_input, 4840)},
+	{__MB_SLOTS(mb_discrete_input, 4848)},
+	{__MB_SLOTS(mb_discrete_input, 4856)},
+	{__MB_SLOTS(mb_discrete_input, 4864)},
+	{__MB_SLOTS(mb_discrete_input, 4872)},
+	{__MB_SLOTS(mb_discrete_input, 4880)},
+	{__MB_SLOTS(mb_discrete_input, 4888)},
+	{__MB_SLOTS(mb_discrete_input, 4896)},
+	{__MB_SLOTS(mb_discrete_input, 4904)},
+	{__MB_SLOTS(mb_discrete_input, 4912)},
+	{__MB_SLOTS(mb_discrete_input, 4920)},
+	{__MB_SLOTS(mb_discrete_input, 4928)},
+	{__MB_SLOTS(mb_discrete_input, 4936)},
+	{__MB_SLOTS(mb_discrete_input, 4944)},
+	{__MB_SLOTS(mb_discrete_input, 4952)},
+	{__MB_SLOTS(mb_discrete_input, 4960)},
+	{__MB_SLOTS(mb_discrete_input, 4968)},
+	{__MB_SLOTS(mb_discrete_input, 4976)},
+	{__MB_SLOTS(mb_discrete_input, 4984)},
+	{__MB_SLOTS(mb_discrete_input, 4992)},
+	{__MB_SLOTS(mb_discrete_input, 5000)},
+	{__MB_SLOTS(mb_discrete_input, 5008)},
+	{__MB_SLOTS(mb_discrete_input, 5016)},
+	{__MB_SLOTS(mb_discrete_input, 5024)},
+	{__MB_SLOTS(mb_discrete_input, 5032)},
+	{__MB_SLOTS(mb_discrete_input, 5040)},
+	{__MB_SLOTS(mb_discrete_input, 5048)},
+	{__MB_SLOTS(mb_discrete_input, 5056)},
+	{__MB_SLOTS(mb_discrete_input, 5064)},
+	{__MB_SLOTS(mb_discrete_input, 5072)},
+	{__MB_SLOTS(mb_discrete_input, 5080)},
+	{__MB_SLOTS(mb_discrete_input, 5088)},
+	{__MB_SLOTS(mb_discrete_input, 5096)},
+	{__MB_SLOTS(mb_discrete_input, 5104)},
+	{__MB_SLOTS(mb_discrete_input, 5112)},
+	{__MB_SLOTS(mb_discrete_input, 5120)},
+	{__MB_SLOTS(mb_discrete_input, 5128)},
+	{__MB_SLOTS(mb_discrete_input, 5136)},
+	{__MB_SLOTS(mb_discrete_input, 5144)},
+	{__MB_SLOTS(mb_discrete_input, 5152)},
+	{__MB_SLOTS(mb_discrete_input, 5160)},
+	{__MB_SLOTS(mb_discrete_input, 5168)},
+	{__MB_SLOTS(mb_discrete_input, 5176)},
+	{__MB_SLOTS(mb_discrete_input, 5184)},
+	{__MB_SLOTS(mb_discrete_input, 5192)},
+	{__MB_SLOTS(mb_discrete_input, 5200)},
+	{__MB_SLOTS(mb_discrete_input, 5208)},
+	{__MB_SLOTS(mb_discrete_input, 5216)},
+	{__MB_SLOTS(mb_discrete_input, 5224)},
+	{__MB_SLOTS(mb_discrete_input, 5232)},
+	{__MB_SLOTS(mb_discrete_input, 5240)},
+	{__MB_SLOTS(mb_discrete_input, 5248)},
+	{__MB_SLOTS(mb_discrete_input, 5256)},
+	{__MB_SLOTS(mb_discrete_input, 5264)},
+	{__MB_SLOTS(mb_discrete_input, 5272)},
+	{__MB_SLOTS(mb_discrete_input, 5280)},
+	{__MB_SLOTS(mb_discrete_input, 5288)},
+	{__MB_SLOTS(mb_discrete_input, 5296)},
+	{__MB_SLOTS(mb_discrete_input, 5304)},
+	{__MB_SLOTS(mb_discrete_input, 5312)},
+	{__MB_SLOTS(mb_discrete_input, 5320)},
+	{__MB_SLOTS(mb_discrete_input, 5328)},
+	{__MB_SLOTS(mb_discrete_input, 5336)},
+	{__MB_SLOTS(mb_discrete_input, 5344)},
+	{__MB_SLOTS(mb_discrete_input, 5352)},
+	{__MB_SLOTS(mb_discrete_input, 5360)},
+	{__MB_SLOTS(mb_discrete_input, 5368)},
+	{__MB_SLOTS(mb_discrete_input, 5376)},
+	{__MB_SLOTS(mb_discrete_input, 5384)},
+	{__MB_SLOTS(mb_discrete_input, 5392)},
+	{__MB_SLOTS(mb_discrete_input, 5400)},
+	{__MB_SLOTS(mb_discrete_input, 5408)},
+	{__MB_SLOTS(mb_discrete_input, 5416)},
+	{__MB_SLOTS(mb_discrete_input, 5424)},
+	{__MB_SLOTS(mb_discrete_input, 5432)},
+	{__MB_SLOTS(mb_discrete_input, 5440)},
+	{__MB_SLOTS(mb_discrete_input, 5448)},
+	{__MB_SLOTS(mb_discrete_input, 5456)},
+	{__MB_SLOTS(mb_discrete_input, 5464)},
+	{__MB_SLOTS(mb_discrete_input, 5472)},
+	{__MB_SLOTS(mb_discrete_input, 5480)},
+	{__MB_SLOTS(mb_discrete_input, 5488)},
+	{__MB_SLOTS(mb_discrete_input, 5496)},
+	{__MB_SLOTS(mb_discrete_input, 5504)},
+	{__MB_SLOTS(mb_discrete_input, 5512)},
+	{__MB_SLOTS(mb_discrete_input, 5520)},
+	{__MB_SLOTS(mb_discrete_input, 5528)},
+	{__MB_SLOTS(mb_discrete_input, 5536)},
+	{__MB_SLOTS(mb_discrete_input, 5544)},
+	{__MB_SLOTS(mb_discrete_input, 5552)},
+	{__MB_SLOTS(mb_discrete_input, 5560)},
+	{__MB_SLOTS(mb_discrete_input, 5568)},
+	{__MB_SLOTS(mb_discrete_input, 5576)},
+	{__MB_SLOTS(mb_discrete_input, 5584)},
+	{__MB_SLOTS(mb_discrete_input, 5592)},
+	{__MB_SLOTS(mb_discrete_input, 5600)},
+	{__MB_SLOTS(mb_discrete_input, 5608)},
+	{__MB_SLOTS(mb_discrete_input, 5616)},
+	{__MB_SLOTS(mb_discrete_input, 5624)},
+	{__MB_SLOTS(mb_discrete_input, 5632)},
+	{__MB_SLOTS(mb_discrete_input, 5640)},
+	{__MB_SLOTS(mb_discrete_input, 5648)},
+	{__MB_SLOTS(mb_discrete_input, 5656)},
+	{__MB_SLOTS(mb_discrete_input, 5664)},
+	{__MB_SLOTS(mb_discrete_input, 5672)},
+	{__MB_SLOTS(mb_discrete_input, 5680)},
+	{__MB_SLOTS(mb_discrete_input, 5688)},
+	{__MB_SLOTS(mb_discrete_input, 5696)},
+	{__MB_SLOTS(mb_discrete_input, 5704)},
+	{__MB_SLOTS(mb_discrete_input, 5712)},
+	{__MB_SLOTS(mb_discrete_input, 5720)},
+	{__MB_SLOTS(mb_discrete_input, 5728)},
+	{__MB_SLOTS(mb_discrete_input, 5736)},
+	{__MB_SLOTS(mb_discrete_input, 5744)},
+	{__MB_SLOTS(mb_discrete_input, 5752)},
+	{__MB_SLOTS(mb_discrete_input, 5760)},
+	{__MB_SLOTS(mb_discrete_input, 5768)},
+	{__MB_SLOTS(mb_discrete_input, 5776)},
+	{__MB_SLOTS(mb_discrete_input, 5784)},
+	{__MB_SLOTS(mb_discrete_input, 5792)},
+	{__MB_SLOTS(mb_discrete_input, 5800)},
+	{__MB_SLOTS(mb_discrete_input, 5808)},
+	{__MB_SLOTS(mb_discrete_input, 5816)},
+	{__MB_SLOTS(mb_discrete_input, 5824)},
+	{__MB_SLOTS(mb_discrete_input, 5832)},
+	{__MB_SLOTS(mb_discrete_input, 5840)},
+	{__MB_SLOTS(mb_discrete_input, 5848)},
+	{__MB_SLOTS(mb_discrete_input, 5856)},
+	{__MB_SLOTS(mb_discrete_input, 5864)},
+	{__MB_SLOTS(mb_discrete_input, 5872)},
+	{__MB_SLOTS(mb_discrete_input, 5880)},
+	{__MB_SLOTS(mb_discrete_input, 5888)},
+	{__MB_SLOTS(mb_discrete_input, 5896)},
+	{__MB_SLOTS(mb_discrete_input, 5904)},
+	{__MB_SLOTS(mb_discrete_input, 5912)},
+	{__MB_SLOTS(mb_discrete_input, 5920)},
+	{__MB_SLOTS(mb_discrete_input, 5928)},
+	{__MB_SLOTS(mb_discrete_input, 5936)},
+	{__MB_SLOTS(mb_discrete_input, 5944)},
+	{__MB_SLOTS(mb_discrete_input, 5952)},
+	{__MB_SLOTS(mb_discrete_input, 5960)},
+	{__MB_SLOTS(mb_discrete_input, 5968)},
+	{__MB_SLOTS(mb_discrete_input, 5976)},
+	{__MB_SLOTS(mb_discrete_input, 5984)},
+	{__MB_SLOTS(mb_discrete_input, 5992)},
+	{__MB_SLOTS(mb_discrete_input, 6000)},
+	{__MB_SLOTS(mb_discrete_input, 6008)},
+	{__MB_SLOTS(mb_discrete_input, 6016)},
+	{__MB_SLOTS(mb_discrete_input, 6024)},
+	{__MB_SLOTS(mb_discrete_input, 6032)},
+	{__MB_SLOTS(mb_discrete_input, 6040)},
+	{__MB_SLOTS(mb_discrete_input, 6048)},
+	{__MB_SLOTS(mb_discrete_input, 6056)},
+	{__MB_SLOTS(mb_discrete_input, 6064)},
+	{__MB_SLOTS(mb_discrete_input, 6072)},
+	{__MB_SLOTS(mb_discrete_input, 6080)},
+	{__MB_SLOTS(mb_discrete_input, 6088)},
+	{__MB_SLOTS(mb_discrete_input, 6096)},
+	{__MB_SLOTS(mb_discrete_input, 6104)},
+	{__MB_SLOTS(mb_discrete_input, 6112)},
+	{__MB_SLOTS(mb_discrete_input, 6120)},
+	{__MB_SLOTS(mb_discrete_input, 6128)},
+	{__MB_SLOTS(mb_discrete_input, 6136)},
+	{__MB_SLOTS(mb_discrete_input, 6144)},
+	{__MB_SLOTS(mb_discrete_input, 6152)},
+	{__MB_SLOTS(mb_discrete_input, 6160)},
+	{__MB_SLOTS(mb_discrete_input, 6168)},
+	{__MB_SLOTS(mb_discrete_input, 6176)},
+	{__MB_SLOTS(mb_discrete_input, 6184)},
+	{__MB_SLOTS(mb_discrete_input, 6192)},
+	{__MB_SLOTS(mb_discrete_input, 6200)},
+	{__MB_SLOTS(mb_discrete_input, 6208)},
+	{__MB_SLOTS(mb_discrete_input, 6216)},
+	{__MB_SLOTS(mb_discrete_input, 6224)},
+	{__MB_SLOTS(mb_discrete_input, 6232)},
+	{__MB_SLOTS(mb_discrete_input, 6240)},
+	{__MB_SLOTS(mb_discrete_input, 6248)},
+	{__MB_SLOTS(mb_discrete_input, 6256)},
+	{__MB_SLOTS(mb_discrete_input, 6264)},
+	{__MB_SLOTS(mb_discrete_input, 6272)},
+	{__MB_SLOTS(mb_discrete_input, 6280)},
+	{__MB_SLOTS(mb_discrete_input, 6288)},
+	{__MB_SLOTS(mb_discrete_input, 6296)},
+	{__MB_SLOTS(mb_discrete_input, 6304)},
+	{__MB_SLOTS(mb_discrete_input, 6312)},
+	{__MB_SLOTS(mb_discrete_input, 6320)},
+	{__MB_SLOTS(mb_discrete_input, 6328)},
+	{__MB_SLOTS(mb_discrete_input, 6336)},
+	{__MB_SLOTS(mb_discrete_input, 6344)},
+	{__MB_SLOTS(mb_discrete_input, 6352)},
+	{__MB_SLOTS(mb_discrete_input, 6360)},
+	{__MB_SLOTS(mb_discrete_input, 6368)},
+	{__MB_SLOTS(mb_discrete_input, 6376)},
+	{__MB_SLOTS(mb_discrete_input, 6384)},
+	{__MB_SLOTS(mb_discrete_input, 6392)},
+	{__MB_SLOTS(mb_discrete_input, 6400)},
+	{__MB_SLOTS(mb_discrete_input, 6408)},
+	{__MB_SLOTS(mb_discrete_input, 6416)},
+	{__MB_SLOTS(mb_discrete_input, 6424)},
+	{__MB_SLOTS(mb_discrete_input, 6432)},
+	{__MB_SLOTS(mb_discrete_input, 6440)},
+	{__MB_SLOTS(mb_discrete_input, 6448)},
+	{__MB_SLOTS(mb_discrete_input, 6456)},
+	{__MB_SLOTS(mb_discrete_input, 6464)},
+	{__MB_SLOTS(mb_discrete_input, 6472)},
+	{__MB_SLOTS(mb_discrete_input, 6480)},
+	{__MB_SLOTS(mb_discrete_input, 6488)},
+	{__MB_SLOTS(mb_discrete_input, 6496)},
+	{__MB_SLOTS(mb_discrete_input, 6504)},
+	{__MB_SLOTS(mb_discrete_input, 6512)},
+	{__MB_SLOTS(mb_discrete_input, 6520)},
+	{__MB_SLOTS(mb_discrete_input, 6528)},
+	{__MB_SLOTS(mb_discrete_input, 6536)},
+	{__MB_SLOTS(mb_discrete_input, 6544)},
+	{__MB_SLOTS(mb_discrete_input, 6552)},
+	{__MB_SLOTS(mb_discrete_input, 6560)},
+	{__MB_SLOTS(mb_discrete_input, 6568)},
+	{__MB_SLOTS(mb_discrete_input, 6576)},
+	{__MB_SLOTS(mb_discrete_input, 6584)},
+	{__MB_SLOTS(mb_discrete_input, 6592)},
+	{__MB_SLOTS(mb_discrete_input, 6600)},
+	{__MB_SLOTS(mb_discrete_input, 6608)},
+	{__MB_SLOTS(mb_discrete_input, 6616)},
+	{__MB_SLOTS(mb_discrete_input, 6624)},
+	{__MB_SLOTS(mb_discrete_input, 6632)},
+	{__MB_SLOTS(mb_discrete_input, 6640)},
+	{__MB_SLOTS(mb_discrete_input, 6648)},
+	{__MB_SLOTS(mb_discrete_input, 6656)},
+	{__MB_SLOTS(mb_discrete_input, 6664)},
+	{__MB_SLOTS(mb_discrete_input, 6672)},
+	{__MB_SLOTS(mb_discrete_input, 6680)},
+	{__MB_SLOTS(mb_discrete_input, 6688)},
+	{__MB_SLOTS(mb_discrete_input, 6696)},
+	{__MB_SLOTS(mb_discrete_input, 6704)},
+	{__MB_SLOTS(mb_discrete_input, 6712)},
+	{__MB_SLOTS(mb_discrete_input, 6720)},
+	{__MB_SLOTS(mb_discrete_input, 6728)},
+	{__MB_SLOTS(mb_discrete_input, 6736)},
+	{__MB_SLOTS(mb_discrete_input, 6744)},
+	{__MB_SLOTS(mb_discrete_input, 6752)},
+	{__MB_SLOTS(mb_discrete_input, 6760)},
+	{__MB_SLOTS(mb_discrete_input, 6768)},
+	{__MB_SLOTS(mb_discrete_input, 6776)},
+	{__MB_SLOTS(mb_discrete_input, 6784)},
+	{__MB_SLOTS(mb_discrete_input, 6792)},
+	{__MB_SLOTS(mb_discrete_input, 6800)},
+	{__MB_SLOTS(mb_discrete_input, 6808)},
+	{__MB_SLOTS(mb_discrete_input, 6816)},
+	{__MB_SLOTS(mb_discrete_input, 6824)},
+	{__MB_SLOTS(mb_discrete_input, 6832)},
+	{__MB_SLOTS(mb_discrete_input, 6840)},
+	{__MB_SLOTS(mb_discrete_input, 6848)},
+	{__MB_SLOTS(mb_discrete_input, 6856)},
+	{__MB_SLOTS(mb_discrete_input, 6864)},
+	{__MB_SLOTS(mb_discrete_input, 6872)},
+	{__MB_SLOTS(mb_discrete_input, 6880)},
+	{__MB_SLOTS(mb_discrete_input, 6888)},
+	{__MB_SLOTS(mb_discrete_input, 6896)},
+	{__MB_SLOTS(mb_discrete_input, 6904)},
+	{__MB_SLOTS(mb_discrete_input, 6912)},
+	{__MB_SLOTS(mb_discrete_input, 6920)},
+	{__MB_SLOTS(mb_discrete_input, 6928)},
+	{__MB_SLOTS(mb_discrete_input, 6936)},
+	{__MB_SLOTS(mb_discrete_input, 6944)},
+	{__MB_SLOTS(mb_discrete_input, 6952)},
+	{__MB_SLOTS(mb_discrete_input, 6960)},
+	{__MB_SLOTS(mb_discrete_input, 6968)},
+	{__MB_SLOTS(mb_discrete_input, 6976)},
+	{__MB_SLOTS(mb_discrete_input, 6984)},
+	{__MB_SLOTS(mb_discrete_input, 6992)},
+	{__MB_SLOTS(mb_discrete_input, 7000)},
+	{__MB_SLOTS(mb_discrete_input, 7008)},
+	{__MB_SLOTS(mb_discrete_input, 7016)},
+	{__MB_SLOTS(mb_discrete_input, 7024)},
+	{__MB_SLOTS(mb_discrete_input, 7032)},
+	{__MB_SLOTS(mb_discrete_input, 7040)},
+	{__MB_SLOTS(mb_discrete_input, 7048)},
+	{__MB_SLOTS(mb_discrete_input, 7056)},
+	{__MB_SLOTS(mb_discrete_input, 7064)},
+	{__MB_SLOTS(mb_discrete_input, 7072)},
+	{__MB_SLOTS(mb_discrete_input, 7080)},
+	{__MB_SLOTS(mb_discrete_input, 7088)},
+	{__MB_SLOTS(mb_discrete_input, 7096)},
+	{__MB_SLOTS(mb_discrete_input, 7104)},
+	{__MB_SLOTS(mb_discrete_input, 7112)},
+	{__MB_SLOTS(mb_discrete_input, 7120)},
+	{__MB_SLOTS(mb_discrete_input, 7128)},
+	{__MB_SLOTS(mb_discrete_input, 7136)},
+	{__MB_SLOTS(mb_discrete_input, 7144)},
+	{__MB_SLOTS(mb_discrete_input, 7152)},
+	{__MB_SLOTS(mb_discrete_input, 7160)},
+	{__MB_SLOTS(mb_discrete_input, 7168)},
+	{__MB_SLOTS(mb_discrete_input, 7176)},
+	{__MB_SLOTS(mb_discrete_input, 7184)},
+	{__MB_SLOTS(mb_discrete_input, 7192)},
+	{__MB_SLOTS(mb_discrete_input, 7200)},
+	{__MB_SLOTS(mb_discrete_input, 7208)},
+	{__MB_SLOTS(mb_discrete_input, 7216)},
+	{__MB_SLOTS(mb_discrete_input, 7224)},
+	{__MB_SLOTS(mb_discrete_input, 7232)},
+	{__MB_SLOTS(mb_discrete_input, 7240)},
+	{__MB_SLOTS(mb_discrete_input, 7248)},
+	{__MB_SLOTS(mb_discrete_input, 7256)},
+	{__MB_SLOTS(mb_discrete_input, 7264)},
+	{__MB_SLOTS(mb_discrete_input, 7272)},
+	{__MB_SLOTS(mb_discrete_input, 7280)},
+	{__MB_SLOTS(mb_discrete_input, 7288)},
+	{__MB_SLOTS(mb_discrete_input, 7296)},
+	{__MB_SLOTS(mb_discrete_input, 7304)},
+	{__MB_SLOTS(mb_discrete_input, 7312)},
+	{__MB_SLOTS(mb_discrete_input, 7320)},
+	{__MB_SLOTS(mb_discrete_input, 7328)},
+	{__MB_SLOTS(mb_discrete_input, 7336)},
+	{__MB_SLOTS(mb_discrete_input, 7344)},
+	{__MB_SLOTS(mb_discrete_input, 7352)},
+	{__MB_SLOTS(mb_discrete_input, 7360)},
+	{__MB_SLOTS(mb_discrete_input, 7368)},
+	{__MB_SLOTS(mb_discrete_input, 7376)},
+	{__MB_SLOTS(mb_discrete_input, 7384)},
+	{__MB_SLOTS(mb_discrete_input, 7392)},
+	{__MB_SLOTS(mb_discrete_input, 7400)},
+	{__MB_SLOTS(mb_discrete_input, 7408)},
+	{__MB_SLOTS(mb_discrete_input, 7416)},
+	{__MB_SLOTS(mb_discrete_input, 7424)},
+	{__MB_SLOTS(mb_discrete_input, 7432)},
+	{__MB_SLOTS(mb_discrete_input, 7440)},
+	{__MB_SLOTS(mb_discrete_input, 7448)},
+	{__MB_SLOTS(mb_discrete_input, 7456)},
+	{__MB_SLOTS(mb_discrete_input, 7464)},
+	{__MB_SLOTS(mb_discrete_input, 7472)},
+	{__MB_SLOTS(mb_discrete_input, 7480)},
+	{__MB_SLOTS(mb_discrete_input, 7488)},
+	{__MB_SLOTS(mb_discrete_input, 7496)},
+	{__MB_SLOTS(mb_discrete_input, 7504)},
+	{__MB_SLOTS(mb_discrete_input, 7512)},
+	{__MB_SLOTS(mb_discrete_input, 7520)},
+	{__MB_SLOTS(mb_discrete_input, 7528)},
+	{__MB_SLOTS(mb_discrete_input, 7536)},
+	{__MB_SLOTS(mb_discrete_input, 7544)},
+	{__MB_SLOTS(mb_discrete_input, 7552)},
+	{__MB_SLOTS(mb_discrete_input, 7560)},
+	{__MB_SLOTS(mb_discrete_input, 7568)},
+	{__MB_SLOTS(mb_discrete_input, 7576)},
+	{__MB_SLOTS(mb_discrete_input, 7584)},
+	{__MB_SLOTS(mb_discrete_input, 7592)},
+	{__MB_SLOTS(mb_discrete_input, 7600)},
+	{__MB_SLOTS(mb_discrete_input, 7608)},
+	{__MB_SLOTS(mb_discrete_input, 7616)},
+	{__MB_SLOTS(mb_discrete_input, 7624)},
+	{__MB_SLOTS(mb_discrete_input, 7632)},
+	{__MB_SLOTS(mb_discrete_input, 7640)},
+	{__MB_SLOTS(mb_discrete_input, 7648)},
+	{__MB_SLOTS(mb_discrete_input, 7656)},
+	{__MB_SLOTS(mb_discrete_input, 7664)},
+	{__MB_SLOTS(mb_discrete_input, 7672)},
+	{__MB_SLOTS(mb_discrete_input, 7680)},
+	{__MB_SLOTS(mb_discrete_input, 7688)},
+	{__MB_SLOTS(mb_discrete_input, 7696)},
+	{__MB_SLOTS(mb_discrete_input, 7704)},
+	{__MB_SLOTS(mb_discrete_input, 7712)},
+	{__MB_SLOTS(mb_discrete_input, 7720)},
+	{__MB_SLOTS(mb_discrete_input, 7728)},
+	{__MB_SLOTS(mb_discrete_input, 7736)},
+	{__MB_SLOTS(mb_discrete_input, 7744)},
+	{__MB_SLOTS(mb_discrete_input, 7752)},
+	{__MB_SLOTS(mb_discrete_input, 7760)},
+	{__MB_SLOTS(mb_discrete_input, 7768)},
+	{__MB_SLOTS(mb_discrete_input, 7776)},
+	{__MB_SLOTS(mb_discrete_input, 7784)},
+	{__MB_SLOTS(mb_discrete_input, 7792)},
+	{__MB_SLOTS(mb_discrete_input, 7800)},
+	{__MB_SLOTS(mb_discrete_input, 7808)},
+	{__MB_SLOTS(mb_discrete_input, 7816)},
+	{__MB_SLOTS(mb_discrete_input, 7824)},
+	{__MB_SLOTS(mb_discrete_input, 7832)},
+	{__MB_SLOTS(mb_discrete_input, 7840)},
+	{__MB_SLOTS(mb_discrete_input, 7848)},
+	{__MB_SLOTS(mb_discrete_input, 7856)},
+	{__MB_SLOTS(mb_discrete_input, 7864)},
+	{__MB_SLOTS(mb_discrete_input, 7872)},
+	{__MB_SLOTS(mb_discrete_input, 7880)},
+	{__MB_SLOTS(mb_discrete_input, 7888)},
+	{__MB_SLOTS(mb_discrete_input, 7896)},
+	{__MB_SLOTS(mb_discrete_input, 7904)},
+	{__MB_SLOTS(mb_discrete_input, 7912)},
+	{__MB_SLOTS(mb_discrete_input, 7920)},
+	{__MB_SLOTS(mb_discrete_input, 7928)},
+	{__MB_SLOTS(mb_discrete_input, 7936)},
+	{__MB_SLOTS(mb_discrete_input, 7944)},
+	{__MB_SLOTS(mb_discrete_input, 7952)},
+	{__MB_SLOTS(mb_discrete_input, 7960)},
+	{__MB_SLOTS(mb_discrete_input, 7968)},
+	{__MB_SLOTS(mb_discrete_input, 7976)},
+	{__MB_SLOTS(mb_discrete_input, 7984)},
+	{__MB_SLOTS(mb_discrete_input, 7992)},
+	{__MB_SLOTS(mb_discrete_input, 8000)},
+	{__MB_SLOTS(mb_discrete_input, 8008)},
+	{__MB_SLOTS(mb_discrete_input, 8016)},
+	{__MB_SLOTS(mb_discrete_input, 8024)},
+	{__MB_SLOTS(mb_discrete_input, 8032)},
+	{__MB_SLOTS(mb_discrete_input, 8040)},
+	{__MB_SLOTS(mb_discrete_input, 8048)},
+	{__MB_SLOTS(mb_discrete_input, 8056)},
+	{__MB_SLOTS(mb_discrete_input, 8064)},
+	{__MB_SLOTS(mb_discrete_input, 8072)},
+	{__MB_SLOTS(mb_discrete_input, 8080)},
+	{__MB_SLOTS(mb_discrete_input, 8088)},
+	{__MB_SLOTS(mb_discrete_input, 8096)},
+	{__MB_SLOTS(mb_discrete_input, 8104)},
+	{__MB_SLOTS(mb_discrete_input, 8112)},
+	{__MB_SLOTS(mb_discrete_input, 8120)},
+	{__MB_SLOTS(mb_discrete_input, 8128)},
+	{__MB_SLOTS(mb_discrete_input, 8136)},
+	{__MB_SLOTS(mb_discrete_input, 8144)},
+	{__MB_SLOTS(mb_discrete_input, 8152)},
+	{__MB_SLOTS(mb_discrete_input, 8160)},
+	{__MB_SLOTS(mb_discrete_input, 8168)},
+	{__MB_SLOTS(mb_discrete_input, 8176)},
+	{__MB_SLOTS(mb_discrete_input, 8184)},
+};
+extern IEC_BOOL *const bool_output[BUFFER_SIZE][8] = {
+	{__MB_SLOTS(mb_coils, 0)},
+	{__MB_SLOTS(mb_coils, 8)},
+	{__MB_SLOTS(mb_coils, 16)},
+	{__MB_SLOTS(mb_coils, 24)},
+	{__MB_SLOTS(mb_coils, 32)},
+	{__MB_SLOTS(mb_coils, 40)},
+	{__MB_SLOTS(mb_coils, 48)},
+	{__MB_SLOTS(mb_coils, 56)},
+	{__MB_SLOTS(mb_coils, 64)},
+	{__MB_SLOTS(mb_coils, 72)},
+	{__MB_SLOTS(mb_coils, 80)},
+	{__MB_SLOTS(mb_coils, 88)},
+	{__MB_SLOTS(mb_coils, 96)},
+	{__MB_SLOTS(mb_coils, 104)},
+	{__MB_SLOTS(mb_coils, 112)},
+	{__MB_SLOTS(mb_coils, 120)},
+	{__MB_SLOTS(mb_coils, 128)},
+	{__MB_SLOTS(mb_coils, 136)},
+	{__MB_SLOTS(mb_coils, 144)},
+	{__MB_SLOTS(mb_coils, 152)},
+	{__MB_SLOTS(mb_coils, 160)},
+	{__MB_SLOTS(mb_coils, 168)},
+	{__MB_SLOTS(mb_coils, 176)},
+	{__MB_SLOTS(mb_coils, 184)},
+	{__MB_SLOTS(mb_coils, 192)},
+	{__MB_SLOTS(mb_coils, 200)},
+	{__MB_SLOTS(mb_coils, 208)},
+	{__MB_SLOTS(mb_coils, 216)},
+	{__MB_SLOTS(mb_coils, 224)},
+	{__MB_SLOTS(mb_coils, 232)},
+	{__MB_SLOTS(mb_coils, 240)},
+	{__MB_SLOTS(mb_coils, 248)},
+	{__MB_SLOTS(mb_coils, 256)},
+	{__MB_SLOTS(mb_coils, 264)},
+	{__MB_SLOTS(mb_coils, 272)},
+	{__MB_SLOTS(mb_coils, 280)},
+	{__MB_SLOTS(mb_coils, 288)},
+	{__MB_SLOTS(mb_coils, 296)},
+	{__MB_SLOTS(mb_coils, 304)},
+	{__MB_SLOTS(mb_coils, 312)},
+	{__MB_SLOTS(mb_coils, 320)},
+	{__MB_SLOTS(mb_coils, 328)},
+	{__MB_SLOTS(mb_coils, 336)},
+	{__MB_SLOTS(mb_coils, 344)},
+	{__MB_SLOTS(mb_coils, 352)},
+	{__MB_SLOTS(mb_coils, 360)},
+	{__MB_SLOTS(mb_coils, 368)},
+	{__MB_SLOTS(mb_coils, 376)},
+	{__MB_SLOTS(mb_coils, 384)},
+	{__MB_SLOTS(mb_coils, 392)},
+	{__MB_SLOTS(mb_coils, 400)},
+	{__MB_SLOTS(mb_coils, 408)},
+	{__MB_SLOTS(mb_coils, 416)},
+	{__MB_SLOTS(mb_coils, 424)},
+	{__MB_SLOTS(mb_coils, 432)},
+	{__MB_SLOTS(mb_coils, 440)},
+	{__MB_SLOTS(mb_coils, 448)},
+	{__MB_SLOTS(mb_coils, 456)},
+	{__MB_SLOTS(mb_coils, 464)},
+	{__MB_SLOTS(mb_coils, 472)},
+	{__MB_SLOTS(mb_coils, 480)},
+	{__MB_SLOTS(mb_coils, 488)},
+	{__MB_SLOTS(mb_coils, 496)},
+	{__MB_SLOTS(mb_coils, 504)},
+	{__MB_SLOTS(mb_coils, 512)},
+	{__MB_SLOTS(mb_coils, 520)},
+	{__MB_SLOTS(mb_coils, 528)},
+	{__MB_SLOTS(mb_coils, 536)},
+	{__MB_SLOTS(mb_coils, 544)},
+	{__MB_SLOTS(mb_coils, 552)},
+	{__MB_SLOTS(mb_coils, 560)},
+	{__MB_SLOTS(mb_coils, 568)},
+	{__MB_SLOTS(mb_coils, 576)},
+	{__MB_SLOTS(mb_coils, 584)},
+	{__MB_SLOTS(mb_coils, 592)},
+	{__MB_SLOTS(mb_coils, 600)},
+	{__MB_SLOTS(mb_coils, 608)},
+	{__MB_SLOTS(mb_coils, 616)},
+	{__MB_SLOTS(mb_coils, 624)},
+	{__MB_SLOTS(mb_coils, 632)},
+	{__MB_SLOTS(mb_coils, 640)},
+	{__MB_SLOTS(mb_coils, 648)},
+	{__MB_SLOTS(mb_coils, 656)},
+	{__MB_SLOTS(mb_coils, 664)},
+	{__MB_SLOTS(mb_coils, 672)},
+	{__MB_SLOTS(mb_coils, 680)},
+	{__MB_SLOTS(mb_coils, 688)},
+	{__MB_SLOTS(mb_coils, 696)},
+	{__MB_SLOTS(mb_coils, 704)},
+	{__MB_SLOTS(mb_coils, 712)},
+	{__MB_SLOTS(mb_coils, 720)},
+	{__MB_SLOTS(mb_coils, 728)},
+	{__MB_SLOTS(mb_coils, 736)},
+	{__MB_SLOTS(mb_coils, 744)},
+	{__MB_SLOTS(mb_coils, 752)},
+	{__MB_SLOTS(mb_coils, 760)},
+	{__MB_SLOTS(mb_coils, 768)},
+	{__MB_SLOTS(mb_coils, 776)},
+	{__MB_SLOTS(mb_coils, 784)},
+	{__MB_SLOTS(mb_coils, 792)},
+	{__MB_SLOTS(mb_coils, 800)},
+	{__MB_SLOTS(mb_coils, 808)},
+	{__MB_SLOTS(mb_coils, 816)},
+	{__MB_SLOTS(mb_coils, 824)},
+	{__MB_SLOTS(mb_coils, 832)},
+	{__MB_SLOTS(mb_coils, 840)},
+	{__MB_SLOTS(mb_coils, 848)},
+	{__MB_SLOTS(mb_coils, 856)},
+	{__MB_SLOTS(mb_coils, 864)},
+	{__MB_SLOTS(mb_coils, 872)},
+	{__MB_SLOTS(mb_coils, 880)},
+	{__MB_SLOTS(mb_coils, 888)},
+	{__MB_SLOTS(mb_coils, 896)},
+	{__MB_SLOTS(mb_coils, 904)},
+	{__MB_SLOTS(mb_coils, 912)},
+	{__MB_SLOTS(mb_coils, 920)},
+	{__MB_SLOTS(mb_coils, 928)},
+	{__MB_SLOTS(mb_coils, 936)},
+	{__MB_SLOTS(mb_coils, 944)},
+	{__MB_SLOTS(mb_coils, 952)},
+	{__MB_SLOTS(mb_coils, 960)},
+	{__MB_SLOTS(mb_coils, 968)},
+	{__MB_SLOTS(mb_coils, 976)},
+	{__MB_SLOTS(mb_coils, 984)},
+	{__MB_SLOTS(mb_coils, 992)},
+	{__MB_SLOTS(mb_coils, 1000)},
+	{__MB_SLOTS(mb_coils, 1008)},
+	{__MB_SLOTS(mb_coils, 1016)},
+	{__MB_SLOTS(mb_coils, 1024)},
+	{__MB_SLOTS(mb_coils, 1032)},
+	{__MB_SLOTS(mb_coils, 1040)},
+	{__MB_SLOTS(mb_coils, 1048)},
+	{__MB_SLOTS(mb_coils, 1056)},
+	{__MB_SLOTS(mb_coils, 1064)},
+	{__MB_SLOTS(mb_coils, 1072)},
+	{__MB_SLOTS(mb_coils, 1080)},
+	{__MB_SLOTS(mb_coils, 1088)},
+	{__MB_SLOTS(mb_coils, 1096)},
+	{__MB_SLOTS(mb_coils, 1104)},
+	{__MB_SLOTS(mb_coils, 1112)},
+	{__MB_SLOTS(mb_coils, 1120)},
+	{__MB_SLOTS(mb_coils, 1128)},
+	{__MB_SLOTS(mb_coils, 1136)},
+	{__MB_SLOTS(mb_coils, 1144)},
+	{__MB_SLOTS(mb_coils, 1152)},
+	{__MB_SLOTS(mb_coils, 1160)},
+	{__MB_SLOTS(mb_coils, 1168)},
+	{__MB_SLOTS(mb_coils, 1176)},
+	{__MB_SLOTS(mb_coils, 1184)},
+	{__MB_SLOTS(mb_coils, 1192)},
+	{__MB_SLOTS(mb_coils, 1200)},
+	{__MB_SLOTS(mb_coils, 1208)},
+	{__MB_SLOTS(mb_coils, 1216)},
+	{__MB_SLOTS(mb_coils, 1224)},
+	{__MB_SLOTS(mb_coils, 1232)},
+	{__MB_SLOTS(mb_coils, 1240)},
+	{__MB_SLOTS(mb_coils, 1248)},
+	{__MB_SLOTS(mb_coils, 1256)},
+	{__MB_SLOTS(mb_coils, 1264)},
+	{__MB_SLOTS(mb_coils, 1272)},
+	{__MB_SLOTS(mb_coils, 1280)},
+	{__MB_SLOTS(mb_coils, 1288)},
+	{__MB_SLOTS(mb_coils, 1296)},
+	{__MB_SLOTS(mb_coils, 1304)},
+	{__MB_SLOTS(mb_coils, 1312)},
+	{__MB_SLOTS(mb_coils, 1320)},
+	{__MB_SLOTS(mb_coils, 1328)},
+	{__MB_SLOTS(mb_coils, 1336)},
+	{__MB_SLOTS(mb_coils, 1344)},
+	{__MB_SLOTS(mb_coils, 1352)},
+	{__MB_SLOTS(mb_coils, 1360)},
+	{__MB_SLOTS(mb_coils, 1368)},
+	{__MB_SLOTS(mb_coils, 1376)},
+	{__MB_SLOTS(mb_coils, 1384)},
+	{__MB_SLOTS(mb_coils, 1392)},
+	{__MB_SLOTS(mb_coils, 1400)},
+	{__MB_SLOTS(mb_coils, 1408)},
+	{__MB_SLOTS(mb_coils, 1416)},
+	{__MB_SLOTS(mb_coils, 1424)},
+	{__MB_SLOTS(mb_coils, 1432)},
+	{__MB_SLOTS(mb_coils, 1440)},
+	{__MB_SLOTS(mb_coils, 1448)},
+	{__MB_SLOTS(mb_coils, 1456)},
+	{__MB_SLOTS(mb_coils, 1464)},
+	{__MB_SLOTS(mb_coils, 1472)},
+	{__MB_SLOTS(mb_coils, 1480)},
+	{__MB_SLOTS(mb_coils, 1488)},
+	{__MB_SLOTS(mb_coils, 1496)},
+	{__MB_SLOTS(mb_coils, 1504)},
+	{__MB_SLOTS(mb_coils, 1512)},
+	{__MB_SLOTS(mb_coils, 1520)},
+	{__MB_SLOTS(mb_coils, 1528)},
+	{__MB_SLOTS(mb_coils, 1536)},
+	{__MB_SLOTS(mb_coils, 1544)},
+	{__MB_SLOTS(mb_coils, 1552)},
+	{__MB_SLOTS(mb_coils, 1560)},
+	{__MB_SLOTS(mb_coils, 1568)},
+	{__MB_SLOTS(mb_coils, 1576)},
+	{__MB_SLOTS(mb_coils, 1584)},
+	{__MB_SLOTS(mb_coils, 1592)},
+	{__MB_SLOTS(mb_coils, 1600)},
+	{__MB_SLOTS(mb_coils, 1608)},
+	{__MB_SLOTS(mb_coils, 1616)},
+	{__MB_SLOTS(mb_coils, 1624)},
+	{__MB_SLOTS(mb_coils, 1632)},
+	{__MB_SLOTS(mb_coils, 1640)},
+	{__MB_SLOTS(mb_coils, 1648)},
+	{__MB_SLOTS(mb_coils, 1656)},
+	{__MB_SLOTS(mb_coils, 1664)},
+	{__MB_SLOTS(mb_coils, 1672)},
+	{__MB_SLOTS(mb_coils, 1680)},
+	{__MB_SLOTS(mb_coils, 1688)},
+	{__MB_SLOTS(mb_coils, 1696)},
+	{__MB_SLOTS(mb_coils, 1704)},
+	{__MB_SLOTS(mb_coils, 1712)},
+	{__MB_SLOTS(mb_coils, 1720)},
+	{__MB_SLOTS(mb_coils, 1728)},
+	{__MB_SLOTS(mb_coils, 1736)},
+	{__MB_SLOTS(mb_coils, 1744)},
+	{__MB_SLOTS(mb_coils, 1752)},
+	{__MB_SLOTS(mb_coils, 1760)},
+	{__MB_SLOTS(mb_coils, 1768)},
+	{__MB_SLOTS(mb_coils, 1776)},
+	{__MB_SLOTS(mb_coils, 1784)},
+	{__MB_SLOTS(mb_coils, 1792)},
+	{__MB_SLOTS(mb_coils, 1800)},
+	{__MB_SLOTS(mb_coils, 1808)},
+	{__MB_SLOTS(mb_coils, 1816)},
+	{__MB_SLOTS(mb_coils, 1824)},
+	{__MB_SLOTS(mb_coils, 1832)},
+	{__MB_SLOTS(mb_coils, 1840)},
+	{__MB_SLOTS(mb_coils, 1848)},
+	{__MB_SLOTS(mb_coils, 1856)},
+	{__MB_SLOTS(mb_coils, 1864)},
+	{__MB_SLOTS(mb_coils, 1872)},
+	{__MB_SLOTS(mb_coils, 1880)},
+	{__MB_SLOTS(mb_coils, 1888)},
+	{__MB_SLOTS(mb_coils, 1896)},
+	{__MB_SLOTS(mb_coils, 1904)},
+	{__MB_SLOTS(mb_coils, 1912)},
+	{__MB_SLOTS(mb_coils, 1920)},
+	{__MB_SLOTS(mb_coils, 1928)},
+	{__MB_SLOTS(mb_coils, 1936)},
+	{__MB_SLOTS(mb_coils, 1944)},
+	{__MB_SLOTS(mb_coils, 1952)},
+	{__MB_SLOTS(mb_coils, 1960)},
+	{__MB_SLOTS(mb_coils, 1968)},
+	{__MB_SLOTS(mb_coils, 1976)},
+	{__MB_SLOTS(mb_coils, 1984)},
+	{__MB_SLOTS(mb_coils, 1992)},
+	{__MB_SLOTS(mb_coils, 2000)},
+	{__MB_SLOTS(mb_coils, 2008)},
+	{__MB_SLOTS(mb_coils, 2016)},
+	{__MB_SLOTS(mb_coils, 2024)},
+	{__MB_SLOTS(mb_coils, 2032)},
+	{__MB_SLOTS(mb_coils, 2040)},
+	{__MB_SLOTS(mb_coils, 2048)},
+	{__MB_SLOTS(mb_coils, 2056)},
+	{__MB_SLOTS(mb_coils, 2064)},
+	{__MB_SLOTS(mb_coils, 2072)},
+	{__MB_SLOTS(mb_coils, 2080)},
+	{__MB_SLOTS(mb_coils, 2088)},
+	{__MB_SLOTS(mb_coils, 2096)},
+	{__MB_SLOTS(mb_coils, 2104)},
+	{__MB_SLOTS(mb_coils, 2112)},
+	{__MB_SLOTS(mb_coils, 2120)},
+	{__MB_SLOTS(mb_coils, 2128)},
+	{__MB_SLOTS(mb_coils, 2136)},
+	{__MB_SLOTS(mb_coils, 2144)},
+	{__MB_SLOTS(mb_coils, 2152)},
+	{__MB_SLOTS(mb_coils, 2160)},
+	{__MB_SLOTS(mb_coils, 2168)},
+	{__MB_SLOTS(mb_coils, 2176)},
+	{__MB_SLOTS(mb_coils, 2184)},
+	{__MB_SLOTS(mb_coils, 2192)},
+	{__MB_SLOTS(mb_coils, 2200)},
+	{__MB_SLOTS(mb_coils, 2208)},
+	{__MB_SLOTS(mb_coils, 2216)},
+	{__MB_SLOTS(mb_coils, 2224)},
+	{__MB_SLOTS(mb_coils, 2232)},
+	{__MB_SLOTS(mb_coils, 2240)},
+	{__MB_SLOTS(mb_coils, 2248)},
+	{__MB_SLOTS(mb_coils, 2256)},
+	{__MB_SLOTS(mb_coils, 2264)},
+	{__MB_SLOTS(mb_coils, 2272)},
+	{__MB_SLOTS(mb_coils, 2280)},
+	{__MB_SLOTS(mb_coils, 2288)},
+	{__MB_SLOTS(mb_coils, 2296)},
+	{__MB_SLOTS(mb_coils, 2304)},
+	{__MB_SLOTS(mb_coils, 2312)},
+	{__MB_SLOTS(mb_coils, 2320)},
+	{__MB_SLOTS(mb_coils, 2328)},
+	{__MB_SLOTS(mb_coils, 2336)},
+	{__MB_SLOTS(mb_coils, 2344)},
+	{__MB_SLOTS(mb_coils, 2352)},
+	{__MB_SLOTS(mb_coils, 2360)},
+	{__MB_SLOTS(mb_coils, 2368)},
+	{__MB_SLOTS(mb_coils, 2376)},
+	{__MB_SLOTS(mb_coils, 2384)},
+	{__MB_SLOTS(mb_coils, 2392)},
+	{__MB_SLOTS(mb_coils, 2400)},
+	{__MB_SLOTS(mb_coils, 2408)},
+	{__MB_SLOTS(mb_coils, 2416)},
+	{__MB_SLOTS(mb_coils, 2424)},
+	{__MB_SLOTS(mb_coils, 2432)},
+	{__MB_SLOTS(mb_coils, 2440)},
+	{__MB_SLOTS(mb_coils, 2448)},
+	{__MB_SLOTS(mb_coils, 2456)},
+	{__MB_SLOTS(mb_coils, 2464)},
+	{__MB_SLOTS(mb_coils, 2472)},
+	{__MB_SLOTS(mb_coils, 2480)},
+	{__MB_SLOTS(mb_coils, 2488)},
+	{__MB_SLOTS(mb_coils, 2496)},
+	{__MB_SLOTS(mb_coils, 2504)},
+	{__MB_SLOTS(mb_coils, 2512)},
+	{__MB_SLOTS(mb_coils, 2520)},
+	{__MB_SLOTS(mb_coils, 2528)},
+	{__MB_SLOTS(mb_coils, 2536)},
+	{__MB_SLOTS(mb_coils, 2544)},
+	{__MB_SLOTS(mb_coils, 2552)},
+	{__MB_SLOTS(mb_coils, 2560)},
+	{__MB_SLOTS(mb_coils, 2568)},
+	{__MB_SLOTS(mb_coils, 2576)},
+	{__MB_SLOTS(mb_coils, 2584)},
+	{__MB_SLOTS(mb_coils, 2592)},
+	{__MB_SLOTS(mb_coils, 2600)},
+	{__MB_SLOTS(mb_coils, 2608)},
+	{__MB_SLOTS(mb_coils, 2616)},
+	{__MB_SLOTS(mb_coils, 2624)},
+	{__MB_SLOTS(mb_coils, 2632)},
+	{__MB_SLOTS(mb_coils, 2640)},
+	{__MB_SLOTS(mb_coils, 2648)},
+	{__MB_SLOTS(mb_coils, 2656)},
+	{__MB_SLOTS(mb_coils, 2664)},
+	{__MB_SLOTS(mb_coils, 2672)},
+	{__MB_SLOTS(mb_coils, 2680)},
+	{__MB_SLOTS(mb_coils, 2688)},
+	{__MB_SLOTS(mb_coils, 2696)},
+	{__MB_SLOTS(mb_coils, 2704)},
+	{__MB_SLOTS(mb_coils, 2712)},
+	{__MB_SLOTS(mb_coils, 2720)},
+	{__MB_SLOTS(mb_coils, 2728)},
+	{__MB_SLOTS(mb_coils, 2736)},
+	{__MB_SLOTS(mb_coils, 2744)},
+	{__MB_SLOTS(mb_coils, 2752)},
+	{__MB_SLOTS(mb_coils, 2760)},
+	{__MB_SLOTS(mb_coils, 2768)},
+	{__MB_SLOTS(mb_coils, 2776)},
+	{__MB_SLOTS(mb_coils, 2784)},
+	{__MB_SLOTS(mb_coils, 2792)},
+	{__MB_SLOTS(mb_coils, 2800)},
+	{__MB_SLOTS(mb_coils, 2808)},
+	{__MB_SLOTS(mb_coils, 2816)},
+	{__MB_SLOTS(mb_coils, 2824)},
+	{__MB_SLOTS(mb_coils, 2832)},
+	{__MB_SLOTS(mb_coils, 2840)},
+	{__MB_SLOTS(mb_coils, 2848)},
+	{__MB_SLOTS(mb_coils, 2856)},
+	{__MB_SLOTS(mb_coils, 2864)},
+	{__MB_SLOTS(mb_coils, 2872)},
+	{__MB_SLOTS(mb_coils, 2880)},
+	{__MB_SLOTS(mb_coils, 2888)},
+	{__MB_SLOTS(mb_coils, 2896)},
+	{__MB_SLOTS(mb_coils, 2904)},
+	{__MB_SLOTS(mb_coils, 2912)},
+	{__MB_SLOTS(mb_coils, 2920)},
+	{__MB_SLOTS(mb_coils, 2928)},
+	{__MB_SLOTS(mb_coils, 2936)},
+	{__MB_SLOTS(mb_coils, 2944)},
+	{__MB_SLOTS(mb_coils, 2952)},
+	{__MB_SLOTS(mb_coils, 2960)},
+	{__MB_SLOTS(mb_coils, 2968)},
+	{__MB_SLOTS(mb_coils, 2976)},
+	{__MB_SLOTS(mb_coils, 2984)},
+	{__MB_SLOTS(mb_coils, 2992)},
+	{__MB_SLOTS(mb_coils, 3000)},
+	{__MB_SLOTS(mb_coils, 3008)},
+	{__MB_SLOTS(mb_coils, 3016)},
+	{__MB_SLOTS(mb_coils, 3024)},
+	{__MB_SLOTS(mb_coils, 3032)},
+	{__MB_SLOTS(mb_coils, 3040)},
+	{__MB_SLOTS(mb_coils, 3048)},
+	{__MB_SLOTS(mb_coils, 3056)},
+	{__MB_SLOTS(mb_coils, 3064)},
+	{__MB_SLOTS(mb_coils, 3072)},
+	{__MB_SLOTS(mb_coils, 3080)},
+	{__MB_SLOTS(mb_coils, 3088)},
+	{__MB_SLOTS(mb_coils, 3096)},
+	{__MB_SLOTS(mb_coils, 3104)},
+	{__MB_SLOTS(mb_coils, 3112)},
+	{__MB_SLOTS(mb_coils, 3120)},
+	{__MB_SLOTS(mb_coils, 3128)},
+	{__MB_SLOTS(mb_coils, 3136)},
+	{__MB_SLOTS(mb_coils, 3144)},
+	{__MB_SLOTS(mb_coils, 3152)},
+	{__MB_SLOTS(mb_coils, 3160)},
+	{__MB_SLOTS(mb_coils, 3168)},
+	{__MB_SLOTS(mb_coils, 3176)},
+	{__MB_SLOTS(mb_coils, 3184)},
+	{__MB_SLOTS(mb_coils, 3192)},
+	{__MB_SLOTS(mb_coils, 3200)},
+	{__MB_SLOTS(mb_coils, 3208)},
+	{__MB_SLOTS(mb_coils, 3216)},
+	{__MB_SLOTS(mb_coils, 3224)},
+	{__MB_SLOTS(mb_coils, 3232)},
+	{__MB_SLOTS(mb_coils, 3240)},
+	{__MB_SLOTS(mb_coils, 3248)},
+	{__MB_SLOTS(mb_coils, 3256)},
+	{__MB_SLOTS(mb_coils, 3264)},
+	{__MB_SLOTS(mb_coils, 3272)},
+	{__MB_SLOTS(mb_coils, 3280)},
+	{__MB_SLOTS(mb_coils, 3288)},
+	{__MB_SLOTS(mb_coils, 3296)},
+	{__MB_SLOTS(mb_coils, 3304)},
+	{__MB_SLOTS(mb_coils, 3312)},
+	{__MB_SLOTS(mb_coils, 3320)},
+	{__MB_SLOTS(mb_coils, 3328)},
+	{__MB_SLOTS(mb_coils, 3336)},
+	{__MB_SLOTS(mb_coils, 3344)},
+	{__MB_SLOTS(mb_coils, 3352)},
+	{__MB_SLOTS(mb_coils, 3360)},
+	{__MB_SLOTS(mb_coils, 3368)},
+	{__MB_SLOTS(mb_coils, 3376)},
+	{__MB_SLOTS(mb_coils, 3384)},
+	{__MB_SLOTS(mb_coils, 3392)},
+	{__MB_SLOTS(mb_coils, 3400)},
+	{__MB_SLOTS(mb_coils, 3408)},
+	{__MB_SLOTS(mb_coils, 3416)},
+	{__MB_SLOTS(mb_coils, 3424)},
+	{__MB_SLOTS(mb_coils, 3432)},
+	{__MB_SLOTS(mb_coils, 3440)},
+	{__MB_SLOTS(mb_coils, 3448)},
+	{__MB_SLOTS(mb_coils, 3456)},
+	{__MB_SLOTS(mb_coils, 3464)},
+	{__MB_SLOTS(mb_coils, 3472)},
+	{__MB_SLOTS(mb_coils, 3480)},
+	{__MB_SLOTS(mb_coils, 3488)},
+	{__MB_SLOTS(mb_coils, 3496)},
+	{__MB_SLOTS(mb_coils, 3504)},
+	{__MB_SLOTS(mb_coils, 3512)},
+	{__MB_SLOTS(mb_coils, 3520)},
+	{__MB_SLOTS(mb_coils, 3528)},
+	{__MB_SLOTS(mb_coils, 3536)},
+	{__MB_SLOTS(mb_coils, 3544)},
+	{__MB_SLOTS(mb_coils, 3552)},
+	{__MB_SLOTS(mb_coils, 3560)},
+	{__MB_SLOTS(mb_coils, 3568)},
+	{__MB_SLOTS(mb_coils, 3576)},
+	{__MB_SLOTS(mb_coils, 3584)},
+	{__MB_SLOTS(mb_coils, 3592)},
+	{__MB_SLOTS(mb_coils, 3600)},
+	{__MB_SLOTS(mb_coils, 3608)},
+	{__MB_SLOTS(mb_coils, 3616)},
+	{__MB_SLOTS(mb_coils, 3624)},
+	{__MB_SLOTS(mb_coils, 3632)},
+	{__MB_SLOTS(mb_coils, 3640)},
+	{__MB_SLOTS(mb_coils, 3648)},
+	{__MB_SLOTS(mb_coils, 3656)},
+	{__MB_SLOTS(mb_coils, 3664)},
+	{__MB_SLOTS(mb_coils, 3672)},
+	{__MB_SLOTS(mb_coils, 3680)},
+	{__MB_SLOTS(mb_coils, 3688)},
+	{__MB_SLOTS(mb_coils, 3696)},
+	{__MB_SLOTS(mb_coils, 3704)},
+	{__MB_SLOTS(mb_coils, 3712)},
+	{__MB_SLOTS(mb_coils, 3720)},
+	{__MB_SLOTS(mb_coils, 3728)},
+	{__MB_SLOTS(mb_coils, 3736)},
+	{__MB_SLOTS(mb_coils, 3744)},
+	{__MB_SLOTS(mb_coils, 3752)},
+	{__MB_SLOTS(mb_coils, 3760)},
+	{__MB_SLOTS(mb_coils, 3768)},
+	{__MB_SLOTS(mb_coils, 3776)},
+	{__MB_SLOTS(mb_coils, 3784)},
+	{__MB_SLOTS(mb_coils, 3792)},
+	{__MB_SLOTS(mb_coils, 3800)},
+	{__MB_SLOTS(mb_coils, 3808)},
+	{__MB_SLOTS(mb_coils, 3816)},
+	{__MB_SLOTS(mb_coils, 3824)},
+	{__MB_SLOTS(mb_coils, 3832)},
+	{__MB_SLOTS(mb_coils, 3840)},
+	{__MB_SLOTS(mb_coils, 3848)},
+	{__MB_SLOTS(mb_coils, 3856)},
+	{__MB_SLOTS(mb_coils, 3864)},
+	{__MB_SLOTS(mb_coils, 3872)},
+	{__MB_SLOTS(mb_coils, 3880)},
+	{__MB_SLOTS(mb_coils, 3888)},
+	{__MB_SLOTS(mb_coils, 3896)},
+	{__MB_SLOTS(mb_coils, 3904)},
+	{__MB_SLOTS(mb_coils, 3912)},
+	{__MB_SLOTS(mb_coils, 3920)},
+	{__MB_SLOTS(mb_coils, 3928)},
+	{__MB_SLOTS(mb_coils, 3936)},
+	{__MB_SLOTS(mb_coils, 3944)},
+	{__MB_SLOTS(mb_coils, 3952)},
+	{__MB_SLOTS(mb_coils, 3960)},
+	{__MB_SLOTS(mb_coils, 3968)},
+	{__MB_SLOTS(mb_coils, 3976)},
+	{__MB_SLOTS(mb_coils, 3984)},
+	{__MB_SLOTS(mb_coils, 3992)},
+	{__MB_SLOTS(mb_coils, 4000)},
+	{__MB_SLOTS(mb_coils, 4008)},
+	{__MB_SLOTS(mb_coils, 4016)},
+	{__MB_SLOTS(mb_coils, 4024)},
+	{__MB_SLOTS(mb_coils, 4032)},
+	{__MB_SLOTS(mb_coils, 4040)},
+	{__MB_SLOTS(mb_coils, 4048)},
+	{__MB_SLOTS(mb_coils, 4056)},
+	{__MB_SLOTS(mb_coils, 4064)},
+	{__MB_SLOTS(mb_coils, 4072)},
+	{__MB_SLOTS(mb_coils, 4080)},
+	{__MB_SLOTS(mb_coils, 4088)},
+	{__MB_SLOTS(mb_coils, 4096)},
+	{__MB_SLOTS(mb_coils, 4104)},
+	{__MB_SLOTS(mb_coils, 4112)},
+	{__MB_SLOTS(mb_coils, 4120)},
+	{__MB_SLOTS(mb_coils, 4128)},
+	{__MB_SLOTS(mb_coils, 4136)},
+	{__MB_SLOTS(mb_coils, 4144)},
+	{__MB_SLOTS(mb_coils, 4152)},
+	{__MB_SLOTS(mb_coils, 4160)},
+	{__MB_SLOTS(mb_coils, 4168)},
+	{__MB_SLOTS(mb_coils, 4176)},
+	{__MB_SLOTS(mb_coils, 4184)},
+	{__MB_SLOTS(mb_coils, 4192)},
+	{__MB_SLOTS(mb_coils, 4200)},
+	{__MB_SLOTS(mb_coils, 4208)},
+	{__MB_SLOTS(mb_coils, 4216)},
+	{__MB_SLOTS(mb_coils, 4224)},
+	{__MB_SLOTS(mb_coils, 4232)},
+	{__MB_SLOTS(mb_coils, 4240)},
+	{__MB_SLOTS(mb_coils, 4248)},
+	{__MB_SLOTS(mb_coils, 4256)},
+	{__MB_SLOTS(mb_coils, 4264)},
+	{__MB_SLOTS(mb_coils, 4272)},
+	{__MB_SLOTS(mb_coils, 4280)},
+	{__MB_SLOTS(mb_coils, 4288)},
+	{__MB_SLOTS(mb_coils, 4296)},
+	{__MB_SLOTS(mb_coils, 4304)},
+	{__MB_SLOTS(mb_coils, 4312)},
+	{__MB_SLOTS(mb_coils, 4320)},
+	{__MB_SLOTS(mb_coils, 4328)},
+	{__MB_SLOTS(mb_coils, 4336)},
+	{__MB_SLOTS(mb_coils, 4344)},
+	{__MB_SLOTS(mb_coils, 4352)},
+	{__MB_SLOTS(mb_coils, 4360)},
+	{__MB_SLOTS(mb_coils, 4368)},
+	{__MB_SLOTS(mb_coils, 4376)},
+	{__MB_SLOTS(mb_coils, 4384)},
+	{__MB_SLOTS(mb_coils, 4392)},
+	{__MB_SLOTS(mb_coils, 4400)},
+	{__MB_SLOTS(mb_coils, 4408)},
+	{__MB_SLOTS(mb_coils, 4416)},
+	{__MB_SLOTS(mb_coils, 4424)},
+	{__MB_SLOTS(mb_coils, 4432)},
+	{__MB_SLOTS(mb_coils, 4440)},
+	{__MB_SLOTS(mb_coils, 4448)},
+	{__MB_SLOTS(mb_coils, 4456)},
+	{__MB_SLOTS(mb_coils, 4464)},
+	{__MB_SLOTS(mb_coils, 4472)},
+	{__MB_SLOTS(mb_coils, 4480)},
+	{__MB_SLOTS(mb_coils, 4488)},
+	{__MB_SLOTS(mb_coils, 4496)},
+	{__MB_SLOTS(mb_coils, 4504)},
+	{__MB_SLOTS(mb_coils, 4512)},
+	{__MB_SLOTS(mb_coils, 4520)},
+	{__MB_SLOTS(mb_coils, 4528)},
+	{__MB_SLOTS(mb_coils, 4536)},
+	{__MB_SLOTS(mb_coils, 4544)},
+	{__MB_SLOTS(mb_coils, 4552)},
+	{__MB_SLOTS(mb_coils, 4560)},
+	{__MB_SLOTS(mb_coils, 4568)},
+	{__MB_SLOTS(mb_coils, 4576)},
+	{__MB_SLOTS(mb_coils, 4584)},
+	{__MB_SLOTS(mb_coils, 4592)},
+	{__MB_SLOTS(mb_coils, 4600)},
+	{__MB_SLOTS(mb_coils, 4608)},
+	{__MB_SLOTS(mb_coils, 4616)},
+	{__MB_SLOTS(mb_coils, 4624)},
+	{__MB_SLOTS(mb_coils, 4632)},
+	{__MB_SLOTS(mb_coils, 4640)},
+	{__MB_SLOTS(mb_coils, 4648)},
+	{__MB_SLOTS(mb_coils, 4656)},
+	{__MB_SLOTS(mb_coils, 4664)},
+	{__MB_SLOTS(mb_coils, 4672)},
+	{__MB_SLOTS(mb_coils, 4680)},
+	{__MB_SLOTS(mb_coils, 4688)},
+	{__MB_SLOTS(mb_coils, 4696)},
+	{__MB_SLOTS(mb_coils, 4704)},
+	{__MB_SLOTS(mb_coils, 4712)},
+	{__MB_SLOTS(mb_coils, 4720)},
+	{__MB_SLOTS(mb_coils, 4728)},
+	{__MB_SLOTS(mb_coils, 4736)},
+	{__MB_SLOTS(mb_coils, 4744)},
+	{__MB_SLOTS(mb_coils, 4752)},
+	{__MB_SLOTS(mb_coils, 4760)},
+	{__MB_SLOTS(mb_coils, 4768)},
+	{__MB_SLOTS(mb_coils, 4776)},
+	{__MB_SLOTS(mb_coils, 4784)},
+	{__MB_SLOTS(mb_coils, 4792)},
+	{__MB_SLOTS(mb_coils, 4800)},
+	{__MB_SLOTS(mb_coils, 4808)},
+	{__MB_SLOTS(mb_coils, 4816)},
+	{__MB_SLOTS(mb_coils, 4824)},
+	{__MB_SLOTS(mb_coils, 4832)},
+	{__MB_SLOTS(mb_coils, 4840)},
+	{__MB_SLOTS(mb_coils, 4848)},
+	{__MB_SLOTS(mb_coils, 4856)},
+	{__MB_SLOTS(mb_coils, 4864)},
+	{__MB_SLOTS(mb_coils, 4872)},
+	{__MB_SLOTS(mb_coils, 4880)},
+	{__MB_SLOTS(mb_coils, 4888)},
+	{__MB_SLOTS(mb_coils, 4896)},
+	{__MB_SLOTS(mb_coils, 4904)},
+	{__MB_SLOTS(mb_coils, 4912)},
+	{__MB_SLOTS(mb_coils, 4920)},
+	{__MB_SLOTS(mb_coils, 4928)},
+	{__MB_SLOTS(mb_coils, 4936)},
+	{__MB_SLOTS(mb_coils, 4944)},
+	{__MB_SLOTS(mb_coils, 4952)},
+	{__MB_SLOTS(mb_coils, 4960)},
+	{__MB_SLOTS(mb_coils, 4968)},
+	{__MB_SLOTS(mb_coils, 4976)},
+	{__MB_SLOTS(mb_coils, 4984)},
+	{__MB_SLOTS(mb_coils, 4992)},
+	{__MB_SLOTS(mb_coils, 5000)},
+	{__MB_SLOTS(mb_coils, 5008)},
+	{__MB_SLOTS(mb_coils, 5016)},
+	{__MB_SLOTS(mb_coils, 5024)},
+	{__MB_SLOTS(mb_coils, 5032)},
+	{__MB_SLOTS(mb_coils, 5040)},
+	{__MB_SLOTS(mb_coils, 5048)},
+	{__MB_SLOTS(mb_coils, 5056)},
+	{__MB_SLOTS(mb_coils, 5064)},
+	{__MB_SLOTS(mb_coils, 5072)},
+	{__MB_SLOTS(mb_coils, 5080)},
+	{__MB_SLOTS(mb_coils, 5088)},
+	{__MB_SLOTS(mb_coils, 5096)},
+	{__MB_SLOTS(mb_coils, 5104)},
+	{__MB_SLOTS(mb_coils, 5112)},
+	{__MB_SLOTS(mb_coils, 5120)},
+	{__MB_SLOTS(mb_coils, 5128)},
+	{__MB_SLOTS(mb_coils, 5136)},
+	{__MB_SLOTS(mb_coils, 5144)},
+	{__MB_SLOTS(mb_coils, 5152)},
+	{__MB_SLOTS(mb_coils, 5160)},
+	{__MB_SLOTS(mb_coils, 5168)},
+	{__MB_SLOTS(mb_coils, 5176)},
+	{__MB_SLOTS(mb_coils, 5184)},
+	{__MB_SLOTS(mb_coils, 5192)},
+	{__MB_SLOTS(mb_coils, 5200)},
+	{__MB_SLOTS(mb_coils, 5208)},
+	{__MB_SLOTS(mb_coils, 5216)},
+	{__MB_SLOTS(mb_coils, 5224)},
+	{__MB_SLOTS(mb_coils, 5232)},
+	{__MB_SLOTS(mb_coils, 5240)},
+	{__MB_SLOTS(mb_coils, 5248)},
+	{__MB_SLOTS(mb_coils, 5256)},
+	{__MB_SLOTS(mb_coils, 5264)},
+	{__MB_SLOTS(mb_coils, 5272)},
+	{__MB_SLOTS(mb_coils, 5280)},
+	{__MB_SLOTS(mb_coils, 5288)},
+	{__MB_SLOTS(mb_coils, 5296)},
+	{__MB_SLOTS(mb_coils, 5304)},
+	{__MB_SLOTS(mb_coils, 5312)},
+	{__MB_SLOTS(mb_coils, 5320)},
+	{__MB_SLOTS(mb_coils, 5328)},
+	{__MB_SLOTS(mb_coils, 5336)},
+	{__MB_SLOTS(mb_coils, 5344)},
+	{__MB_SLOTS(mb_coils, 5352)},
+	{__MB_SLOTS(mb_coils, 5360)},
+	{__MB_SLOTS(mb_coils, 5368)},
+	{__MB_SLOTS(mb_coils, 5376)},
+	{__MB_SLOTS(mb_coils, 5384)},
+	{__MB_SLOTS(mb_coils, 5392)},
+	{__MB_SLOTS(mb_coils, 5400)},
+	{__MB_SLOTS(mb_coils, 5408)},
+	{__MB_SLOTS(mb_coils, 5416)},
+	{__MB_SLOTS(mb_coils, 5424)},
+	{__MB_SLOTS(mb_coils, 5432)},
+	{__MB_SLOTS(mb_coils, 5440)},
+	{__MB_SLOTS(mb_coils, 5448)},
+	{__MB_SLOTS(mb_coils, 5456)},
+	{__MB_SLOTS(mb_coils, 5464)},
+	{__MB_SLOTS(mb_coils, 5472)},
+	{__MB_SLOTS(mb_coils, 5480)},
+	{__MB_SLOTS(mb_coils, 5488)},
+	{__MB_SLOTS(mb_coils, 5496)},
+	{__MB_SLOTS(mb_coils, 5504)},
+	{__MB_SLOTS(mb_coils, 5512)},
+	{__MB_SLOTS(mb_coils, 5520)},
+	{__MB_SLOTS(mb_coils, 5528)},
+	{__MB_SLOTS(mb_coils, 5536)},
+	{__MB_SLOTS(mb_coils, 5544)},
+	{__MB_SLOTS(mb_coils, 5552)},
+	{__MB_SLOTS(mb_coils, 5560)},
+	{__MB_SLOTS(mb_coils, 5568)},
+	{__MB_SLOTS(mb_coils, 5576)},
+	{__MB_SLOTS(mb_coils, 5584)},
+	{__MB_SLOTS(mb_coils, 5592)},
+	{__MB_SLOTS(mb_coils, 5600)},
+	{__MB_SLOTS(mb_coils, 5608)},
+	{__MB_SLOTS(mb_coils, 5616)},
+	{__MB_SLOTS(mb_coils, 5624)},
+	{__MB_SLOTS(mb_coils, 5632)},
+	{__MB_SLOTS(mb_coils, 5640)},
+	{__MB_SLOTS(mb_coils, 5648)},
+	{__MB_SLOTS(mb_coils, 5656)},
+	{__MB_SLOTS(mb_coils, 5664)},
+	{__MB_SLOTS(mb_coils, 5672)},
+	{__MB_SLOTS(mb_coils, 5680)},
+	{__MB_SLOTS(mb_coils, 5688)},
+	{__MB_SLOTS(mb_coils, 5696)},
+	{__MB_SLOTS(mb_coils, 5704)},
+	{__MB_SLOTS(mb_coils, 5712)},
+	{__MB_SLOTS(mb_coils, 5720)},
+	{__MB_SLOTS(mb_coils, 5728)},
+	{__MB_SLOTS(mb_coils, 5736)},
+	{__MB_SLOTS(mb_coils, 5744)},
+	{__MB_SLOTS(mb_coils, 5752)},
+	{__MB_SLOTS(mb_coils, 5760)},
+	{__MB_SLOTS(mb_coils, 5768)},
+	{__MB_SLOTS(mb_coils, 5776)},
+	{__MB_SLOTS(mb_coils, 5784)},
+	{__MB_SLOTS(mb_coils, 5792)},
+	{__MB_SLOTS(mb_coils, 5800)},
+	{__MB_SLOTS(mb_coils, 5808)},
+	{__MB_SLOTS(mb_coils, 5816)},
+	{__MB_SLOTS(mb_coils, 5824)},
+	{__MB_SLOTS(mb_coils, 5832)},
+	{__MB_SLOTS(mb_coils, 5840)},
+	{__MB_SLOTS(mb_coils, 5848)},
+	{__MB_SLOTS(mb_coils, 5856)},
+	{__MB_SLOTS(mb_coils, 5864)},
+	{__MB_SLOTS(mb_coils, 5872)},
+	{__MB_SLOTS(mb_coils, 5880)},
+	{__MB_SLOTS(mb_coils, 5888)},
+	{__MB_SLOTS(mb_coils, 5896)},
+	{__MB_SLOTS(mb_coils, 5904)},
+	{__MB_SLOTS(mb_coils, 5912)},
+	{__MB_SLOTS(mb_coils, 5920)},
+	{__MB_SLOTS(mb_coils, 5928)},
+	{__MB_SLOTS(mb_coils, 5936)},
+	{__MB_SLOTS(mb_coils, 5944)},
+	{__MB_SLOTS(mb_coils, 5952)},
+	{__MB_SLOTS(mb_coils, 5960)},
+	{__MB_SLOTS(mb_coils, 5968)},
+	{__MB_SLOTS(mb_coils, 5976)},
+	{__MB_SLOTS(mb_coils, 5984)},
+	{__MB_SLOTS(mb_coils, 5992)},
+	{__MB_SLOTS(mb_coils, 6000)},
+	{__MB_SLOTS(mb_coils, 6008)},
+	{__MB_SLOTS(mb_coils, 6016)},
+	{__MB_SLOTS(mb_coils, 6024)},
+	{__MB_SLOTS(mb_coils, 6032)},
+	{__MB_SLOTS(mb_coils, 6040)},
+	{__MB_SLOTS(mb_coils, 6048)},
+	{__MB_SLOTS(mb_coils, 6056)},
+	{__MB_SLOTS(mb_coils, 6064)},
+	{__MB_SLOTS(mb_coils, 6072)},
+	{__MB_SLOTS(mb_coils, 6080)},
+	{__MB_SLOTS(mb_coils, 6088)},
+	{__MB_SLOTS(mb_coils, 6096)},
+	{__MB_SLOTS(mb_coils, 6104)},
+	{__MB_SLOTS(mb_coils, 6112)},
+	{__MB_SLOTS(mb_coils, 6120)},
+	{__MB_SLOTS(mb_coils, 6128)},
+	{__MB_SLOTS(mb_coils, 6136)},
+	{__MB_SLOTS(mb_coils, 6144)},
+	{__MB_SLOTS(mb_coils, 6152)},
+	{__MB_SLOTS(mb_coils, 6160)},
+	{__MB_SLOTS(mb_coils, 6168)},
+	{__MB_SLOTS(mb_coils, 6176)},
+	{__MB_SLOTS(mb_coils, 6184)},
+	{__MB_SLOTS(mb_coils, 6192)},
+	{__MB_SLOTS(mb_coils, 6200)},
+	{__MB_SLOTS(mb_coils, 6208)},
+	{__MB_SLOTS(mb_coils, 6216)},
+	{__MB_SLOTS(mb_coils, 6224)},
+	{__MB_SLOTS(mb_coils, 6232)},
+	{__MB_SLOTS(mb_coils, 6240)},
+	{__MB_SLOTS(mb_coils, 6248)},
+	{__MB_SLOTS(mb_coils, 6256)},
+	{__MB_SLOTS(mb_coils, 6264)},
+	{__MB_SLOTS(mb_coils, 6272)},
+	{__MB_SLOTS(mb_coils, 6280)},
+	{__MB_SLOTS(mb_coils, 6288)},
+	{__MB_SLOTS(mb_coils, 6296)},
+	{__MB_SLOTS(mb_coils, 6304)},
+	{__MB_SLOTS(mb_coils, 6312)},
+	{__MB_SLOTS(mb_coils, 6320)},
+	{__MB_SLOTS(mb_coils, 6328)},
+	{__MB_SLOTS(mb_coils, 6336)},
+	{__MB_SLOTS(mb_coils, 6344)},
+	{__MB_SLOTS(mb_coils, 6352)},
+	{__MB_SLOTS(mb_coils, 6360)},
+	{__MB_SLOTS(mb_coils, 6368)},
+	{__MB_SLOTS(mb_coils, 6376)},
+	{__MB_SLOTS(mb_coils, 6384)},
+	{__MB_SLOTS(mb_coils, 6392)},
+	{__MB_SLOTS(mb_coils, 6400)},
+	{__MB_SLOTS(mb_coils, 6408)},
+	{__MB_SLOTS(mb_coils, 6416)},
+	{__MB_SLOTS(mb_coils, 6424)},
+	{__MB_SLOTS(mb_coils, 6432)},
+	{__MB_SLOTS(mb_coils, 6440)},
+	{__MB_SLOTS(mb_coils, 6448)},
+	{__MB_SLOTS(mb_coils, 6456)},
+	{__MB_SLOTS(mb_coils, 6464)},
+	{__MB_SLOTS(mb_coils, 6472)},
+	{__MB_SLOTS(mb_coils, 6480)},
+	{__MB_SLOTS(mb_coils, 6488)},
+	{__MB_SLOTS(mb_coils, 6496)},
+	{__MB_SLOTS(mb_coils, 6504)},
+	{__MB_SLOTS(mb_coils, 6512)},
+	{__MB_SLOTS(mb_coils, 6520)},
+	{__MB_SLOTS(mb_coils, 6528)},
+	{__MB_SLOTS(mb_coils, 6536)},
+	{__MB_SLOTS(mb_coils, 6544)},
+	{__MB_SLOTS(mb_coils, 6552)},
+	{__MB_SLOTS(mb_coils, 6560)},
+	{__MB_SLOTS(mb_coils, 6568)},
+	{__MB_SLOTS(mb_coils, 6576)},
+	{__MB_SLOTS(mb_coils, 6584)},
+	{__MB_SLOTS(mb_coils, 6592)},
+	{__MB_SLOTS(mb_coils, 6600)},
+	{__MB_SLOTS(mb_coils, 6608)},
+	{__MB_SLOTS(mb_coils, 6616)},
+	{__MB_SLOTS(mb_coils, 6624)},
+	{__MB_SLOTS(mb_coils, 6632)},
+	{__MB_SLOTS(mb_coils, 6640)},
+	{__MB_SLOTS(mb_coils, 6648)},
+	{__MB_SLOTS(mb_coils, 6656)},
+	{__MB_SLOTS(mb_coils, 6664)},
+	{__MB_SLOTS(mb_coils, 6672)},
+	{__MB_SLOTS(mb_coils, 6680)},
+	{__MB_SLOTS(mb_coils, 6688)},
+	{__MB_SLOTS(mb_coils, 6696)},
+	{__MB_SLOTS(mb_coils, 6704)},
+	{__MB_SLOTS(mb_coils, 6712)},
+	{__MB_SLOTS(mb_coils, 6720)},
+	{__MB_SLOTS(mb_coils, 6728)},
+	{__MB_SLOTS(mb_coils, 6736)},
+	{__MB_SLOTS(mb_coils, 6744)},
+	{__MB_SLOTS(mb_coils, 6752)},
+	{__MB_SLOTS(mb_coils, 6760)},
+	{__MB_SLOTS(mb_coils, 6768)},
+	{__MB_SLOTS(mb_coils, 6776)},
+	{__MB_SLOTS(mb_coils, 6784)},
+	{__MB_SLOTS(mb_coils, 6792)},
+	{__MB_SLOTS(mb_coils, 6800)},
+	{__MB_SLOTS(mb_coils, 6808)},
+	{__MB_SLOTS(mb_coils, 6816)},
+	{__MB_SLOTS(mb_coils, 6824)},
+	{__MB_SLOTS(mb_coils, 6832)},
+	{__MB_SLOTS(mb_coils, 6840)},
+	{__MB_SLOTS(mb_coils, 6848)},
+	{__MB_SLOTS(mb_coils, 6856)},
+	{__MB_SLOTS(mb_coils, 6864)},
+	{__MB_SLOTS(mb_coils, 6872)},
+	{__MB_SLOTS(mb_coils, 6880)},
+	{__MB_SLOTS(mb_coils, 6888)},
+	{__MB_SLOTS(mb_coils, 6896)},
+	{__MB_SLOTS(mb_coils, 6904)},
+	{__MB_SLOTS(mb_coils, 6912)},
+	{__MB_SLOTS(mb_coils, 6920)},
+	{__MB_SLOTS(mb_coils, 6928)},
+	{__MB_SLOTS(mb_coils, 6936)},
+	{__MB_SLOTS(mb_coils, 6944)},
+	{__MB_SLOTS(mb_coils, 6952)},
+	{__MB_SLOTS(mb_coils, 6960)},
+	{__MB_SLOTS(mb_coils, 6968)},
+	{__MB_SLOTS(mb_coils, 6976)},
+	{__MB_SLOTS(mb_coils, 6984)},
+	{__MB_SLOTS(mb_coils, 6992)},
+	{__MB_SLOTS(mb_coils, 7000)},
+	{__MB_SLOTS(mb_coils, 7008)},
+	{__MB_SLOTS(mb_coils, 7016)},
+	{__MB_SLOTS(mb_coils, 7024)},
+	{__MB_SLOTS(mb_coils, 7032)},
+	{__MB_SLOTS(mb_coils, 7040)},
+	{__MB_SLOTS(mb_coils, 7048)},
+	{__MB_SLOTS(mb_coils, 7056)},
+	{__MB_SLOTS(mb_coils, 7064)},
+	{__MB_SLOTS(mb_coils, 7072)},
+	{__MB_SLOTS(mb_coils, 7080)},
+	{__MB_SLOTS(mb_coils, 7088)},
+	{__MB_SLOTS(mb_coils, 7096)},
+	{__MB_SLOTS(mb_coils, 7104)},
+	{__MB_SLOTS(mb_coils, 7112)},
+	{__MB_SLOTS(mb_coils, 7120)},
+	{__MB_SLOTS(mb_coils, 7128)},
+	{__MB_SLOTS(mb_coils, 7136)},
+	{__MB_SLOTS(mb_coils, 7144)},
+	{__MB_SLOTS(mb_coils, 7152)},
+	{__MB_SLOTS(mb_coils, 7160)},
+	{__MB_SLOTS(mb_coils, 7168)},
+	{__MB_SLOTS(mb_coils, 7176)},
+	{__MB_SLOTS(mb_coils, 7184)},
+	{__MB_SLOTS(mb_coils, 7192)},
+	{__MB_SLOTS(mb_coils, 7200)},
+	{__MB_SLOTS(mb_coils, 7208)},
+	{__MB_SLOTS(mb_coils, 7216)},
+	{__MB_SLOTS(mb_coils, 7224)},
+	{__MB_SLOTS(mb_coils, 7232)},
+	{__MB_SLOTS(mb_coils, 7240)},
+	{__MB_SLOTS(mb_coils, 7248)},
+	{__MB_SLOTS(mb_coils, 7256)},
+	{__MB_SLOTS(mb_coils, 7264)},
+	{__MB_SLOTS(mb_coils, 7272)},
+	{__MB_SLOTS(mb_coils, 7280)},
+	{__MB_SLOTS(mb_coils, 7288)},
+	{__MB_SLOTS(mb_coils, 7296)},
+	{__MB_SLOTS(mb_coils, 7304)},
+	{__MB_SLOTS(mb_coils, 7312)},
+	{__MB_SLOTS(mb_coils, 7320)},
+	{__MB_SLOTS(mb_coils, 7328)},
+	{__MB_SLOTS(mb_coils, 7336)},
+	{__MB_SLOTS(mb_coils, 7344)},
+	{__MB_SLOTS(mb_coils, 7352)},
+	{__MB_SLOTS(mb_coils, 7360)},
+	{__MB_SLOTS(mb_coils, 7368)},
+	{__MB_SLOTS(mb_coils, 7376)},
+	{__MB_SLOTS(mb_coils, 7384)},
+	{__MB_SLOTS(mb_coils, 7392)},
+	{__MB_SLOTS(mb_coils, 7400)},
+	{__MB_SLOTS(mb_coils, 7408)},
+	{__MB_SLOTS(mb_coils, 7416)},
+	{__MB_SLOTS(mb_coils, 7424)},
+	{__MB_SLOTS(mb_coils, 7432)},
+	{__MB_SLOTS(mb_coils, 7440)},
+	{__MB_SLOTS(mb_coils, 7448)},
+	{__MB_SLOTS(mb_coils, 7456)},
+	{__MB_SLOTS(mb_coils, 7464)},
+	{__MB_SLOTS(mb_coils, 7472)},
+	{__MB_SLOTS(mb_coils, 7480)},
+	{__MB_SLOTS(mb_coils, 7488)},
+	{__MB_SLOTS(mb_coils, 7496)},
+	{__MB_SLOTS(mb_coils, 7504)},
+	{__MB_SLOTS(mb_coils, 7512)},
+	{__MB_SLOTS(mb_coils, 7520)},
+	{__MB_SLOTS(mb_coils, 7528)},
+	{__MB_SLOTS(mb_coils, 7536)},
+	{__MB_SLOTS(mb_coils, 7544)},
+	{__MB_SLOTS(mb_coils, 7552)},
+	{__MB_SLOTS(mb_coils, 7560)},
+	{__MB_SLOTS(mb_coils, 7568)},
+	{__MB_SLOTS(mb_coils, 7576)},
+	{__MB_SLOTS(mb_coils, 7584)},
+	{__MB_SLOTS(mb_coils, 7592)},
+	{__MB_SLOTS(mb_coils, 7600)},
+	{__MB_SLOTS(mb_coils, 7608)},
+	{__MB_SLOTS(mb_coils, 7616)},
+	{__MB_SLOTS(mb_coils, 7624)},
+	{__MB_SLOTS(mb_coils, 7632)},
+	{__MB_SLOTS(mb_coils, 7640)},
+	{__MB_SLOTS(mb_coils, 7648)},
+	{__MB_SLOTS(mb_coils, 7656)},
+	{__MB_SLOTS(mb_coils, 7664)},
+	{__MB_SLOTS(mb_coils, 7672)},
+	{__MB_SLOTS(mb_coils, 7680)},
+	{__MB_SLOTS(mb_coils, 7688)},
+	{__MB_SLOTS(mb_coils, 7696)},
+	{__MB_SLOTS(mb_coils, 7704)},
+	{__MB_SLOTS(mb_coils, 7712)},
+	{__MB_SLOTS(mb_coils, 7720)},
+	{__MB_SLOTS(mb_coils, 7728)},
+	{__MB_SLOTS(mb_coils, 7736)},
+	{__MB_SLOTS(mb_coils, 7744)},
+	{__MB_SLOTS(mb_coils, 7752)},
+	{__MB_SLOTS(mb_coils, 7760)},
+	{__MB_SLOTS(mb_coils, 7768)},
+	{__MB_SLOTS(mb_coils, 7776)},
+	{__MB_SLOTS(mb_coils, 7784)},
+	{__MB_SLOTS(mb_coils, 7792)},
+	{__MB_SLOTS(mb_coils, 7800)},
+	{__MB_SLOTS(mb_coils, 7808)},
+	{__MB_SLOTS(mb_coils, 7816)},
+	{__MB_SLOTS(mb_coils, 7824)},
+	{__MB_SLOTS(mb_coils, 7832)},
+	{__MB_SLOTS(mb_coils, 7840)},
+	{__MB_SLOTS(mb_coils, 7848)},
+	{__MB_SLOTS(mb_coils, 7856)},
+	{__MB_SLOTS(mb_coils, 7864)},
+	{__MB_SLOTS(mb_coils, 7872)},
+	{__MB_SLOTS(mb_coils, 7880)},
+	{__MB_SLOTS(mb_coils, 7888)},
+	{__MB_SLOTS(mb_coils, 7896)},
+	{__MB_SLOTS(mb_coils, 7904)},
+	{__MB_SLOTS(mb_coils, 7912)},
+	{__MB_SLOTS(mb_coils, 7920)},
+	{__MB_SLOTS(mb_coils, 7928)},
+	{__MB_SLOTS(mb_coils, 7936)},
+	{__MB_SLOTS(mb_coils, 7944)},
+	{__MB_SLOTS(mb_coils, 7952)},
+	{__MB_SLOTS(mb_coils, 7960)},
+	{__MB_SLOTS(mb_coils, 7968)},
+	{__MB_SLOTS(mb_coils, 7976)},
+	{__MB_SLOTS(mb_coils, 7984)},
+	{__MB_SLOTS(mb_coils, 7992)},
+	{__MB_SLOTS(mb_coils, 8000)},
+	{__MB_SLOTS(mb_coils, 8008)},
+	{__MB_SLOTS(mb_coils, 8016)},
+	{__MB_SLOTS(mb_coils, 8024)},
+	{__MB_SLOTS(mb_coils, 8032)},
+	{__MB_SLOTS(mb_coils, 8040)},
+	{__MB_SLOTS(mb_coils, 8048)},
+	{__MB_SLOTS(mb_coils, 8056)},
+	{__MB_SLOTS(mb_coils, 8064)},
+	{__MB_SLOTS(mb_coils, 8072)},
+	{__MB_SLOTS(mb_coils, 8080)},
+	{__MB_SLOTS(mb_coils, 8088)},
+	{__MB_SLOTS(mb_coils, 8096)},
+	{__MB_SLOTS(mb_coils, 8104)},
+	{__MB_SLOTS(mb_coils, 8112)},
+	{__MB_SLOTS(mb_coils, 8120)},
+	{__MB_SLOTS(mb_coils, 8128)},
+	{__MB_SLOTS(mb_coils, 8136)},
+	{__MB_SLOTS(mb_coils, 8144)},
+	{__MB_SLOTS(mb_coils, 8152)},
+	{__MB_SLOTS(mb_coils, 8160)},
+	{__MB_SLOTS(mb_coils, 8168)},
+	{__MB_SLOTS(mb_coils, 8176)},
+	{__MB_SLOTS(mb_coils, 8184)},
+};
 
 //Bytes
-IEC_BYTE *byte_input[BUFFER_SIZE];
-IEC_BYTE *byte_output[BUFFER_SIZE];
+extern IEC_BYTE *const byte_input[BUFFER_SIZE] = {};
+extern IEC_BYTE *const byte_output[BUFFER_SIZE] = {};
 
 //Analog I/O
-IEC_UINT *int_input[BUFFER_SIZE];
-IEC_UINT *int_output[BUFFER_SIZE];
+extern IEC_UINT *const int_input[BUFFER_SIZE] = {
+	__MB_SLOTS(mb_input_regs, 0),
+	__MB_SLOTS(mb_input_regs, 8),
+	__MB_SLOTS(mb_input_regs, 16),
+	__MB_SLOTS(mb_input_regs, 24),
+	__MB_SLOTS(mb_input_regs, 32),
+	__MB_SLOTS(mb_input_regs, 40),
+	__MB_SLOTS(mb_input_regs, 48),
+	__MB_SLOTS(mb_input_regs, 56),
+	__MB_SLOTS(mb_input_regs, 64),
+	__MB_SLOTS(mb_input_regs, 72),
+	__MB_SLOTS(mb_input_regs, 80),
+	__MB_SLOTS(mb_input_regs, 88),
+	__MB_SLOTS(mb_input_regs, 96),
+	__MB_SLOTS(mb_input_regs, 104),
+	__MB_SLOTS(mb_input_regs, 112),
+	__MB_SLOTS(mb_input_regs, 120),
+	__MB_SLOTS(mb_input_regs, 128),
+	__MB_SLOTS(mb_input_regs, 136),
+	__MB_SLOTS(mb_input_regs, 144),
+	__MB_SLOTS(mb_input_regs, 152),
+	__MB_SLOTS(mb_input_regs, 160),
+	__MB_SLOTS(mb_input_regs, 168),
+	__MB_SLOTS(mb_input_regs, 176),
+	__MB_SLOTS(mb_input_regs, 184),
+	__MB_SLOTS(mb_input_regs, 192),
+	__MB_SLOTS(mb_input_regs, 200),
+	__MB_SLOTS(mb_input_regs, 208),
+	__MB_SLOTS(mb_input_regs, 216),
+	__MB_SLOTS(mb_input_regs, 224),
+	__MB_SLOTS(mb_input_regs, 232),
+	__MB_SLOTS(mb_input_regs, 240),
+	__MB_SLOTS(mb_input_regs, 248),
+	__MB_SLOTS(mb_input_regs, 256),
+	__MB_SLOTS(mb_input_regs, 264),
+	__MB_SLOTS(mb_input_regs, 272),
+	__MB_SLOTS(mb_input_regs, 280),
+	__MB_SLOTS(mb_input_regs, 288),
+	__MB_SLOTS(mb_input_regs, 296),
+	__MB_SLOTS(mb_input_regs, 304),
+	__MB_SLOTS(mb_input_regs, 312),
+	__MB_SLOTS(mb_input_regs, 320),
+	__MB_SLOTS(mb_input_regs, 328),
+	__MB_SLOTS(mb_input_regs, 336),
+	__MB_SLOTS(mb_input_regs, 344),
+	__MB_SLOTS(mb_input_regs, 352),
+	__MB_SLOTS(mb_input_regs, 360),
+	__MB_SLOTS(mb_input_regs, 368),
+	__MB_SLOTS(mb_input_regs, 376),
+	__MB_SLOTS(mb_input_regs, 384),
+	__MB_SLOTS(mb_input_regs, 392),
+	__MB_SLOTS(mb_input_regs, 400),
+	__MB_SLOTS(mb_input_regs, 408),
+	__MB_SLOTS(mb_input_regs, 416),
+	__MB_SLOTS(mb_input_regs, 424),
+	__MB_SLOTS(mb_input_regs, 432),
+	__MB_SLOTS(mb_input_regs, 440),
+	__MB_SLOTS(mb_input_regs, 448),
+	__MB_SLOTS(mb_input_regs, 456),
+	__MB_SLOTS(mb_input_regs, 464),
+	__MB_SLOTS(mb_input_regs, 472),
+	__MB_SLOTS(mb_input_regs, 480),
+	__MB_SLOTS(mb_input_regs, 488),
+	__MB_SLOTS(mb_input_regs, 496),
+	__MB_SLOTS(mb_input_regs, 504),
+	__MB_SLOTS(mb_input_regs, 512),
+	__MB_SLOTS(mb_input_regs, 520),
+	__MB_SLOTS(mb_input_regs, 528),
+	__MB_SLOTS(mb_input_regs, 536),
+	__MB_SLOTS(mb_input_regs, 544),
+	__MB_SLOTS(mb_input_regs, 552),
+	__MB_SLOTS(mb_input_regs, 560),
+	__MB_SLOTS(mb_input_regs, 568),
+	__MB_SLOTS(mb_input_regs, 576),
+	__MB_SLOTS(mb_input_regs, 584),
+	__MB_SLOTS(mb_input_regs, 592),
+	__MB_SLOTS(mb_input_regs, 600),
+	__MB_SLOTS(mb_input_regs, 608),
+	__MB_SLOTS(mb_input_regs, 616),
+	__MB_SLOTS(mb_input_regs, 624),
+	__MB_SLOTS(mb_input_regs, 632),
+	__MB_SLOTS(mb_input_regs, 640),
+	__MB_SLOTS(mb_input_regs, 648),
+	__MB_SLOTS(mb_input_regs, 656),
+	__MB_SLOTS(mb_input_regs, 664),
+	__MB_SLOTS(mb_input_regs, 672),
+	__MB_SLOTS(mb_input_regs, 680),
+	__MB_SLOTS(mb_input_regs, 688),
+	__MB_SLOTS(mb_input_regs, 696),
+	__MB_SLOTS(mb_input_regs, 704),
+	__MB_SLOTS(mb_input_regs, 712),
+	__MB_SLOTS(mb_input_regs, 720),
+	__MB_SLOTS(mb_input_regs, 728),
+	__MB_SLOTS(mb_input_regs, 736),
+	__MB_SLOTS(mb_input_regs, 744),
+	__MB_SLOTS(mb_input_regs, 752),
+	__MB_SLOTS(mb_input_regs, 760),
+	__MB_SLOTS(mb_input_regs, 768),
+	__MB_SLOTS(mb_input_regs, 776),
+	__MB_SLOTS(mb_input_regs, 784),
+	__MB_SLOTS(mb_input_regs, 792),
+	__MB_SLOTS(mb_input_regs, 800),
+	__MB_SLOTS(mb_input_regs, 808),
+	__MB_SLOTS(mb_input_regs, 816),
+	__MB_SLOTS(mb_input_regs, 824),
+	__MB_SLOTS(mb_input_regs, 832),
+	__MB_SLOTS(mb_input_regs, 840),
+	__MB_SLOTS(mb_input_regs, 848),
+	__MB_SLOTS(mb_input_regs, 856),
+	__MB_SLOTS(mb_input_regs, 864),
+	__MB_SLOTS(mb_input_regs, 872),
+	__MB_SLOTS(mb_input_regs, 880),
+	__MB_SLOTS(mb_input_regs, 888),
+	__MB_SLOTS(mb_input_regs, 896),
+	__MB_SLOTS(mb_input_regs, 904),
+	__MB_SLOTS(mb_input_regs, 912),
+	__MB_SLOTS(mb_input_regs, 920),
+	__MB_SLOTS(mb_input_regs, 928),
+	__MB_SLOTS(mb_input_regs, 936),
+	__MB_SLOTS(mb_input_regs, 944),
+	__MB_SLOTS(mb_input_regs, 952),
+	__MB_SLOTS(mb_input_regs, 960),
+	__MB_SLOTS(mb_input_regs, 968),
+	__MB_SLOTS(mb_input_regs, 976),
+	__MB_SLOTS(mb_input_regs, 984),
+	__MB_SLOTS(mb_input_regs, 992),
+	__MB_SLOTS(mb_input_regs, 1000),
+	__MB_SLOTS(mb_input_regs, 1008),
+	__MB_SLOTS(mb_input_regs, 1016),
+};
+extern IEC_UINT *const int_output[BUFFER_SIZE] = {
+	__MB_SLOTS(mb_holding_regs, 0),
+	__MB_SLOTS(mb_holding_regs, 8),
+	__MB_SLOTS(mb_holding_regs, 16),
+	__MB_SLOTS(mb_holding_regs, 24),
+	__MB_SLOTS(mb_holding_regs, 32),
+	__MB_SLOTS(mb_holding_regs, 40),
+	__MB_SLOTS(mb_holding_regs, 48),
+	__MB_SLOTS(mb_holding_regs, 56),
+	__MB_SLOTS(mb_holding_regs, 64),
+	__MB_SLOTS(mb_holding_regs, 72),
+	__MB_SLOTS(mb_holding_regs, 80),
+	__MB_SLOTS(mb_holding_regs, 88),
+	__MB_SLOTS(mb_holding_regs, 96),
+	__MB_SLOTS(mb_holding_regs, 104),
+	__MB_SLOTS(mb_holding_regs, 112),
+	__MB_SLOTS(mb_holding_regs, 120),
+	__MB_SLOTS(mb_holding_regs, 128),
+	__MB_SLOTS(mb_holding_regs, 136),
+	__MB_SLOTS(mb_holding_regs, 144),
+	__MB_SLOTS(mb_holding_regs, 152),
+	__MB_SLOTS(mb_holding_regs, 160),
+	__MB_SLOTS(mb_holding_regs, 168),
+	__MB_SLOTS(mb_holding_regs, 176),
+	__MB_SLOTS(mb_holding_regs, 184),
+	__MB_SLOTS(mb_holding_regs, 192),
+	__MB_SLOTS(mb_holding_regs, 200),
+	__MB_SLOTS(mb_holding_regs, 208),
+	__MB_SLOTS(mb_holding_regs, 216),
+	__MB_SLOTS(mb_holding_regs, 224),
+	__MB_SLOTS(mb_holding_regs, 232),
+	__MB_SLOTS(mb_holding_regs, 240),
+	__MB_SLOTS(mb_holding_regs, 248),
+	__MB_SLOTS(mb_holding_regs, 256),
+	__MB_SLOTS(mb_holding_regs, 264),
+	__MB_SLOTS(mb_holding_regs, 272),
+	__MB_SLOTS(mb_holding_regs, 280),
+	__MB_SLOTS(mb_holding_regs, 288),
+	__MB_SLOTS(mb_holding_regs, 296),
+	__MB_SLOTS(mb_holding_regs, 304),
+	__MB_SLOTS(mb_holding_regs, 312),
+	__MB_SLOTS(mb_holding_regs, 320),
+	__MB_SLOTS(mb_holding_regs, 328),
+	__MB_SLOTS(mb_holding_regs, 336),
+	__MB_SLOTS(mb_holding_regs, 344),
+	__MB_SLOTS(mb_holding_regs, 352),
+	__MB_SLOTS(mb_holding_regs, 360),
+	__MB_SLOTS(mb_holding_regs, 368),
+	__MB_SLOTS(mb_holding_regs, 376),
+	__MB_SLOTS(mb_holding_regs, 384),
+	__MB_SLOTS(mb_holding_regs, 392),
+	__MB_SLOTS(mb_holding_regs, 400),
+	__MB_SLOTS(mb_holding_regs, 408),
+	__MB_SLOTS(mb_holding_regs, 416),
+	__MB_SLOTS(mb_holding_regs, 424),
+	__MB_SLOTS(mb_holding_regs, 432),
+	__MB_SLOTS(mb_holding_regs, 440),
+	__MB_SLOTS(mb_holding_regs, 448),
+	__MB_SLOTS(mb_holding_regs, 456),
+	__MB_SLOTS(mb_holding_regs, 464),
+	__MB_SLOTS(mb_holding_regs, 472),
+	__MB_SLOTS(mb_holding_regs, 480),
+	__MB_SLOTS(mb_holding_regs, 488),
+	__MB_SLOTS(mb_holding_regs, 496),
+	__MB_SLOTS(mb_holding_regs, 504),
+	__MB_SLOTS(mb_holding_regs, 512),
+	__MB_SLOTS(mb_holding_regs, 520),
+	__MB_SLOTS(mb_holding_regs, 528),
+	__MB_SLOTS(mb_holding_regs, 536),
+	__MB_SLOTS(mb_holding_regs, 544),
+	__MB_SLOTS(mb_holding_regs, 552),
+	__MB_SLOTS(mb_holding_regs, 560),
+	__MB_SLOTS(mb_holding_regs, 568),
+	__MB_SLOTS(mb_holding_regs, 576),
+	__MB_SLOTS(mb_holding_regs, 584),
+	__MB_SLOTS(mb_holding_regs, 592),
+	__MB_SLOTS(mb_holding_regs, 600),
+	__MB_SLOTS(mb_holding_regs, 608),
+	__MB_SLOTS(mb_holding_regs, 616),
+	__MB_SLOTS(mb_holding_regs, 624),
+	__MB_SLOTS(mb_holding_regs, 632),
+	__MB_SLOTS(mb_holding_regs, 640),
+	__MB_SLOTS(mb_holding_regs, 648),
+	__MB_SLOTS(mb_holding_regs, 656),
+	__MB_SLOTS(mb_holding_regs, 664),
+	__MB_SLOTS(mb_holding_regs, 672),
+	__MB_SLOTS(mb_holding_regs, 680),
+	__MB_SLOTS(mb_holding_regs, 688),
+	__MB_SLOTS(mb_holding_regs, 696),
+	__MB_SLOTS(mb_holding_regs, 704),
+	__MB_SLOTS(mb_holding_regs, 712),
+	__MB_SLOTS(mb_holding_regs, 720),
+	__MB_SLOTS(mb_holding_regs, 728),
+	__MB_SLOTS(mb_holding_regs, 736),
+	__MB_SLOTS(mb_holding_regs, 744),
+	__MB_SLOTS(mb_holding_regs, 752),
+	__MB_SLOTS(mb_holding_regs, 760),
+	__MB_SLOTS(mb_holding_regs, 768),
+	__MB_SLOTS(mb_holding_regs, 776),
+	__MB_SLOTS(mb_holding_regs, 784),
+	__MB_SLOTS(mb_holding_regs, 792),
+	__MB_SLOTS(mb_holding_regs, 800),
+	__MB_SLOTS(mb_holding_regs, 808),
+	__MB_SLOTS(mb_holding_regs, 816),
+	__MB_SLOTS(mb_holding_regs, 824),
+	__MB_SLOTS(mb_holding_regs, 832),
+	__MB_SLOTS(mb_holding_regs, 840),
+	__MB_SLOTS(mb_holding_regs, 848),
+	__MB_SLOTS(mb_holding_regs, 856),
+	__MB_SLOTS(mb_holding_regs, 864),
+	__MB_SLOTS(mb_holding_regs, 872),
+	__MB_SLOTS(mb_holding_regs, 880),
+	__MB_SLOTS(mb_holding_regs, 888),
+	__MB_SLOTS(mb_holding_regs, 896),
+	__MB_SLOTS(mb_holding_regs, 904),
+	__MB_SLOTS(mb_holding_regs, 912),
+	__MB_SLOTS(mb_holding_regs, 920),
+	__MB_SLOTS(mb_holding_regs, 928),
+	__MB_SLOTS(mb_holding_regs, 936),
+	__MB_SLOTS(mb_holding_regs, 944),
+	__MB_SLOTS(mb_holding_regs, 952),
+	__MB_SLOTS(mb_holding_regs, 960),
+	__MB_SLOTS(mb_holding_regs, 968),
+	__MB_SLOTS(mb_holding_regs, 976),
+	__MB_SLOTS(mb_holding_regs, 984),
+	__MB_SLOTS(mb_holding_regs, 992),
+	__MB_SLOTS(mb_holding_regs, 1000),
+	__MB_SLOTS(mb_holding_regs, 1008),
+	__MB_SLOTS(mb_holding_regs, 1016),
+};
 
 //Memory
-IEC_UINT *int_memory[BUFFER_SIZE];
-IEC_DINT *dint_memory[BUFFER_SIZE];
-IEC_LINT *lint_memory[BUFFER_SIZE];
+extern IEC_UINT *const int_memory[BUFFER_SIZE] = {
+	__MB_SLOTS(mb_holding_regs, 1024),
+	__MB_SLOTS(mb_holding_regs, 1032),
+	__MB_SLOTS(mb_holding_regs, 1040),
+	__MB_SLOTS(mb_holding_regs, 1048),
+	__MB_SLOTS(mb_holding_regs, 1056),
+	__MB_SLOTS(mb_holding_regs, 1064),
+	__MB_SLOTS(mb_holding_regs, 1072),
+	__MB_SLOTS(mb_holding_regs, 1080),
+	__MB_SLOTS(mb_holding_regs, 1088),
+	__MB_SLOTS(mb_holding_regs, 1096),
+	__MB_SLOTS(mb_holding_regs, 1104),
+	__MB_SLOTS(mb_holding_regs, 1112),
+	__MB_SLOTS(mb_holding_regs, 1120),
+	__MB_SLOTS(mb_holding_regs, 1128),
+	__MB_SLOTS(mb_holding_regs, 1136),
+	__MB_SLOTS(mb_holding_regs, 1144),
+	__MB_SLOTS(mb_holding_regs, 1152),
+	__MB_SLOTS(mb_holding_regs, 1160),
+	__MB_SLOTS(mb_holding_regs, 1168),
+	__MB_SLOTS(mb_holding_regs, 1176),
+	__MB_SLOTS(mb_holding_regs, 1184),
+	__MB_SLOTS(mb_holding_regs, 1192),
+	__MB_SLOTS(mb_holding_regs, 1200),
+	__MB_SLOTS(mb_holding_regs, 1208),
+	__MB_SLOTS(mb_holding_regs, 1216),
+	__MB_SLOTS(mb_holding_regs, 1224),
+	__MB_SLOTS(mb_holding_regs, 1232),
+	__MB_SLOTS(mb_holding_regs, 1240),
+	__MB_SLOTS(mb_holding_regs, 1248),
+	__MB_SLOTS(mb_holding_regs, 1256),
+	__MB_SLOTS(mb_holding_regs, 1264),
+	__MB_SLOTS(mb_holding_regs, 1272),
+	__MB_SLOTS(mb_holding_regs, 1280),
+	__MB_SLOTS(mb_holding_regs, 1288),
+	__MB_SLOTS(mb_holding_regs, 1296),
+	__MB_SLOTS(mb_holding_regs, 1304),
+	__MB_SLOTS(mb_holding_regs, 1312),
+	__MB_SLOTS(mb_holding_regs, 1320),
+	__MB_SLOTS(mb_holding_regs, 1328),
+	__MB_SLOTS(mb_holding_regs, 1336),
+	__MB_SLOTS(mb_holding_regs, 1344),
+	__MB_SLOTS(mb_holding_regs, 1352),
+	__MB_SLOTS(mb_holding_regs, 1360),
+	__MB_SLOTS(mb_holding_regs, 1368),
+	__MB_SLOTS(mb_holding_regs, 1376),
+	__MB_SLOTS(mb_holding_regs, 1384),
+	__MB_SLOTS(mb_holding_regs, 1392),
+	__MB_SLOTS(mb_holding_regs, 1400),
+	__MB_SLOTS(mb_holding_regs, 1408),
+	__MB_SLOTS(mb_holding_regs, 1416),
+	__MB_SLOTS(mb_holding_regs, 1424),
+	__MB_SLOTS(mb_holding_regs, 1432),
+	__MB_SLOTS(mb_holding_regs, 1440),
+	__MB_SLOTS(mb_holding_regs, 1448),
+	__MB_SLOTS(mb_holding_regs, 1456),
+	__MB_SLOTS(mb_holding_regs, 1464),
+	__MB_SLOTS(mb_holding_regs, 1472),
+	__MB_SLOTS(mb_holding_regs, 1480),
+	__MB_SLOTS(mb_holding_regs, 1488),
+	__MB_SLOTS(mb_holding_regs, 1496),
+	__MB_SLOTS(mb_holding_regs, 1504),
+	__MB_SLOTS(mb_holding_regs, 1512),
+	__MB_SLOTS(mb_holding_regs, 1520),
+	__MB_SLOTS(mb_holding_regs, 1528),
+	__MB_SLOTS(mb_holding_regs, 1536),
+	__MB_SLOTS(mb_holding_regs, 1544),
+	__MB_SLOTS(mb_holding_regs, 1552),
+	__MB_SLOTS(mb_holding_regs, 1560),
+	__MB_SLOTS(mb_holding_regs, 1568),
+	__MB_SLOTS(mb_holding_regs, 1576),
+	__MB_SLOTS(mb_holding_regs, 1584),
+	__MB_SLOTS(mb_holding_regs, 1592),
+	__MB_SLOTS(mb_holding_regs, 1600),
+	__MB_SLOTS(mb_holding_regs, 1608),
+	__MB_SLOTS(mb_holding_regs, 1616),
+	__MB_SLOTS(mb_holding_regs, 1624),
+	__MB_SLOTS(mb_holding_regs, 1632),
+	__MB_SLOTS(mb_holding_regs, 1640),
+	__MB_SLOTS(mb_holding_regs, 1648),
+	__MB_SLOTS(mb_holding_regs, 1656),
+	__MB_SLOTS(mb_holding_regs, 1664),
+	__MB_SLOTS(mb_holding_regs, 1672),
+	__MB_SLOTS(mb_holding_regs, 1680),
+	__MB_SLOTS(mb_holding_regs, 1688),
+	__MB_SLOTS(mb_holding_regs, 1696),
+	__MB_SLOTS(mb_holding_regs, 1704),
+	__MB_SLOTS(mb_holding_regs, 1712),
+	__MB_SLOTS(mb_holding_regs, 1720),
+	__MB_SLOTS(mb_holding_regs, 1728),
+	__MB_SLOTS(mb_holding_regs, 1736),
+	__MB_SLOTS(mb_holding_regs, 1744),
+	__MB_SLOTS(mb_holding_regs, 1752),
+	__MB_SLOTS(mb_holding_regs, 1760),
+	__MB_SLOTS(mb_holding_regs, 1768),
+	__MB_SLOTS(mb_holding_regs, 1776),
+	__MB_SLOTS(mb_holding_regs, 1784),
+	__MB_SLOTS(mb_holding_regs, 1792),
+	__MB_SLOTS(mb_holding_regs, 1800),
+	__MB_SLOTS(mb_holding_regs, 1808),
+	__MB_SLOTS(mb_holding_regs, 1816),
+	__MB_SLOTS(mb_holding_regs, 1824),
+	__MB_SLOTS(mb_holding_regs, 1832),
+	__MB_SLOTS(mb_holding_regs, 1840),
+	__MB_SLOTS(mb_holding_regs, 1848),
+	__MB_SLOTS(mb_holding_regs, 1856),
+	__MB_SLOTS(mb_holding_regs, 1864),
+	__MB_SLOTS(mb_holding_regs, 1872),
+	__MB_SLOTS(mb_holding_regs, 1880),
+	__MB_SLOTS(mb_holding_regs, 1888),
+	__MB_SLOTS(mb_holding_regs, 1896),
+	__MB_SLOTS(mb_holding_regs, 1904),
+	__MB_SLOTS(mb_holding_regs, 1912),
+	__MB_SLOTS(mb_holding_regs, 1920),
+	__MB_SLOTS(mb_holding_regs, 1928),
+	__MB_SLOTS(mb_holding_regs, 1936),
+	__MB_SLOTS(mb_holding_regs, 1944),
+	__MB_SLOTS(mb_holding_regs, 1952),
+	__MB_SLOTS(mb_holding_regs, 1960),
+	__MB_SLOTS(mb_holding_regs, 1968),
+	__MB_SLOTS(mb_holding_regs, 1976),
+	__MB_SLOTS(mb_holding_regs, 1984),
+	__MB_SLOTS(mb_holding_regs, 1992),
+	__MB_SLOTS(mb_holding_regs, 2000),
+	__MB_SLOTS(mb_holding_regs, 2008),
+	__MB_SLOTS(mb_holding_regs, 2016),
+	__MB_SLOTS(mb_holding_regs, 2024),
+	__MB_SLOTS(mb_holding_regs, 2032),
+	__MB_SLOTS(mb_holding_regs, 2040),
+};
+extern IEC_DINT *const dint_memory[BUFFER_SIZE] = {};
+extern IEC_LINT *const lint_memory[BUFFER_SIZE] = {};
 
+//Special Functions
+extern IEC_LINT *const special_functions[BUFFER_SIZE] = {};
 
-#define __LOCATED_VAR(type, name, ...) type __##name;
-#include "LOCATED_VARIABLES.h"
-#undef __LOCATED_VAR
-#define __LOCATED_VAR(type, name, ...) type* name = &__##name;
-#include "LOCATED_VARIABLES.h"
-#undef __LOCATED_VAR
+//Located variables map. Describes the IEC type of every located address
+extern const struct located_address located_address_map[] = {
+	{0, 0, 0, 0, NULL},
+};
+extern const int located_address_count = 0;
 
 void glueVars()
 {
-}
-
-void updateTime()
-{
-	__CURRENT_TIME.tv_nsec += common_ticktime__;
-
-	if (__CURRENT_TIME.tv_nsec >= 1000000000)
-	{
-		__CURRENT_TIME.tv_nsec -= 1000000000;
-		__CURRENT_TIME.tv_sec += 1;
-	}
+	//The buffers are statically initialised above. Nothing to do at runtime
 }
\ No newline at end of file
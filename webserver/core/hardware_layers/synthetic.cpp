@@ -0,0 +1,411 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 OpenPLC Project
+// This file is part of the OpenPLC Software Stack.
+//
+// OpenPLC is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenPLC is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with OpenPLC.  If not, see <http://www.gnu.org/licenses/>.
+//------
+//
+// Synthetic hardware layer for scaling tests. It needs no board: the inputs
+// (up to %IX1023.7 and %IW1023) are driven with generated patterns, and the
+// outputs can be checked against them when the program copies every input to
+// the output with the same address (loopback). This is the fixture used to
+// measure image update, change detection and protocol publication with
+// thousands of changing points. The settings are read from synthetic_io.cfg
+// and the counters are logged every report_period seconds.
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "ladder.h"
+#include "custom_layer.h"
+
+#if !defined(ARRAY_SIZE)
+    #define ARRAY_SIZE(x) (sizeof((x)) / sizeof((x)[0]))
+#endif
+
+#define SYNTHETIC_CFG_FILE      "synthetic_io.cfg"
+#define MAX_SYNTHETIC_BOOLS     (BUFFER_SIZE * 8)
+#define MAX_SYNTHETIC_INTS      BUFFER_SIZE
+
+#define PATTERN_STATIC          0
+#define PATTERN_RANDOM_WALK     1
+#define PATTERN_SQUARE          2
+#define PATTERN_BURST           3
+
+struct synthetic_config
+{
+	int bool_points;
+	int int_points;
+	int pattern;
+	int changes_per_scan;   //random walk
+	int walk_step;          //random walk and burst, for %IW
+	int square_period;      //scans per half period
+	int burst_period;       //scans between bursts
+	int burst_size;         //points changed by a burst
+	unsigned int seed;
+	bool loopback_check;
+	int report_period;      //seconds, 0 disables the report
+};
+
+static struct synthetic_config synth_cfg;
+
+//values the layer wants on the inputs
+static IEC_BOOL bool_values[MAX_SYNTHETIC_BOOLS];
+static IEC_UINT int_values[MAX_SYNTHETIC_INTS];
+
+static unsigned int random_state;
+static unsigned long long synth_scans = 0;
+static unsigned long long points_changed = 0;
+static unsigned long long last_changed = 0;
+static unsigned long long max_changed = 0;
+static unsigned long long output_checks = 0;
+static unsigned long long output_mismatches = 0;
+static unsigned long long last_mismatches = 0;
+static time_t last_report;
+
+//-----------------------------------------------------------------------------
+// Helper function - Removes leading and trailing blanks from a string
+//-----------------------------------------------------------------------------
+static char *trimBlanks(char *str)
+{
+	while (isspace((unsigned char)*str)) str++;
+	char *end = str + strlen(str);
+	while (end > str && isspace((unsigned char)end[-1])) end--;
+	*end = '\0';
+	return str;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Reads synthetic_io.cfg. Missing keys keep their defaults:
+// the full address space with 100 random changes per scan
+//-----------------------------------------------------------------------------
+static void loadSyntheticConfig()
+{
+	unsigned char log_msg[1000];
+	char line[1024];
+
+	synth_cfg.bool_points = MAX_SYNTHETIC_BOOLS;
+	synth_cfg.int_points = MAX_SYNTHETIC_INTS;
+	synth_cfg.pattern = PATTERN_RANDOM_WALK;
+	synth_cfg.changes_per_scan = 100;
+	synth_cfg.walk_step = 100;
+	synth_cfg.square_period = 100;
+	synth_cfg.burst_period = 1000;
+	synth_cfg.burst_size = 1000;
+	synth_cfg.seed = 1;
+	synth_cfg.loopback_check = false;
+	synth_cfg.report_period = 10;
+
+	FILE *cfgfile = fopen(SYNTHETIC_CFG_FILE, "r");
+	if (cfgfile == NULL)
+	{
+		sprintf(log_msg, "Synthetic I/O: %s not found, using defaults\n", SYNTHETIC_CFG_FILE);
+		log(log_msg);
+		return;
+	}
+
+	int line_number = 0;
+	while (fgets(line, sizeof(line), cfgfile) != NULL)
+	{
+		line_number++;
+		char *start = trimBlanks(line);
+		if (start[0] == '#' || start[0] == '\0') continue;
+
+		char *separator = strchr(start, '=');
+		if (separator == NULL)
+		{
+			sprintf(log_msg, "Synthetic I/O: malformed line %d in %s\n", line_number, SYNTHETIC_CFG_FILE);
+			log(log_msg);
+			continue;
+		}
+		*separator = '\0';
+		char *key = trimBlanks(start);
+		char *value = trimBlanks(separator + 1);
+		int number = atoi(value);
+		bool valid = (number >= 0);
+
+		if (!strcmp(key, "bool_points"))
+		{
+			valid = (number >= 0 && number <= MAX_SYNTHETIC_BOOLS);
+			if (valid) synth_cfg.bool_points = number;
+		}
+		else if (!strcmp(key, "int_points"))
+		{
+			valid = (number >= 0 && number <= MAX_SYNTHETIC_INTS);
+			if (valid) synth_cfg.int_points = number;
+		}
+		else if (!strcmp(key, "pattern"))
+		{
+			valid = true;
+			if (!strcmp(value, "static")) synth_cfg.pattern = PATTERN_STATIC;
+			else if (!strcmp(value, "random_walk")) synth_cfg.pattern = PATTERN_RANDOM_WALK;
+			else if (!strcmp(value, "square")) synth_cfg.pattern = PATTERN_SQUARE;
+			else if (!strcmp(value, "burst")) synth_cfg.pattern = PATTERN_BURST;
+			else valid = false;
+		}
+		else if (!strcmp(key, "changes_per_scan"))
+		{
+			if (valid) synth_cfg.changes_per_scan = number;
+		}
+		else if (!strcmp(key, "walk_step"))
+		{
+			valid = (number > 0);
+			if (valid) synth_cfg.walk_step = number;
+		}
+		else if (!strcmp(key, "square_period"))
+		{
+			valid = (number > 0);
+			if (valid) synth_cfg.square_period = number;
+		}
+		else if (!strcmp(key, "burst_period"))
+		{
+			valid = (number > 0);
+			if (valid) synth_cfg.burst_period = number;
+		}
+		else if (!strcmp(key, "burst_size"))
+		{
+			if (valid) synth_cfg.burst_size = number;
+		}
+		else if (!strcmp(key, "seed"))
+		{
+			synth_cfg.seed = (unsigned int)strtoul(value, NULL, 0);
+			valid = true;
+		}
+		else if (!strcmp(key, "output_check"))
+		{
+			valid = true;
+			if (!strcmp(value, "none")) synth_cfg.loopback_check = false;
+			else if (!strcmp(value, "loopback")) synth_cfg.loopback_check = true;
+			else valid = false;
+		}
+		else if (!strcmp(key, "report_period"))
+		{
+			if (valid) synth_cfg.report_period = number;
+		}
+		else
+		{
+			sprintf(log_msg, "Synthetic I/O: unknown setting '%s' on line %d\n", key, line_number);
+			log(log_msg);
+			continue;
+		}
+
+		if (!valid)
+		{
+			sprintf(log_msg, "Synthetic I/O: invalid value '%s' for %s on line %d\n", value, key, line_number);
+			log(log_msg);
+		}
+	}
+
+	fclose(cfgfile);
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - xorshift generator. The sequence only depends on the
+// seed, so a run can be repeated exactly
+//-----------------------------------------------------------------------------
+static unsigned int nextRandom()
+{
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 17;
+	random_state ^= random_state << 5;
+	return random_state;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Changes one random point. %IX points toggle, %IW points
+// move by up to walk_step. Returns 1 if the value changed
+//-----------------------------------------------------------------------------
+static int changeRandomPoint()
+{
+	int total = synth_cfg.bool_points + synth_cfg.int_points;
+	if (total == 0) return 0;
+
+	int point = nextRandom() % total;
+	if (point < synth_cfg.bool_points)
+	{
+		bool_values[point] = !bool_values[point];
+		return 1;
+	}
+
+	point -= synth_cfg.bool_points;
+	int value = (int)int_values[point] + (int)(nextRandom() % (2 * synth_cfg.walk_step + 1)) - synth_cfg.walk_step;
+	if (value < 0) value = 0;
+	if (value > 65535) value = 65535;
+	if ((IEC_UINT)value == int_values[point]) return 0;
+
+	int_values[point] = (IEC_UINT)value;
+	return 1;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Sets every point to the same level. Returns the number of
+// points that changed
+//-----------------------------------------------------------------------------
+static int setAllPoints(bool level)
+{
+	int changed = 0;
+	IEC_UINT int_level = level ? 65535 : 0;
+
+	for (int i = 0; i < synth_cfg.bool_points; i++)
+	{
+		if (bool_values[i] != level) changed++;
+		bool_values[i] = level;
+	}
+	for (int i = 0; i < synth_cfg.int_points; i++)
+	{
+		if (int_values[i] != int_level) changed++;
+		int_values[i] = int_level;
+	}
+
+	return changed;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Advances the pattern by one scan. Returns the number of
+// points that changed
+//-----------------------------------------------------------------------------
+static int generatePattern()
+{
+	int changed = 0;
+
+	switch (synth_cfg.pattern)
+	{
+		case PATTERN_RANDOM_WALK:
+			for (int i = 0; i < synth_cfg.changes_per_scan; i++) changed += changeRandomPoint();
+			break;
+
+		case PATTERN_SQUARE:
+			if (synth_scans % synth_cfg.square_period == 0)
+				changed = setAllPoints((synth_scans / synth_cfg.square_period) % 2 == 1);
+			break;
+
+		case PATTERN_BURST:
+			if (synth_scans % synth_cfg.burst_period == 0)
+				for (int i = 0; i < synth_cfg.burst_size; i++) changed += changeRandomPoint();
+			break;
+	}
+
+	return changed;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Logs the counters and clears the per period values
+//-----------------------------------------------------------------------------
+static void reportSyntheticStats()
+{
+	unsigned char log_msg[1000];
+	sprintf(log_msg, "Synthetic I/O: %llu scans, %llu points changed (last scan %llu, max %llu), %llu of %llu checked scans with wrong outputs (last %llu points)\n",
+	        synth_scans, points_changed, last_changed, max_changed, output_mismatches, output_checks, last_mismatches);
+	log(log_msg);
+	max_changed = 0;
+}
+
+//-----------------------------------------------------------------------------
+// This function is called by the main OpenPLC routine when it is initializing.
+// Hardware initialization procedures should be here.
+//-----------------------------------------------------------------------------
+void initializeHardware()
+{
+	unsigned char log_msg[1000];
+	const char *pattern_names[] = {"static", "random_walk", "square", "burst"};
+
+	loadSyntheticConfig();
+	random_state = (synth_cfg.seed != 0) ? synth_cfg.seed : 1;
+	time(&last_report);
+
+	sprintf(log_msg, "Synthetic I/O: %d %%IX and %d %%IW points, pattern=%s, output check=%s\n", synth_cfg.bool_points,
+	        synth_cfg.int_points, pattern_names[synth_cfg.pattern], synth_cfg.loopback_check ? "loopback" : "none");
+	log(log_msg);
+}
+
+//-----------------------------------------------------------------------------
+// This function is called by the main OpenPLC routine when it is finalizing.
+// Resource clearing procedures should be here.
+//-----------------------------------------------------------------------------
+void finalizeHardware()
+{
+	reportSyntheticStats();
+}
+
+//-----------------------------------------------------------------------------
+// This function is called by the OpenPLC in a loop. Here the internal buffers
+// must be updated to reflect the actual Input state. The mutex bufferLock
+// must be used to protect access to the buffers on a threaded environment.
+//-----------------------------------------------------------------------------
+void updateBuffersIn()
+{
+	int changed = generatePattern();
+	synth_scans++;
+	points_changed += changed;
+	last_changed = changed;
+	if ((unsigned long long)changed > max_changed) max_changed = changed;
+
+	pthread_mutex_lock(&bufferLock); //lock mutex
+
+	for (int i = 0; i < synth_cfg.bool_points; i++)
+	{
+		if (pinNotPresent(ignored_bool_inputs, ARRAY_SIZE(ignored_bool_inputs), i))
+			if (bool_input[i/8][i%8] != NULL) *bool_input[i/8][i%8] = bool_values[i];
+	}
+
+	for (int i = 0; i < synth_cfg.int_points; i++)
+	{
+		if (pinNotPresent(ignored_int_inputs, ARRAY_SIZE(ignored_int_inputs), i))
+			if (int_input[i] != NULL) *int_input[i] = int_values[i];
+	}
+
+	pthread_mutex_unlock(&bufferLock); //unlock mutex
+
+	if (synth_cfg.report_period > 0 && time(NULL) - last_report >= synth_cfg.report_period)
+	{
+		reportSyntheticStats();
+		time(&last_report);
+	}
+}
+
+//-----------------------------------------------------------------------------
+// This function is called by the OpenPLC in a loop. Here the internal buffers
+// must be updated to reflect the actual Output state. The mutex bufferLock
+// must be used to protect access to the buffers on a threaded environment.
+// With the loopback check every output must hold the value of the input with
+// the same address, as set at the start of this scan
+//-----------------------------------------------------------------------------
+void updateBuffersOut()
+{
+	if (!synth_cfg.loopback_check) return;
+
+	unsigned long long mismatches = 0;
+	pthread_mutex_lock(&bufferLock); //lock mutex
+
+	for (int i = 0; i < synth_cfg.bool_points; i++)
+	{
+		if (bool_output[i/8][i%8] != NULL && *bool_output[i/8][i%8] != bool_values[i]) mismatches++;
+	}
+
+	for (int i = 0; i < synth_cfg.int_points; i++)
+	{
+		if (int_output[i] != NULL && *int_output[i] != int_values[i]) mismatches++;
+	}
+
+	pthread_mutex_unlock(&bufferLock); //unlock mutex
+
+	output_checks++;
+	last_mismatches = mismatches;
+	if (mismatches > 0) output_mismatches++;
+}
@@ -22,6 +22,25 @@
 // with the Python webserver GUI only.
 //
 // Thiago Alves, Jun 2018
+//
+// All clients are served by a single event loop. Two protocols are accepted
+// on the same port, told apart by the first byte a client sends:
+//
+// - Text: one command per line, e.g. "start_modbus(502)\n". Replies come
+//   back in order, as plain text.
+// - Binary: length prefixed frames, so a client can keep one connection
+//   open, pipeline requests and have several of them in flight. Every frame
+//   starts with a 12 byte header, in network byte order:
+//       magic (1 byte, 0xA5), opcode (1), status (2), request id (4),
+//       payload length (4)
+//   BINARY_OP_COMMAND carries one text command as payload. BINARY_OP_BATCH
+//   carries a list of commands, each one a 2 byte length followed by the
+//   command, and is answered with a single frame holding, for every
+//   command, a 2 byte status, a 4 byte length and the reply. The reply
+//   frame has the opcode and request id of the request. Commands that
+//   start or stop services run on a separate thread in the order they
+//   arrived, so their replies can come after the replies of requests sent
+//   later.
 //-----------------------------------------------------------------------------
 
 #include <stdio.h>
@@ -33,10 +52,34 @@
 #include <pthread.h>
 #include <arpa/inet.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <time.h>
 
 #include "ladder.h"
 
+#define BINARY_MAGIC                0xA5
+#define BINARY_HEADER_SIZE          12
+#define BINARY_MAX_PAYLOAD          65536
+#define BINARY_OP_COMMAND           0x01
+#define BINARY_OP_BATCH             0x02
+
+#define REPLY_OK                    0
+#define REPLY_ERROR                 1
+#define REPLY_BUSY                  2
+#define REPLY_BAD_FRAME             3
+
+#define PROTOCOL_UNKNOWN            0
+#define PROTOCOL_TEXT               1
+#define PROTOCOL_BINARY             2
+
+#define MAX_INTERACTIVE_CLIENTS     16
+#define MAX_QUEUED_COMMANDS         32
+#define MAX_OUTPUT_BACKLOG          (4*1024*1024)
+#define MAX_REPLY_SIZE              (2*1024*1024)
+#define MAX_CLIENT_OUTPUT           (MAX_OUTPUT_BACKLOG + MAX_REPLY_SIZE + BINARY_HEADER_SIZE)
+#define IDLE_OUTPUT_CAPACITY        (64*1024)
+#define TEXT_COMMAND_SIZE           1024
+
 //Global Variables
 bool run_modbus = 0;
 uint16_t modbus_port = 502;
@@ -46,9 +89,6 @@ bool run_enip = 0;
 uint16_t enip_port = 44818;
 bool run_pstorage = 0;
 uint16_t pstorage_polling = 10;
-unsigned char server_command[1024];
-int command_index = 0;
-bool processing_command = 0;
 time_t start_time;
 time_t end_time;
 
@@ -58,11 +98,61 @@ pthread_t dnp3_thread;
 pthread_t enip_thread;
 pthread_t pstorage_thread;
 
+//Growable buffer for replies and for the data waiting to be sent to a client.
+//It never grows past limit; data that does not fit sets overflow instead
+struct reply_buffer
+{
+    unsigned char *data;
+    int size;
+    int capacity;
+    int limit;
+    bool overflow;
+};
+
+struct interactive_client
+{
+    int fd;                                 //-1 when the slot is free
+    unsigned int generation;                //changes every time the slot is reused
+    int protocol;
+    unsigned char input[BINARY_HEADER_SIZE + BINARY_MAX_PAYLOAD];
+    int input_size;
+    struct reply_buffer output;
+    int output_sent;
+    bool waiting;                           //text client waiting for a queued command
+};
+
+static struct interactive_client clients[MAX_INTERACTIVE_CLIENTS];
+
+//Commands that start or stop services can block for a while, so they are
+//queued to the command thread instead of running on the event loop
+struct queued_command
+{
+    int client;
+    unsigned int generation;
+    unsigned int request_id;
+    char command[TEXT_COMMAND_SIZE];
+    int status;
+    struct reply_buffer reply;
+};
+
+static struct queued_command pending_commands[MAX_QUEUED_COMMANDS];
+static struct queued_command finished_commands[MAX_QUEUED_COMMANDS];
+static int pending_head = 0, pending_count = 0;
+static int finished_head = 0, finished_count = 0;
+static int commands_in_flight = 0;
+static bool command_thread_running = false;
+static pthread_mutex_t command_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t command_ready = PTHREAD_COND_INITIALIZER;
+
+//written by the command thread to wake up the event loop
+static int wake_pipe[2] = {-1, -1};
+
 //-----------------------------------------------------------------------------
 // Start the Modbus Thread
 //-----------------------------------------------------------------------------
 void *modbusThread(void *arg)
 {
+    applyThreadProfile(THREAD_PROTOCOL);
     startServer(modbus_port, MODBUS_PROTOCOL);
 }
 
@@ -71,6 +161,7 @@ void *modbusThread(void *arg)
 //-----------------------------------------------------------------------------
 void *dnp3Thread(void *arg)
 {
+    applyThreadProfile(THREAD_PROTOCOL);
     dnp3StartServer(dnp3_port);
 }
 
@@ -79,6 +170,7 @@ void *dnp3Thread(void *arg)
 //-----------------------------------------------------------------------------
 void *enipThread(void *arg)
 {
+    applyThreadProfile(THREAD_PROTOCOL);
     startServer(enip_port, ENIP_PROTOCOL);
 }
 
@@ -87,6 +179,7 @@ void *enipThread(void *arg)
 //-----------------------------------------------------------------------------
 void *pstorageThread(void *arg)
 {
+    applyThreadProfile(THREAD_PSTORAGE);
     startPstorage();
 }
 
@@ -160,339 +253,913 @@ int createSocket_interactive(int port)
 }
 
 //-----------------------------------------------------------------------------
-// Blocking call. Wait here for the client to connect. Returns the file
-// descriptor to communicate with the client.
+// Helper functions - Append data to a reply buffer, growing it as needed up
+// to its limit. Data that does not fit, or that there is no memory for, is
+// dropped and flags the overflow
 //-----------------------------------------------------------------------------
-int waitForClient_interactive(int socket_fd)
+static void replyInit(struct reply_buffer *reply, int limit)
 {
-    int client_fd;
-    struct sockaddr_in client_addr;
-    socklen_t client_len;
+    reply->data = NULL;
+    reply->size = 0;
+    reply->capacity = 0;
+    reply->limit = limit;
+    reply->overflow = false;
+}
 
-    printf("Interactive Server: waiting for new client...\n");
+static int replySpace(struct reply_buffer *reply)
+{
+    return reply->limit - reply->size;
+}
 
-    client_len = sizeof(client_addr);
-    while (run_openplc)
+static void replyAppend(struct reply_buffer *reply, const void *data, int size)
+{
+    if (size > replySpace(reply))
     {
-        client_fd = accept(socket_fd, (struct sockaddr *)&client_addr, &client_len); //non-blocking call
-        if (client_fd > 0)
+        reply->overflow = true;
+        return;
+    }
+
+    if (reply->size + size > reply->capacity)
+    {
+        int capacity = (reply->capacity > 0) ? reply->capacity : 1024;
+        while (capacity < reply->size + size) capacity *= 2;
+        if (capacity > reply->limit) capacity = reply->limit;
+        unsigned char *data = (unsigned char *)realloc(reply->data, capacity);
+        if (data == NULL)
         {
-            SetSocketBlockingEnabled(client_fd, true);
-            break;
+            //the old buffer is still valid and keeps what was appended so far
+            reply->overflow = true;
+            return;
         }
-        sleepms(100);
+        reply->data = data;
+        reply->capacity = capacity;
     }
+    memcpy(reply->data + reply->size, data, size);
+    reply->size += size;
+}
 
-    return client_fd;
+static void replyText(struct reply_buffer *reply, const char *text)
+{
+    replyAppend(reply, text, strlen(text));
 }
 
-//-----------------------------------------------------------------------------
-// Blocking call. Holds here until something is received from the client.
-// Once the message is received, it is stored on the buffer and the function
-// returns the number of bytes received.
-//-----------------------------------------------------------------------------
-int listenToClient_interactive(int client_fd, unsigned char *buffer)
+static void replyFree(struct reply_buffer *reply)
 {
-    bzero(buffer, 1024);
-    int n = read(client_fd, buffer, 1024);
-    return n;
+    free(reply->data);
+    replyInit(reply, reply->limit);
+}
+
+static void putUint16(unsigned char *buffer, uint16_t value)
+{
+    value = htons(value);
+    memcpy(buffer, &value, 2);
+}
+
+static void putUint32(unsigned char *buffer, uint32_t value)
+{
+    value = htonl(value);
+    memcpy(buffer, &value, 4);
+}
+
+static uint16_t getUint16(const unsigned char *buffer)
+{
+    uint16_t value;
+    memcpy(&value, buffer, 2);
+    return ntohs(value);
+}
+
+static uint32_t getUint32(const unsigned char *buffer)
+{
+    uint32_t value;
+    memcpy(&value, buffer, 4);
+    return ntohl(value);
 }
 
 //-----------------------------------------------------------------------------
-// Process client's commands for the interactive server
+// Helper functions - Stop one of the protocol servers if it is running
 //-----------------------------------------------------------------------------
-void processCommand(unsigned char *buffer, int client_fd)
+static void stopModbus()
 {
     unsigned char log_msg[1000];
-    int count_char = 0;
-    
-    if (processing_command)
+    if (run_modbus)
     {
-        count_char = sprintf(buffer, "Processing command...\n");
-        write(client_fd, buffer, count_char);
-        return;
+        run_modbus = 0;
+        pthread_join(modbus_thread, NULL);
+        sprintf(log_msg, "Modbus server was stopped\n");
+        log(log_msg);
     }
-    
-    if (strncmp(buffer, "quit()", 6) == 0)
+}
+
+static void stopDnp3()
+{
+    unsigned char log_msg[1000];
+    if (run_dnp3)
     {
-        processing_command = true;
-        sprintf(log_msg, "Issued quit() command\n");
+        run_dnp3 = 0;
+        pthread_join(dnp3_thread, NULL);
+        sprintf(log_msg, "DNP3 server was stopped\n");
         log(log_msg);
-        if (run_modbus)
-        {
-            run_modbus = 0;
-            pthread_join(modbus_thread, NULL);
-            sprintf(log_msg, "Modbus server was stopped\n");
-            log(log_msg);
-        }
-        if (run_dnp3)
-        {
-            run_dnp3 = 0;
-            pthread_join(dnp3_thread, NULL);
-            sprintf(log_msg, "DNP3 server was stopped\n");
-            log(log_msg);
-        }
-        run_openplc = 0;
-        processing_command = false;
     }
-    else if (strncmp(buffer, "start_modbus(", 13) == 0)
+}
+
+static void stopEnip()
+{
+    unsigned char log_msg[1000];
+    if (run_enip)
     {
-        processing_command = true;
-        modbus_port = readCommandArgument(buffer);
-        sprintf(log_msg, "Issued start_modbus() command to start on port: %d\n", modbus_port);
+        run_enip = 0;
+        pthread_join(enip_thread, NULL);
+        sprintf(log_msg, "EtherNet/IP server was stopped\n");
         log(log_msg);
-        if (run_modbus)
-        {
-            sprintf(log_msg, "Modbus server already active. Restarting on port: %d\n", modbus_port);
-            log(log_msg);
-            //Stop Modbus server
-            run_modbus = 0;
-            pthread_join(modbus_thread, NULL);
-            sprintf(log_msg, "Modbus server was stopped\n");
-            log(log_msg);
-        }
-        //Start Modbus server
-        run_modbus = 1;
-        pthread_create(&modbus_thread, NULL, modbusThread, NULL);
-        processing_command = false;
     }
-    else if (strncmp(buffer, "stop_modbus()", 13) == 0)
+}
+
+//-----------------------------------------------------------------------------
+// Command handlers. Each one gets the full command text and fills in the
+// reply. Handlers that leave the reply empty answer "OK"
+//-----------------------------------------------------------------------------
+static int commandQuit(unsigned char *command, struct reply_buffer *reply)
+{
+    unsigned char log_msg[1000];
+    sprintf(log_msg, "Issued quit() command\n");
+    log(log_msg);
+    stopModbus();
+    stopDnp3();
+    run_openplc = 0;
+    return REPLY_OK;
+}
+
+static int commandStartModbus(unsigned char *command, struct reply_buffer *reply)
+{
+    unsigned char log_msg[1000];
+    modbus_port = readCommandArgument(command);
+    sprintf(log_msg, "Issued start_modbus() command to start on port: %d\n", modbus_port);
+    log(log_msg);
+    if (run_modbus)
     {
-        processing_command = true;
-        sprintf(log_msg, "Issued stop_modbus() command\n");
+        sprintf(log_msg, "Modbus server already active. Restarting on port: %d\n", modbus_port);
         log(log_msg);
-        if (run_modbus)
-        {
-            run_modbus = 0;
-            pthread_join(modbus_thread, NULL);
-            sprintf(log_msg, "Modbus server was stopped\n");
-            log(log_msg);
-        }
-        processing_command = false;
+        stopModbus();
     }
-    else if (strncmp(buffer, "start_dnp3(", 11) == 0)
+    run_modbus = 1;
+    createRuntimeThread(&modbus_thread, modbusThread, NULL, THREAD_PROTOCOL);
+    return REPLY_OK;
+}
+
+static int commandStopModbus(unsigned char *command, struct reply_buffer *reply)
+{
+    unsigned char log_msg[1000];
+    sprintf(log_msg, "Issued stop_modbus() command\n");
+    log(log_msg);
+    stopModbus();
+    return REPLY_OK;
+}
+
+static int commandStartDnp3(unsigned char *command, struct reply_buffer *reply)
+{
+    unsigned char log_msg[1000];
+    dnp3_port = readCommandArgument(command);
+    sprintf(log_msg, "Issued start_dnp3() command to start on port: %d\n", dnp3_port);
+    log(log_msg);
+    if (run_dnp3)
     {
-        processing_command = true;
-        dnp3_port = readCommandArgument(buffer);
-        sprintf(log_msg, "Issued start_dnp3() command to start on port: %d\n", dnp3_port);
+        sprintf(log_msg, "DNP3 server already active. Restarting on port: %d\n", dnp3_port);
         log(log_msg);
-        if (run_dnp3)
-        {
-            sprintf(log_msg, "DNP3 server already active. Restarting on port: %d\n", dnp3_port);
-            log(log_msg);
-            //Stop DNP3 server
-            run_dnp3 = 0;
-            pthread_join(dnp3_thread, NULL);
-            sprintf(log_msg, "DNP3 server was stopped\n");
-            log(log_msg);
-        }
-        //Start DNP3 server
-        run_dnp3 = 1;
-        pthread_create(&dnp3_thread, NULL, dnp3Thread, NULL);
-        processing_command = false;
+        stopDnp3();
     }
-    else if (strncmp(buffer, "stop_dnp3()", 11) == 0)
+    run_dnp3 = 1;
+    createRuntimeThread(&dnp3_thread, dnp3Thread, NULL, THREAD_PROTOCOL);
+    return REPLY_OK;
+}
+
+static int commandStopDnp3(unsigned char *command, struct reply_buffer *reply)
+{
+    unsigned char log_msg[1000];
+    sprintf(log_msg, "Issued stop_dnp3() command\n");
+    log(log_msg);
+    stopDnp3();
+    return REPLY_OK;
+}
+
+static int commandStartEnip(unsigned char *command, struct reply_buffer *reply)
+{
+    unsigned char log_msg[1000];
+    enip_port = readCommandArgument(command);
+    sprintf(log_msg, "Issued start_enip() command to start on port: %d\n", enip_port);
+    log(log_msg);
+    if (run_enip)
     {
-        processing_command = true;
-        sprintf(log_msg, "Issued stop_dnp3() command\n");
+        sprintf(log_msg, "EtherNet/IP server already active. Restarting on port: %d\n", enip_port);
         log(log_msg);
-        if (run_dnp3)
-        {
-            run_dnp3 = 0;
-            pthread_join(dnp3_thread, NULL);
-            sprintf(log_msg, "DNP3 server was stopped\n");
-            log(log_msg);
-        }
-        processing_command = false;
+        stopEnip();
     }
-    else if (strncmp(buffer, "start_enip(", 11) == 0)
+    run_enip = 1;
+    createRuntimeThread(&enip_thread, enipThread, NULL, THREAD_PROTOCOL);
+    return REPLY_OK;
+}
+
+static int commandStopEnip(unsigned char *command, struct reply_buffer *reply)
+{
+    unsigned char log_msg[1000];
+    sprintf(log_msg, "Issued stop_enip() command\n");
+    log(log_msg);
+    stopEnip();
+    return REPLY_OK;
+}
+
+static int commandStartPstorage(unsigned char *command, struct reply_buffer *reply)
+{
+    unsigned char log_msg[1000];
+    pstorage_polling = readCommandArgument(command);
+    sprintf(log_msg, "Issued start_pstorage() command with polling rate of %d seconds\n", pstorage_polling);
+    log(log_msg);
+    if (run_pstorage)
     {
-        processing_command = true;
-        enip_port = readCommandArgument(buffer);
-        sprintf(log_msg, "Issued start_enip() command to start on port: %d\n", enip_port);
+        sprintf(log_msg, "Persistent Storage server already active. Changing polling rate to: %d\n", pstorage_polling);
         log(log_msg);
-        if (run_enip)
-        {
-            sprintf(log_msg, "EtherNet/IP server already active. Restarting on port: %d\n", enip_port);
-            log(log_msg);
-            //Stop Enip server
-            run_enip = 0;
-            pthread_join(enip_thread, NULL);
-            sprintf(log_msg, "EtherNet/IP server was stopped\n");
-            log(log_msg);
-        }
-        //Start Enip server
-        run_enip = 1;
-        pthread_create(&enip_thread, NULL, enipThread, NULL);
-        processing_command = false;
+        return REPLY_OK;
     }
-    else if (strncmp(buffer, "stop_enip()", 11) == 0)
+    run_pstorage = 1;
+    createRuntimeThread(&pstorage_thread, pstorageThread, NULL, THREAD_PSTORAGE);
+    return REPLY_OK;
+}
+
+static int commandStopPstorage(unsigned char *command, struct reply_buffer *reply)
+{
+    unsigned char log_msg[1000];
+    sprintf(log_msg, "Issued stop_pstorage() command\n");
+    log(log_msg);
+    if (run_pstorage)
     {
-        processing_command = true;
-        sprintf(log_msg, "Issued stop_enip() command\n");
+        run_pstorage = 0;
+        sprintf(log_msg, "Persistent Storage thread was stopped\n");
         log(log_msg);
-        if (run_enip)
-        {
-            run_enip = 0;
-            pthread_join(enip_thread, NULL);
-            sprintf(log_msg, "EtherNet/IP server was stopped\n");
-            log(log_msg);
-        }
-        processing_command = false;
     }
-    else if (strncmp(buffer, "start_pstorage(", 15) == 0)
+    return REPLY_OK;
+}
+
+static int commandPstorageStats(unsigned char *command, struct reply_buffer *reply)
+{
+    char stats_buffer[256];
+    int count_char = pstorageStats(stats_buffer, sizeof(stats_buffer));
+    replyAppend(reply, stats_buffer, count_char);
+    return REPLY_OK;
+}
+
+//The log is copied under logLock, as resizeLogBuffer() can replace the buffer.
+//A log larger than the reply limit is sent from its newest part
+static int commandRuntimeLogs(unsigned char *command, struct reply_buffer *reply)
+{
+    printf("Issued runtime_logs() command\n");
+    pthread_mutex_lock(&logLock);
+    int size = log_index;
+    if (size > replySpace(reply)) size = replySpace(reply);
+    if (log_buffer != NULL) replyAppend(reply, log_buffer + log_index - size, size);
+    pthread_mutex_unlock(&logLock);
+    return REPLY_OK;
+}
+
+//Only the last N bytes of the log, so pollers do not fetch it whole every time
+static int commandRuntimeLogsTail(unsigned char *command, struct reply_buffer *reply)
+{
+    int size = readCommandArgument(command);
+    pthread_mutex_lock(&logLock);
+    int end = log_index;
+    if (size <= 0 || size > end) size = end;
+    if (size > replySpace(reply)) size = replySpace(reply);
+    if (log_buffer != NULL) replyAppend(reply, log_buffer + end - size, size);
+    pthread_mutex_unlock(&logLock);
+    return REPLY_OK;
+}
+
+static int commandScanStats(unsigned char *command, struct reply_buffer *reply)
+{
+    char stats_buffer[4096];
+    int count_char = scanStatsReport(stats_buffer, sizeof(stats_buffer));
+    replyAppend(reply, stats_buffer, count_char);
+    return REPLY_OK;
+}
+
+static int commandResetScanStats(unsigned char *command, struct reply_buffer *reply)
+{
+    resetScanStats();
+    return REPLY_OK;
+}
+
+static int commandResetWatchdog(unsigned char *command, struct reply_buffer *reply)
+{
+    resetWatchdog();
+    return REPLY_OK;
+}
+
+static int commandPouProfile(unsigned char *command, struct reply_buffer *reply)
+{
+    static char profile_buffer[65536];
+    int count_char = pouProfileReport(profile_buffer, sizeof(profile_buffer));
+    replyAppend(reply, profile_buffer, count_char);
+    return REPLY_OK;
+}
+
+static int commandResetPouProfile(unsigned char *command, struct reply_buffer *reply)
+{
+    resetPouProfile();
+    return REPLY_OK;
+}
+
+static int commandPouProfileRate(unsigned char *command, struct reply_buffer *reply)
+{
+    unsigned char log_msg[1000];
+    pou_profile_rate = readCommandArgument(command);
+    if (pou_profile_rate < 0) pou_profile_rate = 0;
+    sprintf(log_msg, "Issued pou_profile_rate() command. Timing one scan out of %d (0 = disabled)\n", pou_profile_rate);
+    log(log_msg);
+    return REPLY_OK;
+}
+
+static int commandFlightRecorderDump(unsigned char *command, struct reply_buffer *reply)
+{
+    char dump_buffer[300];
+    int count_char = flightRecorderDump(dump_buffer, sizeof(dump_buffer));
+    if (count_char < 0)
     {
-        processing_command = true;
-        pstorage_polling = readCommandArgument(buffer);
-        sprintf(log_msg, "Issued start_pstorage() command with polling rate of %d seconds\n", pstorage_polling);
-        log(log_msg);
-        if (run_pstorage)
-        {
-            sprintf(log_msg, "Persistent Storage server already active. Changing polling rate to: %d\n", pstorage_polling);
-            log(log_msg);
-        }
-        //Start Enip server
-        run_pstorage = 1;
-        pthread_create(&pstorage_thread, NULL, pstorageThread, NULL);
-        processing_command = false;
+        replyText(reply, "Flight recorder is disabled or empty\n");
+        return REPLY_ERROR;
     }
-    else if (strncmp(buffer, "stop_pstorage()", 15) == 0)
+    replyAppend(reply, dump_buffer, count_char);
+    return REPLY_OK;
+}
+
+static int commandMemoryReport(unsigned char *command, struct reply_buffer *reply)
+{
+    char report_buffer[4096];
+    int count_char = memoryReport(report_buffer, sizeof(report_buffer));
+    replyAppend(reply, report_buffer, count_char);
+    return REPLY_OK;
+}
+
+static int commandExecTime(unsigned char *command, struct reply_buffer *reply)
+{
+    char time_buffer[32];
+    time(&end_time);
+    int count_char = sprintf(time_buffer, "%llu\n", (unsigned long long)difftime(end_time, start_time));
+    replyAppend(reply, time_buffer, count_char);
+    return REPLY_OK;
+}
+
+struct interactive_command
+{
+    const char *name;                       //matched against the start of the command
+    int (*handler)(unsigned char *command, struct reply_buffer *reply);
+    bool queued;                            //runs on the command thread
+};
+
+static const struct interactive_command command_table[] =
+{
+    {"quit()",              commandQuit,            true},
+    {"start_modbus(",       commandStartModbus,     true},
+    {"stop_modbus()",       commandStopModbus,      true},
+    {"start_dnp3(",         commandStartDnp3,       true},
+    {"stop_dnp3()",         commandStopDnp3,        true},
+    {"start_enip(",         commandStartEnip,       true},
+    {"stop_enip()",         commandStopEnip,        true},
+    {"start_pstorage(",     commandStartPstorage,   true},
+    {"stop_pstorage()",     commandStopPstorage,    true},
+    {"pstorage_stats()",    commandPstorageStats,   false},
+    {"runtime_logs()",      commandRuntimeLogs,     false},
+    {"runtime_logs_tail(",  commandRuntimeLogsTail, false},
+    {"scan_stats()",        commandScanStats,       false},
+    {"reset_scan_stats()",  commandResetScanStats,  false},
+    {"reset_watchdog()",    commandResetWatchdog,   false},
+    {"pou_profile()",       commandPouProfile,      false},
+    {"reset_pou_profile()", commandResetPouProfile, false},
+    {"pou_profile_rate(",   commandPouProfileRate,  false},
+    {"flight_recorder_dump()", commandFlightRecorderDump, false},
+    {"memory_report()",     commandMemoryReport,    false},
+    {"exec_time()",         commandExecTime,        false},
+};
+
+//-----------------------------------------------------------------------------
+// Helper function - Finds the entry of the command table for a command.
+// Returns NULL for unrecognized commands
+//-----------------------------------------------------------------------------
+static const struct interactive_command *findCommand(const char *command)
+{
+    for (unsigned int i = 0; i < sizeof(command_table) / sizeof(command_table[0]); i++)
     {
-        processing_command = true;
-        sprintf(log_msg, "Issued stop_pstorage() command\n");
-        log(log_msg);
-        if (run_pstorage)
+        if (strncmp(command, command_table[i].name, strlen(command_table[i].name)) == 0)
+            return &command_table[i];
+    }
+    return NULL;
+}
+
+//-----------------------------------------------------------------------------
+// Runs a command and appends its reply. Returns the status of the reply
+//-----------------------------------------------------------------------------
+static int runCommand(const struct interactive_command *entry, unsigned char *command, struct reply_buffer *reply)
+{
+    if (entry == NULL)
+    {
+        replyText(reply, "Error: unrecognized command\n");
+        return REPLY_ERROR;
+    }
+
+    int reply_start = reply->size;
+    int status = entry->handler(command, reply);
+    if (reply->overflow)
+    {
+        reply->size = reply_start;
+        reply->overflow = false;
+        replyText(reply, "Error: reply too large\n");
+        return REPLY_ERROR;
+    }
+    if (status == REPLY_OK && reply->size == reply_start) replyText(reply, "OK\n");
+    return status;
+}
+
+//-----------------------------------------------------------------------------
+// Command thread. Runs the queued commands one at a time, in the order they
+// arrived, and hands the replies back to the event loop
+//-----------------------------------------------------------------------------
+static void *commandThread(void *arg)
+{
+    while (true)
+    {
+        pthread_mutex_lock(&command_lock);
+        while (pending_count == 0)
         {
-            run_pstorage = 0;
-            sprintf(log_msg, "Persistent Storage thread was stopped\n");
-            log(log_msg);
+            pthread_cond_wait(&command_ready, &command_lock);
         }
-        processing_command = false;
+        struct queued_command job = pending_commands[pending_head];
+        pending_head = (pending_head + 1) % MAX_QUEUED_COMMANDS;
+        pending_count--;
+        pthread_mutex_unlock(&command_lock);
+
+        replyInit(&job.reply, MAX_REPLY_SIZE);
+        job.status = runCommand(findCommand(job.command), (unsigned char *)job.command, &job.reply);
+
+        pthread_mutex_lock(&command_lock);
+        finished_commands[(finished_head + finished_count) % MAX_QUEUED_COMMANDS] = job;
+        finished_count++;
+        pthread_mutex_unlock(&command_lock);
+
+        char wake = 1;
+        write(wake_pipe[1], &wake, 1);
     }
-    else if (strncmp(buffer, "runtime_logs()", 14) == 0)
+
+    return NULL;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Queues a command for the command thread. Returns false
+// if too many commands are waiting already. Called by the event loop only
+//-----------------------------------------------------------------------------
+static bool queueCommand(int client, unsigned int request_id, const char *command)
+{
+    if (commands_in_flight >= MAX_QUEUED_COMMANDS) return false;
+
+    if (!command_thread_running)
     {
-        processing_command = true;
-        printf("Issued runtime_logs() command\n");
-        write(client_fd, log_buffer, log_index);
-        processing_command = false;
-        return;
+        pthread_t thread;
+        if (createRuntimeThread(&thread, commandThread, NULL, THREAD_INTERACTIVE)) return false;
+        pthread_detach(thread);
+        command_thread_running = true;
+    }
+
+    pthread_mutex_lock(&command_lock);
+    struct queued_command *job = &pending_commands[(pending_head + pending_count) % MAX_QUEUED_COMMANDS];
+    job->client = client;
+    job->generation = clients[client].generation;
+    job->request_id = request_id;
+    strncpy(job->command, command, TEXT_COMMAND_SIZE - 1);
+    job->command[TEXT_COMMAND_SIZE - 1] = '\0';
+    pending_count++;
+    commands_in_flight++;
+    pthread_cond_signal(&command_ready);
+    pthread_mutex_unlock(&command_lock);
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Appends a binary frame to the output of a client
+//-----------------------------------------------------------------------------
+static void sendFrame(struct interactive_client *client, int opcode, int status, uint32_t request_id, const unsigned char *payload, int size)
+{
+    unsigned char header[BINARY_HEADER_SIZE];
+    header[0] = BINARY_MAGIC;
+    header[1] = opcode;
+    putUint16(&header[2], status);
+    putUint32(&header[4], request_id);
+    putUint32(&header[8], size);
+    replyAppend(&client->output, header, BINARY_HEADER_SIZE);
+    if (size > 0) replyAppend(&client->output, payload, size);
+}
+
+//-----------------------------------------------------------------------------
+// Returns the memory taken by the client slots, the command queues and the
+// replies waiting to be sent, for the memory report. Called by the event
+// loop only (memory_report() is not queued)
+//-----------------------------------------------------------------------------
+unsigned long long interactiveServerMemory()
+{
+    unsigned long long size = sizeof(clients) + sizeof(pending_commands) + sizeof(finished_commands);
+    for (int i = 0; i < MAX_INTERACTIVE_CLIENTS; i++)
+    {
+        size += clients[i].output.capacity;
     }
-    else if (strncmp(buffer, "exec_time()", 11) == 0)
+    return size;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Closes the connection of a client and frees its slot.
+// Replies of queued commands for it are dropped
+//-----------------------------------------------------------------------------
+static void closeClient(struct interactive_client *client)
+{
+    printf("Interactive Server: client ID: %d has closed the connection\n", client->fd);
+    closeSocket(client->fd);
+    client->fd = -1;
+    client->generation++;
+    client->protocol = PROTOCOL_UNKNOWN;
+    client->input_size = 0;
+    client->output_sent = 0;
+    client->waiting = false;
+    replyFree(&client->output);
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Handles one line of a text client. Returns the number of
+// bytes used, or 0 if the line is not complete yet
+//-----------------------------------------------------------------------------
+static int processTextInput(int index)
+{
+    struct interactive_client *client = &clients[index];
+    char command[TEXT_COMMAND_SIZE];
+    int length = 0;
+
+    while (length < client->input_size && client->input[length] != '\r' && client->input[length] != '\n') length++;
+    if (length == client->input_size && length < TEXT_COMMAND_SIZE - 1) return 0;
+
+    int used = (length < client->input_size) ? length + 1 : length;
+    if (length == 0) return used;
+    if (length > TEXT_COMMAND_SIZE - 1) length = TEXT_COMMAND_SIZE - 1;
+    memcpy(command, client->input, length);
+    command[length] = '\0';
+
+    const struct interactive_command *entry = findCommand(command);
+    if (entry != NULL && entry->queued)
     {
-        processing_command = true;
-        time(&end_time);
-        count_char = sprintf(buffer, "%llu\n", (unsigned long long)difftime(end_time, start_time));
-        write(client_fd, buffer, count_char);
-        processing_command = false;
-        return;
+        //the next commands of this client wait for the reply, so they are
+        //still answered in order
+        if (queueCommand(index, 0, command)) client->waiting = true;
+        else replyText(&client->output, "Processing command...\n");
     }
     else
     {
-        processing_command = true;
-        count_char = sprintf(buffer, "Error: unrecognized command\n");
-        write(client_fd, buffer, count_char);
-        processing_command = false;
-        return;
+        runCommand(entry, (unsigned char *)command, &client->output);
     }
-    
-    count_char = sprintf(buffer, "OK\n");
-    write(client_fd, buffer, count_char);
+
+    return used;
 }
 
 //-----------------------------------------------------------------------------
-// Process client's request
+// Helper function - Handles one frame of a binary client. Returns the number
+// of bytes used, 0 if the frame is not complete yet or -1 if the connection
+// has to be closed
 //-----------------------------------------------------------------------------
-void processMessage_interactive(unsigned char *buffer, int bufferSize, int client_fd)
+static int processBinaryInput(int index)
 {
-    for (int i = 0; i < bufferSize; i++)
+    struct interactive_client *client = &clients[index];
+    char command[TEXT_COMMAND_SIZE];
+
+    if (client->input_size < BINARY_HEADER_SIZE) return 0;
+
+    int opcode = client->input[1];
+    uint32_t request_id = getUint32(&client->input[4]);
+    uint32_t length = getUint32(&client->input[8]);
+    if (client->input[0] != BINARY_MAGIC || length > BINARY_MAX_PAYLOAD)
     {
-        if (buffer[i] == '\r' || buffer[i] == '\n' || command_index >= 1024)
+        //the stream cannot be trusted anymore
+        sendFrame(client, opcode, REPLY_BAD_FRAME, request_id, NULL, 0);
+        return -1;
+    }
+    if (client->input_size < BINARY_HEADER_SIZE + (int)length) return 0;
+
+    unsigned char *payload = &client->input[BINARY_HEADER_SIZE];
+    if (opcode == BINARY_OP_COMMAND)
+    {
+        int size = (length < TEXT_COMMAND_SIZE) ? length : TEXT_COMMAND_SIZE - 1;
+        memcpy(command, payload, size);
+        command[size] = '\0';
+
+        const struct interactive_command *entry = findCommand(command);
+        if (entry != NULL && entry->queued)
         {
-            processCommand(server_command, client_fd);
-            command_index = 0;
-            break;
+            if (!queueCommand(index, request_id, command))
+            {
+                const char *busy = "Processing command...\n";
+                sendFrame(client, opcode, REPLY_BUSY, request_id, (const unsigned char *)busy, strlen(busy));
+            }
+        }
+        else
+        {
+            struct reply_buffer reply;
+            replyInit(&reply, MAX_REPLY_SIZE);
+            int status = runCommand(entry, (unsigned char *)command, &reply);
+            sendFrame(client, opcode, status, request_id, reply.data, reply.size);
+            replyFree(&reply);
         }
-        server_command[command_index] = buffer[i];
-        command_index++;
-        server_command[command_index] = '\0';
     }
+    else if (opcode == BINARY_OP_BATCH)
+    {
+        //queries only. A command that would have to wait for the command
+        //thread cannot be answered in the same frame
+        struct reply_buffer reply;
+        replyInit(&reply, MAX_REPLY_SIZE);
+        uint32_t position = 0;
+        int status = REPLY_OK;
+        while (position + 2 <= length)
+        {
+            uint32_t item_size = getUint16(&payload[position]);
+            position += 2;
+            if (position + item_size > length)
+            {
+                status = REPLY_BAD_FRAME;
+                break;
+            }
+            int size = (item_size < TEXT_COMMAND_SIZE) ? item_size : TEXT_COMMAND_SIZE - 1;
+            memcpy(command, &payload[position], size);
+            command[size] = '\0';
+            position += item_size;
+
+            unsigned char item_header[6];
+            int item_start = reply.size;
+            replyAppend(&reply, item_header, sizeof(item_header));
+            if (reply.overflow) break;
+
+            int item_status;
+            const struct interactive_command *entry = findCommand(command);
+            if (entry != NULL && entry->queued)
+            {
+                replyText(&reply, "Error: command cannot be batched\n");
+                item_status = REPLY_ERROR;
+            }
+            else
+            {
+                item_status = runCommand(entry, (unsigned char *)command, &reply);
+            }
+            if (reply.overflow) break;
+            putUint16(&reply.data[item_start], item_status);
+            putUint32(&reply.data[item_start + 2], reply.size - item_start - sizeof(item_header));
+        }
+        if (reply.overflow)
+        {
+            //the items do not fit in a single frame
+            reply.size = 0;
+            reply.overflow = false;
+            replyText(&reply, "Error: reply too large\n");
+            status = REPLY_ERROR;
+        }
+        sendFrame(client, opcode, status, request_id, reply.data, reply.size);
+        replyFree(&reply);
+    }
+    else
+    {
+        sendFrame(client, opcode, REPLY_BAD_FRAME, request_id, NULL, 0);
+    }
+
+    return BINARY_HEADER_SIZE + length;
 }
 
 //-----------------------------------------------------------------------------
-// Thread to handle requests for each connected client
+// Helper function - Handles the requests a client has sent so far. Returns
+// false if the connection has to be closed
 //-----------------------------------------------------------------------------
-void *handleConnections_interactive(void *arguments)
+static bool processClientInput(int index)
 {
-    int client_fd = *(int *)arguments;
-    unsigned char buffer[1024];
-    int messageSize;
+    struct interactive_client *client = &clients[index];
+
+    while (client->input_size > 0 && !client->waiting && client->output.size - client->output_sent < MAX_OUTPUT_BACKLOG)
+    {
+        if (client->protocol == PROTOCOL_UNKNOWN)
+        {
+            client->protocol = (client->input[0] == BINARY_MAGIC) ? PROTOCOL_BINARY : PROTOCOL_TEXT;
+        }
 
-    printf("Interactive Server: Thread created for client ID: %d\n", client_fd);
+        int used = (client->protocol == PROTOCOL_BINARY) ? processBinaryInput(index) : processTextInput(index);
+        if (used < 0) return false;
+        if (used == 0) break;
 
-    while(run_openplc)
+        client->input_size -= used;
+        memmove(client->input, client->input + used, client->input_size);
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Sends as much of the pending output of a client as the
+// socket takes. Returns false if the connection has to be closed
+//-----------------------------------------------------------------------------
+static bool flushClient(struct interactive_client *client)
+{
+    while (client->output_sent < client->output.size)
     {
-        //unsigned char buffer[1024];
-        //int messageSize;
+        int n = write(client->fd, client->output.data + client->output_sent, client->output.size - client->output_sent);
+        if (n < 0)
+        {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return true;
+            if (errno == EINTR) continue;
+            return false;
+        }
+        client->output_sent += n;
+    }
+
+    client->output.size = 0;
+    client->output_sent = 0;
+    if (client->output.capacity > IDLE_OUTPUT_CAPACITY) replyFree(&client->output);
+    return true;
+}
 
-        messageSize = listenToClient_interactive(client_fd, buffer);
-        if (messageSize <= 0 || messageSize > 1024)
+//-----------------------------------------------------------------------------
+// Helper function - Delivers the replies of the commands the command thread
+// has finished to their clients
+//-----------------------------------------------------------------------------
+static void collectFinishedCommands()
+{
+    char wake[64];
+    while (read(wake_pipe[0], wake, sizeof(wake)) > 0);
+
+    while (true)
+    {
+        pthread_mutex_lock(&command_lock);
+        if (finished_count == 0)
         {
-            // something has  gone wrong or the client has closed connection
-            if (messageSize == 0)
+            pthread_mutex_unlock(&command_lock);
+            break;
+        }
+        struct queued_command job = finished_commands[finished_head];
+        finished_head = (finished_head + 1) % MAX_QUEUED_COMMANDS;
+        finished_count--;
+        commands_in_flight--;
+        pthread_mutex_unlock(&command_lock);
+
+        struct interactive_client *client = &clients[job.client];
+        if (client->fd >= 0 && client->generation == job.generation)
+        {
+            if (client->protocol == PROTOCOL_BINARY)
             {
-                printf("Interactive Server: client ID: %d has closed the connection\n", client_fd);
+                sendFrame(client, BINARY_OP_COMMAND, job.status, job.request_id, job.reply.data, job.reply.size);
             }
             else
             {
-                printf("Interactive Server: Something is wrong with the  client ID: %d message Size : %i\n", client_fd, messageSize);
+                replyAppend(&client->output, job.reply.data, job.reply.size);
+                client->waiting = false;
             }
-            break;
         }
+        replyFree(&job.reply);
+    }
+}
 
-        processMessage_interactive(buffer, messageSize, client_fd);
+//-----------------------------------------------------------------------------
+// Helper function - Accepts every client waiting on the listening socket
+//-----------------------------------------------------------------------------
+static void acceptClients(int socket_fd)
+{
+    while (true)
+    {
+        struct sockaddr_in client_addr;
+        socklen_t client_len = sizeof(client_addr);
+        int client_fd = accept(socket_fd, (struct sockaddr *)&client_addr, &client_len);
+        if (client_fd < 0) return;
+
+        int slot = -1;
+        for (int i = 0; i < MAX_INTERACTIVE_CLIENTS; i++)
+        {
+            if (clients[i].fd < 0)
+            {
+                slot = i;
+                break;
+            }
+        }
+        if (slot < 0)
+        {
+            printf("Interactive Server: too many clients, dropping client ID: %d\n", client_fd);
+            closeSocket(client_fd);
+            continue;
+        }
+
+        SetSocketBlockingEnabled(client_fd, false);
+        clients[slot].fd = client_fd;
+        printf("Interactive Server: Client accepted! Client ID: %d\n", client_fd);
     }
-    //printf("Debug: Closing client socket and calling pthread_exit in interactive_server.cpp\n");
-    closeSocket(client_fd);
-    printf("Terminating interactive server connections\r\n");
-    pthread_exit(NULL);
 }
 
 //-----------------------------------------------------------------------------
 // Function to start the server. It receives the port number as argument and
-// creates an infinite loop to listen and parse the messages sent by the
-// clients
+// runs the event loop that serves every client until the runtime stops
 //-----------------------------------------------------------------------------
 void startInteractiveServer(int port)
 {
     unsigned char log_msg[1000];
-    int socket_fd, client_fd;
+    int socket_fd;
+    struct pollfd poll_fds[MAX_INTERACTIVE_CLIENTS + 2];
+    int poll_clients[MAX_INTERACTIVE_CLIENTS + 2];
+
     socket_fd = createSocket_interactive(port);
+    if (pipe(wake_pipe) < 0)
+    {
+        sprintf(log_msg, "Interactive Server: error creating wake up pipe => %s\n", strerror(errno));
+        log(log_msg);
+        exit(1);
+    }
+    fcntl(wake_pipe[0], F_SETFL, O_NONBLOCK);
+    fcntl(wake_pipe[1], F_SETFL, O_NONBLOCK);
+
+    for (int i = 0; i < MAX_INTERACTIVE_CLIENTS; i++)
+    {
+        clients[i].fd = -1;
+        replyInit(&clients[i].output, MAX_CLIENT_OUTPUT);
+    }
 
-    while(run_openplc)
+    while (run_openplc)
     {
-        client_fd = waitForClient_interactive(socket_fd); //block until a client connects
-        if (client_fd < 0)
+        int count = 0;
+        poll_fds[count].fd = wake_pipe[0];
+        poll_fds[count].events = POLLIN;
+        count++;
+        poll_fds[count].fd = socket_fd;
+        poll_fds[count].events = POLLIN;
+        count++;
+
+        for (int i = 0; i < MAX_INTERACTIVE_CLIENTS; i++)
+        {
+            struct interactive_client *client = &clients[i];
+            if (client->fd < 0) continue;
+
+            short events = 0;
+            if (client->input_size < (int)sizeof(client->input)) events |= POLLIN;
+            if (client->output_sent < client->output.size) events |= POLLOUT;
+            poll_fds[count].fd = client->fd;
+            poll_fds[count].events = events;
+            poll_clients[count] = i;
+            count++;
+        }
+
+        //the timeout only bounds how long it takes to notice run_openplc
+        if (poll(poll_fds, count, 100) < 0)
         {
-            sprintf(log_msg, "Interactive Server: Error accepting client!\n");
+            if (errno == EINTR) continue;
+            sprintf(log_msg, "Interactive Server: poll failed => %s\n", strerror(errno));
             log(log_msg);
+            break;
         }
 
-        else
+        if (poll_fds[0].revents & POLLIN) collectFinishedCommands();
+        if (poll_fds[1].revents & POLLIN) acceptClients(socket_fd);
+
+        for (int p = 2; p < count; p++)
         {
-            int arguments[1];
-            pthread_t thread;
-            int ret = -1;
-
-            printf("Interactive Server: Client accepted! Creating thread for the new client ID: %d...\n", client_fd);
-            arguments[0] = client_fd;
-            ret = pthread_create(&thread, NULL, handleConnections_interactive, arguments);
-            if (ret==0) 
+            struct interactive_client *client = &clients[poll_clients[p]];
+            if (client->fd != poll_fds[p].fd) continue;
+
+            if (poll_fds[p].revents & (POLLIN | POLLHUP | POLLERR))
             {
-                pthread_detach(thread);
+                int n = read(client->fd, client->input + client->input_size, sizeof(client->input) - client->input_size);
+                if (n <= 0 && !(n < 0 && (errno == EAGAIN || errno == EINTR)))
+                {
+                    closeClient(client);
+                    continue;
+                }
+                if (n > 0) client->input_size += n;
             }
         }
+
+        //replies of queued commands can unblock text clients, so every
+        //client gets a chance to go on
+        for (int i = 0; i < MAX_INTERACTIVE_CLIENTS; i++)
+        {
+            struct interactive_client *client = &clients[i];
+            if (client->fd < 0) continue;
+
+            bool keep = processClientInput(i);
+            if (client->output.overflow)
+            {
+                //the client is not reading its replies
+                printf("Interactive Server: output limit reached for client ID: %d\n", client->fd);
+                keep = false;
+            }
+            if (!flushClient(client) || !keep) closeClient(client);
+        }
     }
-    
+
+    //let the command that stopped the runtime answer before closing
+    for (int i = 0; i < 20 && commands_in_flight > 0; i++)
+    {
+        sleepms(50);
+        collectFinishedCommands();
+    }
+
     printf("Shutting down internal threads\n");
     run_modbus = 0;
     run_dnp3 = 0;
@@ -504,6 +1171,12 @@ void startInteractiveServer(int port)
     
     printf("Closing socket...\n");
     closeSocket(socket_fd);
-    closeSocket(client_fd);
+    for (int i = 0; i < MAX_INTERACTIVE_CLIENTS; i++)
+    {
+        if (clients[i].fd < 0) continue;
+        SetSocketBlockingEnabled(clients[i].fd, true);
+        flushClient(&clients[i]);
+        closeClient(&clients[i]);
+    }
     printf("Terminating interactive server thread\n");
-}
\ No newline at end of file
+}
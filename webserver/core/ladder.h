@@ -26,6 +26,8 @@
 #include <pthread.h>
 #include <stdint.h>
 
+#include "located_address.h"
+
 #define MODBUS_PROTOCOL     0
 #define DNP3_PROTOCOL       1
 #define ENIP_PROTOCOL       2
@@ -58,24 +60,31 @@ typedef float    IEC_REAL;
 typedef double   IEC_LREAL;
 
 //Booleans
-extern IEC_BOOL *bool_input[BUFFER_SIZE][8];
-extern IEC_BOOL *bool_output[BUFFER_SIZE][8];
+extern IEC_BOOL *const bool_input[BUFFER_SIZE][8];
+extern IEC_BOOL *const bool_output[BUFFER_SIZE][8];
 
 //Bytes
-extern IEC_BYTE *byte_input[BUFFER_SIZE];
-extern IEC_BYTE *byte_output[BUFFER_SIZE];
+extern IEC_BYTE *const byte_input[BUFFER_SIZE];
+extern IEC_BYTE *const byte_output[BUFFER_SIZE];
 
 //Analog I/O
-extern IEC_UINT *int_input[BUFFER_SIZE];
-extern IEC_UINT *int_output[BUFFER_SIZE];
+extern IEC_UINT *const int_input[BUFFER_SIZE];
+extern IEC_UINT *const int_output[BUFFER_SIZE];
 
 //Memory
-extern IEC_UINT *int_memory[BUFFER_SIZE];
-extern IEC_DINT *dint_memory[BUFFER_SIZE];
-extern IEC_LINT *lint_memory[BUFFER_SIZE];
+extern IEC_UINT *const int_memory[BUFFER_SIZE];
+extern IEC_DINT *const dint_memory[BUFFER_SIZE];
+extern IEC_LINT *const lint_memory[BUFFER_SIZE];
 
 //Special Functions
-extern IEC_LINT *special_functions[BUFFER_SIZE];
+extern IEC_LINT *const special_functions[BUFFER_SIZE];
+
+//Modbus buffers. Defined in modbus.cpp. The table slots that are not used by
+//the program point here
+extern IEC_BOOL mb_discrete_input[];
+extern IEC_BOOL mb_coils[];
+extern IEC_UINT mb_input_regs[];
+extern IEC_UINT mb_holding_regs[];
 
 //lock for the buffer
 extern pthread_mutex_t bufferLock;
@@ -93,7 +102,8 @@ void config_init__(void);
 
 //glueVars.cpp
 void glueVars();
-void updateTime();
+extern const struct located_address located_address_map[];
+extern const int located_address_count;
 
 //hardware_layer.cpp
 void initializeHardware();
@@ -116,15 +126,27 @@ void sleepms(int milliseconds);
 void log(unsigned char *logmsg);
 bool pinNotPresent(int *ignored_vector, int vector_size, int pinNumber);
 extern uint8_t run_openplc;
-extern unsigned char log_buffer[1000000];
+extern pthread_mutex_t logLock;
+extern unsigned char *log_buffer;
 extern int log_index;
+extern int log_buffer_kb;
+void resizeLogBuffer();
 void handleSpecialFunctions();
+void disableOutputs();
+void updateClock();
+bool clockChanged();
 
 //server.cpp
 void startServer(uint16_t port, int protocol_type);
 int getSO_ERROR(int fd);
 void closeSocket(int fd);
 bool SetSocketBlockingEnabled(int fd, bool blocking);
+#define NET_THREADS             0
+#define NET_EPOLL               1
+#define NET_IO_URING            2
+extern int max_connections;
+extern int net_backend;
+unsigned long long connectionPoolMemory(int *in_use);
 
 //interactive_server.cpp
 void startInteractiveServer(int port);
@@ -135,10 +157,13 @@ extern bool run_pstorage;
 extern uint16_t pstorage_polling;
 extern time_t start_time;
 extern time_t end_time;
+unsigned long long interactiveServerMemory();
 
 //modbus.cpp
 int processModbusMessage(unsigned char *buffer, int bufferSize);
 void mapUnusedIO();
+void publishRegisterSnapshot();
+unsigned long long registerSnapshotMemory(int *bindings);
 
 //enip.cpp
 int processEnipMessage(unsigned char *buffer, int buffer_size);
@@ -151,10 +176,78 @@ void initializeMB();
 void *querySlaveDevices(void *arg);
 void updateBuffersIn_MB();
 void updateBuffersOut_MB();
+bool hasWorkIn_MB();
+bool hasWorkOut_MB();
 
 //dnp3.cpp
 void dnp3StartServer(int port);
 
+//scan_pipeline.cpp
+#define OVERRUN_CATCH_UP        0
+#define OVERRUN_SKIP            1
+#define OVERRUN_STRETCH         2
+#define SCAN_CYCLIC             0
+#define SCAN_EVENT              1
+extern int overrun_policy;
+extern int watchdog_overruns;
+extern int scan_mode;
+extern int max_idle_ms;
+extern int input_poll_ms;
+void addScanStage(const char *name, void (*run)(), bool (*has_work)(), bool needs_lock);
+void runScanPipeline();
+void updateTime();
+unsigned long waitNextCycle(struct timespec *next_cycle);
+bool watchdogTripped();
+bool plcLogicDue();
+void notifyScanEvent();
+void resetWatchdog();
+void resetScanStats();
+int scanStatsReport(char *buffer, int buffer_size);
+
+//pou_profile.cpp
+extern int pou_profile_rate;
+void startPouProfileScan(unsigned long long tick);
+void resetPouProfile();
+int pouProfileReport(char *buffer, int buffer_size);
+
+//parallel_programs.cpp
+extern int program_workers;
+void startProgramWorkers();
+
+//timer_wheel.cpp
+void advanceTimerWheel();
+
+//flight_recorder.cpp
+extern int flight_recorder_kb;
+extern char flight_replay[256];
+void initFlightRecorder();
+bool flightRecorderScanStart();
+void flightRecorderScanEnd();
+void flightRecorderOverrun();
+int flightRecorderDump(char *buffer, int buffer_size);
+unsigned long long flightRecorderMemory();
+
+//runtime_config.cpp
+#define THREAD_SCAN             0
+#define THREAD_INTERACTIVE      1
+#define THREAD_PROTOCOL         2
+#define THREAD_MODBUS_MASTER    3
+#define THREAD_PSTORAGE         4
+#define THREAD_WORKER           5
+#define NUM_THREAD_CLASSES      6
+void loadRuntimeConfig();
+void applyThreadProfile(int thread_class);
+void applyWorkerProfile(int worker);
+void applyScanProfile();
+void reportRuntimeConfig();
+int createRuntimeThread(pthread_t *thread, void *(*routine)(void *), void *arg, int thread_class);
+int memoryReport(char *buffer, int buffer_size);
+
 //persistent_storage.cpp
+extern int pstorage_sync_ms;
+extern int pstorage_daily_kb;
 void startPstorage();
 int readPersistentStorage();
+bool pstorageCaptureDue();
+void capturePstorage();
+int pstorageStats(char *buffer, int buffer_size);
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2026 OpenPLC Project
+ *
+ * This file is part of the OpenPLC Software Stack.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/****
+ * Per POU execution profiler.
+ *
+ * Code generated by iec2c with the 't' stage 4 option ('-O t') wraps the body
+ * of every program and function block, and every function block call, with
+ * the macros below. Each wrapped site owns a static accumulator. Calls are
+ * always counted; the time is only measured on the scans the runtime selects
+ * for sampling (__pou_profile_sampling), using the CPU cycle counter when
+ * there is one. Each accumulator is written only by the thread running the
+ * POU, and the accumulators are linked into a list the first time they are
+ * sampled, so readers can walk them without taking any lock. When programs
+ * run concurrently ('-O j'), the accumulator of a POU type used by two
+ * programs of the same wave is not locked either, so its counts are
+ * approximate.
+ *
+ * The runtime linked with the generated code provides __pou_profile_list,
+ * __pou_profile_sampling and __pou_profile_clock().
+ ****/
+
+#ifndef _POU_PROFILE_H
+#define _POU_PROFILE_H
+
+#define POU_PROFILE_BODY    0  /* body of a program or function block type */
+#define POU_PROFILE_CALL    1  /* call of one function block instance */
+
+typedef struct __pou_profile_t {
+  const char *name;
+  unsigned char kind;
+  unsigned char registered;
+  unsigned long long calls;
+  unsigned long long samples;
+  unsigned long long total_cycles;
+  unsigned long long max_cycles;
+  struct __pou_profile_t *next;
+} __pou_profile_t;
+
+extern __pou_profile_t *__pou_profile_list;
+extern int __pou_profile_sampling;
+unsigned long long __pou_profile_clock(void);
+
+/* Cycle counter used for the measurements. Falls back to the monotonic
+ * clock (in ns) on targets without a counter readable from user space */
+static inline unsigned long long __pou_profile_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+  unsigned int lo, hi;
+  __asm__ __volatile__ ("rdtsc" : "=a" (lo), "=d" (hi));
+  return ((unsigned long long)hi << 32) | lo;
+#elif defined(__aarch64__)
+  unsigned long long value;
+  __asm__ __volatile__ ("mrs %0, cntvct_el0" : "=r" (value));
+  return value;
+#else
+  return __pou_profile_clock();
+#endif
+}
+
+static inline void __pou_profile_register(__pou_profile_t *profile) {
+  if (__atomic_exchange_n(&profile->registered, 1, __ATOMIC_ACQ_REL)) return;
+  __pou_profile_t *head = __atomic_load_n(&__pou_profile_list, __ATOMIC_ACQUIRE);
+  do {
+    profile->next = head;
+  } while (!__atomic_compare_exchange_n(&__pou_profile_list, &head, profile, 1, __ATOMIC_RELEASE, __ATOMIC_ACQUIRE));
+}
+
+static inline unsigned long long __pou_profile_enter(__pou_profile_t *profile) {
+  profile->calls++;
+  if (__builtin_expect(!__pou_profile_sampling, 1)) return 0;
+  if (!profile->registered) __pou_profile_register(profile);
+  return __pou_profile_cycles();
+}
+
+static inline void __pou_profile_exit(__pou_profile_t *profile, unsigned long long start) {
+  if (__builtin_expect(start == 0, 1)) return;
+  unsigned long long elapsed = __pou_profile_cycles() - start;
+  profile->samples++;
+  profile->total_cycles += elapsed;
+  if (elapsed > profile->max_cycles) profile->max_cycles = elapsed;
+}
+
+/* Accumulator of a program or function block type, placed before its body */
+#define __POU_PROFILE_DEFINE(pou) \
+  static __pou_profile_t __pou_profile_##pou = {#pou, POU_PROFILE_BODY, 0, 0, 0, 0, 0, 0};
+
+/* First and last statements of the body. Every 'goto __end' of the body
+ * lands before __POU_PROFILE_EXIT */
+#define __POU_PROFILE_ENTER(pou) \
+  unsigned long long __pou_profile_start = __pou_profile_enter(&__pou_profile_##pou);
+#define __POU_PROFILE_EXIT(pou) \
+  __pou_profile_exit(&__pou_profile_##pou, __pou_profile_start);
+
+/* Call of a function block instance. site is "<POU>.<instance>" */
+#define __POU_PROFILE_CALL(site, call) \
+  do { \
+    static __pou_profile_t __pou_profile_site = {site, POU_PROFILE_CALL, 0, 0, 0, 0, 0, 0}; \
+    unsigned long long __pou_profile_site_start = __pou_profile_enter(&__pou_profile_site); \
+    call; \
+    __pou_profile_exit(&__pou_profile_site, __pou_profile_site_start); \
+  } while (0)
+
+#endif /* _POU_PROFILE_H */
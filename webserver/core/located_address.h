@@ -0,0 +1,40 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 OpenPLC Project
+// This file is part of the OpenPLC Software Stack.
+//
+// OpenPLC is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenPLC is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with OpenPLC.  If not, see <http://www.gnu.org/licenses/>.
+//------
+//
+// Entry of the located variables map generated by glue_generator. It is kept
+// apart from ladder.h because glueVars.cpp includes iec_std_lib.h, which
+// cannot be mixed with the system headers ladder.h pulls in
+//-----------------------------------------------------------------------------
+
+#ifndef LOCATED_ADDRESS_H
+#define LOCATED_ADDRESS_H
+
+#include <stdint.h>
+
+//Sorted list of the located variables used by the program. Generated by
+//glue_generator together with the buffer tables
+struct located_address
+{
+    char area;
+    char size;
+    uint16_t pos1;
+    uint8_t pos2;
+    const char *type;
+};
+
+#endif
@@ -45,7 +45,9 @@ unsigned long __tick = 0;
 pthread_mutex_t bufferLock; //mutex for the internal buffers
 pthread_mutex_t logLock; //mutex for the internal log
 uint8_t run_openplc = 1; //Variable to control OpenPLC Runtime execution
-unsigned char log_buffer[1000000]; //A very large buffer to store all logs
+unsigned char *log_buffer = NULL; //Buffer to store the latest logs
+int log_buffer_kb = 256; //size of the log buffer (configured in runtime.cfg)
+int log_buffer_size = 0;
 int log_index = 0;
 int log_counter = 0;
 
@@ -83,10 +85,29 @@ void log(unsigned char *logmsg)
 {
     pthread_mutex_lock(&logLock); //lock mutex
     printf("%s", logmsg);
-    for (int i = 0; logmsg[i] != '\0'; i++)
+    if (log_buffer == NULL)
     {
-        log_buffer[log_index] = logmsg[i];
-        log_index++;
+        log_buffer_size = log_buffer_kb * 1024;
+        log_buffer = (unsigned char *)calloc(log_buffer_size, 1);
+    }
+
+    //when the buffer is full, the oldest messages are dropped and the newest
+    //half of the buffer is moved down, starting at a whole message
+    int length = strlen((char *)logmsg);
+    if (log_buffer != NULL && length < log_buffer_size && log_index + length >= log_buffer_size)
+    {
+        int start = log_index - log_buffer_size / 2;
+        if (start < 0) start = 0;
+        while (start > 0 && start < log_index && log_buffer[start - 1] != '\n') start++;
+        if (log_index - start + length >= log_buffer_size) start = log_index;
+        memmove(log_buffer, log_buffer + start, log_index - start);
+        log_index -= start;
+        log_buffer[log_index] = '\0';
+    }
+    if (log_buffer != NULL && length < log_buffer_size)
+    {
+        memcpy(log_buffer + log_index, logmsg, length);
+        log_index += length;
         log_buffer[log_index] = '\0';
     }
     
@@ -100,12 +121,45 @@ void log(unsigned char *logmsg)
     pthread_mutex_unlock(&logLock); //unlock mutex
 }
 
+//-----------------------------------------------------------------------------
+// Helper function - Gives the log buffer the size set in runtime.cfg. The
+// messages logged so far are kept, or the newest of them if they do not fit
+//-----------------------------------------------------------------------------
+void resizeLogBuffer()
+{
+    int size = log_buffer_kb * 1024;
+    pthread_mutex_lock(&logLock);
+    if (size != log_buffer_size)
+    {
+        unsigned char *buffer = (unsigned char *)calloc(size, 1);
+        if (buffer != NULL)
+        {
+            int start = 0;
+            if (log_buffer == NULL) log_index = 0;
+            else if (log_index >= size)
+            {
+                //a smaller buffer gets the newest messages that fill half of it
+                start = log_index - size / 2;
+                while (start < log_index && log_buffer[start - 1] != '\n') start++;
+            }
+            log_index -= start;
+            if (log_buffer != NULL) memcpy(buffer, log_buffer + start, log_index);
+            buffer[log_index] = '\0';
+            free(log_buffer);
+            log_buffer = buffer;
+            log_buffer_size = size;
+        }
+    }
+    pthread_mutex_unlock(&logLock);
+}
+
 //-----------------------------------------------------------------------------
 // Interactive Server Thread. Creates the server to listen to commands on
 // localhost
 //-----------------------------------------------------------------------------
 void *interactiveServerThread(void *arg)
 {
+    applyThreadProfile(THREAD_INTERACTIVE);
     startInteractiveServer(43628);
 }
 
@@ -151,25 +205,44 @@ void disableOutputs()
 }
 
 //-----------------------------------------------------------------------------
-// Special Functions
+// Scan pipeline hint for the clock special functions. The wall clock is only
+// published once per second, so the localtime() conversion is skipped when
+// the second has not changed since the last update
 //-----------------------------------------------------------------------------
-void handleSpecialFunctions()
+time_t last_clock_update = 0;
+
+bool clockChanged()
+{
+    return (time(NULL) != last_clock_update);
+}
+
+//-----------------------------------------------------------------------------
+// Special Functions - Clock
+//-----------------------------------------------------------------------------
+void updateClock()
 {
     //current time [%ML1024]
-    struct tm *current_time;
+    struct tm current_time;
     time_t rawtime;
     
     time(&rawtime);
+    last_clock_update = rawtime;
     // store the UTC clock in [%ML1027]
     if (special_functions[3] != NULL) *special_functions[3] = rawtime;
 
-    current_time = localtime(&rawtime);
+    localtime_r(&rawtime, &current_time);
     
     rawtime = rawtime - timezone;
-    if (current_time->tm_isdst > 0) rawtime = rawtime + 3600;
+    if (current_time.tm_isdst > 0) rawtime = rawtime + 3600;
         
     if (special_functions[0] != NULL) *special_functions[0] = rawtime;
-    
+}
+
+//-----------------------------------------------------------------------------
+// Special Functions
+//-----------------------------------------------------------------------------
+void handleSpecialFunctions()
+{
     //number of cycles [%ML1025]
     cycle_counter++;
     if (special_functions[1] != NULL) *special_functions[1] = cycle_counter;
@@ -180,6 +253,39 @@ void handleSpecialFunctions()
     //insert other special functions below
 }
 
+//-----------------------------------------------------------------------------
+// Executes the PLC program logic
+//-----------------------------------------------------------------------------
+void runPlcLogic()
+{
+    if (!flightRecorderScanStart()) return; //replay of a flight recording is over
+    startPouProfileScan(__tick);
+    advanceTimerWheel(); //expire the timers of programs compiled with iec2c -O w
+    config_run__(__tick++);
+    flightRecorderScanEnd();
+}
+
+//-----------------------------------------------------------------------------
+// Builds the scan pipeline. The order of the stages is the order in which
+// they are executed on every cycle
+//-----------------------------------------------------------------------------
+void setupScanPipeline()
+{
+    addScanStage("buffers_in", updateBuffersIn, NULL, false); //read input image
+    addScanStage("custom_in", updateCustomIn, NULL, true);
+    addScanStage("modbus_master_in", updateBuffersIn_MB, hasWorkIn_MB, true); //update input image table with data from slave devices
+    addScanStage("clock", updateClock, clockChanged, true);
+    addScanStage("special_functions", handleSpecialFunctions, NULL, true);
+    addScanStage("plc_logic", runPlcLogic, plcLogicDue, true); // execute plc program logic (in event mode only when due)
+    addScanStage("safe_state", disableOutputs, watchdogTripped, true); // keep outputs off while the watchdog is tripped
+    addScanStage("custom_out", updateCustomOut, NULL, true);
+    addScanStage("modbus_master_out", updateBuffersOut_MB, hasWorkOut_MB, true); //update slave devices with data from the output image table
+    addScanStage("modbus_snapshot", publishRegisterSnapshot, NULL, true); //publish the registers read by Modbus clients
+    addScanStage("pstorage", capturePstorage, pstorageCaptureDue, true); //hand changed %MW words to the persistent storage thread
+    addScanStage("buffers_out", updateBuffersOut, NULL, false); //write output image
+    addScanStage("update_time", updateTime, NULL, false);
+}
+
 int main(int argc,char **argv)
 {
     unsigned char log_msg[1000];
@@ -191,8 +297,9 @@ int main(int argc,char **argv)
     //======================================================
     tzset();
     time(&start_time);
+    loadRuntimeConfig();
     pthread_t interactive_thread;
-    pthread_create(&interactive_thread, NULL, interactiveServerThread, NULL);
+    createRuntimeThread(&interactive_thread, interactiveServerThread, NULL, THREAD_INTERACTIVE);
     config_init__();
     glueVars();
 
@@ -222,29 +329,20 @@ int main(int argc,char **argv)
     glueVars();
     mapUnusedIO();
     readPersistentStorage();
+    initFlightRecorder();
     //pthread_t persistentThread;
     //pthread_create(&persistentThread, NULL, persistentStorage, NULL);
 
-#ifdef __linux__
     //======================================================
     //              REAL-TIME INITIALIZATION
     //======================================================
-    // Set our thread to real time priority
-    struct sched_param sp;
-    sp.sched_priority = 30;
-    printf("Setting main thread priority to RT\n");
-    if(pthread_setschedparam(pthread_self(), SCHED_FIFO, &sp))
-    {
-        printf("WARNING: Failed to set main thread to real-time priority\n");
-    }
+    // Set our thread to real time priority, pin it to the scan
+    // cores and lock memory as configured in runtime.cfg
+    applyScanProfile();
+    reportRuntimeConfig();
 
-    // Lock memory to ensure no swapping is done.
-    printf("Locking main thread memory\n");
-    if(mlockall(MCL_FUTURE|MCL_CURRENT))
-    {
-        printf("WARNING: Failed to lock memory\n");
-    }
-#endif
+    //threads that run independent programs next to this one (iec2c -O j)
+    startProgramWorkers();
 
 	//gets the starting point for the clock
 	printf("Getting current time\n");
@@ -254,28 +352,14 @@ int main(int argc,char **argv)
 	//======================================================
 	//                    MAIN LOOP
 	//======================================================
+	setupScanPipeline();
 	while(run_openplc)
 	{
-		//make sure the buffer pointers are correct and
-		//attached to the user variables
-		glueVars();
-        
-		updateBuffersIn(); //read input image
-
-		pthread_mutex_lock(&bufferLock); //lock mutex
-		updateCustomIn();
-        updateBuffersIn_MB(); //update input image table with data from slave devices
-        handleSpecialFunctions();
-		config_run__(__tick++); // execute plc program logic
-		updateCustomOut();
-        updateBuffersOut_MB(); //update slave devices with data from the output image table
-		pthread_mutex_unlock(&bufferLock); //unlock mutex
-
-		updateBuffersOut(); //write output image
-        
-		updateTime();
+		runScanPipeline();
 
-		sleep_until(&timer_start, common_ticktime__);
+		//wait for the next cycle. Skipped cycles still count as ticks so
+		//the tasks keep their real period
+		__tick += waitNextCycle(&timer_start);
 	}
     
     //======================================================
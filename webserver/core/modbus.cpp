@@ -60,6 +60,8 @@
 #define ERR_SLAVE_DEVICE_FAILURE        4
 #define ERR_SLAVE_DEVICE_BUSY           6
 
+#define SNAPSHOT_READ_ATTEMPTS          8
+#define MAX_WRITE_REGISTERS             128
 
 #define bitRead(value, bit) (((value) >> (bit)) & 0x01)
 #define bitSet(value, bit) ((value) |= (1UL << (bit)))
@@ -90,45 +92,305 @@ int word(unsigned char byte1, unsigned char byte2)
 }
 
 //-----------------------------------------------------------------------------
-// This function sets the internal NULL OpenPLC buffers to point to valid
-// positions on the Modbus buffer
+// Register snapshot. Read Holding Registers and Read Input Registers are
+// answered from a copy of the registers bound to located variables instead
+// of the live image, so a read never waits for the scan cycle and never sees
+// a %MD or %ML value the program is halfway through updating. The copy is
+// published with bufferLock held, by the scan cycle and by every register
+// write, reading each variable once. There are two copies: the publisher
+// fills the one readers are not using and then makes it current. Each copy
+// has a sequence number that is odd while it is being filled, and readers
+// start over when it changes under them. Registers that are not bound to a
+// variable are read straight from mb_holding_regs/mb_input_regs, guarded
+// the same way by scratch_sequence.
 //-----------------------------------------------------------------------------
-void mapUnusedIO()
+struct register_binding
 {
-	pthread_mutex_lock(&bufferLock);
+	int position;	//first register of the variable
+	int width;		//number of registers (1, 2 or 4)
+	void *value;
+};
+
+struct register_snapshot
+{
+	unsigned int sequence;
+	IEC_UINT holding_regs[MAX_HOLD_REGS];
+	IEC_UINT input_regs[MAX_INP_REGS];
+};
+
+static struct register_binding holding_bindings[MAX_HOLD_REGS];
+static struct register_binding input_bindings[MAX_INP_REGS];
+static int num_holding_bindings = 0;
+static int num_input_bindings = 0;
+static bool holding_bound[MAX_HOLD_REGS];
+static bool input_bound[MAX_INP_REGS];
+
+static struct register_snapshot register_snapshots[2];
+static unsigned int snapshot_current = 0;
+static unsigned int scratch_sequence = 0;
+static bool snapshot_ready = false;
+
+//-----------------------------------------------------------------------------
+// Helper function - Finds the located variable behind a holding register.
+// Returns its address (NULL if the register is not bound), its size in
+// registers and the register it starts at
+//-----------------------------------------------------------------------------
+static void *holdingRegisterVariable(int position, int *width, int *first)
+{
+	if (position < MIN_16B_RANGE)
+	{
+		*width = 1;
+		*first = position;
+		return int_output[position];
+	}
+	else if (position <= MAX_16B_RANGE)
+	{
+		*width = 1;
+		*first = position;
+		return int_memory[position - MIN_16B_RANGE];
+	}
+	else if (position <= MAX_32B_RANGE)
+	{
+		*width = 2;
+		*first = position - (position - MIN_32B_RANGE) % 2;
+		return dint_memory[(position - MIN_32B_RANGE) / 2];
+	}
+	else
+	{
+		*width = 4;
+		*first = position - (position - MIN_64B_RANGE) % 4;
+		return lint_memory[(position - MIN_64B_RANGE) / 4];
+	}
+}
 
-	for(int i = 0; i < MAX_DISCRETE_INPUT; i++)
+//-----------------------------------------------------------------------------
+// Helper function - Lists the holding and input registers bound to located
+// variables. The 16-bit registers that are not bound point to mb_holding_regs
+// and mb_input_regs, as set by glue_generator
+//-----------------------------------------------------------------------------
+static void buildRegisterBindings()
+{
+	for (int position = 0; position < MAX_HOLD_REGS; )
 	{
-		if (bool_input[i/8][i%8] == NULL) bool_input[i/8][i%8] = &mb_discrete_input[i];
+		int width, first;
+		void *value = holdingRegisterVariable(position, &width, &first);
+		bool bound = (value != NULL && value != &mb_holding_regs[position]);
+		if (bound)
+		{
+			holding_bindings[num_holding_bindings].position = position;
+			holding_bindings[num_holding_bindings].width = width;
+			holding_bindings[num_holding_bindings].value = value;
+			num_holding_bindings++;
+		}
+		for (int i = 0; i < width; i++) holding_bound[position + i] = bound;
+		position += width;
 	}
 
-	for(int i = 0; i < MAX_COILS; i++)
+	for (int position = 0; position < MAX_INP_REGS; position++)
 	{
-		if (bool_output[i/8][i%8] == NULL) bool_output[i/8][i%8] = &mb_coils[i];
+		input_bound[position] = (int_input[position] != NULL && int_input[position] != &mb_input_regs[position]);
+		if (input_bound[position])
+		{
+			input_bindings[num_input_bindings].position = position;
+			input_bindings[num_input_bindings].width = 1;
+			input_bindings[num_input_bindings].value = int_input[position];
+			num_input_bindings++;
+		}
 	}
 
-	for (int i = 0; i < MAX_INP_REGS; i++)
+	snapshot_ready = true;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Copies the current value of a list of bound variables
+// into the registers of a snapshot, most significant word first
+//-----------------------------------------------------------------------------
+static void copyBindings(struct register_binding *bindings, int count, IEC_UINT *registers)
+{
+	for (int i = 0; i < count; i++)
+	{
+		uint64_t value;
+		if (bindings[i].width == 1) value = *(IEC_UINT *)bindings[i].value;
+		else if (bindings[i].width == 2) value = *(IEC_UDINT *)bindings[i].value;
+		else value = *(IEC_ULINT *)bindings[i].value;
+
+		for (int word = bindings[i].width - 1; word >= 0; word--)
+		{
+			__atomic_store_n(&registers[bindings[i].position + word], (IEC_UINT)(value & 0xffff), __ATOMIC_RELAXED);
+			value >>= 16;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Publishes a new register snapshot. Must be called with bufferLock held
+//-----------------------------------------------------------------------------
+void publishRegisterSnapshot()
+{
+	if (!snapshot_ready) return;
+
+	unsigned int next = snapshot_current ^ 1;
+	struct register_snapshot *snapshot = &register_snapshots[next];
+
+	__atomic_store_n(&snapshot->sequence, snapshot->sequence + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	copyBindings(holding_bindings, num_holding_bindings, snapshot->holding_regs);
+	copyBindings(input_bindings, num_input_bindings, snapshot->input_regs);
+	__atomic_store_n(&snapshot->sequence, snapshot->sequence + 1, __ATOMIC_RELEASE);
+	__atomic_store_n(&snapshot_current, next, __ATOMIC_RELEASE);
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Copies count registers from start into a reply, from the
+// current snapshot. Returns false if a publisher or a register write changed
+// them while they were copied
+//-----------------------------------------------------------------------------
+static bool readRegisterSnapshot(bool holding, int start, int count, unsigned char *reply)
+{
+	struct register_snapshot *snapshot = &register_snapshots[__atomic_load_n(&snapshot_current, __ATOMIC_ACQUIRE)];
+	unsigned int sequence = __atomic_load_n(&snapshot->sequence, __ATOMIC_ACQUIRE);
+	unsigned int scratch = __atomic_load_n(&scratch_sequence, __ATOMIC_ACQUIRE);
+	if ((sequence & 1) || (scratch & 1)) return false;
+
+	for (int i = 0; i < count; i++)
+	{
+		int position = start + i;
+		IEC_UINT value;
+		if (holding)
+		{
+			if (holding_bound[position]) value = __atomic_load_n(&snapshot->holding_regs[position], __ATOMIC_RELAXED);
+			else value = __atomic_load_n(&mb_holding_regs[position], __ATOMIC_RELAXED);
+		}
+		else
+		{
+			if (input_bound[position]) value = __atomic_load_n(&snapshot->input_regs[position], __ATOMIC_RELAXED);
+			else value = __atomic_load_n(&mb_input_regs[position], __ATOMIC_RELAXED);
+		}
+		reply[i * 2] = highByte(value);
+		reply[i * 2 + 1] = lowByte(value);
+	}
+
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	return (__atomic_load_n(&snapshot->sequence, __ATOMIC_RELAXED) == sequence &&
+			__atomic_load_n(&scratch_sequence, __ATOMIC_RELAXED) == scratch);
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Copies count registers from start into a reply. After a
+// few attempts spoiled by publishers it takes bufferLock, which keeps them
+// all away
+//-----------------------------------------------------------------------------
+static void readRegisters(bool holding, int start, int count, unsigned char *reply)
+{
+	for (int attempt = 0; attempt < SNAPSHOT_READ_ATTEMPTS; attempt++)
+	{
+		if (readRegisterSnapshot(holding, start, count, reply)) return;
+	}
+
+	pthread_mutex_lock(&bufferLock);
+	readRegisterSnapshot(holding, start, count, reply);
+	pthread_mutex_unlock(&bufferLock);
+}
+
+//-----------------------------------------------------------------------------
+// Memory taken by the register snapshot, for the memory report
+//-----------------------------------------------------------------------------
+unsigned long long registerSnapshotMemory(int *bindings)
+{
+	*bindings = num_holding_bindings + num_input_bindings;
+	return sizeof(register_snapshots) + sizeof(holding_bindings) + sizeof(input_bindings) +
+			sizeof(holding_bound) + sizeof(input_bound);
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Writes count registers from start, taken from a request,
+// as one batch. The words of a 32 or 64-bit variable are merged and stored
+// at once, so neither the program nor a reader can see half of a value, and
+// nothing is written unless every register is valid. Returns a Modbus error
+//-----------------------------------------------------------------------------
+static int writeRegisters(int start, int count, unsigned char *data)
+{
+	struct register_write
 	{
-		if (int_input[i] == NULL) int_input[i] = &mb_input_regs[i];
+		void *value;	//variable written, or NULL for a register that is not bound
+		int position;
+		int width;
+		uint64_t bits;
+		uint64_t mask;
+	} batch[MAX_WRITE_REGISTERS];
+	int batch_size = 0;
+
+	if (count > MAX_WRITE_REGISTERS || start + count > MAX_HOLD_REGS) return ERR_ILLEGAL_DATA_ADDRESS;
+
+	for (int i = 0; i < count; i++)
+	{
+		int position = start + i;
+		int width, first;
+		void *value = holdingRegisterVariable(position, &width, &first);
+		int shift = 16 * (width - 1 - (position - first));
+		uint64_t bits = (uint64_t)word(data[i * 2], data[i * 2 + 1]) << shift;
+
+		if (value != NULL && batch_size > 0 && batch[batch_size - 1].value == value)
+		{
+			batch[batch_size - 1].bits |= bits;
+			batch[batch_size - 1].mask |= 0xffffULL << shift;
+			continue;
+		}
+
+		batch[batch_size].value = value;
+		batch[batch_size].position = position;
+		batch[batch_size].width = (value == NULL) ? 1 : width;
+		batch[batch_size].bits = (value == NULL) ? bits >> shift : bits;
+		batch[batch_size].mask = 0xffffULL << ((value == NULL) ? 0 : shift);
+		batch_size++;
 	}
 
-	for (int i = 0; i <= MAX_16B_RANGE; i++)
+	pthread_mutex_lock(&bufferLock);
+	__atomic_store_n(&scratch_sequence, scratch_sequence + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	for (int i = 0; i < batch_size; i++)
 	{
-		if (i < MIN_16B_RANGE)
-        {
-            if (int_output[i] == NULL)
-            {
-                int_output[i] = &mb_holding_regs[i];
-            }
-        }
+		struct register_write *write = &batch[i];
+		if (write->value == NULL)
+		{
+			__atomic_store_n(&mb_holding_regs[write->position], (IEC_UINT)write->bits, __ATOMIC_RELAXED);
+		}
+		else if (write->width == 1)
+		{
+			__atomic_store_n((IEC_UINT *)write->value, (IEC_UINT)write->bits, __ATOMIC_RELAXED);
+		}
+		else if (write->width == 2)
+		{
+			IEC_UDINT *value = (IEC_UDINT *)write->value;
+			*value = (*value & ~(IEC_UDINT)write->mask) | (IEC_UDINT)write->bits;
+		}
+		else
+		{
+			IEC_ULINT *value = (IEC_ULINT *)write->value;
+			*value = (*value & ~(IEC_ULINT)write->mask) | (IEC_ULINT)write->bits;
+		}
+	}
+	__atomic_store_n(&scratch_sequence, scratch_sequence + 1, __ATOMIC_RELEASE);
+	publishRegisterSnapshot();
+	pthread_mutex_unlock(&bufferLock);
+	notifyScanEvent();
+
+	return ERR_NONE;
+}
 
-		else if (i >= MIN_16B_RANGE && i <= MAX_16B_RANGE)
-        {
-			if (int_memory[i - MIN_16B_RANGE] == NULL)
-            {
-                int_memory[i - MIN_16B_RANGE] = &mb_holding_regs[i];
-            }
-        }
+//-----------------------------------------------------------------------------
+// The buffer slots that are not used by the program already point to the
+// Modbus buffers, as glue_generator binds them when the tables are generated.
+// This function only prepares the register snapshot for those tables
+//-----------------------------------------------------------------------------
+void mapUnusedIO()
+{
+	pthread_mutex_lock(&bufferLock);
+
+	if (!snapshot_ready)
+	{
+		buildRegisterBindings();
+		publishRegisterSnapshot();
 	}
 
 	pthread_mutex_unlock(&bufferLock);
@@ -286,7 +548,6 @@ void ReadDiscreteInputs(unsigned char *buffer, int bufferSize)
 void ReadHoldingRegisters(unsigned char *buffer, int bufferSize)
 {
 	int Start, WordDataLength, ByteDataLength;
-	int mb_error = ERR_NONE;
 
 	//this request must have at least 12 bytes. If it doesn't, it's a corrupted message
 	if (bufferSize < 12)
@@ -299,126 +560,27 @@ void ReadHoldingRegisters(unsigned char *buffer, int bufferSize)
 	WordDataLength = word(buffer[10],buffer[11]);
 	ByteDataLength = WordDataLength * 2;
 
-	//asked for too many registers
-	if (ByteDataLength > 255)
+	//asked for too many registers, or for registers that don't exist
+	if (ByteDataLength > 255 || Start + WordDataLength > MAX_HOLD_REGS)
 	{
 		ModbusError(buffer, ERR_ILLEGAL_DATA_ADDRESS);
 		return;
 	}
 
+	//the located variables are not bound yet
+	if (!snapshot_ready)
+	{
+		ModbusError(buffer, ERR_SLAVE_DEVICE_BUSY);
+		return;
+	}
+
 	//preparing response
 	buffer[4] = highByte(ByteDataLength + 3);
 	buffer[5] = lowByte(ByteDataLength + 3); //Number of bytes after this one
 	buffer[8] = ByteDataLength;     //Number of bytes of data
 
-	pthread_mutex_lock(&bufferLock);
-	for(int i = 0; i < WordDataLength; i++)
-	{
-		int position = Start + i;
-		if (position <= MIN_16B_RANGE)
-		{
-			if (int_output[position] != NULL)
-			{
-				buffer[ 9 + i * 2] = highByte(*int_output[position]);
-				buffer[10 + i * 2] = lowByte(*int_output[position]);
-			}
-			else
-			{
-				buffer[ 9 + i * 2] = 0;
-				buffer[10 + i * 2] = 0;
-			}
-		}
-		//accessing memory
-		//16-bit registers
-		else if (position >= MIN_16B_RANGE && position <= MAX_16B_RANGE)
-		{
-			if (int_memory[position - MIN_16B_RANGE] != NULL)
-			{
-				buffer[ 9 + i * 2] = highByte(*int_memory[position - MIN_16B_RANGE]);
-				buffer[10 + i * 2] = lowByte(*int_memory[position - MIN_16B_RANGE]);
-			}
-			else
-			{
-				buffer[ 9 + i * 2] = 0;
-				buffer[10 + i * 2] = 0;
-			}
-		}
-		//32-bit registers
-		else if (position >= MIN_32B_RANGE && position <= MAX_32B_RANGE)
-		{
-			if (dint_memory[(position - MIN_32B_RANGE)/2] != NULL)
-			{
-				if ((position - MIN_32B_RANGE) % 2 == 0) //first word
-				{
-					uint16_t tempValue = (uint16_t)(*dint_memory[(position - MIN_32B_RANGE)/2] >> 16);
-					buffer[ 9 + i * 2] = highByte(tempValue);
-					buffer[10 + i * 2] = lowByte(tempValue);
-				}
-				else //second word
-				{
-					uint16_t tempValue = (uint16_t)(*dint_memory[(position - MIN_32B_RANGE)/2] & 0xffff);
-					buffer[ 9 + i * 2] = highByte(tempValue);
-					buffer[10 + i * 2] = lowByte(tempValue);
-				}
-			}
-			else
-			{
-				buffer[ 9 + i * 2] = mb_holding_regs[position];
-				buffer[10 + i * 2] = mb_holding_regs[position];
-			}
-		}
-		//64-bit registers
-		else if (position >= MIN_64B_RANGE && position <= MAX_64B_RANGE)
-		{
-			if (lint_memory[(position - MIN_64B_RANGE)/4] != NULL)
-			{
-				if ((position - MIN_64B_RANGE) % 4 == 0) //first word
-				{
-					uint16_t tempValue = (uint16_t)(*lint_memory[(position - MIN_64B_RANGE)/4] >> 48);
-					buffer[ 9 + i * 2] = highByte(tempValue);
-					buffer[10 + i * 2] = lowByte(tempValue);
-				}
-				else if ((position - MIN_64B_RANGE) % 4 == 1)//second word
-				{
-					uint16_t tempValue = (uint16_t)((*lint_memory[(position - MIN_64B_RANGE)/4] >> 32) & 0xffff);
-					buffer[ 9 + i * 2] = highByte(tempValue);
-					buffer[10 + i * 2] = lowByte(tempValue);
-				}
-				else if ((position - MIN_64B_RANGE) % 4 == 2)//third word
-				{
-					uint16_t tempValue = (uint16_t)((*lint_memory[(position - MIN_64B_RANGE)/4] >> 16) & 0xffff);
-					buffer[ 9 + i * 2] = highByte(tempValue);
-					buffer[10 + i * 2] = lowByte(tempValue);
-				}
-				else if ((position - MIN_64B_RANGE) % 4 == 3)//fourth word
-				{
-					uint16_t tempValue = (uint16_t)(*lint_memory[(position - MIN_64B_RANGE)/4] & 0xffff);
-					buffer[ 9 + i * 2] = highByte(tempValue);
-					buffer[10 + i * 2] = lowByte(tempValue);
-				}
-			}
-			else
-			{
-				buffer[ 9 + i * 2] = mb_holding_regs[position];
-				buffer[10 + i * 2] = mb_holding_regs[position];
-			}
-		}
-		//invalid address
-		else
-		{
-			mb_error = ERR_ILLEGAL_DATA_ADDRESS;
-		}
-	}
-	pthread_mutex_unlock(&bufferLock);
-
-	if (mb_error != ERR_NONE)
-	{
-		ModbusError(buffer, mb_error);
-	}
-	else
-	{
-		MessageLength = ByteDataLength + 9;
-	}
+	readRegisters(true, Start, WordDataLength, &buffer[9]);
+	MessageLength = ByteDataLength + 9;
 }
 
 //-----------------------------------------------------------------------------
@@ -427,7 +589,6 @@ void ReadHoldingRegisters(unsigned char *buffer, int bufferSize)
 void ReadInputRegisters(unsigned char *buffer, int bufferSize)
 {
 	int Start, WordDataLength, ByteDataLength;
-	int mb_error = ERR_NONE;
 
 	//this request must have at least 12 bytes. If it doesn't, it's a corrupted message
 	if (bufferSize < 12)
@@ -440,50 +601,27 @@ void ReadInputRegisters(unsigned char *buffer, int bufferSize)
 	WordDataLength = word(buffer[10],buffer[11]);
 	ByteDataLength = WordDataLength * 2;
 
-	//asked for too many registers
-	if (ByteDataLength > 255)
+	//asked for too many registers, or for registers that don't exist
+	if (ByteDataLength > 255 || Start + WordDataLength > MAX_INP_REGS)
 	{
 		ModbusError(buffer, ERR_ILLEGAL_DATA_ADDRESS);
 		return;
 	}
 
+	//the located variables are not bound yet
+	if (!snapshot_ready)
+	{
+		ModbusError(buffer, ERR_SLAVE_DEVICE_BUSY);
+		return;
+	}
+
 	//preparing response
 	buffer[4] = highByte(ByteDataLength + 3);
 	buffer[5] = lowByte(ByteDataLength + 3); //Number of bytes after this one
 	buffer[8] = ByteDataLength;     //Number of bytes of data
 
-	pthread_mutex_lock(&bufferLock);
-	for(int i = 0; i < WordDataLength; i++)
-	{
-		int position = Start + i;
-		if (position < MAX_INP_REGS)
-		{
-			if (int_input[position] != NULL)
-			{
-				buffer[ 9 + i * 2] = highByte(*int_input[position]);
-				buffer[10 + i * 2] = lowByte(*int_input[position]);
-			}
-			else
-			{
-				buffer[ 9 + i * 2] = 0;
-				buffer[10 + i * 2] = 0;
-			}
-		}
-		else //invalid address
-		{
-			mb_error = ERR_ILLEGAL_DATA_ADDRESS;
-		}
-	}
-	pthread_mutex_unlock(&bufferLock);
-
-	if (mb_error != ERR_NONE)
-	{
-		ModbusError(buffer, mb_error);
-	}
-	else
-	{
-		MessageLength = ByteDataLength + 9;
-	}
+	readRegisters(false, Start, WordDataLength, &buffer[9]);
+	MessageLength = ByteDataLength + 9;
 }
 
 //-----------------------------------------------------------------------------
@@ -521,6 +659,7 @@ void WriteCoil(unsigned char *buffer, int bufferSize)
 			*bool_output[Start/8][Start%8] = value;
 		}
 		pthread_mutex_unlock(&bufferLock);
+		notifyScanEvent();
 	}
 
 	else //invalid address
@@ -556,86 +695,7 @@ void WriteRegister(unsigned char *buffer, int bufferSize)
 	}
 
 	Start = word(buffer[8],buffer[9]);
-
-	pthread_mutex_lock(&bufferLock);
-	//analog outputs
-	if (Start <= MIN_16B_RANGE)
-	{
-		if (int_output[Start] != NULL)
-		{
-			*int_output[Start] = word(buffer[10],buffer[11]);
-		}
-	}
-	//accessing memory
-	//16-bit registers
-	else if (Start >= MIN_16B_RANGE && Start <= MAX_16B_RANGE)
-	{
-		if (int_memory[Start - MIN_16B_RANGE] != NULL)
-		{
-			*int_memory[Start - MIN_16B_RANGE] = word(buffer[10],buffer[11]);
-		}
-	}
-	//32-bit registers
-	else if (Start >= MIN_32B_RANGE && Start <= MAX_32B_RANGE)
-	{
-		if (dint_memory[(Start - MIN_32B_RANGE)/2] != NULL)
-		{
-			uint32_t tempValue = (uint32_t)word(buffer[10],buffer[11]);
-
-			if ((Start - MIN_32B_RANGE) % 2 == 0) //first word
-			{
-				*dint_memory[(Start - MIN_32B_RANGE) / 2] = *dint_memory[(Start - MIN_32B_RANGE) / 2] & 0x0000ffff;
-				*dint_memory[(Start - MIN_32B_RANGE) / 2] = *dint_memory[(Start - MIN_32B_RANGE) / 2] | (tempValue << 16);
-			}
-			else //second word
-			{
-				*dint_memory[(Start - MIN_32B_RANGE) / 2] = *dint_memory[(Start - MIN_32B_RANGE) / 2] & 0xffff0000;
-				*dint_memory[(Start - MIN_32B_RANGE) / 2] = *dint_memory[(Start - MIN_32B_RANGE) / 2] | tempValue;
-			}
-		}
-		else
-		{
-			mb_holding_regs[Start] = word(buffer[10],buffer[11]);
-		}
-	}
-	//64-bit registers
-	else if (Start >= MIN_64B_RANGE && Start <= MAX_64B_RANGE)
-	{
-		if (lint_memory[(Start - MIN_64B_RANGE)/4] != NULL)
-		{
-			uint64_t tempValue = (uint64_t)word(buffer[10],buffer[11]);
-
-			if ((Start - MIN_64B_RANGE) % 4 == 0) //first word
-			{
-				*lint_memory[(Start - MIN_64B_RANGE) / 4] = *lint_memory[(Start - MIN_64B_RANGE) / 4] & 0x0000ffffffffffff;
-				*lint_memory[(Start - MIN_64B_RANGE) / 4] = *lint_memory[(Start - MIN_64B_RANGE) / 4] | (tempValue << 48);
-			}
-			else if ((Start - MIN_64B_RANGE) % 4 == 1) //second word
-			{
-				*lint_memory[(Start - MIN_64B_RANGE) / 4] = *lint_memory[(Start - MIN_64B_RANGE) / 4] & 0xffff0000ffffffff;
-				*lint_memory[(Start - MIN_64B_RANGE) / 4] = *lint_memory[(Start - MIN_64B_RANGE) / 4] | (tempValue << 32);
-			}
-			else if ((Start - MIN_64B_RANGE) % 4 == 2) //third word
-			{
-				*lint_memory[(Start - MIN_64B_RANGE) / 4] = *lint_memory[(Start - MIN_64B_RANGE) / 4] & 0xffffffff0000ffff;
-				*lint_memory[(Start - MIN_64B_RANGE) / 4] = *lint_memory[(Start - MIN_64B_RANGE) / 4] | (tempValue << 16);
-			}
-			else if ((Start - MIN_64B_RANGE) % 4 == 3) //fourth word
-			{
-				*lint_memory[(Start - MIN_64B_RANGE) / 4] = *lint_memory[(Start - MIN_64B_RANGE) / 4] & 0xffffffffffff0000;
-				*lint_memory[(Start - MIN_64B_RANGE) / 4] = *lint_memory[(Start - MIN_64B_RANGE) / 4] | tempValue;
-			}
-		}
-		else
-		{
-			mb_holding_regs[Start] = word(buffer[10],buffer[11]);
-		}
-	}
-	else //invalid address
-	{
-		mb_error = ERR_ILLEGAL_DATA_ADDRESS;
-	}
-	pthread_mutex_unlock(&bufferLock);
+	mb_error = writeRegisters(Start, 1, &buffer[10]);
 
 	if (mb_error != ERR_NONE)
 	{
@@ -697,6 +757,7 @@ void WriteMultipleCoils(unsigned char *buffer, int bufferSize)
 		}
 	}
 	pthread_mutex_unlock(&bufferLock);
+	notifyScanEvent();
 
 	if (mb_error != ERR_NONE)
 	{
@@ -738,83 +799,7 @@ void WriteMultipleRegisters(unsigned char *buffer, int bufferSize)
 	buffer[4] = 0;
 	buffer[5] = 6; //Number of bytes after this one.
 
-	pthread_mutex_lock(&bufferLock);
-	for(int i = 0; i < WordDataLength; i++)
-	{
-		int position = Start + i;
-		//analog outputs
-		if (position <= MIN_16B_RANGE)
-		{
-			if (int_output[position] != NULL) *int_output[position] =  word(buffer[13 + i * 2], buffer[14 + i * 2]);
-		}
-		//accessing memory
-		//16-bit registers
-		else if (position >= MIN_16B_RANGE && position <= MAX_16B_RANGE)
-		{
-			if (int_memory[position - MIN_16B_RANGE] != NULL) *int_memory[position - MIN_16B_RANGE] = word(buffer[13 + i * 2], buffer[14 + i * 2]);
-		}
-		//32-bit registers
-		else if (position >= MIN_32B_RANGE && position <= MAX_32B_RANGE)
-		{
-			if (dint_memory[(Start - MIN_32B_RANGE)/2] != NULL)
-			{
-				uint32_t tempValue = (uint32_t)word(buffer[13 + i * 2], buffer[14 + i * 2]);
-
-				if ((position - MIN_32B_RANGE) % 2 == 0) //first word
-				{
-					*dint_memory[(position - MIN_32B_RANGE) / 2] = *dint_memory[(position - MIN_32B_RANGE) / 2] & 0x0000ffff;
-					*dint_memory[(position - MIN_32B_RANGE) / 2] = *dint_memory[(position - MIN_32B_RANGE) / 2] | (tempValue << 16);
-				}
-				else //second word
-				{
-					*dint_memory[(position - MIN_32B_RANGE) / 2] = *dint_memory[(position - MIN_32B_RANGE) / 2] & 0xffff0000;
-					*dint_memory[(position - MIN_32B_RANGE) / 2] = *dint_memory[(position - MIN_32B_RANGE) / 2] | tempValue;
-				}
-			}
-			else
-			{
-				mb_holding_regs[position] = word(buffer[13 + i * 2], buffer[14 + i * 2]);
-			}
-		}
-		//64-bit registers
-		else if (position >= MIN_64B_RANGE && position <= MAX_64B_RANGE)
-		{
-			if (lint_memory[(position - MIN_64B_RANGE)/4] != NULL)
-			{
-				uint64_t tempValue = (uint64_t)word(buffer[13 + i * 2], buffer[14 + i * 2]);
-
-				if ((position - MIN_64B_RANGE) % 4 == 0) //first word
-				{
-					*lint_memory[(position - MIN_64B_RANGE) / 4] = *lint_memory[(position - MIN_64B_RANGE) / 4] & 0x0000ffffffffffff;
-					*lint_memory[(position - MIN_64B_RANGE) / 4] = *lint_memory[(position - MIN_64B_RANGE) / 4] | (tempValue << 48);
-				}
-				else if ((Start - MIN_64B_RANGE) % 4 == 1) //second word
-				{
-					*lint_memory[(position - MIN_64B_RANGE) / 4] = *lint_memory[(position - MIN_64B_RANGE) / 4] & 0xffff0000ffffffff;
-					*lint_memory[(position - MIN_64B_RANGE) / 4] = *lint_memory[(position - MIN_64B_RANGE) / 4] | (tempValue << 32);
-				}
-				else if ((Start - MIN_64B_RANGE) % 4 == 2) //third word
-				{
-					*lint_memory[(position - MIN_64B_RANGE) / 4] = *lint_memory[(position - MIN_64B_RANGE) / 4] & 0xffffffff0000ffff;
-					*lint_memory[(position - MIN_64B_RANGE) / 4] = *lint_memory[(position - MIN_64B_RANGE) / 4] | (tempValue << 16);
-				}
-				else if ((Start - MIN_64B_RANGE) % 4 == 3) //fourth word
-				{
-					*lint_memory[(position - MIN_64B_RANGE) / 4] = *lint_memory[(position - MIN_64B_RANGE) / 4] & 0xffffffffffff0000;
-					*lint_memory[(position - MIN_64B_RANGE) / 4] = *lint_memory[(position - MIN_64B_RANGE) / 4] | tempValue;
-				}
-			}
-			else
-			{
-				mb_holding_regs[Start] = word(buffer[10],buffer[11]);
-			}
-		}
-		else //invalid address
-		{
-			mb_error = ERR_ILLEGAL_DATA_ADDRESS;
-		}
-	}
-	pthread_mutex_unlock(&bufferLock);
+	mb_error = writeRegisters(Start, WordDataLength, &buffer[13]);
 
 	if (mb_error != ERR_NONE)
 	{
@@ -38,10 +38,7 @@
 #include <string>
 
 #include "ladder.h"
-
-#define MB_TCP                1
-#define MB_RTU                2
-#define MAX_MB_IO            400
+#include "config_image.h"
 
 using namespace std;
 
@@ -51,6 +48,7 @@ uint16_t int_input_buf[MAX_MB_IO];
 uint16_t int_output_buf[MAX_MB_IO];
 
 pthread_mutex_t ioLock;
+bool mb_inputs_dirty = true; //set when the polling thread receives new input data
 
 struct MB_address
 {
@@ -149,7 +147,49 @@ void getFunction(char *line, char *parameter)
     }
 }
 
-void parseConfig()
+//-----------------------------------------------------------------------------
+// Copies the slave devices from the configuration image. The image has been
+// validated already, so there is nothing left to parse
+//-----------------------------------------------------------------------------
+void loadImageConfig(const struct config_image_header *image)
+{
+    const struct config_image_device *devices = configImageDevices(image);
+
+    num_devices = image->device_count;
+    polling_period = image->polling_period;
+    timeout = image->timeout;
+    mb_devices = (struct MB_device *)calloc(num_devices, sizeof(struct MB_device));
+
+    for (int i = 0; i < num_devices; i++)
+    {
+        strcpy(mb_devices[i].dev_name, devices[i].name);
+        strcpy(mb_devices[i].dev_address, devices[i].address);
+        mb_devices[i].protocol = devices[i].protocol;
+        mb_devices[i].dev_id = devices[i].slave_id;
+        mb_devices[i].ip_port = devices[i].ip_port;
+        mb_devices[i].rtu_baud = devices[i].rtu_baud;
+        mb_devices[i].rtu_parity = devices[i].rtu_parity;
+        mb_devices[i].rtu_data_bit = devices[i].rtu_data_bits;
+        mb_devices[i].rtu_stop_bit = devices[i].rtu_stop_bits;
+        mb_devices[i].rtu_tx_pause = devices[i].rtu_tx_pause;
+        mb_devices[i].discrete_inputs.start_address = devices[i].discrete_inputs.start;
+        mb_devices[i].discrete_inputs.num_regs = devices[i].discrete_inputs.size;
+        mb_devices[i].coils.start_address = devices[i].coils.start;
+        mb_devices[i].coils.num_regs = devices[i].coils.size;
+        mb_devices[i].input_registers.start_address = devices[i].input_registers.start;
+        mb_devices[i].input_registers.num_regs = devices[i].input_registers.size;
+        mb_devices[i].holding_read_registers.start_address = devices[i].holding_read_registers.start;
+        mb_devices[i].holding_read_registers.num_regs = devices[i].holding_read_registers.size;
+        mb_devices[i].holding_registers.start_address = devices[i].holding_registers.start;
+        mb_devices[i].holding_registers.num_regs = devices[i].holding_registers.size;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Parses the slave devices from mbconfig.cfg. Only used when there is no
+// valid configuration image
+//-----------------------------------------------------------------------------
+void parseTextConfig()
 {
     string line;
     char line_str[1024];
@@ -319,6 +359,15 @@ void parseConfig()
         sprintf(log_msg, "Skipping configuration of Slave Devices (mbconfig.cfg file not found)\n");
         log(log_msg);
     }
+}
+
+void parseConfig()
+{
+    const struct config_image_header *image = loadConfigImage();
+    if (image != NULL)
+        loadImageConfig(image);
+    else
+        parseTextConfig();
 
     //Parser Debug
     ///*
@@ -352,6 +401,8 @@ void parseConfig()
 //-----------------------------------------------------------------------------
 void *querySlaveDevices(void *arg)
 {
+    applyThreadProfile(THREAD_MODBUS_MASTER);
+
     while (run_openplc)
     {
         unsigned char log_msg[1000];
@@ -397,7 +448,7 @@ void *querySlaveDevices(void *arg)
                     sprintf(log_msg, "Connection failed on MB device %s: %s\n", mb_devices[i].dev_name, modbus_strerror(errno));
                     log(log_msg);
                     
-                    if (special_functions[2] != NULL) *special_functions[2]++;
+                    if (special_functions[2] != NULL) (*special_functions[2])++;
                     
                     // Because this device is not connected, we skip those input registers
                     bool_input_index += (mb_devices[i].discrete_inputs.num_regs);
@@ -447,17 +498,21 @@ void *querySlaveDevices(void *arg)
                         sprintf(log_msg, "Modbus Read Discrete Input Registers failed on MB device %s: %s\n", mb_devices[i].dev_name, modbus_strerror(errno));
                         log(log_msg);
                         bool_input_index += (mb_devices[i].discrete_inputs.num_regs);
-                        if (special_functions[2] != NULL) *special_functions[2]++;
+                        if (special_functions[2] != NULL) (*special_functions[2])++;
                     }
                     else
                     {
+                        bool changed = false;
                         pthread_mutex_lock(&ioLock);
                         for (int j = 0; j < return_val; j++)
                         {
+                            if (bool_input_buf[bool_input_index] != tempBuff[j]) changed = true;
                             bool_input_buf[bool_input_index] = tempBuff[j];
                             bool_input_index++;
                         }
+                        __atomic_store_n(&mb_inputs_dirty, true, __ATOMIC_RELEASE);
                         pthread_mutex_unlock(&ioLock);
+                        if (changed) notifyScanEvent();
                     }
 
                     free(tempBuff);
@@ -490,7 +545,7 @@ void *querySlaveDevices(void *arg)
 
                         sprintf(log_msg, "Modbus Write Coils failed on MB device %s: %s\n", mb_devices[i].dev_name, modbus_strerror(errno));
                         log(log_msg);
-                        if (special_functions[2] != NULL) *special_functions[2]++;
+                        if (special_functions[2] != NULL) (*special_functions[2])++;
                     }
                     
                     free(tempBuff);
@@ -516,17 +571,21 @@ void *querySlaveDevices(void *arg)
                         sprintf(log_msg, "Modbus Read Input Registers failed on MB device %s: %s\n", mb_devices[i].dev_name, modbus_strerror(errno));
                         log(log_msg);
                         int_input_index += (mb_devices[i].input_registers.num_regs);
-                        if (special_functions[2] != NULL) *special_functions[2]++;
+                        if (special_functions[2] != NULL) (*special_functions[2])++;
                     }
                     else
                     {
+                        bool changed = false;
                         pthread_mutex_lock(&ioLock);
                         for (int j = 0; j < return_val; j++)
                         {
+                            if (int_input_buf[int_input_index] != tempBuff[j]) changed = true;
                             int_input_buf[int_input_index] = tempBuff[j];
                             int_input_index++;
                         }
+                        __atomic_store_n(&mb_inputs_dirty, true, __ATOMIC_RELEASE);
                         pthread_mutex_unlock(&ioLock);
+                        if (changed) notifyScanEvent();
                     }
 
                     free(tempBuff);
@@ -551,17 +610,21 @@ void *querySlaveDevices(void *arg)
                         sprintf(log_msg, "Modbus Read Holding Registers failed on MB device %s: %s\n", mb_devices[i].dev_name, modbus_strerror(errno));
                         log(log_msg);
                         int_input_index += (mb_devices[i].holding_read_registers.num_regs);
-                        if (special_functions[2] != NULL) *special_functions[2]++;
+                        if (special_functions[2] != NULL) (*special_functions[2])++;
                     }
                     else
                     {
+                        bool changed = false;
                         pthread_mutex_lock(&ioLock);
                         for (int j = 0; j < return_val; j++)
                         {
+                            if (int_input_buf[int_input_index] != tempBuff[j]) changed = true;
                             int_input_buf[int_input_index] = tempBuff[j];
                             int_input_index++;
                         }
+                        __atomic_store_n(&mb_inputs_dirty, true, __ATOMIC_RELEASE);
                         pthread_mutex_unlock(&ioLock);
+                        if (changed) notifyScanEvent();
                     }
 
                     free(tempBuff);
@@ -595,7 +658,7 @@ void *querySlaveDevices(void *arg)
                         
                         sprintf(log_msg, "Modbus Write Holding Registers failed on MB device %s: %s\n", mb_devices[i].dev_name, modbus_strerror(errno));
                         log(log_msg);
-                        if (special_functions[2] != NULL) *special_functions[2]++;
+                        if (special_functions[2] != NULL) (*special_functions[2])++;
                     }
                     
                     free(tempBuff);
@@ -669,7 +732,7 @@ void initializeMB()
     if (num_devices > 0)
     {
         pthread_t thread;
-        int ret = pthread_create(&thread, NULL, querySlaveDevices, NULL);
+        int ret = createRuntimeThread(&thread, querySlaveDevices, NULL, THREAD_MODBUS_MASTER);
         if (ret==0) 
         {
             pthread_detach(thread);
@@ -677,6 +740,23 @@ void initializeMB()
     }
 }
 
+//-----------------------------------------------------------------------------
+// Scan pipeline hint. The input image only needs to be refreshed when the
+// polling thread received new data from a slave device
+//-----------------------------------------------------------------------------
+bool hasWorkIn_MB()
+{
+    return (num_devices > 0 && __atomic_load_n(&mb_inputs_dirty, __ATOMIC_ACQUIRE));
+}
+
+//-----------------------------------------------------------------------------
+// Scan pipeline hint. Outputs are only copied when slave devices are configured
+//-----------------------------------------------------------------------------
+bool hasWorkOut_MB()
+{
+    return (num_devices > 0);
+}
+
 //-----------------------------------------------------------------------------
 // This function is called by the OpenPLC in a loop. Here the internal buffers
 // must be updated to reflect the actual Input state.
@@ -684,6 +764,7 @@ void initializeMB()
 void updateBuffersIn_MB()
 {
     pthread_mutex_lock(&ioLock);
+    __atomic_exchange_n(&mb_inputs_dirty, false, __ATOMIC_ACQ_REL);
 
     for (int i = 0; i < MAX_MB_IO; i++)
     {
@@ -0,0 +1,203 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 OpenPLC Project
+// This file is part of the OpenPLC Software Stack.
+//
+// OpenPLC is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenPLC is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with OpenPLC.  If not, see <http://www.gnu.org/licenses/>.
+//------
+//
+// Worker pool for programs compiled with iec2c -O j. The generated resource
+// run function hands each wave of independent programs to
+// __run_program_jobs() (see parallel_programs.h). The scan thread and the
+// workers take jobs from the wave until none is left, and the scan thread
+// waits for the last one to finish before the next wave starts. The workers
+// spin for a short while after each wave so back to back waves do not pay
+// for a wake-up, then sleep until the next one.
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "ladder.h"
+#include "parallel_programs.h"
+
+#define MAX_PROGRAM_WORKERS     16
+#define WORKER_SPIN_LOOPS       20000
+
+//number of worker threads besides the scan thread. 0 runs every program in the scan thread
+int program_workers = 0;
+
+static int running_workers = 0;
+
+//The current wave is published in wave_state: the generation of the wave in
+//the upper 32 bits and the index of the next job to take in the lower 32.
+//Jobs are taken with a compare and swap on the whole word, so a worker that
+//wakes up late for a wave that is already over can never take a job from
+//the next one. The jobs of the wave are in waves[generation % 2]
+struct program_wave
+{
+    const __program_job_t *jobs;
+    int count;
+};
+
+static struct program_wave waves[2];
+static unsigned long long wave_state = 0;
+static int pending_jobs = 0;
+
+static int sleeping_workers = 0;
+static pthread_mutex_t wave_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t wave_ready = PTHREAD_COND_INITIALIZER;
+
+//-----------------------------------------------------------------------------
+// Helper function - Takes the next job of wave generation. Returns NULL when
+// the wave has no jobs left or is over
+//-----------------------------------------------------------------------------
+static __program_job_t takeJob(unsigned int generation)
+{
+    unsigned long long state = __atomic_load_n(&wave_state, __ATOMIC_ACQUIRE);
+    while ((unsigned int)(state >> 32) == generation)
+    {
+        struct program_wave *wave = &waves[generation % 2];
+        const __program_job_t *jobs = __atomic_load_n(&wave->jobs, __ATOMIC_RELAXED);
+        unsigned int job = (unsigned int)state;
+        if (job >= (unsigned int)__atomic_load_n(&wave->count, __ATOMIC_RELAXED)) return NULL;
+
+        //the wave can only have been replaced if wave_state changed too
+        if (__atomic_compare_exchange_n(&wave_state, &state, state + 1, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+            return jobs[job];
+    }
+    return NULL;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Runs jobs of a wave until there are none left
+//-----------------------------------------------------------------------------
+static void runWaveJobs(unsigned int generation)
+{
+    __program_job_t job;
+    while ((job = takeJob(generation)) != NULL)
+    {
+        job();
+        __atomic_fetch_sub(&pending_jobs, 1, __ATOMIC_RELEASE);
+    }
+}
+
+static unsigned int currentGeneration()
+{
+    return (unsigned int)(__atomic_load_n(&wave_state, __ATOMIC_SEQ_CST) >> 32);
+}
+
+//-----------------------------------------------------------------------------
+// Worker thread. Waits for a new wave, helps running it and starts over
+//-----------------------------------------------------------------------------
+static void *programWorker(void *arg)
+{
+    int worker = (int)(long)arg;
+    applyWorkerProfile(worker);
+
+    unsigned int seen = currentGeneration();
+    while (true)
+    {
+        int spins = 0;
+        while (currentGeneration() == seen && spins < WORKER_SPIN_LOOPS)
+        {
+            spins++;
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#endif
+        }
+
+        if (currentGeneration() == seen)
+        {
+            pthread_mutex_lock(&wave_lock);
+            __atomic_fetch_add(&sleeping_workers, 1, __ATOMIC_SEQ_CST);
+            while (currentGeneration() == seen)
+            {
+                pthread_cond_wait(&wave_ready, &wave_lock);
+            }
+            __atomic_fetch_sub(&sleeping_workers, 1, __ATOMIC_SEQ_CST);
+            pthread_mutex_unlock(&wave_lock);
+        }
+
+        seen = currentGeneration();
+        runWaveJobs(seen);
+    }
+
+    return NULL;
+}
+
+//-----------------------------------------------------------------------------
+// Starts the worker threads. Must be called from the scan thread after its
+// profile has been applied
+//-----------------------------------------------------------------------------
+void startProgramWorkers()
+{
+    unsigned char log_msg[1000];
+
+    if (program_workers > MAX_PROGRAM_WORKERS) program_workers = MAX_PROGRAM_WORKERS;
+    for (int i = 0; i < program_workers; i++)
+    {
+        pthread_t thread;
+        if (createRuntimeThread(&thread, programWorker, (void *)(long)i, THREAD_WORKER))
+        {
+            sprintf(log_msg, "WARNING: Failed to start program worker %d\n", i);
+            log(log_msg);
+            break;
+        }
+        pthread_detach(thread);
+        running_workers++;
+    }
+
+    if (running_workers > 0)
+    {
+        sprintf(log_msg, "Started %d program worker thread(s)\n", running_workers);
+        log(log_msg);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Called by the generated resource run function for every wave with more
+// than one program. Returns once all jobs are done
+//-----------------------------------------------------------------------------
+void __run_program_jobs(const __program_job_t *jobs, int count)
+{
+    if (running_workers == 0)
+    {
+        for (int i = 0; i < count; i++) jobs[i]();
+        return;
+    }
+
+    unsigned int generation = currentGeneration() + 1;
+    struct program_wave *wave = &waves[generation % 2];
+    __atomic_store_n(&wave->jobs, jobs, __ATOMIC_RELAXED);
+    __atomic_store_n(&wave->count, count, __ATOMIC_RELAXED);
+    __atomic_store_n(&pending_jobs, count, __ATOMIC_RELAXED);
+    __atomic_store_n(&wave_state, (unsigned long long)generation << 32, __ATOMIC_SEQ_CST);
+
+    if (__atomic_load_n(&sleeping_workers, __ATOMIC_SEQ_CST) > 0)
+    {
+        pthread_mutex_lock(&wave_lock);
+        pthread_cond_broadcast(&wave_ready);
+        pthread_mutex_unlock(&wave_lock);
+    }
+
+    runWaveJobs(generation);
+
+    //barrier. Yield now and then in case a worker shares the scan core
+    int spins = 0;
+    while (__atomic_load_n(&pending_jobs, __ATOMIC_ACQUIRE) > 0)
+    {
+        if (++spins % 1000 == 0) sched_yield();
+    }
+}
@@ -574,6 +574,7 @@ void Pccc_WriteRegister(unsigned char *buffer, int buffer_size) // QW Write
 		}
 	
 	pthread_mutex_unlock(&bufferLock);
+	notifyScanEvent();
 
 	}
 }
\ No newline at end of file
@@ -1,161 +1,421 @@
-//-----------------------------------------------------------------------------
-// Copyright 2019 Thiago Alves
-// This file is part of the OpenPLC Software Stack.
-//
-// OpenPLC is free software: you can redistribute it and/or modify
-// it under the terms of the GNU General Public License as published by
-// the Free Software Foundation, either version 3 of the License, or
-// (at your option) any later version.
-//
-// OpenPLC is distributed in the hope that it will be useful,
-// but WITHOUT ANY WARRANTY; without even the implied warranty of
-// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-// GNU General Public License for more details.
-//
-// You should have received a copy of the GNU General Public License
-// along with OpenPLC.  If not, see <http://www.gnu.org/licenses/>.
-//------
-//
-// This file is responsible for the persistent storage on the OpenPLC
-// Thiago Alves, Jun 2019
-//-----------------------------------------------------------------------------
-
-#include <stdio.h>
-#include <unistd.h>
-#include <time.h>
-#include <pthread.h>
-
-#include "ladder.h"
-
-uint8_t pstorage_read = false;
-
-//-----------------------------------------------------------------------------
-// Main function for the thread. Should create a buffer for the persistent
-// data, compare it with the actual data and write back to the persistent
-// file if the data has changed
-//-----------------------------------------------------------------------------
-void startPstorage()
-{
-    //We can only start persistent storage after the persistent.file was read
-    while (pstorage_read == false)
-        sleepms(100);
-    
-    unsigned char log_msg[1000];
-    IEC_UINT persistentBuffer[BUFFER_SIZE];
-
-    //Read initial buffers into persistent struct
-    pthread_mutex_lock(&bufferLock); //lock mutex
-    for (int i = 0; i < BUFFER_SIZE; i++)
-    {
-        if (int_memory[i] != NULL) persistentBuffer[i] = *int_memory[i];
-    }
-    pthread_mutex_unlock(&bufferLock); //unlock mutex
-    
-    //Perform the first write
-    if (access("persistent.file", F_OK) == -1) 
-    {
-        sprintf(log_msg, "Creating Persistent Storage file\n");
-        log(log_msg);
-    }
-    
-    FILE *ps = fopen("persistent.file", "w"); //if file already exists, it will be overwritten
-    if (ps == NULL)
-    {
-        sprintf(log_msg, "Persistent Storage: Error creating persistent memory file!\n");
-        log(log_msg);
-        return 0;
-    }
-
-    if (fwrite(persistentBuffer, sizeof(IEC_INT), BUFFER_SIZE, ps) < BUFFER_SIZE)
-    {
-        sprintf(log_msg, "Persistent Storage: Error writing to persistent memory file!\n");
-        log(log_msg);
-        return 0;
-    }
-    fclose(ps);
-    
-    //Run the main thread
-    while (run_pstorage)
-    {
-        
-        //Verify if persistent buffer is outdated
-        bool bufferOutdated = false;
-        pthread_mutex_lock(&bufferLock); //lock mutex
-        for (int i = 0; i < BUFFER_SIZE; i++)
-        {
-            if (int_memory[i] != NULL)
-            {
-                if (persistentBuffer[i] != *int_memory[i])
-                {
-                    persistentBuffer[i] = *int_memory[i];
-                    bufferOutdated = true;
-                }
-            }
-        }
-        pthread_mutex_unlock(&bufferLock); //unlock mutex
-
-        //If buffer is outdated, write the changes back to the file
-        if (bufferOutdated)
-        {
-            FILE *fd = fopen("persistent.file", "w"); //if file already exists, it will be overwritten
-            if (fd == NULL)
-            {
-                sprintf(log_msg, "Persistent Storage: Error creating persistent memory file!\n");
-                log(log_msg);
-                return 0;
-            }
-
-            if (fwrite(persistentBuffer, sizeof(IEC_INT), BUFFER_SIZE, fd) < BUFFER_SIZE)
-            {
-                sprintf(log_msg, "Persistent Storage: Error writing to persistent memory file!\n");
-                log(log_msg);
-                return 0;
-            }
-            fclose(fd);
-        }
-
-        sleepms(pstorage_polling*1000);
-    }
-}
-
-//-----------------------------------------------------------------------------
-// This function reads the contents from persistent.file into OpenPLC internal
-// buffers. Must be called when OpenPLC is initializing. If persistent storage
-// is disabled, the persistent.file will not be found and the function will
-// exit gracefully.
-//-----------------------------------------------------------------------------
-int readPersistentStorage()
-{
-    unsigned char log_msg[1000];
-    FILE *fd = fopen("persistent.file", "r");
-    if (fd == NULL)
-    {
-        sprintf(log_msg, "Warning: Persistent Storage file not found\n");
-        log(log_msg);
-        pstorage_read = true;
-        return 0;
-    }
-
-    IEC_INT persistentBuffer[BUFFER_SIZE];
-
-    if (fread(persistentBuffer, sizeof(IEC_INT), BUFFER_SIZE, fd) < BUFFER_SIZE)
-    {
-        sprintf(log_msg, "Persistent Storage: Error while trying to read persistent.file!\n");
-        log(log_msg);
-        pstorage_read = true;
-        return 0;
-    }
-    fclose(fd);
-    
-    sprintf(log_msg, "Persistent Storage: Reading persistent.file into local buffers\n");
-    log(log_msg);
-    
-    pthread_mutex_lock(&bufferLock); //lock mutex
-    for (int i = 0; i < BUFFER_SIZE; i++)
-    {
-        if (int_memory[i] != NULL) *int_memory[i] = persistentBuffer[i];
-    }
-    pthread_mutex_unlock(&bufferLock); //unlock mutex
-    
-    pstorage_read = true;
-}
+//-----------------------------------------------------------------------------
+// Copyright 2019 Thiago Alves
+// This file is part of the OpenPLC Software Stack.
+//
+// OpenPLC is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenPLC is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with OpenPLC.  If not, see <http://www.gnu.org/licenses/>.
+//------
+//
+// This file is responsible for the persistent storage on the OpenPLC
+// Thiago Alves, Jun 2019
+//
+// The scan thread never touches the file. Once per polling period the
+// storage thread asks for a capture, and the "pstorage" scan stage compares
+// the %MW words with the values it captured last time. It hands the words
+// that changed over through a dirty bitmap, set with atomic operations, so
+// neither side ever waits for the other. The storage thread collects the
+// dirty words and writes only those that differ from the file, merged into
+// runs. It then calls fdatasync() within the durability budget set by
+// pstorage_sync_ms. Changes keep piling up in the bitmap while the thread
+// waits for a slow storage device, and they are written together later.
+// The bytes written every day are counted for flash wear. Above
+// pstorage_daily_kb the writes are spaced out to one per
+// PSTORAGE_THROTTLED_INTERVAL seconds.
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "ladder.h"
+
+#define PSTORAGE_FILE                   "persistent.file"
+#define PSTORAGE_TEMP_FILE              "persistent.file.tmp"
+#define PSTORAGE_DIRTY_WORDS            (BUFFER_SIZE / 64)
+#define PSTORAGE_MERGE_GAP              16      //words of unchanged data worth rewriting to save a write
+#define PSTORAGE_MIN_INTERVAL_MS        100
+#define PSTORAGE_THROTTLED_INTERVAL     60      //seconds between writes over the daily budget
+
+uint8_t pstorage_read = false;
+
+//durability budget and wear budget (configured in runtime.cfg)
+int pstorage_sync_ms = 1000;
+int pstorage_daily_kb = 0;
+
+//handoff from the scan thread. capture_requested is set by the storage
+//thread and cleared by the scan. pending_values and dirty_bits are written
+//by the scan; the storage thread takes the dirty bits and then reads the
+//values they point to
+static bool capture_requested = false;
+static bool capture_all = true;
+static IEC_UINT pending_values[BUFFER_SIZE];
+static uint64_t dirty_bits[PSTORAGE_DIRTY_WORDS];
+
+//values seen by the last capture. Owned by the scan thread
+static IEC_UINT scan_shadow[BUFFER_SIZE];
+
+//contents of the file. Owned by the storage thread
+static IEC_UINT file_image[BUFFER_SIZE];
+
+//only one storage thread at a time, even if start_pstorage() comes in while
+//the previous one is still flushing
+static bool writer_active = false;
+
+//wear and durability counters
+static unsigned long long bytes_today = 0;
+static unsigned long long bytes_total = 0;
+static unsigned long long write_count = 0;
+static unsigned long long sync_count = 0;
+static long current_day = 0;
+static bool throttled = false;
+
+//-----------------------------------------------------------------------------
+// Helper function - Returns a monotonic time stamp in milliseconds
+//-----------------------------------------------------------------------------
+static unsigned long long monotonicMs()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned long long)now.tv_sec * 1000ULL + now.tv_nsec / 1000000;
+}
+
+//-----------------------------------------------------------------------------
+// Scan stage. Returns true when the storage thread is waiting for a capture
+//-----------------------------------------------------------------------------
+bool pstorageCaptureDue()
+{
+    return __atomic_load_n(&capture_requested, __ATOMIC_ACQUIRE);
+}
+
+//-----------------------------------------------------------------------------
+// Scan stage. Hands the %MW words that changed since the last capture over to
+// the storage thread. Runs with bufferLock held, and never waits
+//-----------------------------------------------------------------------------
+void capturePstorage()
+{
+    for (int block = 0; block < PSTORAGE_DIRTY_WORDS; block++)
+    {
+        uint64_t changed = 0;
+        for (int bit = 0; bit < 64; bit++)
+        {
+            int i = block * 64 + bit;
+            if (int_memory[i] == NULL) continue;
+
+            IEC_UINT value = *int_memory[i];
+            if (!capture_all && value == scan_shadow[i]) continue;
+            scan_shadow[i] = value;
+            __atomic_store_n(&pending_values[i], value, __ATOMIC_RELAXED);
+            changed |= 1ULL << bit;
+        }
+        if (changed) __atomic_fetch_or(&dirty_bits[block], changed, __ATOMIC_RELEASE);
+    }
+
+    capture_all = false;
+    __atomic_store_n(&capture_requested, false, __ATOMIC_RELEASE);
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Takes the words handed over by the scan and keeps those
+// that differ from the file. Returns the number of words to write
+//-----------------------------------------------------------------------------
+static int collectDirtyWords(bool *changed)
+{
+    int count = 0;
+    for (int block = 0; block < PSTORAGE_DIRTY_WORDS; block++)
+    {
+        uint64_t bits = __atomic_exchange_n(&dirty_bits[block], 0, __ATOMIC_ACQUIRE);
+        while (bits)
+        {
+            int i = block * 64 + __builtin_ctzll(bits);
+            bits &= bits - 1;
+
+            IEC_UINT value = __atomic_load_n(&pending_values[i], __ATOMIC_RELAXED);
+            if (value == file_image[i]) continue;
+            file_image[i] = value;
+            changed[i] = true;
+            count++;
+        }
+    }
+    return count;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Adds bytes written to the wear counters, starting a new
+// day when the date changes
+//-----------------------------------------------------------------------------
+static void countWrite(unsigned long long bytes)
+{
+    unsigned char log_msg[1000];
+    long today = time(NULL) / 86400;
+
+    if (today != current_day)
+    {
+        current_day = today;
+        bytes_today = 0;
+        throttled = false;
+    }
+
+    bytes_today += bytes;
+    bytes_total += bytes;
+    write_count++;
+
+    if (!throttled && pstorage_daily_kb > 0 && bytes_today > (unsigned long long)pstorage_daily_kb * 1024)
+    {
+        throttled = true;
+        sprintf(log_msg, "Persistent Storage: %llu KB written today, over the budget of %d KB. Writing once every %d seconds until tomorrow\n",
+                bytes_today / 1024, pstorage_daily_kb, PSTORAGE_THROTTLED_INTERVAL);
+        log(log_msg);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Writes the changed words to the file in runs. Runs that
+// are a few words apart are merged, since rewriting a little unchanged data
+// costs the flash less than another write. Returns false on error
+//-----------------------------------------------------------------------------
+static bool writeDirtyRuns(int fd, bool *changed)
+{
+    int i = 0;
+    while (i < BUFFER_SIZE)
+    {
+        if (!changed[i])
+        {
+            i++;
+            continue;
+        }
+
+        int first = i, last = i;
+        for (int j = i + 1; j < BUFFER_SIZE && j <= last + PSTORAGE_MERGE_GAP; j++)
+        {
+            if (changed[j]) last = j;
+        }
+
+        size_t size = (last - first + 1) * sizeof(IEC_UINT);
+        if (pwrite(fd, &file_image[first], size, first * sizeof(IEC_UINT)) != (ssize_t)size) return false;
+        countWrite(size);
+
+        for (int j = first; j <= last; j++) changed[j] = false;
+        i = last + 1;
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Replaces the file with the whole image. The new file is
+// synced before it takes the place of the old one, so a power loss leaves
+// either of them intact. Returns the descriptor of the new file, or -1
+//-----------------------------------------------------------------------------
+static int createStorageFile()
+{
+    int fd = open(PSTORAGE_TEMP_FILE, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return -1;
+
+    size_t size = sizeof(file_image);
+    if (write(fd, file_image, size) != (ssize_t)size || fdatasync(fd) != 0 || rename(PSTORAGE_TEMP_FILE, PSTORAGE_FILE) != 0)
+    {
+        close(fd);
+        unlink(PSTORAGE_TEMP_FILE);
+        return -1;
+    }
+    countWrite(size);
+    sync_count++;
+
+    //make the rename itself durable
+    int dir = open(".", O_RDONLY);
+    if (dir >= 0)
+    {
+        fsync(dir);
+        close(dir);
+    }
+
+    close(fd);
+    return open(PSTORAGE_FILE, O_WRONLY);
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Opens the file and loads what it holds into file_image,
+// so that only the words that really change are written. Returns the
+// descriptor, or -1 if the file must be created
+//-----------------------------------------------------------------------------
+static int openStorageFile()
+{
+    int fd = open(PSTORAGE_FILE, O_RDWR);
+    if (fd < 0) return -1;
+
+    if (pread(fd, file_image, sizeof(file_image), 0) != (ssize_t)sizeof(file_image))
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+//-----------------------------------------------------------------------------
+// Main function for the thread. Collects the %MW words that changed from the
+// scan once per polling period, writes them to the persistent file and syncs
+// it within the durability budget
+//-----------------------------------------------------------------------------
+void startPstorage()
+{
+    //We can only start persistent storage after the persistent.file was read
+    while (pstorage_read == false)
+        sleepms(100);
+
+    while (__atomic_exchange_n(&writer_active, true, __ATOMIC_ACQUIRE))
+        sleepms(100);
+
+    unsigned char log_msg[1000];
+    static bool changed[BUFFER_SIZE];
+    bool file_valid = true;
+
+    int fd = openStorageFile();
+    if (fd < 0)
+    {
+        sprintf(log_msg, "Creating Persistent Storage file\n");
+        log(log_msg);
+        memset(file_image, 0, sizeof(file_image));
+        file_valid = false;
+    }
+
+    //the first capture hands over every word
+    memset(changed, 0, sizeof(changed));
+    capture_all = true;
+    __atomic_store_n(&capture_requested, true, __ATOMIC_RELEASE);
+    while (run_pstorage && __atomic_load_n(&capture_requested, __ATOMIC_ACQUIRE))
+        sleepms(10);
+
+    unsigned long long last_write = 0;
+    unsigned long long unsynced_since = 0;
+    bool stopping = false;
+
+    while (!stopping)
+    {
+        stopping = !run_pstorage;
+        unsigned long long now = monotonicMs();
+        bool write_due = stopping || !throttled || now - last_write >= PSTORAGE_THROTTLED_INTERVAL * 1000ULL;
+
+        if (write_due)
+        {
+            int count = collectDirtyWords(changed);
+            if (!file_valid)
+            {
+                fd = createStorageFile();
+                if (fd < 0)
+                {
+                    sprintf(log_msg, "Persistent Storage: Error creating persistent memory file!\n");
+                    log(log_msg);
+                    break;
+                }
+                file_valid = true;
+                memset(changed, 0, sizeof(changed));
+            }
+            else if (count > 0)
+            {
+                //the whole file is written again on the next pass
+                if (!writeDirtyRuns(fd, changed))
+                {
+                    sprintf(log_msg, "Persistent Storage: Error writing to persistent memory file!\n");
+                    log(log_msg);
+                    close(fd);
+                    fd = -1;
+                    file_valid = false;
+                    unsynced_since = 0;
+                }
+                else if (unsynced_since == 0)
+                {
+                    unsynced_since = now;
+                }
+            }
+
+            last_write = now;
+        }
+
+        //sync within the durability budget, and always before stopping
+        if (unsynced_since != 0 && (stopping || now - unsynced_since >= (unsigned long long)pstorage_sync_ms))
+        {
+            if (fdatasync(fd) == 0) sync_count++;
+            unsynced_since = 0;
+        }
+
+        if (stopping) break;
+
+        //wait for the next poll, or for the sync deadline if it comes first
+        unsigned long long interval = (unsigned long long)pstorage_polling * 1000ULL;
+        if (interval < PSTORAGE_MIN_INTERVAL_MS) interval = PSTORAGE_MIN_INTERVAL_MS;
+        unsigned long long wake = now + interval;
+        if (unsynced_since != 0 && unsynced_since + pstorage_sync_ms < wake) wake = unsynced_since + pstorage_sync_ms;
+
+        __atomic_store_n(&capture_requested, true, __ATOMIC_RELEASE);
+        while (run_pstorage && monotonicMs() < wake)
+            sleepms(PSTORAGE_MIN_INTERVAL_MS);
+    }
+
+    if (fd >= 0) close(fd);
+    __atomic_store_n(&writer_active, false, __ATOMIC_RELEASE);
+}
+
+//-----------------------------------------------------------------------------
+// Writes the wear and durability counters of the persistent storage to the
+// buffer as CSV. Returns the number of characters written
+//-----------------------------------------------------------------------------
+int pstorageStats(char *buffer, int buffer_size)
+{
+    return snprintf(buffer, buffer_size, "bytes_today,bytes_total,writes,syncs,daily_budget_kb,throttled\n%llu,%llu,%llu,%llu,%d,%s\n",
+                    bytes_today, bytes_total, write_count, sync_count, pstorage_daily_kb, throttled ? "yes" : "no");
+}
+
+//-----------------------------------------------------------------------------
+// This function reads the contents from persistent.file into OpenPLC internal
+// buffers. Must be called when OpenPLC is initializing. If persistent storage
+// is disabled, the persistent.file will not be found and the function will
+// exit gracefully.
+//-----------------------------------------------------------------------------
+int readPersistentStorage()
+{
+    unsigned char log_msg[1000];
+    FILE *fd = fopen(PSTORAGE_FILE, "r");
+    if (fd == NULL)
+    {
+        sprintf(log_msg, "Warning: Persistent Storage file not found\n");
+        log(log_msg);
+        pstorage_read = true;
+        return 0;
+    }
+
+    IEC_INT persistentBuffer[BUFFER_SIZE];
+
+    if (fread(persistentBuffer, sizeof(IEC_INT), BUFFER_SIZE, fd) < BUFFER_SIZE)
+    {
+        sprintf(log_msg, "Persistent Storage: Error while trying to read persistent.file!\n");
+        log(log_msg);
+        fclose(fd);
+        pstorage_read = true;
+        return 0;
+    }
+    fclose(fd);
+
+    sprintf(log_msg, "Persistent Storage: Reading persistent.file into local buffers\n");
+    log(log_msg);
+
+    pthread_mutex_lock(&bufferLock); //lock mutex
+    for (int i = 0; i < BUFFER_SIZE; i++)
+    {
+        if (int_memory[i] != NULL) *int_memory[i] = persistentBuffer[i];
+    }
+    pthread_mutex_unlock(&bufferLock); //unlock mutex
+
+    pstorage_read = true;
+}
@@ -0,0 +1,119 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 OpenPLC Project
+// This file is part of the OpenPLC Software Stack.
+//
+// OpenPLC is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenPLC is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with OpenPLC.  If not, see <http://www.gnu.org/licenses/>.
+//------
+//
+// Runtime side of the POU profiler. Programs compiled with iec2c -O t time
+// their program and function block bodies and FB calls (see pou_profile.h).
+// This file selects the scans on which the time is measured, converts the
+// cycle counts to nanoseconds and reports the accumulators to the
+// interactive server.
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <time.h>
+
+#include "ladder.h"
+#include "pou_profile.h"
+
+__pou_profile_t *__pou_profile_list = NULL;
+int __pou_profile_sampling = 0;
+
+//measure one scan out of every pou_profile_rate scans. 0 disables timing
+int pou_profile_rate = 100;
+
+static double cycles_per_ns = 0;
+
+//-----------------------------------------------------------------------------
+// Monotonic clock in ns. Used by the generated code as cycle counter on
+// targets without one
+//-----------------------------------------------------------------------------
+unsigned long long __pou_profile_clock(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+//-----------------------------------------------------------------------------
+// Called by the scan thread right before the program runs. Decides whether
+// this scan is sampled
+//-----------------------------------------------------------------------------
+void startPouProfileScan(unsigned long long tick)
+{
+    __pou_profile_sampling = (pou_profile_rate > 0 && (tick % pou_profile_rate) == 0);
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Measures the rate of the cycle counter against the
+// monotonic clock. Done once, the first time a report is requested
+//-----------------------------------------------------------------------------
+static void calibrateCycles()
+{
+    unsigned long long ns_start = __pou_profile_clock();
+    unsigned long long cycles_start = __pou_profile_cycles();
+
+    struct timespec delay = {0, 20000000};
+    nanosleep(&delay, NULL);
+
+    unsigned long long ns = __pou_profile_clock() - ns_start;
+    unsigned long long cycles = __pou_profile_cycles() - cycles_start;
+    cycles_per_ns = (ns > 0 && cycles > 0) ? (double)cycles / ns : 1.0;
+}
+
+//-----------------------------------------------------------------------------
+// Clears the counters of every POU
+//-----------------------------------------------------------------------------
+void resetPouProfile()
+{
+    for (__pou_profile_t *p = __atomic_load_n(&__pou_profile_list, __ATOMIC_ACQUIRE); p != NULL; p = p->next)
+    {
+        p->calls = 0;
+        p->samples = 0;
+        p->total_cycles = 0;
+        p->max_cycles = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Writes one line per profiled program/FB body and FB call site. calls counts
+// every execution; samples, avg_ns and max_ns come from the sampled scans.
+// Returns the number of characters written
+//-----------------------------------------------------------------------------
+int pouProfileReport(char *buffer, int buffer_size)
+{
+    if (cycles_per_ns == 0) calibrateCycles();
+
+    int count_char = snprintf(buffer, buffer_size, "pou,kind,calls,samples,avg_ns,max_ns\n");
+    __pou_profile_t *p = __atomic_load_n(&__pou_profile_list, __ATOMIC_ACQUIRE);
+    if (p == NULL && count_char < buffer_size)
+    {
+        count_char += snprintf(buffer + count_char, buffer_size - count_char,
+                               "# no samples. The program must be compiled with iec2c -O t and pou_profile_rate > 0\n");
+    }
+
+    for (; p != NULL && count_char < buffer_size; p = p->next)
+    {
+        unsigned long long samples = p->samples;
+        unsigned long long avg = (samples > 0) ? (unsigned long long)(p->total_cycles / samples / cycles_per_ns) : 0;
+        unsigned long long max = (unsigned long long)(p->max_cycles / cycles_per_ns);
+        count_char += snprintf(buffer + count_char, buffer_size - count_char, "%s,%s,%llu,%llu,%llu,%llu\n", p->name,
+                               (p->kind == POU_PROFILE_CALL) ? "call" : "body", p->calls, samples, avg, max);
+    }
+
+    if (count_char > buffer_size) count_char = buffer_size;
+    return count_char;
+}
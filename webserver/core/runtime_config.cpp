@@ -0,0 +1,1021 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 OpenPLC Project
+// This file is part of the OpenPLC Software Stack.
+//
+// OpenPLC is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenPLC is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with OpenPLC.  If not, see <http://www.gnu.org/licenses/>.
+//------
+//
+// This file reads the real-time profile of the runtime from runtime.cfg and
+// applies it to the scan thread and to the I/O threads (interactive server,
+// protocol servers, modbus master and persistent storage). The profile
+// controls CPU affinity, scheduling policy and priority of every thread
+// class, memory locking, pre-faulting of the stack and heap, the overrun
+// handling of the scan cycle, the event driven scan mode and the worker
+// threads that run independent programs next to the scan thread. When the
+// file is missing the runtime keeps its historical behavior: SCHED_FIFO
+// priority 30 for the scan and locked memory.
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <limits.h>
+#include <malloc.h>
+#include <alloca.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+
+#include "ladder.h"
+
+//longest task interval in program cycles (generated with the program)
+extern unsigned long greatest_tick_count__;
+
+#define RUNTIME_CFG_FILE    "runtime.cfg"
+#define MAX_CFG_CPUS        64
+
+#ifndef SCHED_DEADLINE
+#define SCHED_DEADLINE      6
+#endif
+
+struct thread_profile
+{
+    const char *name;
+    int policy;
+    int priority;
+};
+
+struct runtime_config
+{
+    cpu_set_t scan_cpus;
+    bool scan_cpus_set;
+    cpu_set_t io_cpus;
+    bool io_cpus_set;
+    cpu_set_t worker_cpus;
+    bool worker_cpus_set;
+
+    struct thread_profile threads[NUM_THREAD_CLASSES];
+
+    unsigned long long deadline_runtime_ns;
+    unsigned long long deadline_period_ns;
+
+    bool lock_memory;
+    int prefault_stack_kb;
+    int prefault_heap_kb;
+    int thread_stack_kb;
+    int worker_stack_kb;
+};
+
+struct runtime_config rt_config;
+
+//Runtime threads alive, by thread class. Their stacks are reserved (and
+//locked with lock_memory) for as long as they run
+static int running_threads[NUM_THREAD_CLASSES];
+
+struct thread_start
+{
+    void *(*routine)(void *);
+    void *arg;
+    int thread_class;
+};
+
+// Layout of the sched_setattr() argument. glibc only recently started to
+// export it, so a local copy is used
+struct oplc_sched_attr
+{
+    uint32_t size;
+    uint32_t sched_policy;
+    uint64_t sched_flags;
+    int32_t sched_nice;
+    uint32_t sched_priority;
+    uint64_t sched_runtime;
+    uint64_t sched_deadline;
+    uint64_t sched_period;
+};
+
+//-----------------------------------------------------------------------------
+// Helper function - Returns the name of a scheduling policy
+//-----------------------------------------------------------------------------
+const char *policyName(int policy)
+{
+    switch (policy)
+    {
+        case SCHED_OTHER: return "other";
+        case SCHED_FIFO: return "fifo";
+        case SCHED_RR: return "rr";
+        case SCHED_DEADLINE: return "deadline";
+        default: return "unknown";
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Parses a CPU list in the same format used by isolcpus
+// (e.g. "2,3" or "1-3,6"). Returns false if the list is malformed
+//-----------------------------------------------------------------------------
+bool parseCpuList(const char *list, cpu_set_t *cpus)
+{
+    CPU_ZERO(cpus);
+    const char *p = list;
+
+    while (*p != '\0')
+    {
+        char *end;
+        long first = strtol(p, &end, 10);
+        if (end == p || first < 0 || first >= MAX_CFG_CPUS) return false;
+
+        long last = first;
+        p = end;
+        if (*p == '-')
+        {
+            p++;
+            last = strtol(p, &end, 10);
+            if (end == p || last < first || last >= MAX_CFG_CPUS) return false;
+            p = end;
+        }
+
+        for (long cpu = first; cpu <= last; cpu++) CPU_SET(cpu, cpus);
+
+        while (*p == ' ') p++;
+        if (*p == ',') p++;
+        else if (*p != '\0') return false;
+        while (*p == ' ') p++;
+    }
+
+    return (CPU_COUNT(cpus) > 0);
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Formats a CPU set as a comma separated list
+//-----------------------------------------------------------------------------
+void formatCpuList(cpu_set_t *cpus, char *buffer, int buffer_size)
+{
+    int count_char = 0;
+    buffer[0] = '\0';
+
+    for (int cpu = 0; cpu < CPU_SETSIZE && count_char < buffer_size; cpu++)
+    {
+        if (CPU_ISSET(cpu, cpus))
+        {
+            count_char += snprintf(buffer + count_char, buffer_size - count_char, "%s%d", (count_char > 0) ? "," : "", cpu);
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Parses a scheduling policy name
+//-----------------------------------------------------------------------------
+int parsePolicy(const char *value)
+{
+    if (!strcmp(value, "other")) return SCHED_OTHER;
+    if (!strcmp(value, "fifo")) return SCHED_FIFO;
+    if (!strcmp(value, "rr")) return SCHED_RR;
+    if (!strcmp(value, "deadline")) return SCHED_DEADLINE;
+    return -1;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Parses a boolean setting
+//-----------------------------------------------------------------------------
+bool parseBool(const char *value)
+{
+    return (!strcasecmp(value, "true") || !strcasecmp(value, "yes") || !strcmp(value, "1"));
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Removes leading and trailing blanks from a string
+//-----------------------------------------------------------------------------
+char *trimBlanks(char *str)
+{
+    while (*str == ' ' || *str == '\t') str++;
+    int len = strlen(str);
+    while (len > 0 && (str[len-1] == ' ' || str[len-1] == '\t' || str[len-1] == '\r' || str[len-1] == '\n'))
+    {
+        str[len-1] = '\0';
+        len--;
+    }
+    return str;
+}
+
+//-----------------------------------------------------------------------------
+// Returns the index of the thread class configured by the key prefix (e.g.
+// "protocol" for "protocol_priority"), or -1 if it is unknown
+//-----------------------------------------------------------------------------
+int threadClassFromKey(const char *key, const char *suffix)
+{
+    for (int i = 0; i < NUM_THREAD_CLASSES; i++)
+    {
+        int name_len = strlen(rt_config.threads[i].name);
+        if (!strncmp(key, rt_config.threads[i].name, name_len) && !strcmp(key + name_len, suffix))
+            return i;
+    }
+    return -1;
+}
+
+//-----------------------------------------------------------------------------
+// Sets the default profile. Matches the behavior of the runtime before the
+// profile existed
+//-----------------------------------------------------------------------------
+void setDefaultRuntimeConfig()
+{
+    memset(&rt_config, 0, sizeof(rt_config));
+
+    rt_config.threads[THREAD_SCAN].name = "scan";
+    rt_config.threads[THREAD_INTERACTIVE].name = "interactive";
+    rt_config.threads[THREAD_PROTOCOL].name = "protocol";
+    rt_config.threads[THREAD_MODBUS_MASTER].name = "modbus_master";
+    rt_config.threads[THREAD_PSTORAGE].name = "pstorage";
+    rt_config.threads[THREAD_WORKER].name = "worker";
+
+    for (int i = 0; i < NUM_THREAD_CLASSES; i++)
+    {
+        rt_config.threads[i].policy = SCHED_OTHER;
+        rt_config.threads[i].priority = 0;
+    }
+    rt_config.threads[THREAD_SCAN].policy = SCHED_FIFO;
+    rt_config.threads[THREAD_SCAN].priority = 30;
+    //program workers run the same kind of code as the scan thread
+    rt_config.threads[THREAD_WORKER].policy = SCHED_FIFO;
+    rt_config.threads[THREAD_WORKER].priority = 30;
+
+    rt_config.lock_memory = true;
+    rt_config.thread_stack_kb = 256;
+    rt_config.worker_stack_kb = 1024;
+}
+
+//-----------------------------------------------------------------------------
+// Parses runtime.cfg. Every line has the format "key = value". Lines starting
+// with # are comments
+//-----------------------------------------------------------------------------
+void loadRuntimeConfig()
+{
+    unsigned char log_msg[1000];
+    char line[1024];
+
+    setDefaultRuntimeConfig();
+
+    FILE *cfgfile = fopen(RUNTIME_CFG_FILE, "r");
+    if (cfgfile == NULL)
+    {
+        sprintf(log_msg, "Runtime profile: %s not found, using defaults\n", RUNTIME_CFG_FILE);
+        log(log_msg);
+        return;
+    }
+
+    int line_number = 0;
+    while (fgets(line, sizeof(line), cfgfile) != NULL)
+    {
+        line_number++;
+        char *start = trimBlanks(line);
+        if (start[0] == '#' || start[0] == '\0') continue;
+
+        char *separator = strchr(start, '=');
+        if (separator == NULL)
+        {
+            sprintf(log_msg, "Runtime profile: malformed line %d in %s\n", line_number, RUNTIME_CFG_FILE);
+            log(log_msg);
+            continue;
+        }
+        *separator = '\0';
+        char *key = trimBlanks(start);
+        char *value = trimBlanks(separator + 1);
+
+        bool valid = true;
+        int thread_class;
+
+        if (!strcmp(key, "scan_cpus"))
+        {
+            valid = parseCpuList(value, &rt_config.scan_cpus);
+            rt_config.scan_cpus_set = valid;
+        }
+        else if (!strcmp(key, "io_cpus"))
+        {
+            valid = parseCpuList(value, &rt_config.io_cpus);
+            rt_config.io_cpus_set = valid;
+        }
+        else if (!strcmp(key, "worker_cpus"))
+        {
+            valid = parseCpuList(value, &rt_config.worker_cpus);
+            rt_config.worker_cpus_set = valid;
+        }
+        else if (!strcmp(key, "program_workers"))
+        {
+            program_workers = atoi(value);
+            valid = (program_workers >= 0);
+            if (!valid) program_workers = 0;
+        }
+        else if ((thread_class = threadClassFromKey(key, "_policy")) >= 0)
+        {
+            int policy = parsePolicy(value);
+            valid = (policy >= 0 && (policy != SCHED_DEADLINE || thread_class == THREAD_SCAN));
+            if (valid) rt_config.threads[thread_class].policy = policy;
+        }
+        else if ((thread_class = threadClassFromKey(key, "_priority")) >= 0)
+        {
+            rt_config.threads[thread_class].priority = atoi(value);
+            //A priority on an I/O thread without an explicit policy means fifo
+            if (thread_class != THREAD_SCAN && rt_config.threads[thread_class].priority > 0 &&
+                rt_config.threads[thread_class].policy == SCHED_OTHER)
+            {
+                rt_config.threads[thread_class].policy = SCHED_FIFO;
+            }
+        }
+        else if (!strcmp(key, "deadline_runtime_us"))
+        {
+            rt_config.deadline_runtime_ns = strtoull(value, NULL, 10) * 1000ULL;
+        }
+        else if (!strcmp(key, "deadline_period_us"))
+        {
+            rt_config.deadline_period_ns = strtoull(value, NULL, 10) * 1000ULL;
+        }
+        else if (!strcmp(key, "lock_memory"))
+        {
+            rt_config.lock_memory = parseBool(value);
+        }
+        else if (!strcmp(key, "prefault_stack_kb"))
+        {
+            rt_config.prefault_stack_kb = atoi(value);
+        }
+        else if (!strcmp(key, "prefault_heap_kb"))
+        {
+            rt_config.prefault_heap_kb = atoi(value);
+        }
+        else if (!strcmp(key, "thread_stack_kb"))
+        {
+            rt_config.thread_stack_kb = atoi(value);
+            valid = (rt_config.thread_stack_kb >= 64);
+            if (!valid) rt_config.thread_stack_kb = 256;
+        }
+        else if (!strcmp(key, "worker_stack_kb"))
+        {
+            rt_config.worker_stack_kb = atoi(value);
+            valid = (rt_config.worker_stack_kb >= 64);
+            if (!valid) rt_config.worker_stack_kb = 1024;
+        }
+        else if (!strcmp(key, "max_connections"))
+        {
+            max_connections = atoi(value);
+            valid = (max_connections > 0);
+            if (!valid) max_connections = 16;
+        }
+        else if (!strcmp(key, "net_backend"))
+        {
+            if (!strcmp(value, "threads")) net_backend = NET_THREADS;
+            else if (!strcmp(value, "epoll")) net_backend = NET_EPOLL;
+            else if (!strcmp(value, "io_uring")) net_backend = NET_IO_URING;
+            else valid = false;
+        }
+        else if (!strcmp(key, "log_buffer_kb"))
+        {
+            log_buffer_kb = atoi(value);
+            valid = (log_buffer_kb >= 16);
+            if (!valid) log_buffer_kb = 256;
+        }
+        else if (!strcmp(key, "overrun_policy"))
+        {
+            if (!strcmp(value, "catch_up")) overrun_policy = OVERRUN_CATCH_UP;
+            else if (!strcmp(value, "skip")) overrun_policy = OVERRUN_SKIP;
+            else if (!strcmp(value, "stretch")) overrun_policy = OVERRUN_STRETCH;
+            else valid = false;
+        }
+        else if (!strcmp(key, "watchdog_overruns"))
+        {
+            watchdog_overruns = atoi(value);
+            valid = (watchdog_overruns >= 0);
+            if (!valid) watchdog_overruns = 0;
+        }
+        else if (!strcmp(key, "scan_mode"))
+        {
+            if (!strcmp(value, "cyclic")) scan_mode = SCAN_CYCLIC;
+            else if (!strcmp(value, "event")) scan_mode = SCAN_EVENT;
+            else valid = false;
+        }
+        else if (!strcmp(key, "max_idle_ms"))
+        {
+            max_idle_ms = atoi(value);
+            valid = (max_idle_ms > 0);
+            if (!valid) max_idle_ms = 1000;
+        }
+        else if (!strcmp(key, "input_poll_ms"))
+        {
+            input_poll_ms = atoi(value);
+            valid = (input_poll_ms >= 0);
+            if (!valid) input_poll_ms = 0;
+        }
+        else if (!strcmp(key, "pou_profile_rate"))
+        {
+            pou_profile_rate = atoi(value);
+            valid = (pou_profile_rate >= 0);
+            if (!valid) pou_profile_rate = 0;
+        }
+        else if (!strcmp(key, "pstorage_sync_ms"))
+        {
+            pstorage_sync_ms = atoi(value);
+            valid = (pstorage_sync_ms >= 0);
+            if (!valid) pstorage_sync_ms = 1000;
+        }
+        else if (!strcmp(key, "pstorage_daily_kb"))
+        {
+            pstorage_daily_kb = atoi(value);
+            valid = (pstorage_daily_kb >= 0);
+            if (!valid) pstorage_daily_kb = 0;
+        }
+        else if (!strcmp(key, "flight_recorder_kb"))
+        {
+            flight_recorder_kb = atoi(value);
+            valid = (flight_recorder_kb >= 0);
+            if (!valid) flight_recorder_kb = 1024;
+        }
+        else if (!strcmp(key, "flight_replay"))
+        {
+            strncpy(flight_replay, value, sizeof(flight_replay) - 1);
+            flight_replay[sizeof(flight_replay) - 1] = '\0';
+            valid = (strlen(value) < sizeof(flight_replay));
+        }
+        else
+        {
+            sprintf(log_msg, "Runtime profile: unknown setting '%s' on line %d\n", key, line_number);
+            log(log_msg);
+            continue;
+        }
+
+        if (!valid)
+        {
+            sprintf(log_msg, "Runtime profile: invalid value '%s' for %s on line %d\n", value, key, line_number);
+            log(log_msg);
+        }
+    }
+
+    fclose(cfgfile);
+    resizeLogBuffer();
+}
+
+//-----------------------------------------------------------------------------
+// Touches every page of a stack area so that later calls never page fault
+//-----------------------------------------------------------------------------
+void prefaultStack(int size_kb)
+{
+    struct rlimit stack_limit;
+    size_t size = (size_t)size_kb * 1024;
+
+    //leave some room for the frames already in use
+    if (getrlimit(RLIMIT_STACK, &stack_limit) == 0 && stack_limit.rlim_cur != RLIM_INFINITY &&
+        size + 65536 > stack_limit.rlim_cur)
+    {
+        size = stack_limit.rlim_cur - 65536;
+    }
+
+    volatile char *stack_area = (volatile char *)alloca(size);
+    for (size_t i = 0; i < size; i += 4096) stack_area[i] = 0;
+}
+
+//-----------------------------------------------------------------------------
+// Grows the heap by size_kb, touches it and returns it to malloc without
+// giving it back to the kernel, so future allocations do not page fault
+//-----------------------------------------------------------------------------
+void prefaultHeap(int size_kb)
+{
+    size_t size = (size_t)size_kb * 1024;
+
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+
+    char *heap_area = (char *)malloc(size);
+    if (heap_area == NULL) return;
+    for (size_t i = 0; i < size; i += 4096) heap_area[i] = 0;
+    free(heap_area);
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Start routine of the runtime threads. Keeps the count of
+// running threads up to date, also when the thread calls pthread_exit()
+//-----------------------------------------------------------------------------
+static void runtimeThreadExit(void *arg)
+{
+    __atomic_sub_fetch(&running_threads[(long)arg], 1, __ATOMIC_RELAXED);
+}
+
+static void *runtimeThreadStart(void *arg)
+{
+    struct thread_start start = *(struct thread_start *)arg;
+    free(arg);
+
+    void *result;
+    pthread_cleanup_push(runtimeThreadExit, (void *)(long)start.thread_class);
+    result = start.routine(start.arg);
+    pthread_cleanup_pop(1);
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Stack size of the threads of a class
+//-----------------------------------------------------------------------------
+static size_t threadStackSize(int thread_class)
+{
+    int size_kb = (thread_class == THREAD_WORKER) ? rt_config.worker_stack_kb : rt_config.thread_stack_kb;
+    size_t size = (size_t)size_kb * 1024;
+    if (size < (size_t)PTHREAD_STACK_MIN) size = PTHREAD_STACK_MIN;
+    return size;
+}
+
+//-----------------------------------------------------------------------------
+// Creates a runtime thread with the stack size of its class instead of the
+// default of the C library (usually 8 MB, all of it locked with lock_memory).
+// Takes the same arguments and returns the same as pthread_create()
+//-----------------------------------------------------------------------------
+int createRuntimeThread(pthread_t *thread, void *(*routine)(void *), void *arg, int thread_class)
+{
+    struct thread_start *start = (struct thread_start *)malloc(sizeof(struct thread_start));
+    if (start == NULL) return ENOMEM;
+    start->routine = routine;
+    start->arg = arg;
+    start->thread_class = thread_class;
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, threadStackSize(thread_class));
+
+    __atomic_add_fetch(&running_threads[thread_class], 1, __ATOMIC_RELAXED);
+    int ret = pthread_create(thread, &attr, runtimeThreadStart, start);
+    pthread_attr_destroy(&attr);
+    if (ret != 0)
+    {
+        __atomic_sub_fetch(&running_threads[thread_class], 1, __ATOMIC_RELAXED);
+        free(start);
+    }
+    return ret;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Reads a memory counter of this process from
+// /proc/self/status, in KB. Returns 0 if it is not available
+//-----------------------------------------------------------------------------
+static unsigned long long processMemoryKb(const char *counter)
+{
+    char line[256];
+    unsigned long long value = 0;
+    size_t length = strlen(counter);
+
+    FILE *status = fopen("/proc/self/status", "r");
+    if (status == NULL) return 0;
+    while (fgets(line, sizeof(line), status) != NULL)
+    {
+        if (!strncmp(line, counter, length) && line[length] == ':')
+        {
+            value = strtoull(line + length + 1, NULL, 10);
+            break;
+        }
+    }
+    fclose(status);
+    return value;
+}
+
+//-----------------------------------------------------------------------------
+// Writes the memory reserved by each subsystem of the runtime to the buffer
+// as CSV, followed by the totals of the process as seen by the kernel.
+// Returns the number of characters written
+//-----------------------------------------------------------------------------
+int memoryReport(char *buffer, int buffer_size)
+{
+    int connections_in_use;
+    int count_char = snprintf(buffer, buffer_size, "subsystem,bytes,detail\n");
+
+    for (int i = 0; i < NUM_THREAD_CLASSES && count_char < buffer_size; i++)
+    {
+        if (i == THREAD_SCAN) continue;
+        int threads = __atomic_load_n(&running_threads[i], __ATOMIC_RELAXED);
+        count_char += snprintf(buffer + count_char, buffer_size - count_char, "%s_stacks,%llu,%d thread(s) of %zu KB\n", rt_config.threads[i].name,
+                               (unsigned long long)threads * threadStackSize(i), threads, threadStackSize(i) / 1024);
+    }
+
+    if (count_char < buffer_size)
+    {
+        unsigned long long pool = connectionPoolMemory(&connections_in_use);
+        count_char += snprintf(buffer + count_char, buffer_size - count_char, "connection_pool,%llu,%d of %d connection(s) in use\n",
+                               pool, connections_in_use, max_connections);
+    }
+    if (count_char < buffer_size)
+    {
+        count_char += snprintf(buffer + count_char, buffer_size - count_char, "interactive_server,%llu,client slots and pending replies\n",
+                               interactiveServerMemory());
+    }
+    if (count_char < buffer_size)
+    {
+        int bindings;
+        unsigned long long snapshot = registerSnapshotMemory(&bindings);
+        count_char += snprintf(buffer + count_char, buffer_size - count_char, "register_snapshot,%llu,%d bound variable(s)\n",
+                               snapshot, bindings);
+    }
+    if (count_char < buffer_size)
+    {
+        count_char += snprintf(buffer + count_char, buffer_size - count_char, "log_buffer,%d,\n", log_buffer_kb * 1024);
+    }
+    if (count_char < buffer_size)
+    {
+        count_char += snprintf(buffer + count_char, buffer_size - count_char, "flight_recorder,%llu,\n", flightRecorderMemory());
+    }
+    if (count_char < buffer_size)
+    {
+        count_char += snprintf(buffer + count_char, buffer_size - count_char, "locked_kb=%llu,resident_kb=%llu,memory_locked=%s\n",
+                               processMemoryKb("VmLck"), processMemoryKb("VmRSS"), rt_config.lock_memory ? "yes" : "no");
+    }
+
+    if (count_char > buffer_size) count_char = buffer_size;
+    return count_char;
+}
+
+#ifdef __linux__
+//-----------------------------------------------------------------------------
+// Switches the calling thread to SCHED_DEADLINE. Returns 0 on success
+//-----------------------------------------------------------------------------
+int setDeadlineScheduling(unsigned long long runtime_ns, unsigned long long period_ns)
+{
+#ifdef SYS_sched_setattr
+    struct oplc_sched_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.sched_policy = SCHED_DEADLINE;
+    attr.sched_runtime = runtime_ns;
+    attr.sched_deadline = period_ns;
+    attr.sched_period = period_ns;
+    return syscall(SYS_sched_setattr, 0, &attr, 0);
+#else
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+#endif
+
+//-----------------------------------------------------------------------------
+// Applies the affinity and scheduling of a thread class to the calling
+// thread. The I/O threads should call this as the first thing they do, so
+// every thread they create inherits the same profile
+//-----------------------------------------------------------------------------
+void applyThreadProfile(int thread_class)
+{
+#ifdef __linux__
+    unsigned char log_msg[1000];
+    struct thread_profile *profile = &rt_config.threads[thread_class];
+
+    if (thread_class != THREAD_SCAN && thread_class != THREAD_WORKER && rt_config.io_cpus_set)
+    {
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &rt_config.io_cpus))
+        {
+            sprintf(log_msg, "WARNING: Failed to set CPU affinity of the %s thread\n", profile->name);
+            log(log_msg);
+        }
+    }
+
+    if (profile->policy != SCHED_OTHER || thread_class == THREAD_SCAN)
+    {
+        struct sched_param sp;
+        sp.sched_priority = (profile->policy == SCHED_OTHER) ? 0 : profile->priority;
+        if (pthread_setschedparam(pthread_self(), profile->policy, &sp))
+        {
+            sprintf(log_msg, "WARNING: Failed to set %s thread to %s priority %d\n", profile->name, policyName(profile->policy), profile->priority);
+            log(log_msg);
+        }
+    }
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// Applies the worker profile to the calling program worker. Worker n is
+// pinned to the n-th core of worker_cpus, wrapping around when there are
+// more workers than cores
+//-----------------------------------------------------------------------------
+void applyWorkerProfile(int worker)
+{
+#ifdef __linux__
+    unsigned char log_msg[1000];
+
+    if (rt_config.worker_cpus_set)
+    {
+        int index = worker % CPU_COUNT(&rt_config.worker_cpus);
+        cpu_set_t worker_cpu;
+        CPU_ZERO(&worker_cpu);
+        for (int cpu = 0; cpu < MAX_CFG_CPUS; cpu++)
+        {
+            if (CPU_ISSET(cpu, &rt_config.worker_cpus) && index-- == 0)
+            {
+                CPU_SET(cpu, &worker_cpu);
+                break;
+            }
+        }
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &worker_cpu))
+        {
+            sprintf(log_msg, "WARNING: Failed to set CPU affinity of program worker %d\n", worker);
+            log(log_msg);
+        }
+    }
+#endif
+    applyThreadProfile(THREAD_WORKER);
+}
+
+//-----------------------------------------------------------------------------
+// Applies the scan profile to the calling thread: affinity, scheduling,
+// memory locking and pre-faulting. Must be called from the thread that runs
+// the scan cycle, right before entering the main loop
+//-----------------------------------------------------------------------------
+void applyScanProfile()
+{
+#ifdef __linux__
+    unsigned char log_msg[1000];
+    struct thread_profile *profile = &rt_config.threads[THREAD_SCAN];
+
+    if (rt_config.scan_cpus_set && profile->policy != SCHED_DEADLINE)
+    {
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &rt_config.scan_cpus))
+        {
+            sprintf(log_msg, "WARNING: Failed to set CPU affinity of the scan thread\n");
+            log(log_msg);
+        }
+    }
+
+    if (profile->policy == SCHED_DEADLINE)
+    {
+        printf("Setting main thread to SCHED_DEADLINE\n");
+        unsigned long long period = rt_config.deadline_period_ns ? rt_config.deadline_period_ns : common_ticktime__;
+        if (setDeadlineScheduling(rt_config.deadline_runtime_ns, period))
+        {
+            sprintf(log_msg, "WARNING: Failed to set SCHED_DEADLINE (%s). Falling back to SCHED_FIFO\n", strerror(errno));
+            log(log_msg);
+            profile->policy = SCHED_FIFO;
+            if (profile->priority <= 0) profile->priority = 30;
+            applyThreadProfile(THREAD_SCAN);
+        }
+    }
+    else
+    {
+        printf("Setting main thread priority to RT\n");
+        applyThreadProfile(THREAD_SCAN);
+    }
+
+    if (rt_config.lock_memory)
+    {
+        // Lock memory to ensure no swapping is done.
+        printf("Locking main thread memory\n");
+        if(mlockall(MCL_FUTURE|MCL_CURRENT))
+        {
+            printf("WARNING: Failed to lock memory\n");
+        }
+    }
+
+    if (rt_config.prefault_stack_kb > 0) prefaultStack(rt_config.prefault_stack_kb);
+    if (rt_config.prefault_heap_kb > 0) prefaultHeap(rt_config.prefault_heap_kb);
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// Checks the profile for settings that will not give the expected result and
+// logs a warning for each of them. Returns the number of problems found
+//-----------------------------------------------------------------------------
+int checkRuntimeConfig()
+{
+    unsigned char log_msg[1000];
+    int problems = 0;
+    long online_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    struct thread_profile *scan = &rt_config.threads[THREAD_SCAN];
+
+    for (int cpu = online_cpus; cpu < MAX_CFG_CPUS; cpu++)
+    {
+        if ((rt_config.scan_cpus_set && CPU_ISSET(cpu, &rt_config.scan_cpus)) ||
+            (rt_config.io_cpus_set && CPU_ISSET(cpu, &rt_config.io_cpus)) ||
+            (rt_config.worker_cpus_set && CPU_ISSET(cpu, &rt_config.worker_cpus)))
+        {
+            sprintf(log_msg, "Runtime profile: CPU %d is not online (%ld CPUs available)\n", cpu, online_cpus);
+            log(log_msg);
+            problems++;
+        }
+    }
+
+    if (rt_config.scan_cpus_set && rt_config.io_cpus_set)
+    {
+        cpu_set_t overlap;
+        CPU_AND(&overlap, &rt_config.scan_cpus, &rt_config.io_cpus);
+        if (CPU_COUNT(&overlap) > 0)
+        {
+            sprintf(log_msg, "Runtime profile: scan_cpus and io_cpus overlap. I/O threads can preempt the scan\n");
+            log(log_msg);
+            problems++;
+        }
+    }
+
+    if (program_workers > 0)
+    {
+        cpu_set_t scan_overlap, io_overlap;
+        CPU_ZERO(&scan_overlap);
+        CPU_ZERO(&io_overlap);
+        if (rt_config.worker_cpus_set && rt_config.scan_cpus_set) CPU_AND(&scan_overlap, &rt_config.worker_cpus, &rt_config.scan_cpus);
+        if (rt_config.worker_cpus_set && rt_config.io_cpus_set) CPU_AND(&io_overlap, &rt_config.worker_cpus, &rt_config.io_cpus);
+
+        if (program_workers >= online_cpus)
+        {
+            sprintf(log_msg, "Runtime profile: %d program workers and the scan thread need more than the %ld CPUs available\n", program_workers, online_cpus);
+            log(log_msg);
+            problems++;
+        }
+        if (CPU_COUNT(&scan_overlap) > 0)
+        {
+            sprintf(log_msg, "Runtime profile: worker_cpus and scan_cpus overlap. Programs of the same wave will not run in parallel\n");
+            log(log_msg);
+            problems++;
+        }
+        if (CPU_COUNT(&io_overlap) > 0)
+        {
+            sprintf(log_msg, "Runtime profile: worker_cpus and io_cpus overlap. I/O threads can preempt the program workers\n");
+            log(log_msg);
+            problems++;
+        }
+    }
+
+    //in event mode the task tick only advances when the program runs
+    if (scan_mode == SCAN_EVENT && greatest_tick_count__ > 1)
+    {
+        sprintf(log_msg, "Runtime profile: event driven scan with tasks of different intervals. Slow tasks run every %lu program runs, not on a fixed period\n", greatest_tick_count__);
+        log(log_msg);
+        problems++;
+    }
+
+    //cores used for the scan should be removed from the general scheduler
+    if (rt_config.scan_cpus_set)
+    {
+        cpu_set_t isolated;
+        char isolated_list[256] = "";
+        FILE *isolated_file = fopen("/sys/devices/system/cpu/isolated", "r");
+        if (isolated_file != NULL)
+        {
+            if (fgets(isolated_list, sizeof(isolated_list), isolated_file) == NULL) isolated_list[0] = '\0';
+            fclose(isolated_file);
+        }
+
+        char *list = trimBlanks(isolated_list);
+        if (list[0] == '\0' || !parseCpuList(list, &isolated)) CPU_ZERO(&isolated);
+        for (int cpu = 0; cpu < MAX_CFG_CPUS; cpu++)
+        {
+            if (CPU_ISSET(cpu, &rt_config.scan_cpus) && !CPU_ISSET(cpu, &isolated))
+            {
+                sprintf(log_msg, "Runtime profile: scan CPU %d is not isolated (add it to isolcpus)\n", cpu);
+                log(log_msg);
+                problems++;
+            }
+        }
+    }
+
+    if (scan->policy == SCHED_FIFO || scan->policy == SCHED_RR)
+    {
+        if (scan->priority < sched_get_priority_min(scan->policy) || scan->priority > sched_get_priority_max(scan->policy))
+        {
+            sprintf(log_msg, "Runtime profile: scan priority %d is out of range for %s\n", scan->priority, policyName(scan->policy));
+            log(log_msg);
+            problems++;
+        }
+    }
+
+    for (int i = 0; i < NUM_THREAD_CLASSES; i++)
+    {
+        if (i == THREAD_SCAN || i == THREAD_WORKER) continue;
+        if (scan->policy != SCHED_DEADLINE && rt_config.threads[i].policy != SCHED_OTHER &&
+            rt_config.threads[i].priority >= scan->priority)
+        {
+            sprintf(log_msg, "Runtime profile: %s priority %d is not below the scan priority %d\n", rt_config.threads[i].name, rt_config.threads[i].priority, scan->priority);
+            log(log_msg);
+            problems++;
+        }
+    }
+
+    if (scan->policy == SCHED_DEADLINE)
+    {
+        unsigned long long period = rt_config.deadline_period_ns ? rt_config.deadline_period_ns : common_ticktime__;
+        if (rt_config.deadline_runtime_ns == 0 || rt_config.deadline_runtime_ns > period)
+        {
+            sprintf(log_msg, "Runtime profile: deadline_runtime_us must be greater than 0 and not above the period (%llu us)\n", period / 1000);
+            log(log_msg);
+            problems++;
+        }
+        if (period != common_ticktime__)
+        {
+            sprintf(log_msg, "Runtime profile: deadline period (%llu us) differs from the program cycle (%llu us)\n", period / 1000, common_ticktime__ / 1000);
+            log(log_msg);
+            problems++;
+        }
+        if (rt_config.scan_cpus_set)
+        {
+            sprintf(log_msg, "Runtime profile: scan_cpus is ignored with SCHED_DEADLINE. Use an exclusive cpuset instead\n");
+            log(log_msg);
+            problems++;
+        }
+    }
+
+    if (!rt_config.lock_memory && (rt_config.prefault_stack_kb > 0 || rt_config.prefault_heap_kb > 0))
+    {
+        sprintf(log_msg, "Runtime profile: prefaulting without lock_memory does not prevent page faults\n");
+        log(log_msg);
+        problems++;
+    }
+
+    return problems;
+}
+
+//-----------------------------------------------------------------------------
+// Logs the configuration that is actually in effect for the calling thread,
+// as reported by the kernel
+//-----------------------------------------------------------------------------
+void reportRuntimeConfig()
+{
+    unsigned char log_msg[1000];
+    char cpu_list[256];
+
+#ifdef __linux__
+    cpu_set_t effective_cpus;
+    int policy = sched_getscheduler(0);
+    struct sched_param sp;
+    pthread_getschedparam(pthread_self(), &policy, &sp);
+    if (sched_getscheduler(0) == SCHED_DEADLINE) policy = SCHED_DEADLINE;
+
+    CPU_ZERO(&effective_cpus);
+    pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &effective_cpus);
+    formatCpuList(&effective_cpus, cpu_list, sizeof(cpu_list));
+
+    sprintf(log_msg, "Runtime profile: scan thread policy=%s priority=%d cpus=%s\n", policyName(policy), sp.sched_priority, cpu_list);
+    log(log_msg);
+#endif
+
+    if (rt_config.io_cpus_set)
+    {
+        formatCpuList(&rt_config.io_cpus, cpu_list, sizeof(cpu_list));
+    }
+    else
+    {
+        strcpy(cpu_list, "any");
+    }
+
+    for (int i = 0; i < NUM_THREAD_CLASSES; i++)
+    {
+        if (i == THREAD_SCAN || i == THREAD_WORKER) continue;
+        sprintf(log_msg, "Runtime profile: %s threads policy=%s priority=%d cpus=%s\n", rt_config.threads[i].name,
+                policyName(rt_config.threads[i].policy), rt_config.threads[i].priority, cpu_list);
+        log(log_msg);
+    }
+
+    if (rt_config.worker_cpus_set)
+    {
+        formatCpuList(&rt_config.worker_cpus, cpu_list, sizeof(cpu_list));
+    }
+    else
+    {
+        strcpy(cpu_list, "any");
+    }
+    sprintf(log_msg, "Runtime profile: %d program worker(s) policy=%s priority=%d cpus=%s\n", program_workers,
+            policyName(rt_config.threads[THREAD_WORKER].policy), rt_config.threads[THREAD_WORKER].priority, cpu_list);
+    log(log_msg);
+
+    const char *policy_names[] = {"catch_up", "skip", "stretch"};
+    sprintf(log_msg, "Runtime profile: overrun policy=%s, watchdog after %d consecutive overruns%s\n", policy_names[overrun_policy],
+            watchdog_overruns, (watchdog_overruns == 0) ? " (disabled)" : "");
+    log(log_msg);
+
+    if (scan_mode == SCAN_EVENT)
+    {
+        sprintf(log_msg, "Runtime profile: event driven scan, inputs polled every %llu ms, program run at least every %d ms\n",
+                (input_poll_ms > 0) ? (unsigned long long)input_poll_ms : common_ticktime__ / 1000000, max_idle_ms);
+    }
+    else
+    {
+        sprintf(log_msg, "Runtime profile: cyclic scan\n");
+    }
+    log(log_msg);
+
+    sprintf(log_msg, "Runtime profile: POU profiler timing one scan out of %d%s\n", pou_profile_rate,
+            (pou_profile_rate == 0) ? " (disabled)" : "");
+    log(log_msg);
+
+    sprintf(log_msg, "Runtime profile: memory locked=%s, prefault stack=%dKB heap=%dKB\n", rt_config.lock_memory ? "yes" : "no",
+            rt_config.prefault_stack_kb, rt_config.prefault_heap_kb);
+    log(log_msg);
+
+    sprintf(log_msg, "Runtime profile: thread stacks=%dKB (workers %dKB), up to %d protocol connection(s), log buffer=%dKB, %llu KB locked so far\n",
+            rt_config.thread_stack_kb, rt_config.worker_stack_kb, max_connections, log_buffer_kb, processMemoryKb("VmLck"));
+    log(log_msg);
+
+    int problems = checkRuntimeConfig();
+    if (problems > 0)
+    {
+        sprintf(log_msg, "Runtime profile: %d problem(s) found, real-time behavior may be degraded\n", problems);
+        log(log_msg);
+    }
+}
@@ -0,0 +1,607 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 OpenPLC Project
+// This file is part of the OpenPLC Software Stack.
+//
+// OpenPLC is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenPLC is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with OpenPLC.  If not, see <http://www.gnu.org/licenses/>.
+//------
+//
+// This file implements the scan pipeline. Each scan cycle is a list of
+// stages registered at startup (read inputs, run the program, write
+// outputs...). A stage can tell the pipeline it has nothing to do on this
+// cycle, in which case it is skipped. Stages that touch the PLC buffers are
+// executed with bufferLock held. Every stage is timed individually so the
+// cost of the housekeeping can be compared with the cost of the logic.
+//
+// It also paces the cycle. When a scan runs past its period the configured
+// overrun policy decides what happens to the missed cycles, and a watchdog
+// can force the outputs to a safe state after too many consecutive overruns.
+// The IEC time base follows the monotonic clock, so timers keep real time
+// regardless of the policy. The time spent waiting for bufferLock and the
+// lateness of each wake-up are recorded as well, since that is where load on
+// the protocol servers shows up as scan jitter.
+//
+// In event mode the program only runs when something can change its result:
+// a protocol or Modbus master write, a change of a located input, the expiry
+// of a running TP/TON/TOF or, as a safety net, after max_idle_ms without a
+// run. The rest of the pipeline keeps polling the I/O at input_poll_ms (or at
+// the program cycle), and the scan thread sleeps in between.
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <limits.h>
+#include <pthread.h>
+
+#include "iec_types.h"
+#include "ladder.h"
+
+#define MAX_SCAN_STAGES     16
+
+struct scan_stage
+{
+    const char *name;
+    void (*run)();
+    bool (*has_work)();
+    bool needs_lock;
+
+    unsigned long long runs;
+    unsigned long long skips;
+    unsigned long long last_ns;
+    unsigned long long max_ns;
+    unsigned long long total_ns;
+};
+
+struct scan_stage scan_stages[MAX_SCAN_STAGES];
+int num_scan_stages = 0;
+
+extern pthread_mutex_t bufferLock;
+extern IEC_TIME __CURRENT_TIME;
+
+//overrun handling (configured in runtime.cfg)
+int overrun_policy = OVERRUN_CATCH_UP;
+int watchdog_overruns = 0; //0 disables the watchdog
+bool watchdog_tripped = false; //written by resetWatchdog() from the interactive server
+
+unsigned long long overrun_count = 0;
+unsigned long long skipped_cycles = 0;
+unsigned long long consecutive_overruns = 0;
+unsigned long long max_consecutive_overruns = 0;
+unsigned long long max_overrun_ns = 0;
+
+//scan jitter
+unsigned long long lock_waits = 0;
+unsigned long long lock_wait_total_ns = 0;
+unsigned long long lock_wait_max_ns = 0;
+unsigned long long wakeups = 0;
+unsigned long long wakeup_total_ns = 0;
+unsigned long long wakeup_max_ns = 0;
+
+//event driven scan (configured in runtime.cfg)
+int scan_mode = SCAN_CYCLIC;
+int max_idle_ms = 1000;
+int input_poll_ms = 0; //0 polls the inputs at the program cycle
+
+//earliest expiry of a running timer, in ns of __CURRENT_TIME. Set by the
+//timer blocks through __timer_deadline_hint() (see iec_std_lib.h)
+unsigned long long __next_timer_deadline = ULLONG_MAX;
+
+unsigned long long event_scans = 0;
+unsigned long long input_scans = 0;
+unsigned long long timer_scans = 0;
+unsigned long long idle_scans = 0;
+
+static bool scan_event_pending = true; //the first scan always runs the program
+static pthread_mutex_t scan_event_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t scan_event_cond;
+static pthread_once_t scan_event_once = PTHREAD_ONCE_INIT;
+static struct timespec last_logic_run;
+
+//located inputs watched for changes in event mode
+struct input_watch
+{
+    char size;
+    void *value;
+    unsigned short last;
+};
+
+static struct input_watch *input_watches = NULL;
+static int num_input_watches = -1; //-1 until the list is built
+
+struct timespec time_base;
+
+//-----------------------------------------------------------------------------
+// Helper function - Returns the elapsed time between two timestamps in
+// nanoseconds
+//-----------------------------------------------------------------------------
+static inline unsigned long long elapsedNs(struct timespec *start, struct timespec *end)
+{
+    return (unsigned long long)(end->tv_sec - start->tv_sec) * 1000000000ULL + end->tv_nsec - start->tv_nsec;
+}
+
+//-----------------------------------------------------------------------------
+// Appends a stage to the end of the scan pipeline. has_work can be NULL for
+// stages that must run on every cycle. Stages with needs_lock set run with
+// bufferLock held
+//-----------------------------------------------------------------------------
+void addScanStage(const char *name, void (*run)(), bool (*has_work)(), bool needs_lock)
+{
+    if (num_scan_stages >= MAX_SCAN_STAGES)
+    {
+        unsigned char log_msg[1000];
+        sprintf(log_msg, "Scan pipeline is full. Stage %s was not added\n", name);
+        log(log_msg);
+        return;
+    }
+
+    struct scan_stage *stage = &scan_stages[num_scan_stages];
+    memset(stage, 0, sizeof(struct scan_stage));
+    stage->name = name;
+    stage->run = run;
+    stage->has_work = has_work;
+    stage->needs_lock = needs_lock;
+    num_scan_stages++;
+}
+
+//-----------------------------------------------------------------------------
+// Executes one scan cycle. Consecutive stages that need the buffer lock share
+// a single lock/unlock pair
+//-----------------------------------------------------------------------------
+void runScanPipeline()
+{
+    bool locked = false;
+    struct timespec stage_start, stage_end;
+
+    for (int i = 0; i < num_scan_stages; i++)
+    {
+        struct scan_stage *stage = &scan_stages[i];
+
+        if (stage->needs_lock && !locked)
+        {
+            clock_gettime(CLOCK_MONOTONIC, &stage_start);
+            pthread_mutex_lock(&bufferLock);
+            clock_gettime(CLOCK_MONOTONIC, &stage_end);
+            locked = true;
+
+            unsigned long long wait = elapsedNs(&stage_start, &stage_end);
+            lock_waits++;
+            lock_wait_total_ns += wait;
+            if (wait > lock_wait_max_ns) lock_wait_max_ns = wait;
+        }
+        else if (!stage->needs_lock && locked)
+        {
+            pthread_mutex_unlock(&bufferLock);
+            locked = false;
+        }
+
+        if (stage->has_work != NULL && !stage->has_work())
+        {
+            stage->skips++;
+            continue;
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &stage_start);
+        stage->run();
+        clock_gettime(CLOCK_MONOTONIC, &stage_end);
+
+        unsigned long long duration = elapsedNs(&stage_start, &stage_end);
+        stage->runs++;
+        stage->last_ns = duration;
+        stage->total_ns += duration;
+        if (duration > stage->max_ns) stage->max_ns = duration;
+    }
+
+    if (locked) pthread_mutex_unlock(&bufferLock);
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Adds a number of nanoseconds to a timestamp
+//-----------------------------------------------------------------------------
+static inline void addNs(struct timespec *ts, unsigned long long ns)
+{
+    ts->tv_sec += ns / 1000000000ULL;
+    ts->tv_nsec += ns % 1000000000ULL;
+    if (ts->tv_nsec >= 1000000000)
+    {
+        ts->tv_nsec -= 1000000000;
+        ts->tv_sec++;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Returns true if timestamp a is later than timestamp b
+//-----------------------------------------------------------------------------
+static inline bool isLater(struct timespec *a, struct timespec *b)
+{
+    return (a->tv_sec > b->tv_sec || (a->tv_sec == b->tv_sec && a->tv_nsec > b->tv_nsec));
+}
+
+//-----------------------------------------------------------------------------
+// Updates the IEC time base (__CURRENT_TIME) from the monotonic clock. The
+// time base starts one cycle after the first scan, the same value the
+// nominal tick count used to give
+//-----------------------------------------------------------------------------
+void updateTime()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    if (time_base.tv_sec == 0 && time_base.tv_nsec == 0)
+    {
+        time_base = now;
+        time_base.tv_sec -= common_ticktime__ / 1000000000ULL;
+        time_base.tv_nsec -= common_ticktime__ % 1000000000ULL;
+        if (time_base.tv_nsec < 0)
+        {
+            time_base.tv_nsec += 1000000000;
+            time_base.tv_sec--;
+        }
+    }
+
+    __CURRENT_TIME.tv_sec = now.tv_sec - time_base.tv_sec;
+    __CURRENT_TIME.tv_nsec = now.tv_nsec - time_base.tv_nsec;
+    if (__CURRENT_TIME.tv_nsec < 0)
+    {
+        __CURRENT_TIME.tv_nsec += 1000000000;
+        __CURRENT_TIME.tv_sec--;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Sleeps until the deadline and records how late the thread
+// actually woke up
+//-----------------------------------------------------------------------------
+static void sleepUntil(struct timespec *deadline)
+{
+    struct timespec now;
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, deadline, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    unsigned long long late = isLater(&now, deadline) ? elapsedNs(deadline, &now) : 0;
+    wakeups++;
+    wakeup_total_ns += late;
+    if (late > wakeup_max_ns) wakeup_max_ns = late;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Creates the condition used to wake the scan thread. It
+// waits on the monotonic clock, like the rest of the scan
+//-----------------------------------------------------------------------------
+static void initScanEvents()
+{
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&scan_event_cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+//-----------------------------------------------------------------------------
+// Tells the scan that the program inputs changed and it should run as soon as
+// possible. Called by the protocol servers and the Modbus master after they
+// write to the buffers. Does nothing in cyclic mode
+//-----------------------------------------------------------------------------
+void notifyScanEvent()
+{
+    if (scan_mode != SCAN_EVENT) return;
+
+    pthread_once(&scan_event_once, initScanEvents);
+    pthread_mutex_lock(&scan_event_lock);
+    scan_event_pending = true;
+    pthread_cond_signal(&scan_event_cond);
+    pthread_mutex_unlock(&scan_event_lock);
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Builds the list of located inputs (%IX, %IB and %IW) used
+// by the program, with their current values
+//-----------------------------------------------------------------------------
+static void buildInputWatches()
+{
+    num_input_watches = 0;
+    if (located_address_count == 0) return;
+
+    input_watches = (struct input_watch *)malloc(sizeof(struct input_watch) * located_address_count);
+    if (input_watches == NULL) return;
+
+    for (int i = 0; i < located_address_count; i++)
+    {
+        const struct located_address *address = &located_address_map[i];
+        void *value = NULL;
+
+        if (address->area != 'I' || address->pos1 >= BUFFER_SIZE) continue;
+        if (address->size == 'X' && address->pos2 < 8) value = bool_input[address->pos1][address->pos2];
+        else if (address->size == 'B') value = byte_input[address->pos1];
+        else if (address->size == 'W') value = int_input[address->pos1];
+        if (value == NULL) continue;
+
+        struct input_watch *watch = &input_watches[num_input_watches++];
+        watch->size = address->size;
+        watch->value = value;
+        watch->last = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Compares the located inputs with the values they had on
+// the previous call. Returns true if any of them changed
+//-----------------------------------------------------------------------------
+static bool inputsChanged()
+{
+    bool changed = false;
+    if (num_input_watches < 0) buildInputWatches();
+
+    for (int i = 0; i < num_input_watches; i++)
+    {
+        struct input_watch *watch = &input_watches[i];
+        unsigned short value;
+        if (watch->size == 'X') value = *(IEC_BOOL *)watch->value;
+        else if (watch->size == 'B') value = *(IEC_BYTE *)watch->value;
+        else value = *(IEC_UINT *)watch->value;
+
+        if (value != watch->last)
+        {
+            watch->last = value;
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+//-----------------------------------------------------------------------------
+// Scan pipeline hint for the program logic. In cyclic mode the program runs
+// on every cycle. In event mode it only runs when there is a reason to, and
+// the reason is counted
+//-----------------------------------------------------------------------------
+bool plcLogicDue()
+{
+    if (__atomic_load_n(&watchdog_tripped, __ATOMIC_ACQUIRE)) return false;
+    if (scan_mode != SCAN_EVENT) return true;
+
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    pthread_mutex_lock(&scan_event_lock);
+    bool event = scan_event_pending;
+    scan_event_pending = false;
+    pthread_mutex_unlock(&scan_event_lock);
+
+    //always compared, so the previous values stay current
+    bool input = inputsChanged();
+
+    unsigned long long current_ns = (unsigned long long)__CURRENT_TIME.tv_sec * 1000000000ULL + __CURRENT_TIME.tv_nsec;
+
+    if (event) event_scans++;
+    else if (input) input_scans++;
+    else if (__next_timer_deadline <= current_ns) timer_scans++;
+    else if (elapsedNs(&last_logic_run, &now) >= (unsigned long long)max_idle_ms * 1000000ULL) idle_scans++;
+    else return false;
+
+    //the running timers record their expiry again while the program runs
+    __next_timer_deadline = ULLONG_MAX;
+    last_logic_run = now;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Event mode version of waitNextCycle. Sleeps until the
+// next input poll, the expiry of the earliest running timer or the end of the
+// idle interval, whichever comes first, unless notifyScanEvent() wakes the
+// scan earlier
+//-----------------------------------------------------------------------------
+static unsigned long waitNextEvent(struct timespec *next_cycle)
+{
+    struct timespec now, wake;
+    unsigned long long poll_ns = (input_poll_ms > 0) ? (unsigned long long)input_poll_ms * 1000000ULL : common_ticktime__;
+
+    pthread_once(&scan_event_once, initScanEvents);
+
+    //next input poll. A late poll restarts the schedule from now
+    addNs(next_cycle, poll_ns);
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    if (isLater(&now, next_cycle)) *next_cycle = now;
+    wake = *next_cycle;
+
+    struct timespec idle_end = last_logic_run;
+    addNs(&idle_end, (unsigned long long)max_idle_ms * 1000000ULL);
+    if (isLater(&wake, &idle_end)) wake = idle_end;
+
+    unsigned long long deadline = __next_timer_deadline;
+    if (deadline != ULLONG_MAX)
+    {
+        struct timespec timer_end = time_base;
+        addNs(&timer_end, deadline);
+        if (isLater(&wake, &timer_end)) wake = timer_end;
+    }
+
+    int result = 0;
+    pthread_mutex_lock(&scan_event_lock);
+    while (!scan_event_pending && result == 0)
+    {
+        result = pthread_cond_timedwait(&scan_event_cond, &scan_event_lock, &wake);
+    }
+    pthread_mutex_unlock(&scan_event_lock);
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    if (result != 0)
+    {
+        unsigned long long late = isLater(&now, &wake) ? elapsedNs(&wake, &now) : 0;
+        wakeups++;
+        wakeup_total_ns += late;
+        if (late > wakeup_max_ns) wakeup_max_ns = late;
+    }
+
+    //woken early by an event: the next poll is counted from here
+    if (isLater(next_cycle, &now)) *next_cycle = now;
+
+    //the timers must see the time at which the scan woke up
+    updateTime();
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+// Sleeps until the start of the next cycle. next_cycle holds the start of the
+// cycle that just finished and is advanced according to the overrun policy:
+//  - catch up: missed cycles run back to back until the schedule is met
+//  - skip: missed cycles are dropped and the schedule keeps its phase
+//  - stretch: the late cycle is extended and the schedule restarts from now
+// Returns the number of cycles that were skipped, so the caller can keep the
+// task tick in step with real time. In event mode the tick only advances when
+// the program runs
+//-----------------------------------------------------------------------------
+unsigned long waitNextCycle(struct timespec *next_cycle)
+{
+    unsigned char log_msg[1000];
+    unsigned long skipped = 0;
+    struct timespec now;
+
+    if (scan_mode == SCAN_EVENT) return waitNextEvent(next_cycle);
+
+    addNs(next_cycle, common_ticktime__);
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    if (!isLater(&now, next_cycle))
+    {
+        consecutive_overruns = 0;
+        sleepUntil(next_cycle);
+        return 0;
+    }
+
+    //the scan finished after the start of the next cycle
+    unsigned long long late_ns = elapsedNs(next_cycle, &now);
+    overrun_count++;
+    consecutive_overruns++;
+    if (consecutive_overruns > max_consecutive_overruns) max_consecutive_overruns = consecutive_overruns;
+    if (late_ns > max_overrun_ns) max_overrun_ns = late_ns;
+    flightRecorderOverrun();
+
+    if (overrun_policy == OVERRUN_SKIP)
+    {
+        skipped = late_ns / common_ticktime__ + 1;
+        addNs(next_cycle, skipped * common_ticktime__);
+        skipped_cycles += skipped;
+    }
+    else if (overrun_policy == OVERRUN_STRETCH)
+    {
+        *next_cycle = now;
+    }
+
+    if (watchdog_overruns > 0 && consecutive_overruns >= (unsigned long long)watchdog_overruns && !__atomic_load_n(&watchdog_tripped, __ATOMIC_ACQUIRE))
+    {
+        __atomic_store_n(&watchdog_tripped, true, __ATOMIC_RELEASE);
+        sprintf(log_msg, "Watchdog: %llu consecutive scan overruns. Outputs forced to a safe state\n", consecutive_overruns);
+        log(log_msg);
+    }
+
+    sleepUntil(next_cycle);
+    return skipped;
+}
+
+//-----------------------------------------------------------------------------
+// Scan pipeline hints for the watchdog. Once tripped, the program logic stops
+// and the safe state stage keeps the outputs disabled
+//-----------------------------------------------------------------------------
+bool watchdogTripped()
+{
+    return __atomic_load_n(&watchdog_tripped, __ATOMIC_ACQUIRE);
+}
+
+//-----------------------------------------------------------------------------
+// Resumes normal operation after the watchdog tripped
+//-----------------------------------------------------------------------------
+void resetWatchdog()
+{
+    unsigned char log_msg[1000];
+    if (__atomic_load_n(&watchdog_tripped, __ATOMIC_ACQUIRE))
+    {
+        sprintf(log_msg, "Watchdog: reset, resuming program execution\n");
+        log(log_msg);
+    }
+    consecutive_overruns = 0;
+    __atomic_store_n(&watchdog_tripped, false, __ATOMIC_RELEASE);
+}
+
+//-----------------------------------------------------------------------------
+// Clears the timing statistics of all stages
+//-----------------------------------------------------------------------------
+void resetScanStats()
+{
+    for (int i = 0; i < num_scan_stages; i++)
+    {
+        scan_stages[i].runs = 0;
+        scan_stages[i].skips = 0;
+        scan_stages[i].last_ns = 0;
+        scan_stages[i].max_ns = 0;
+        scan_stages[i].total_ns = 0;
+    }
+
+    overrun_count = 0;
+    skipped_cycles = 0;
+    max_consecutive_overruns = 0;
+    max_overrun_ns = 0;
+
+    lock_waits = 0;
+    lock_wait_total_ns = 0;
+    lock_wait_max_ns = 0;
+    wakeups = 0;
+    wakeup_total_ns = 0;
+    wakeup_max_ns = 0;
+
+    event_scans = 0;
+    input_scans = 0;
+    timer_scans = 0;
+    idle_scans = 0;
+}
+
+//-----------------------------------------------------------------------------
+// Writes one line per stage with its run/skip counters and timings (in
+// nanoseconds) to the buffer. Returns the number of characters written
+//-----------------------------------------------------------------------------
+int scanStatsReport(char *buffer, int buffer_size)
+{
+    int count_char = snprintf(buffer, buffer_size, "stage,runs,skips,last_ns,avg_ns,max_ns\n");
+
+    for (int i = 0; i < num_scan_stages && count_char < buffer_size; i++)
+    {
+        struct scan_stage *stage = &scan_stages[i];
+        unsigned long long avg = (stage->runs > 0) ? stage->total_ns / stage->runs : 0;
+        count_char += snprintf(buffer + count_char, buffer_size - count_char, "%s,%llu,%llu,%llu,%llu,%llu\n",
+                               stage->name, stage->runs, stage->skips, stage->last_ns, avg, stage->max_ns);
+    }
+
+    if (count_char < buffer_size)
+    {
+        count_char += snprintf(buffer + count_char, buffer_size - count_char, "overruns=%llu,skipped_cycles=%llu,consecutive=%llu,max_consecutive=%llu,max_overrun_ns=%llu,watchdog=%s\n",
+                               overrun_count, skipped_cycles, consecutive_overruns, max_consecutive_overruns, max_overrun_ns,
+                               __atomic_load_n(&watchdog_tripped, __ATOMIC_ACQUIRE) ? "tripped" : "ok");
+    }
+
+    if (count_char < buffer_size)
+    {
+        count_char += snprintf(buffer + count_char, buffer_size - count_char, "lock_wait_avg_ns=%llu,lock_wait_max_ns=%llu,wakeup_avg_ns=%llu,wakeup_max_ns=%llu\n",
+                               lock_waits > 0 ? lock_wait_total_ns / lock_waits : 0, lock_wait_max_ns,
+                               wakeups > 0 ? wakeup_total_ns / wakeups : 0, wakeup_max_ns);
+    }
+
+    if (scan_mode == SCAN_EVENT && count_char < buffer_size)
+    {
+        count_char += snprintf(buffer + count_char, buffer_size - count_char, "event_scans=%llu,input_scans=%llu,timer_scans=%llu,idle_scans=%llu\n",
+                               event_scans, input_scans, timer_scans, idle_scans);
+    }
+
+    if (count_char > buffer_size) count_char = buffer_size;
+    return count_char;
+}
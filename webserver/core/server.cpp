@@ -30,12 +30,57 @@
 #include <pthread.h>
 #include <fcntl.h>
 
+#ifdef __linux__
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#if defined(__has_include) && defined(__NR_io_uring_setup)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#ifdef IORING_FEAT_FAST_POLL
+#define NET_IO_URING_SUPPORTED
+#endif
+#endif
+#endif
+#endif
+
 #include "ladder.h"
 
-#define MAX_INPUT 16
 #define MAX_OUTPUT 16
 #define MAX_MODBUS 100
 #define NET_BUFFER_SIZE 10000
+#define EVENT_BATCH 64
+#define EVENT_TIMEOUT_MS 100
+
+//most clients the Modbus and EtherNet/IP servers serve at the same time
+//(configured in runtime.cfg)
+int max_connections = 16;
+
+//how the Modbus and EtherNet/IP servers wait for their clients: a thread per
+//client, epoll or io_uring (configured in runtime.cfg)
+int net_backend = NET_THREADS;
+
+//Connection slots, shared by the Modbus and EtherNet/IP servers. They are
+//allocated once, with their buffers, so a burst of clients can not make the
+//runtime grow past the configured limit
+struct client_connection
+{
+    int fd;
+    int protocol_type;
+    bool in_use;
+    unsigned char *buffer;
+    int dirty_size;         //bytes of the buffer used by the last request (event backends)
+    int response_size;      //response being sent (io_uring backend)
+    int response_sent;
+};
+
+static struct client_connection *connections = NULL;
+static unsigned char *connection_buffers = NULL;
+static int connection_slots = 0;
+static int connections_in_use = 0;
+static pthread_mutex_t connections_lock = PTHREAD_MUTEX_INITIALIZER;
 
 
 //-----------------------------------------------------------------------------
@@ -128,6 +173,92 @@ int createSocket(uint16_t port)
     return socket_fd;
 }
 
+//-----------------------------------------------------------------------------
+// Helper function - Allocates the connection slots the first time a server
+// starts. Must be called with connections_lock held
+//-----------------------------------------------------------------------------
+static void initConnectionPool()
+{
+    unsigned char log_msg[1000];
+    if (connections != NULL) return;
+
+    connections = (struct client_connection *)calloc(max_connections, sizeof(struct client_connection));
+    connection_buffers = (unsigned char *)calloc(max_connections, NET_BUFFER_SIZE);
+    if (connections == NULL || connection_buffers == NULL)
+    {
+        free(connections);
+        free(connection_buffers);
+        connections = NULL;
+        connection_buffers = NULL;
+        sprintf(log_msg, "Server: could not allocate %d connection slots\n", max_connections);
+        log(log_msg);
+        return;
+    }
+
+    for (int i = 0; i < max_connections; i++)
+    {
+        connections[i].fd = -1;
+        connections[i].buffer = connection_buffers + (size_t)i * NET_BUFFER_SIZE;
+    }
+    connection_slots = max_connections;
+}
+
+//-----------------------------------------------------------------------------
+// Helper functions - Take and give back a connection slot. acquireConnection
+// returns NULL when all slots are in use. freeConnection must be called with
+// connections_lock held
+//-----------------------------------------------------------------------------
+static struct client_connection *acquireConnection(int client_fd, int protocol_type)
+{
+    struct client_connection *connection = NULL;
+
+    pthread_mutex_lock(&connections_lock);
+    initConnectionPool();
+    for (int i = 0; i < connection_slots; i++)
+    {
+        if (!connections[i].in_use)
+        {
+            connection = &connections[i];
+            connection->in_use = true;
+            connection->fd = client_fd;
+            connection->protocol_type = protocol_type;
+            connection->dirty_size = NET_BUFFER_SIZE;
+            connections_in_use++;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&connections_lock);
+
+    return connection;
+}
+
+static void freeConnection(struct client_connection *connection)
+{
+    connection->in_use = false;
+    connection->fd = -1;
+    connections_in_use--;
+}
+
+static void releaseConnection(struct client_connection *connection)
+{
+    pthread_mutex_lock(&connections_lock);
+    freeConnection(connection);
+    pthread_mutex_unlock(&connections_lock);
+}
+
+//-----------------------------------------------------------------------------
+// Returns the memory taken by the connection slots and the number of slots
+// in use, for the memory report
+//-----------------------------------------------------------------------------
+unsigned long long connectionPoolMemory(int *in_use)
+{
+    pthread_mutex_lock(&connections_lock);
+    unsigned long long size = (unsigned long long)connection_slots * (sizeof(struct client_connection) + NET_BUFFER_SIZE);
+    *in_use = connections_in_use;
+    pthread_mutex_unlock(&connections_lock);
+    return size;
+}
+
 //-----------------------------------------------------------------------------
 // Blocking call. Wait here for the client to connect. Returns the file
 // descriptor to communicate with the client.
@@ -192,16 +323,556 @@ void processMessage(unsigned char *buffer, int bufferSize, int client_fd, int pr
     }
 }
 
+//-----------------------------------------------------------------------------
+// Helper function - Runs the request sitting in the buffer of a connection
+// through its protocol. The response replaces the request in the buffer.
+// Returns the size of the response
+//-----------------------------------------------------------------------------
+static int processConnectionMessage(struct client_connection *connection, int size)
+{
+    int messageSize = 0;
+    if (connection->protocol_type == MODBUS_PROTOCOL)
+        messageSize = processModbusMessage(connection->buffer, size);
+    else if (connection->protocol_type == ENIP_PROTOCOL)
+        messageSize = processEnipMessage(connection->buffer, size);
+
+    //the buffer is clean past the bytes used here, as listenToClient leaves it
+    connection->dirty_size = (messageSize > size) ? messageSize : size;
+    return messageSize;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Clears what the last request left in the buffer of a
+// connection before it receives the next one
+//-----------------------------------------------------------------------------
+static void cleanConnectionBuffer(struct client_connection *connection)
+{
+    if (connection->dirty_size > 0) memset(connection->buffer, 0, connection->dirty_size);
+    connection->dirty_size = 0;
+}
+
+#ifdef __linux__
+//-----------------------------------------------------------------------------
+// epoll backend. One thread per server serves all of its clients: epoll_wait
+// returns every connection with a request in a single call, and each request
+// is read, processed and answered right away
+//-----------------------------------------------------------------------------
+#define LISTEN_EVENT    ((void *)-1)
+
+//-----------------------------------------------------------------------------
+// Helper function - Writes the whole response on a non-blocking socket.
+// Returns false if the client is gone
+//-----------------------------------------------------------------------------
+static bool sendResponse(int client_fd, unsigned char *buffer, int size)
+{
+    int sent = 0;
+    while (sent < size)
+    {
+        int n = write(client_fd, buffer + sent, size - sent);
+        if (n > 0)
+        {
+            sent += n;
+        }
+        else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            struct pollfd pfd = {client_fd, POLLOUT, 0};
+            if (poll(&pfd, 1, EVENT_TIMEOUT_MS) <= 0) return false;
+        }
+        else if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Accepts every client waiting on the listening socket and
+// adds it to the epoll set
+//-----------------------------------------------------------------------------
+static void acceptEpollClients(int epoll_fd, int socket_fd, int protocol_type)
+{
+    unsigned char log_msg[1000];
+
+    while (true)
+    {
+        int client_fd = accept(socket_fd, NULL, NULL);
+        if (client_fd < 0) return;
+
+        struct client_connection *connection = acquireConnection(client_fd, protocol_type);
+        if (connection == NULL)
+        {
+            sprintf(log_msg, "Server: %d connections open already, refusing client ID: %d\n", max_connections, client_fd);
+            log(log_msg);
+            closeSocket(client_fd);
+            continue;
+        }
+
+        SetSocketBlockingEnabled(client_fd, false);
+        struct epoll_event event;
+        event.events = EPOLLIN;
+        event.data.ptr = connection;
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, client_fd, &event) < 0)
+        {
+            closeSocket(client_fd);
+            releaseConnection(connection);
+            continue;
+        }
+
+        sprintf(log_msg, "Server: Client accepted! Client ID: %d\n", client_fd);
+        log(log_msg);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Closes a client of an event backend
+//-----------------------------------------------------------------------------
+static void dropEventClient(struct client_connection *connection, int messageSize)
+{
+    unsigned char log_msg[1000];
+
+    if (messageSize == 0)
+        sprintf(log_msg, "Server: client ID: %d has closed the connection\n", connection->fd);
+    else
+        sprintf(log_msg, "Server: Something is wrong with the client ID: %d message Size : %i\n", connection->fd, messageSize);
+    log(log_msg);
+
+    closeSocket(connection->fd);
+    releaseConnection(connection);
+}
+
+//-----------------------------------------------------------------------------
+// Serves the clients of a server with epoll until the server is stopped.
+// Returns false if epoll is not available
+//-----------------------------------------------------------------------------
+static bool serveEpoll(int socket_fd, int protocol_type, bool *run_server)
+{
+    unsigned char log_msg[1000];
+    struct epoll_event events[EVENT_BATCH];
+
+    int epoll_fd = epoll_create1(0);
+    if (epoll_fd < 0) return false;
+
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = LISTEN_EVENT;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, socket_fd, &event) < 0)
+    {
+        close(epoll_fd);
+        return false;
+    }
+
+    sprintf(log_msg, "Server: serving clients with epoll\n");
+    log(log_msg);
+
+    while (*run_server)
+    {
+        int count = epoll_wait(epoll_fd, events, EVENT_BATCH, EVENT_TIMEOUT_MS);
+        for (int i = 0; i < count; i++)
+        {
+            if (events[i].data.ptr == LISTEN_EVENT)
+            {
+                acceptEpollClients(epoll_fd, socket_fd, protocol_type);
+                continue;
+            }
+
+            struct client_connection *connection = (struct client_connection *)events[i].data.ptr;
+            cleanConnectionBuffer(connection);
+            int n = read(connection->fd, connection->buffer, NET_BUFFER_SIZE);
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) continue;
+            if (n <= 0)
+            {
+                dropEventClient(connection, n);
+                continue;
+            }
+
+            int messageSize = processConnectionMessage(connection, n);
+            if (messageSize > 0 && !sendResponse(connection->fd, connection->buffer, messageSize))
+                dropEventClient(connection, -1);
+        }
+    }
+
+    //closing the epoll set leaves the clients open, close them here. The
+    //other servers take and give back slots meanwhile, so hold the lock
+    pthread_mutex_lock(&connections_lock);
+    for (int i = 0; i < connection_slots; i++)
+    {
+        if (connections[i].in_use && connections[i].protocol_type == protocol_type)
+        {
+            closeSocket(connections[i].fd);
+            freeConnection(&connections[i]);
+        }
+    }
+    pthread_mutex_unlock(&connections_lock);
+    close(epoll_fd);
+    return true;
+}
+#endif
+
+#ifdef NET_IO_URING_SUPPORTED
+//-----------------------------------------------------------------------------
+// io_uring backend. The receive of every connection stays posted in the
+// ring, into the buffer of its slot of the connection pool, which is
+// registered with the ring once. One io_uring_enter() call submits the
+// responses and receives prepared since the last one and waits for the next
+// batch of completions, so a busy server makes a single system call for many
+// requests. It talks to the kernel through the raw system calls, so the
+// runtime does not need liburing. Needs Linux 5.7 or newer (IORING_FEAT_
+// FAST_POLL); older kernels use the epoll backend
+//-----------------------------------------------------------------------------
+#define URING_ACCEPT    1
+#define URING_READ      2
+#define URING_WRITE     3
+#define URING_TIMEOUT   4
+
+struct uring
+{
+    int fd;
+    unsigned int entries;
+    unsigned int *sq_head;
+    unsigned int *sq_tail;
+    unsigned int *sq_mask;
+    unsigned int *sq_array;
+    struct io_uring_sqe *sqes;
+    unsigned int sqe_tail;      //end of the prepared entries, not in sq_tail until flushed
+    unsigned int sq_pending;    //flushed and not submitted yet
+    unsigned int *cq_head;
+    unsigned int *cq_tail;
+    unsigned int *cq_mask;
+    struct io_uring_cqe *cqes;
+    void *sq_ring;
+    size_t sq_ring_size;
+    void *cq_ring;
+    size_t cq_ring_size;
+    size_t sqes_size;
+};
+
+//-----------------------------------------------------------------------------
+// Helper function - Creates the ring and maps its queues. Returns false if
+// the kernel has no (recent enough) io_uring
+//-----------------------------------------------------------------------------
+static bool setupUring(struct uring *ring, unsigned int entries)
+{
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    memset(ring, 0, sizeof(*ring));
+
+    ring->fd = syscall(__NR_io_uring_setup, entries, &params);
+    if (ring->fd < 0) return false;
+    if (!(params.features & IORING_FEAT_FAST_POLL))
+    {
+        close(ring->fd);
+        return false;
+    }
+
+    ring->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+    ring->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        if (ring->cq_ring_size > ring->sq_ring_size) ring->sq_ring_size = ring->cq_ring_size;
+        ring->cq_ring_size = ring->sq_ring_size;
+    }
+    ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+
+    ring->sq_ring = mmap(NULL, ring->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+    ring->cq_ring = (params.features & IORING_FEAT_SINGLE_MMAP) ? ring->sq_ring :
+                    mmap(NULL, ring->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+    ring->sqes = (struct io_uring_sqe *)mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+    if (ring->sq_ring == MAP_FAILED || ring->cq_ring == MAP_FAILED || ring->sqes == MAP_FAILED)
+    {
+        if (ring->sq_ring != MAP_FAILED) munmap(ring->sq_ring, ring->sq_ring_size);
+        if (ring->cq_ring != MAP_FAILED && ring->cq_ring != ring->sq_ring) munmap(ring->cq_ring, ring->cq_ring_size);
+        if (ring->sqes != MAP_FAILED) munmap(ring->sqes, ring->sqes_size);
+        close(ring->fd);
+        return false;
+    }
+
+    unsigned char *sq = (unsigned char *)ring->sq_ring;
+    unsigned char *cq = (unsigned char *)ring->cq_ring;
+    ring->entries = params.sq_entries;
+    ring->sq_head = (unsigned int *)(sq + params.sq_off.head);
+    ring->sq_tail = (unsigned int *)(sq + params.sq_off.tail);
+    ring->sq_mask = (unsigned int *)(sq + params.sq_off.ring_mask);
+    ring->sq_array = (unsigned int *)(sq + params.sq_off.array);
+    ring->sqe_tail = *ring->sq_tail;
+    ring->cq_head = (unsigned int *)(cq + params.cq_off.head);
+    ring->cq_tail = (unsigned int *)(cq + params.cq_off.tail);
+    ring->cq_mask = (unsigned int *)(cq + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe *)(cq + params.cq_off.cqes);
+    return true;
+}
+
+static void closeUring(struct uring *ring)
+{
+    munmap(ring->sqes, ring->sqes_size);
+    if (ring->cq_ring != ring->sq_ring) munmap(ring->cq_ring, ring->cq_ring_size);
+    munmap(ring->sq_ring, ring->sq_ring_size);
+    close(ring->fd);
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Publishes the prepared entries to the kernel. The tail is
+// only moved once the entries behind it are written, so the kernel (or an
+// SQPOLL thread) never reads an entry that is still being prepared
+//-----------------------------------------------------------------------------
+static void flushUring(struct uring *ring)
+{
+    unsigned int tail = *ring->sq_tail;
+    if (ring->sqe_tail == tail) return;
+    ring->sq_pending += ring->sqe_tail - tail;
+    __atomic_store_n(ring->sq_tail, ring->sqe_tail, __ATOMIC_RELEASE);
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Submits the prepared requests and waits for at least
+// wait_nr completions. Returns the result of io_uring_enter()
+//-----------------------------------------------------------------------------
+static int enterUring(struct uring *ring, unsigned int wait_nr)
+{
+    flushUring(ring);
+    unsigned int to_submit = ring->sq_pending;
+    int ret = syscall(__NR_io_uring_enter, ring->fd, to_submit, wait_nr, wait_nr ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+    if (ret >= 0) ring->sq_pending -= ((unsigned int)ret < to_submit) ? ret : to_submit;
+    return ret;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Returns a free submission entry, cleared. When the queue
+// is full the prepared entries are submitted first. The entry is only handed
+// to the kernel by the next flushUring(), after the caller has filled it in
+//-----------------------------------------------------------------------------
+static struct io_uring_sqe *getUringSqe(struct uring *ring)
+{
+    unsigned int tail = ring->sqe_tail;
+    while (tail - __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE) >= ring->entries)
+    {
+        if (enterUring(ring, 0) < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) return NULL;
+    }
+
+    unsigned int index = tail & *ring->sq_mask;
+    struct io_uring_sqe *sqe = &ring->sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    ring->sq_array[index] = index;
+    ring->sqe_tail = tail + 1;
+    return sqe;
+}
+
+//-----------------------------------------------------------------------------
+// Helper functions - Prepare the requests of the server. user_data holds the
+// kind of request and the slot of the connection
+//-----------------------------------------------------------------------------
+static void postUringAccept(struct uring *ring, int socket_fd)
+{
+    struct io_uring_sqe *sqe = getUringSqe(ring);
+    if (sqe == NULL) return;
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = socket_fd;
+    sqe->user_data = (uint64_t)URING_ACCEPT << 32;
+}
+
+static void postUringRead(struct uring *ring, int slot)
+{
+    struct client_connection *connection = &connections[slot];
+    cleanConnectionBuffer(connection);
+
+    struct io_uring_sqe *sqe = getUringSqe(ring);
+    if (sqe == NULL) return;
+    sqe->opcode = IORING_OP_READ_FIXED;
+    sqe->fd = connection->fd;
+    sqe->addr = (uint64_t)(uintptr_t)connection->buffer;
+    sqe->len = NET_BUFFER_SIZE;
+    sqe->buf_index = slot;
+    sqe->user_data = ((uint64_t)URING_READ << 32) | slot;
+}
+
+static void postUringWrite(struct uring *ring, int slot)
+{
+    struct client_connection *connection = &connections[slot];
+
+    struct io_uring_sqe *sqe = getUringSqe(ring);
+    if (sqe == NULL) return;
+    sqe->opcode = IORING_OP_WRITE_FIXED;
+    sqe->fd = connection->fd;
+    sqe->addr = (uint64_t)(uintptr_t)(connection->buffer + connection->response_sent);
+    sqe->len = connection->response_size - connection->response_sent;
+    sqe->buf_index = slot;
+    sqe->user_data = ((uint64_t)URING_WRITE << 32) | slot;
+}
+
+static void postUringTimeout(struct uring *ring, struct __kernel_timespec *timeout)
+{
+    struct io_uring_sqe *sqe = getUringSqe(ring);
+    if (sqe == NULL) return;
+    sqe->opcode = IORING_OP_TIMEOUT;
+    sqe->fd = -1;
+    sqe->addr = (uint64_t)(uintptr_t)timeout;
+    sqe->len = 1;
+    sqe->user_data = (uint64_t)URING_TIMEOUT << 32;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Handles the completion of one request of the server
+//-----------------------------------------------------------------------------
+static void completeUringRequest(struct uring *ring, struct io_uring_cqe *cqe, int socket_fd, int protocol_type,
+                                 bool *served, struct __kernel_timespec *timeout)
+{
+    unsigned char log_msg[1000];
+    int kind = cqe->user_data >> 32;
+    int slot = cqe->user_data & 0xffffffff;
+    struct client_connection *connection = &connections[slot];
+
+    if (kind == URING_TIMEOUT)
+    {
+        postUringTimeout(ring, timeout);
+    }
+    else if (kind == URING_ACCEPT)
+    {
+        if (cqe->res >= 0)
+        {
+            struct client_connection *accepted = acquireConnection(cqe->res, protocol_type);
+            if (accepted == NULL)
+            {
+                sprintf(log_msg, "Server: %d connections open already, refusing client ID: %d\n", max_connections, cqe->res);
+                log(log_msg);
+                closeSocket(cqe->res);
+            }
+            else
+            {
+                sprintf(log_msg, "Server: Client accepted! Client ID: %d\n", cqe->res);
+                log(log_msg);
+                int accepted_slot = accepted - connections;
+                served[accepted_slot] = true;
+                postUringRead(ring, accepted_slot);
+            }
+        }
+        postUringAccept(ring, socket_fd);
+    }
+    else if (kind == URING_READ)
+    {
+        if (cqe->res <= 0 || cqe->res > NET_BUFFER_SIZE)
+        {
+            served[slot] = false;
+            dropEventClient(connection, cqe->res);
+            return;
+        }
+
+        connection->response_size = processConnectionMessage(connection, cqe->res);
+        connection->response_sent = 0;
+        if (connection->response_size > 0) postUringWrite(ring, slot);
+        else postUringRead(ring, slot);
+    }
+    else if (kind == URING_WRITE)
+    {
+        if (cqe->res <= 0)
+        {
+            served[slot] = false;
+            dropEventClient(connection, -1);
+            return;
+        }
+
+        //the next request goes into the same buffer, so it is only received
+        //once the whole response is out
+        connection->response_sent += cqe->res;
+        if (connection->response_sent < connection->response_size) postUringWrite(ring, slot);
+        else postUringRead(ring, slot);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Serves the clients of a server with io_uring until the server is stopped.
+// Returns false if io_uring is not available
+//-----------------------------------------------------------------------------
+static bool serveUring(int socket_fd, int protocol_type, bool *run_server)
+{
+    unsigned char log_msg[1000];
+    struct uring ring;
+    struct __kernel_timespec timeout = {0, EVENT_TIMEOUT_MS * 1000000LL};
+
+    pthread_mutex_lock(&connections_lock);
+    initConnectionPool();
+    pthread_mutex_unlock(&connections_lock);
+    if (connections == NULL) return false;
+
+    //every connection has one request posted at a time, plus the accept and
+    //the timeout that makes the loop check run_server
+    if (!setupUring(&ring, connection_slots + 2)) return false;
+
+    struct iovec *iovecs = (struct iovec *)malloc(connection_slots * sizeof(struct iovec));
+    bool *served = (bool *)calloc(connection_slots, sizeof(bool));
+    if (iovecs == NULL || served == NULL)
+    {
+        free(iovecs);
+        free(served);
+        closeUring(&ring);
+        return false;
+    }
+    for (int i = 0; i < connection_slots; i++)
+    {
+        iovecs[i].iov_base = connections[i].buffer;
+        iovecs[i].iov_len = NET_BUFFER_SIZE;
+    }
+    if (syscall(__NR_io_uring_register, ring.fd, IORING_REGISTER_BUFFERS, iovecs, connection_slots) < 0)
+    {
+        free(iovecs);
+        free(served);
+        closeUring(&ring);
+        return false;
+    }
+
+    //io_uring waits on the socket itself, it must not fail with EAGAIN
+    SetSocketBlockingEnabled(socket_fd, true);
+    postUringAccept(&ring, socket_fd);
+    postUringTimeout(&ring, &timeout);
+    sprintf(log_msg, "Server: serving clients with io_uring\n");
+    log(log_msg);
+
+    while (*run_server)
+    {
+        if (enterUring(&ring, 1) < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) break;
+
+        unsigned int head = *ring.cq_head;
+        while (head != __atomic_load_n(ring.cq_tail, __ATOMIC_ACQUIRE))
+        {
+            struct io_uring_cqe cqe = ring.cqes[head & *ring.cq_mask];
+            head++;
+            //give the entry back before handling it, handling may prepare
+            //new requests and wait for room
+            __atomic_store_n(ring.cq_head, head, __ATOMIC_RELEASE);
+            completeUringRequest(&ring, &cqe, socket_fd, protocol_type, served, &timeout);
+        }
+    }
+
+    //closing the ring cancels the requests still posted
+    closeUring(&ring);
+    for (int i = 0; i < connection_slots; i++)
+    {
+        if (served[i])
+        {
+            closeSocket(connections[i].fd);
+            releaseConnection(&connections[i]);
+        }
+    }
+    free(iovecs);
+    free(served);
+    SetSocketBlockingEnabled(socket_fd, false);
+    return true;
+}
+#endif
+
 //-----------------------------------------------------------------------------
 // Thread to handle requests for each connected client
 //-----------------------------------------------------------------------------
 void *handleConnections(void *arguments)
 {
     unsigned char log_msg[1000];
-    int *args = (int *)arguments;
-    int client_fd = args[0];
-    int protocol_type = args[1];
-    unsigned char buffer[NET_BUFFER_SIZE];
+    struct client_connection *connection = (struct client_connection *)arguments;
+    int client_fd = connection->fd;
+    int protocol_type = connection->protocol_type;
+    unsigned char *buffer = connection->buffer;
     int messageSize;
     bool *run_server;
     
@@ -239,11 +910,42 @@ void *handleConnections(void *arguments)
     }
     //printf("Debug: Closing client socket and calling pthread_exit in server.cpp\n");
     close(client_fd);
+    releaseConnection(connection);
     sprintf(log_msg, "Terminating Modbus connections thread\r\n");
     log(log_msg);
     pthread_exit(NULL);
 }
 
+//-----------------------------------------------------------------------------
+// Helper function - Serves the clients of a server with the event backend set
+// in runtime.cfg until the server is stopped. io_uring falls back to epoll
+// when the kernel does not have it. Returns false if no event backend could
+// be started, so the server keeps a thread per client
+//-----------------------------------------------------------------------------
+static bool serveEvents(int socket_fd, int protocol_type, bool *run_server)
+{
+    unsigned char log_msg[1000];
+
+    if (net_backend == NET_IO_URING)
+    {
+#ifdef NET_IO_URING_SUPPORTED
+        if (serveUring(socket_fd, protocol_type, run_server)) return true;
+        sprintf(log_msg, "Server: io_uring is not available on this kernel, using epoll\n");
+#else
+        sprintf(log_msg, "Server: the runtime was built without io_uring, using epoll\n");
+#endif
+        log(log_msg);
+    }
+
+#ifdef __linux__
+    if (serveEpoll(socket_fd, protocol_type, run_server)) return true;
+#endif
+
+    sprintf(log_msg, "Server: epoll is not available, using a thread per client\n");
+    log(log_msg);
+    return false;
+}
+
 //-----------------------------------------------------------------------------
 // Function to start the server. It receives the port number as argument and
 // creates an infinite loop to listen and parse the messages sent by the
@@ -264,6 +966,14 @@ void startServer(uint16_t port, int protocol_type)
     }
     else if (protocol_type == ENIP_PROTOCOL)
         run_server = &run_enip;
+
+    if (net_backend != NET_THREADS && socket_fd >= 0 && serveEvents(socket_fd, protocol_type, run_server))
+    {
+        close(socket_fd);
+        sprintf(log_msg, "Terminating Server thread\r\n");
+        log(log_msg);
+        return;
+    }
     
     while(*run_server)
     {
@@ -276,18 +986,29 @@ void startServer(uint16_t port, int protocol_type)
 
         else
         {
-            int arguments[2];
             pthread_t thread;
             int ret = -1;
+            struct client_connection *connection = acquireConnection(client_fd, protocol_type);
+            if (connection == NULL)
+            {
+                sprintf(log_msg, "Server: %d connections open already, refusing client ID: %d\n", max_connections, client_fd);
+                log(log_msg);
+                closeSocket(client_fd);
+                continue;
+            }
+
             sprintf(log_msg, "Server: Client accepted! Creating thread for the new client ID: %d...\n", client_fd);
             log(log_msg);
-            arguments[0] = client_fd;
-            arguments[1] = protocol_type;
-            ret = pthread_create(&thread, NULL, handleConnections, (void*)arguments);
+            ret = createRuntimeThread(&thread, handleConnections, (void*)connection, THREAD_PROTOCOL);
             if (ret==0) 
             {
                 pthread_detach(thread);
             }
+            else
+            {
+                closeSocket(client_fd);
+                releaseConnection(connection);
+            }
         }
     }
     close(socket_fd);
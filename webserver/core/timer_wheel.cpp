@@ -0,0 +1,315 @@
+//-----------------------------------------------------------------------------
+// Copyright 2026 OpenPLC Project
+// This file is part of the OpenPLC Software Stack.
+//
+// OpenPLC is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// OpenPLC is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with OpenPLC.  If not, see <http://www.gnu.org/licenses/>.
+//------
+//
+// Timer wheel behind the TP, TON and TOF blocks of programs compiled with
+// iec2c -O w (see timer_wheel.h). Running timers are kept in a hierarchical
+// wheel of 4 levels of 256 slots, with a resolution of 1 ms on the first
+// level, so starting or stopping a timer costs the same whatever the number
+// of timers. Before each run of the program the scan advances the wheel to
+// __CURRENT_TIME and marks the timers that expired. Timers whose slot came
+// up but are due later in the same millisecond wait in the due list, so they
+// expire on the same scan as with the plain blocks.
+//-----------------------------------------------------------------------------
+
+#include <stdio.h>
+#include <limits.h>
+#include <pthread.h>
+
+#include "iec_types_all.h"
+#include "timer_wheel.h"
+#include "ladder.h"
+
+#define WHEEL_RESOLUTION_NS     1000000ULL
+#define WHEEL_LEVELS            4
+#define WHEEL_SLOT_BITS         8
+#define WHEEL_SLOTS             (1 << WHEEL_SLOT_BITS)
+#define WHEEL_SLOT_MASK         (WHEEL_SLOTS - 1)
+
+//every slot is a circular list with a dummy head, so a timer can be removed
+//without knowing where it is
+static __timer_wheel_entry_t wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+static __timer_wheel_entry_t due_list;
+static bool wheel_ready = false;
+
+//last tick (in WHEEL_RESOLUTION_NS) the wheel was advanced to
+static unsigned long long wheel_tick = 0;
+static int armed_timers = 0;
+static pthread_mutex_t wheel_lock = PTHREAD_MUTEX_INITIALIZER;
+
+extern IEC_TIME __CURRENT_TIME;
+extern unsigned long long __next_timer_deadline;
+
+//-----------------------------------------------------------------------------
+// Helper function - Converts an IEC time to nanoseconds. Negative times are
+// clamped to 0
+//-----------------------------------------------------------------------------
+static inline unsigned long long timeToNs(TIME t)
+{
+    long long ns = (long long)t.tv_sec * 1000000000LL + t.tv_nsec;
+    return (ns < 0) ? 0 : ns;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Same as __timer_deadline_hint() in iec_std_lib.h: lowers
+// the deadline the event driven scan waits for
+//-----------------------------------------------------------------------------
+static inline void hintDeadline(unsigned long long ns)
+{
+    unsigned long long old = __atomic_load_n(&__next_timer_deadline, __ATOMIC_RELAXED);
+    while (ns < old && !__atomic_compare_exchange_n(&__next_timer_deadline, &old, ns, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Empties every slot and the due list
+//-----------------------------------------------------------------------------
+static void initTimerWheel()
+{
+    for (int level = 0; level < WHEEL_LEVELS; level++)
+    {
+        for (int slot = 0; slot < WHEEL_SLOTS; slot++)
+        {
+            wheel[level][slot].next = wheel[level][slot].prev = &wheel[level][slot];
+        }
+    }
+    due_list.next = due_list.prev = &due_list;
+    wheel_ready = true;
+}
+
+//-----------------------------------------------------------------------------
+// Helper functions - Add a timer at the end of a list / remove it from its list
+//-----------------------------------------------------------------------------
+static inline void linkEntry(__timer_wheel_entry_t *head, __timer_wheel_entry_t *entry)
+{
+    entry->next = head;
+    entry->prev = head->prev;
+    head->prev->next = entry;
+    head->prev = entry;
+}
+
+static inline void unlinkEntry(__timer_wheel_entry_t *entry)
+{
+    entry->prev->next = entry->next;
+    entry->next->prev = entry->prev;
+    entry->next = entry->prev = NULL;
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Places a timer in the slot of its deadline. The level is
+// chosen by the distance to the current tick. Timers that are due on the
+// current tick or before go to the due list
+//-----------------------------------------------------------------------------
+static void insertEntry(__timer_wheel_entry_t *entry)
+{
+    unsigned long long expires = entry->deadline / WHEEL_RESOLUTION_NS;
+    if (expires <= wheel_tick)
+    {
+        linkEntry(&due_list, entry);
+        return;
+    }
+
+    //further than the last level can hold: park it at the far end, it is
+    //placed again when that slot is cascaded
+    unsigned long long delta = expires - wheel_tick;
+    if (delta >= (1ULL << (WHEEL_LEVELS * WHEEL_SLOT_BITS)))
+    {
+        delta = (1ULL << (WHEEL_LEVELS * WHEEL_SLOT_BITS)) - 1;
+        expires = wheel_tick + delta;
+    }
+
+    int level = 0;
+    while (delta >= (1ULL << ((level + 1) * WHEEL_SLOT_BITS))) level++;
+    linkEntry(&wheel[level][(expires >> (level * WHEEL_SLOT_BITS)) & WHEEL_SLOT_MASK], entry);
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Moves every timer of a list to the slots where they
+// belong now
+//-----------------------------------------------------------------------------
+static void reinsertList(__timer_wheel_entry_t *head)
+{
+    while (head->next != head)
+    {
+        __timer_wheel_entry_t *entry = head->next;
+        unlinkEntry(entry);
+        insertEntry(entry);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Helper function - Returns the earliest deadline of the running timers, in
+// ns of __CURRENT_TIME. Only the first occupied slot of each level has to be
+// looked at
+//-----------------------------------------------------------------------------
+static unsigned long long earliestDeadline()
+{
+    unsigned long long earliest = ULLONG_MAX;
+
+    for (__timer_wheel_entry_t *entry = due_list.next; entry != &due_list; entry = entry->next)
+    {
+        if (entry->deadline < earliest) earliest = entry->deadline;
+    }
+
+    for (int level = 0; level < WHEEL_LEVELS; level++)
+    {
+        unsigned long long current = wheel_tick >> (level * WHEEL_SLOT_BITS);
+        for (int i = 1; i <= WHEEL_SLOTS; i++)
+        {
+            __timer_wheel_entry_t *head = &wheel[level][(current + i) & WHEEL_SLOT_MASK];
+            if (head->next == head) continue;
+
+            for (__timer_wheel_entry_t *entry = head->next; entry != head; entry = entry->next)
+            {
+                if (entry->deadline < earliest) earliest = entry->deadline;
+            }
+            break;
+        }
+    }
+
+    return earliest;
+}
+
+//-----------------------------------------------------------------------------
+// Called by the timer blocks when a timer starts, or when PT changes while it
+// runs. A timer that is already due expires right away
+//-----------------------------------------------------------------------------
+void __timer_wheel_arm(__timer_wheel_entry_t *entry, TIME start, TIME pt)
+{
+    TIME deadline = {start.tv_sec + pt.tv_sec, start.tv_nsec + pt.tv_nsec};
+
+    pthread_mutex_lock(&wheel_lock);
+    if (!wheel_ready) initTimerWheel();
+    if (entry->armed)
+    {
+        unlinkEntry(entry);
+        armed_timers--;
+    }
+
+    entry->start = start;
+    entry->pt = pt;
+    entry->deadline = timeToNs(deadline);
+    entry->armed = 0;
+    entry->expired = (entry->deadline <= timeToNs(__CURRENT_TIME));
+    if (!entry->expired)
+    {
+        insertEntry(entry);
+        entry->armed = 1;
+        armed_timers++;
+    }
+    pthread_mutex_unlock(&wheel_lock);
+
+    if (!entry->expired) hintDeadline(entry->deadline);
+}
+
+//-----------------------------------------------------------------------------
+// Called by the timer blocks when a running timer is reset
+//-----------------------------------------------------------------------------
+void __timer_wheel_disarm(__timer_wheel_entry_t *entry)
+{
+    pthread_mutex_lock(&wheel_lock);
+    if (entry->armed)
+    {
+        unlinkEntry(entry);
+        entry->armed = 0;
+        armed_timers--;
+    }
+    pthread_mutex_unlock(&wheel_lock);
+}
+
+//-----------------------------------------------------------------------------
+// Advances the wheel to __CURRENT_TIME and marks the timers that expired.
+// Called by the scan thread right before the program runs
+//-----------------------------------------------------------------------------
+void advanceTimerWheel()
+{
+    unsigned long long now = timeToNs(__CURRENT_TIME);
+    unsigned long long target = now / WHEEL_RESOLUTION_NS;
+
+    pthread_mutex_lock(&wheel_lock);
+    if (!wheel_ready) initTimerWheel();
+
+    if (armed_timers == 0)
+    {
+        if (target > wheel_tick) wheel_tick = target;
+        pthread_mutex_unlock(&wheel_lock);
+        return;
+    }
+
+    if (target > wheel_tick + (1ULL << (2 * WHEEL_SLOT_BITS)))
+    {
+        //long jump (the scan slept or stalled): placing every timer again
+        //is cheaper than walking all the ticks in between
+        __timer_wheel_entry_t pending;
+        pending.next = pending.prev = &pending;
+        for (int level = 0; level < WHEEL_LEVELS; level++)
+        {
+            for (int slot = 0; slot < WHEEL_SLOTS; slot++)
+            {
+                __timer_wheel_entry_t *head = &wheel[level][slot];
+                while (head->next != head)
+                {
+                    __timer_wheel_entry_t *entry = head->next;
+                    unlinkEntry(entry);
+                    linkEntry(&pending, entry);
+                }
+            }
+        }
+        wheel_tick = target;
+        reinsertList(&pending);
+    }
+
+    while (wheel_tick < target)
+    {
+        wheel_tick++;
+
+        //at the start of each turn of a level, the next slot of the level
+        //above is spread over the levels below
+        for (int level = 1; level < WHEEL_LEVELS; level++)
+        {
+            if ((wheel_tick & ((1ULL << (level * WHEEL_SLOT_BITS)) - 1)) != 0) break;
+            reinsertList(&wheel[level][(wheel_tick >> (level * WHEEL_SLOT_BITS)) & WHEEL_SLOT_MASK]);
+        }
+
+        __timer_wheel_entry_t *head = &wheel[0][wheel_tick & WHEEL_SLOT_MASK];
+        while (head->next != head)
+        {
+            __timer_wheel_entry_t *entry = head->next;
+            unlinkEntry(entry);
+            linkEntry(&due_list, entry);
+        }
+    }
+
+    __timer_wheel_entry_t *entry = due_list.next;
+    while (entry != &due_list)
+    {
+        __timer_wheel_entry_t *next = entry->next;
+        if (entry->deadline <= now)
+        {
+            unlinkEntry(entry);
+            entry->armed = 0;
+            entry->expired = 1;
+            armed_timers--;
+        }
+        entry = next;
+    }
+
+    //the event driven scan needs to know when to run the program again
+    unsigned long long earliest = (scan_mode == SCAN_EVENT && armed_timers > 0) ? earliestDeadline() : ULLONG_MAX;
+    pthread_mutex_unlock(&wheel_lock);
+
+    if (earliest != ULLONG_MAX) hintDeadline(earliest);
+}
@@ -3,6 +3,10 @@ import subprocess
 import socket
 import errno
 import time
+import struct
+import select
+import threading
+import config_image
 from threading import Thread
 from Queue import Queue, Empty
 
@@ -68,6 +72,84 @@ class NonBlockingStreamReader:
 
 class UnexpectedEndOfStream(Exception): pass
 
+class RuntimeConnection:
+    '''
+    Keeps one connection open to the runtime interactive server and talks
+    to it with the binary protocol (see core/interactive_server.cpp), so
+    status and log queries do not open a new connection each time.
+    '''
+    MAGIC = 0xA5
+    OP_COMMAND = 0x01
+    HEADER = '>BBHII'
+    HEADER_SIZE = 12
+
+    def __init__(self, port = 43628):
+        self.port = port
+        self.sock = None
+        self.next_id = 1
+        self.lock = threading.Lock()
+
+    def close(self):
+        if (self.sock != None):
+            self.sock.close()
+            self.sock = None
+
+    def _recv_exact(self, size):
+        data = b''
+        while (len(data) < size):
+            chunk = self.sock.recv(size - len(data))
+            if not chunk:
+                raise socket.error("Connection closed by the runtime")
+            data += chunk
+        return data
+
+    def _send(self, opcode, payload):
+        #a connection left open to a runtime that was restarted is closed
+        #on the runtime side already, so it is replaced before sending
+        if (self.sock != None):
+            readable, writable, failed = select.select([self.sock], [], [], 0)
+            if readable and not self.sock.recv(1, socket.MSG_PEEK):
+                self.close()
+        if (self.sock == None):
+            self.sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+            self.sock.connect(('localhost', self.port))
+        request_id = self.next_id
+        self.next_id = (self.next_id + 1) & 0xFFFFFFFF
+        self.sock.sendall(struct.pack(self.HEADER, self.MAGIC, opcode, 0, request_id, len(payload)) + payload)
+        return request_id
+
+    def _receive(self, request_id):
+        #replies to other requests can only be left over from a request that failed half way
+        while True:
+            magic, reply_opcode, status, reply_id, length = struct.unpack(self.HEADER, self._recv_exact(self.HEADER_SIZE))
+            data = self._recv_exact(length)
+            if (reply_id == request_id):
+                return status, data
+
+    def _locked_request(self, opcode, payload):
+        with self.lock:
+            #only a request that could not be sent is tried again on a fresh
+            #connection. Once it is sent the runtime may have run it already
+            try:
+                try:
+                    request_id = self._send(opcode, payload)
+                except socket.error:
+                    self.close()
+                    request_id = self._send(opcode, payload)
+                return self._receive(request_id)
+            except socket.error:
+                self.close()
+                raise
+
+    def command(self, command):
+        '''
+        Sends one command and returns its reply
+        '''
+        status, data = self._locked_request(self.OP_COMMAND, command.encode())
+        return data
+
+runtime_connection = RuntimeConnection()
+
 class runtime:
     project_file = ""
     project_name = ""
@@ -75,18 +157,21 @@ class runtime:
     runtime_status = "Stopped"
     
     def start_runtime(self):
+        '''
+        Starts the runtime. If the slave device or DNP3 settings are rejected
+        the runtime is not started and config_image.ConfigImageError is raised
+        '''
         if (self.status() == "Stopped"):
+            #dnp3.cfg can be edited by hand, so the image is brought up to date on every start
+            config_image.convert()
             self.theprocess = subprocess.Popen(['./core/openplc'])  # XXX: iPAS
             self.runtime_status = "Running"
     
     def stop_runtime(self):
         if (self.status() == "Running"):
             try:
-                s = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
-                s.connect(('localhost', 43628))
-                s.send('quit()\n')
-                data = s.recv(1000)
-                s.close()
+                data = runtime_connection.command('quit()')
+                runtime_connection.close()
                 self.runtime_status = "Stopped"
 
                 while self.theprocess.poll() is None:  # XXX: iPAS, to prevent the defunct killed process.
@@ -116,124 +201,96 @@ class runtime:
         return compilation_status_str
     
     def status(self):
-        if ('compilation_object' in globals()):
-            if (compilation_object.end_of_stream == False):
-                return "Compiling"
+        if (self.status_cached() == "Compiling"):
+            return "Compiling"
         
         #If it is running, make sure that it really is running
         if (self.runtime_status == "Running"):
             try:
-                s = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
-                s.connect(('localhost', 43628))
-                s.send('exec_time()\n')
-                data = s.recv(10000)
-                s.close()
+                data = runtime_connection.command('exec_time()')
                 self.runtime_status = "Running"
             except socket.error as serr:
                 print("OpenPLC Runtime is not running. Error: " + str(serr))
                 self.runtime_status = "Stopped"
         
         return self.runtime_status
+
+    def status_cached(self):
+        '''
+        Same as status(), without asking the runtime whether it is alive
+        '''
+        if ('compilation_object' in globals()):
+            if (compilation_object.end_of_stream == False):
+                return "Compiling"
+        return self.runtime_status
     
     def start_modbus(self, port_num):
         if (self.status() == "Running"):
             try:
-                s = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
-                s.connect(('localhost', 43628))
-                s.send('start_modbus(' + str(port_num) + ')\n')
-                data = s.recv(1000)
-                s.close()
+                data = runtime_connection.command('start_modbus(' + str(port_num) + ')')
             except:
                 print("Error connecting to OpenPLC runtime")
                 
     def stop_modbus(self):
         if (self.status() == "Running"):
             try:
-                s = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
-                s.connect(('localhost', 43628))
-                s.send('stop_modbus()\n')
-                data = s.recv(1000)
-                s.close()
+                data = runtime_connection.command('stop_modbus()')
             except:
                 print("Error connecting to OpenPLC runtime")
 
     def start_dnp3(self, port_num):
         if (self.status() == "Running"):
             try:
-                s = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
-                s.connect(('localhost', 43628))
-                s.send('start_dnp3(' + str(port_num) + ')\n')
-                data = s.recv(1000)
-                s.close()
+                data = runtime_connection.command('start_dnp3(' + str(port_num) + ')')
             except:
                 print("Error connecting to OpenPLC runtime")
         
     def stop_dnp3(self):
         if (self.status() == "Running"):
             try:
-                s = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
-                s.connect(('localhost', 43628))
-                s.send('stop_dnp3()\n')
-                data = s.recv(1000)
-                s.close()
+                data = runtime_connection.command('stop_dnp3()')
             except:
                 print("Error connecting to OpenPLC runtime")
                 
     def start_enip(self, port_num):
         if (self.status() == "Running"):
             try:
-                s = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
-                s.connect(('localhost', 43628))
-                s.send('start_enip(' + str(port_num) + ')\n')
-                data = s.recv(1000)
-                s.close()
+                data = runtime_connection.command('start_enip(' + str(port_num) + ')')
             except:
                 print("Error connecting to OpenPLC runtime")
                 
     def stop_enip(self):
         if (self.status() == "Running"):
             try:
-                s = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
-                s.connect(('localhost', 43628))
-                s.send('stop_enip()\n')
-                data = s.recv(1000)
-                s.close()
+                data = runtime_connection.command('stop_enip()')
             except:
                 print("Error connecting to OpenPLC runtime")
     
     def start_pstorage(self, poll_rate):
         if (self.status() == "Running"):
             try:
-                s = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
-                s.connect(('localhost', 43628))
-                s.send('start_pstorage(' + str(poll_rate) + ')\n')
-                data = s.recv(1000)
-                s.close()
+                data = runtime_connection.command('start_pstorage(' + str(poll_rate) + ')')
             except:
                 print("Error connecting to OpenPLC runtime")
                 
     def stop_pstorage(self):
         if (self.status() == "Running"):
             try:
-                s = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
-                s.connect(('localhost', 43628))
-                s.send('stop_pstorage()\n')
-                data = s.recv(1000)
-                s.close()
+                data = runtime_connection.command('stop_pstorage()')
             except:
                 print("Error connecting to OpenPLC runtime")
     
-    def logs(self):
-        if (self.status() == "Running"):
+    def logs(self, tail = 0):
+        #the log request itself tells whether the runtime is still running,
+        #so status() is not asked first. tail only fetches the last bytes
+        if (self.status_cached() == "Running"):
             try:
-                s = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
-                s.connect(('localhost', 43628))
-                s.send('runtime_logs()\n')
-                data = s.recv(1000000)
-                s.close()
-                return data
-            except:
-                print("Error connecting to OpenPLC runtime")
+                if (tail > 0):
+                    return runtime_connection.command('runtime_logs_tail(' + str(tail) + ')')
+                return runtime_connection.command('runtime_logs()')
+            except socket.error as serr:
+                print("OpenPLC Runtime is not running. Error: " + str(serr))
+                self.runtime_status = "Stopped"
             
             return "Error connecting to OpenPLC runtime"
         else:
@@ -242,11 +299,7 @@ class runtime:
     def exec_time(self):
         if (self.status() == "Running"):
             try:
-                s = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
-                s.connect(('localhost', 43628))
-                s.send('exec_time()\n')
-                data = s.recv(10000)
-                s.close()
+                data = runtime_connection.command('exec_time()')
                 return display_time(int(data), 4)
             except:
                 print("Error connecting to OpenPLC runtime")
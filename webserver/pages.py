@@ -1416,7 +1416,7 @@ hardware_tail = """</textarea>
     function loadData()
     {
         refreshSelector();
-        url = 'runtime_logs'
+        url = 'runtime_logs?tail=1'
         try
         {
             req = new XMLHttpRequest();
@@ -87,6 +87,13 @@ elif [ "$1" == "simulink_linux" ]; then
     echo linux > ../scripts/openplc_platform
     echo simulink_linux > ../scripts/openplc_driver
 
+elif [ "$1" == "synthetic" ]; then
+    echo "Activating Synthetic I/O driver"
+    cp ./hardware_layers/synthetic.cpp ./hardware_layer.cpp
+    echo "Setting Platform"
+    echo linux > ../scripts/openplc_platform
+    echo synthetic > ../scripts/openplc_driver
+
 elif [ "$1" == "unipi" ]; then
     echo "Activating UniPi 1.1 driver"
     cp ./hardware_layers/unipi.cpp ./hardware_layer.cpp
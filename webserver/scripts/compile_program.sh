@@ -9,6 +9,25 @@ cd scripts &>/dev/null
 
 OPENPLC_PLATFORM=$(cat openplc_platform)
 
+#iec2c code generation options (-O) are opt-in. They are read from the
+#iec2c_options file as a comma separated list, e.g. "t,w". Option e is
+#given the platform as its profile unless one is written (e=rpi).
+IEC2C_OPTIONS=$(grep -v '^#' iec2c_options 2>/dev/null | tr -d ' \t\r\n')
+IEC2C_ARGS=""
+GENERATED_FILES="POUS.c POUS.h LOCATED_VARIABLES.h VARIABLES.csv Config0.c Config0.h Res0.c"
+if [ -n "$IEC2C_OPTIONS" ]; then
+    OUTPUT_OPTIONS=""
+    for OPTION in ${IEC2C_OPTIONS//,/ }; do
+        if [ "$OPTION" = "e" ]; then
+            OPTION="e=$OPENPLC_PLATFORM"
+        elif [ "$OPTION" = "l" ]; then
+            GENERATED_FILES="$GENERATED_FILES LINE_MAP.csv"
+        fi
+        OUTPUT_OPTIONS="${OUTPUT_OPTIONS:+$OUTPUT_OPTIONS,}$OPTION"
+    done
+    IEC2C_ARGS="-O $OUTPUT_OPTIONS"
+fi
+
 #store the active program filename
 echo "$1" > ../active_program
 
@@ -17,14 +36,14 @@ cd ..
 echo "Optimizing ST program..."
 ./st_optimizer ./st_files/"$1" ./st_files/"$1"
 echo "Generating C files..."
-./iec2c -f -l -p -r -R -a ./st_files/"$1"
+./iec2c -f -l -p -r -R -a $IEC2C_ARGS ./st_files/"$1"
 if [ $? -ne 0 ]; then
     echo "Error generating C files"
     echo "Compilation finished with errors!"
     exit 1
 fi
 echo "Moving Files..."
-mv -f POUS.c POUS.h LOCATED_VARIABLES.h VARIABLES.csv Config0.c Config0.h Res0.c ./core/
+mv -f $GENERATED_FILES ./core/
 if [ $? -ne 0 ]; then
     echo "Error moving files"
     echo "Compilation finished with errors!"
@@ -32,6 +51,9 @@ if [ $? -ne 0 ]; then
 fi
 
 #compiling for each platform
+#Res0.c includes POUS.c, so the -O2 it is built with applies to the whole
+#PLC program and every library block it uses, not only to the batched PID
+#pass. The timing figures of the scan estimate (iec2c -O e) assume it.
 cd core
 if [ "$OPENPLC_PLATFORM" = "win" ]; then
     echo "Compiling for Windows"
@@ -42,7 +64,7 @@ if [ "$OPENPLC_PLATFORM" = "win" ]; then
         echo "Compilation finished with errors!"
         exit 1
     fi
-    g++ -I ./lib -c Res0.c -w
+    g++ -O2 -g -I ./lib -c Res0.c -w
     if [ $? -ne 0 ]; then
         echo "Error compiling C files"
         echo "Compilation finished with errors!"
@@ -50,6 +72,11 @@ if [ "$OPENPLC_PLATFORM" = "win" ]; then
     fi
     echo "Generating glueVars..."
     ./glue_generator
+    if [ $? -ne 0 ]; then
+        echo "Error generating glue variables"
+        echo "Compilation finished with errors!"
+        exit 1
+    fi
     echo "Compiling main program..."
     g++ *.cpp *.o -o openplc -I ./lib -pthread -fpermissive -I /usr/local/include/modbus -L /usr/local/lib -lmodbus -w
     if [ $? -ne 0 ]; then
@@ -69,7 +96,7 @@ elif [ "$OPENPLC_PLATFORM" = "linux" ]; then
         echo "Compilation finished with errors!"
         exit 1
     fi
-    g++ -std=gnu++11 -I ./lib -c Res0.c -lasiodnp3 -lasiopal -lopendnp3 -lopenpal -w
+    g++ -std=gnu++11 -O2 -g -I ./lib -c Res0.c -lasiodnp3 -lasiopal -lopendnp3 -lopenpal -w
     if [ $? -ne 0 ]; then
         echo "Error compiling C files"
         echo "Compilation finished with errors!"
@@ -77,6 +104,11 @@ elif [ "$OPENPLC_PLATFORM" = "linux" ]; then
     fi
     echo "Generating glueVars..."
     ./glue_generator
+    if [ $? -ne 0 ]; then
+        echo "Error generating glue variables"
+        echo "Compilation finished with errors!"
+        exit 1
+    fi
     echo "Compiling main program..."
     g++ -std=gnu++11 *.cpp *.o -o openplc -I ./lib -pthread -fpermissive `pkg-config --cflags --libs libmodbus` -lasiodnp3 -lasiopal -lopendnp3 -lopenpal -w
     if [ $? -ne 0 ]; then
@@ -96,7 +128,7 @@ elif [ "$OPENPLC_PLATFORM" = "rpi" ]; then
         echo "Compilation finished with errors!"
         exit 1
     fi
-    g++ -std=gnu++11 -I ./lib -c Res0.c -lasiodnp3 -lasiopal -lopendnp3 -lopenpal -w
+    g++ -std=gnu++11 -O2 -g -I ./lib -c Res0.c -lasiodnp3 -lasiopal -lopendnp3 -lopenpal -w
     if [ $? -ne 0 ]; then
         echo "Error compiling C files"
         echo "Compilation finished with errors!"
@@ -104,6 +136,11 @@ elif [ "$OPENPLC_PLATFORM" = "rpi" ]; then
     fi
     echo "Generating glueVars..."
     ./glue_generator
+    if [ $? -ne 0 ]; then
+        echo "Error generating glue variables"
+        echo "Compilation finished with errors!"
+        exit 1
+    fi
     echo "Compiling main program..."
     g++ -std=gnu++11 *.cpp *.o -o openplc -I ./lib -lrt -lwiringPi -lpthread -fpermissive `pkg-config --cflags --libs libmodbus` -lasiodnp3 -lasiopal -lopendnp3 -lopenpal -w
     if [ $? -ne 0 ]; then
@@ -9,6 +9,7 @@ import datetime
 import time
 import pages
 import openplc
+import config_image
 import monitoring as monitor
 import sys
 import ctypes
@@ -155,6 +156,11 @@ def generate_mbconfig():
                 device_counter += 1
                 
             with open('./mbconfig.cfg', 'w+') as f: f.write(mbconfig)
+            try:
+                config_image.convert()
+            except config_image.ConfigImageError as e:
+                print("Invalid slave device configuration: " + str(e))
+                flask.flash("Invalid slave device configuration: " + str(e) + ". The PLC will not start until it is fixed.")
             
         except Error as e:
             print("error connecting to the database" + str(e))
@@ -163,6 +169,13 @@ def generate_mbconfig():
                 
 
     
+def draw_flashed_messages():
+    messages = ""
+    for message in flask.get_flashed_messages():
+        messages += "<p style='font-family:\"Roboto\", sans-serif; font-size:16px; color:red'><b>" + str(flask.escape(message)) + "</b></p>"
+    return messages
+
+
 def draw_top_div():
     global openplc_runtime
     top_div = ("<div class='top'>"
@@ -470,7 +483,11 @@ def start_plc():
         return flask.redirect(flask.url_for('login'))
     else:
         monitor.stop_monitor()
-        openplc_runtime.start_runtime()
+        try:
+            openplc_runtime.start_runtime()
+        except config_image.ConfigImageError as e:
+            flask.flash("The PLC was not started. Invalid slave device or DNP3 configuration: " + str(e))
+            return flask.redirect(flask.url_for('dashboard'))
         time.sleep(1)
         configure_runtime()
         monitor.cleanup()
@@ -496,7 +513,7 @@ def runtime_logs():
     if (flask_login.current_user.is_authenticated == False):
         return flask.redirect(flask.url_for('login'))
     else:
-        return openplc_runtime.logs()
+        return openplc_runtime.logs(flask.request.args.get('tail', 0, type=int))
 
 
 @app.route('/dashboard')
@@ -529,7 +546,9 @@ def dashboard():
                 <div style='margin-left:320px'>
                     <div style='w3-container'>
                         <br>
-                        <h2>Dashboard</h2>
+                        <h2>Dashboard</h2>"""
+        return_str += draw_flashed_messages()
+        return_str += """
                         <p style='font-family:'Roboto', sans-serif; font-size:16px'><b>Status: """
         if (openplc_runtime.status() == "Running"):
             return_str += "<font color = '#02CC07'>Running</font></b></p>"
@@ -984,7 +1003,9 @@ def modbus():
             <div style="margin-left:320px; margin-right:70px">
                 <div style="w3-container">
                     <br>
-                    <h2>Slave Devices</h2>
+                    <h2>Slave Devices</h2>"""
+        return_str += draw_flashed_messages()
+        return_str += """
                     <p>List of Slave devices attached to OpenPLC.</p>
                     <p><b>Attention:</b> Slave devices are attached to address 100 onward (i.e. %IX100.0, %IW100, %QX100.0, and %QW100)
                     <table>
@@ -1716,6 +1737,8 @@ def hardware():
             else: return_str += "<option value='simulink'>Simulink</option>"
             if (current_driver == "simulink_linux"): return_str += "<option selected='selected' value='simulink_linux'>Simulink with DNP3 (Linux only)</option>"
             else: return_str += "<option value='simulink_linux'>Simulink with DNP3 (Linux only)</option>"
+            if (current_driver == "synthetic"): return_str += "<option selected='selected' value='synthetic'>Synthetic I/O for scaling tests (Linux only)</option>"
+            else: return_str += "<option value='synthetic'>Synthetic I/O for scaling tests (Linux only)</option>"
             if (current_driver == "unipi"): return_str += "<option selected='selected' value='unipi'>UniPi v1.1</option>"
             else: return_str += "<option value='unipi'>UniPi v1.1</option>"
             if (current_driver == "psm_linux"): return_str += "<option selected='selected' value='psm_linux'>Python on Linux (PSM)</option>"
@@ -2398,10 +2421,13 @@ if __name__ == '__main__':
                     
             if (start_run == 'true'):
                 print("Initializing OpenPLC in RUN mode...")
-                openplc_runtime.start_runtime()
-                time.sleep(1)
-                configure_runtime()
-            	monitor.parse_st(openplc_runtime.project_file)
+                try:
+                    openplc_runtime.start_runtime()
+                    time.sleep(1)
+                    configure_runtime()
+                    monitor.parse_st(openplc_runtime.project_file)
+                except config_image.ConfigImageError as e:
+                    print("OpenPLC was not started. Invalid slave device or DNP3 configuration: " + str(e))
 		
             app.run(debug=False, host='0.0.0.0', threaded=True, port=8080)
         